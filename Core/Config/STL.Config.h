@@ -77,6 +77,10 @@
 #endif
 
 
+// instrumented allocators, memory usage is tracked per subsystem (see MemoryTracker)
+//#define GX_MEMORY_TRACKING
+
+
 // files
 //#define GX_LZMA_ENABLED
 //#define GX_ZLIB_ENABLED
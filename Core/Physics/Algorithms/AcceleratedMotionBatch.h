@@ -0,0 +1,216 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Batch version of 'UniformlyAcceleratedMotion'.
+	Each coordinate is stored in separate array (structure of arrays),
+	so integration loop is a sequence of independent multiply-add operations
+	that can be vectorized by compiler.
+*/
+
+#pragma once
+
+#include "Core/Physics/Algorithms/AcceleratedMotion.h"
+#include "Core/Physics/Dimensions/PhysicsValueVec.h"
+#include "Core/STL/ThreadSafe/ParallelFor.h"
+#include "Core/STL/Containers/StaticArray.h"
+
+namespace GXPhysics
+{
+
+	//
+	// Accelerated Motion Batch
+	//
+
+	template <typename Pos, typename Vel, typename Accel>
+	struct AcceleratedMotionBatch final
+	{
+		STATIC_ASSERT( IsDistanceUnits<Pos> and IsVelocityUnits<Vel> and IsAccelerationUnits<Accel> );
+
+	// types
+	public:
+		using Self				= AcceleratedMotionBatch< Pos, Vel, Accel >;
+		using Position_t		= Pos;
+		using Velocity_t		= Vel;
+		using Acceleration_t	= Accel;
+		using Position3_t		= PhysicsValueVec< Pos, 3 >;
+		using Velocity3_t		= PhysicsValueVec< Vel, 3 >;
+		using Acceleration3_t	= PhysicsValueVec< Accel, 3 >;
+
+
+	// constants
+	private:
+		static constexpr usize	_BatchSize			= 1 << 12;
+		static constexpr usize	_MinParallelCount	= 1 << 16;
+
+
+	// variables
+	private:
+		StaticArray< Array< Pos >, 3 >		_position;		// x, y, z
+		StaticArray< Array< Vel >, 3 >		_velocity;
+		StaticArray< Array< Accel >, 3 >	_acceleration;
+
+
+	// methods
+	public:
+		AcceleratedMotionBatch () {}
+
+		usize Add (const Position3_t &pos, const Velocity3_t &vel, const Acceleration3_t &accel = Acceleration3_t());
+
+		void Reserve (usize count);
+		void Clear ();
+
+		void SetPosition (usize i, const Position3_t &pos);
+		void SetVelocity (usize i, const Velocity3_t &vel);
+		void SetAcceleration (usize i, const Acceleration3_t &accel);
+
+		template <typename Time>
+		void Integrate (Time dt);
+
+		template <typename Time>
+		void Integrate (Time dt, usize first, usize last);
+
+		ND_ usize				Count ()					const	{ return _position[0].Count(); }
+		ND_ Position3_t			Position (usize i)			const	{ return Position3_t( _position[0][i], _position[1][i], _position[2][i] ); }
+		ND_ Velocity3_t			Velocity (usize i)			const	{ return Velocity3_t( _velocity[0][i], _velocity[1][i], _velocity[2][i] ); }
+		ND_ Acceleration3_t		Acceleration (usize i)		const	{ return Acceleration3_t( _acceleration[0][i], _acceleration[1][i], _acceleration[2][i] ); }
+
+		ND_ ArrayCRef<Pos>		Positions (usize axis)		const	{ return _position[axis]; }
+		ND_ ArrayCRef<Vel>		Velocities (usize axis)		const	{ return _velocity[axis]; }
+	};
+
+
+
+/*
+=================================================
+	Add
+=================================================
+*/
+	template <typename Pos, typename Vel, typename Accel>
+	inline usize  AcceleratedMotionBatch<Pos,Vel,Accel>::Add (const Position3_t &pos, const Velocity3_t &vel, const Acceleration3_t &accel)
+	{
+		FOR( i, _position )
+		{
+			_position[i].PushBack( pos[i] );
+			_velocity[i].PushBack( vel[i] );
+			_acceleration[i].PushBack( accel[i] );
+		}
+		return _position[0].LastIndex();
+	}
+
+/*
+=================================================
+	Reserve
+=================================================
+*/
+	template <typename Pos, typename Vel, typename Accel>
+	inline void  AcceleratedMotionBatch<Pos,Vel,Accel>::Reserve (usize count)
+	{
+		FOR( i, _position )
+		{
+			_position[i].Reserve( count );
+			_velocity[i].Reserve( count );
+			_acceleration[i].Reserve( count );
+		}
+	}
+
+/*
+=================================================
+	Clear
+=================================================
+*/
+	template <typename Pos, typename Vel, typename Accel>
+	inline void  AcceleratedMotionBatch<Pos,Vel,Accel>::Clear ()
+	{
+		FOR( i, _position )
+		{
+			_position[i].Clear();
+			_velocity[i].Clear();
+			_acceleration[i].Clear();
+		}
+	}
+
+/*
+=================================================
+	SetPosition
+=================================================
+*/
+	template <typename Pos, typename Vel, typename Accel>
+	inline void  AcceleratedMotionBatch<Pos,Vel,Accel>::SetPosition (usize index, const Position3_t &pos)
+	{
+		FOR( i, _position ) {
+			_position[i][index] = pos[i];
+		}
+	}
+
+/*
+=================================================
+	SetVelocity
+=================================================
+*/
+	template <typename Pos, typename Vel, typename Accel>
+	inline void  AcceleratedMotionBatch<Pos,Vel,Accel>::SetVelocity (usize index, const Velocity3_t &vel)
+	{
+		FOR( i, _velocity ) {
+			_velocity[i][index] = vel[i];
+		}
+	}
+
+/*
+=================================================
+	SetAcceleration
+=================================================
+*/
+	template <typename Pos, typename Vel, typename Accel>
+	inline void  AcceleratedMotionBatch<Pos,Vel,Accel>::SetAcceleration (usize index, const Acceleration3_t &accel)
+	{
+		FOR( i, _acceleration ) {
+			_acceleration[i][index] = accel[i];
+		}
+	}
+
+/*
+=================================================
+	Integrate
+=================================================
+*/
+	template <typename Pos, typename Vel, typename Accel>
+	template <typename Time>
+	inline void  AcceleratedMotionBatch<Pos,Vel,Accel>::Integrate (const Time dt)
+	{
+		ParallelFor( Count(), _BatchSize, _MinParallelCount,
+			LAMBDA( this, dt ) (usize first, usize last)
+			{
+				Integrate( dt, first, last );
+			});
+	}
+
+/*
+=================================================
+	Integrate
+----
+	same as 'UniformlyAcceleratedMotion' for each body
+=================================================
+*/
+	template <typename Pos, typename Vel, typename Accel>
+	template <typename Time>
+	inline void  AcceleratedMotionBatch<Pos,Vel,Accel>::Integrate (const Time dt, usize first, usize last)
+	{
+		ASSERT( first <= last and last <= Count() );
+
+		if ( first == last )
+			return;
+
+		FOR( axis, _position )
+		{
+			Pos *			pos		= _position[axis].ptr();
+			Vel *			vel		= _velocity[axis].ptr();
+			Accel const*	accel	= _acceleration[axis].ptr();
+
+			for (usize i = first; i < last; ++i)
+			{
+				UniformlyAcceleratedMotion( INOUT pos[i], INOUT vel[i], accel[i], dt );
+			}
+		}
+	}
+
+
+}	// GXPhysics
@@ -47,7 +47,7 @@ namespace Astrophysics
 
 		void Update (const Days_t time)
 		{
-			angle = Rad_t::Pi() * T(2) * time / period;
+			angle = Rad_t::Pi() * T(2) * ( time / period );
 		}
 
 
@@ -0,0 +1,359 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Batch versions of 'AxialRotation' and 'Orbit'.
+	State is stored as structure of arrays, time independent terms are
+	calculated once in 'Add', so 'Update' has no branches and data dependencies
+	between bodies. Large batches are updated in parallel.
+*/
+
+#pragma once
+
+#include "Core/Physics/Algorithms/Astrophysics_Orbit.h"
+#include "Core/STL/ThreadSafe/ParallelFor.h"
+
+namespace GXPhysics
+{
+namespace Astrophysics
+{
+
+	//
+	// Axial Rotation Batch
+	//
+
+	template <typename T>
+	struct AxialRotationBatch final
+	{
+	// types
+	public:
+		using Self			= AxialRotationBatch<T>;
+		using Rotation_t	= AxialRotation<T>;
+		using Days_t		= typename Rotation_t::Days_t;
+		using Rad_t			= typename Rotation_t::Rad_t;
+		using Value_t		= T;
+
+
+	// constants
+	private:
+		static constexpr usize	_BatchSize			= 1 << 12;
+		static constexpr usize	_MinParallelCount	= 1 << 16;
+
+
+	// variables
+	private:
+		// static
+		Array< Rad_t >		_axisTilt;
+		Array< Days_t >		_period;
+
+		// dynamic
+		Array< Rad_t >		_angle;
+
+
+	// methods
+	public:
+		AxialRotationBatch () {}
+
+		usize Add (const Rotation_t &rotation);
+
+		void Reserve (usize count);
+		void Clear ();
+
+		void Update (Days_t time);
+		void Update (Days_t time, usize first, usize last);
+
+		ND_ usize			Count ()				const	{ return _period.Count(); }
+		ND_ Rad_t			AxisTilt (usize i)		const	{ return _axisTilt[i]; }
+		ND_ Days_t			Period (usize i)		const	{ return _period[i]; }
+		ND_ Rad_t			Angle (usize i)			const	{ return _angle[i]; }
+		ND_ ArrayCRef<Rad_t> Angles ()				const	{ return _angle; }
+	};
+
+
+
+	//
+	// Orbit Batch
+	//
+
+	template <typename T>
+	struct OrbitBatch final
+	{
+	// types
+	public:
+		using Self			= OrbitBatch<T>;
+		using Orbit_t		= Orbit<T>;
+		using Value_t		= T;
+		using AU_t			= typename Orbit_t::AU_t;
+		using AU3_t			= typename Orbit_t::AU3_t;
+		using Days_t		= typename Orbit_t::Days_t;
+		using Rad_t			= typename Orbit_t::Rad_t;
+		using Position3_t	= typename Orbit_t::Position3_t;
+
+
+	// constants
+	private:
+		static constexpr usize	_BatchSize			= 1 << 10;
+		static constexpr usize	_MinParallelCount	= 1 << 13;
+
+
+	// variables
+	private:
+		// static, calculated from 'Orbit'
+		Array< Days_t >		_orbitalPeriod;		// 1 day for orbits with zero period
+		Array< Days_t >		_startTime;
+		Array< Rad_t >		_perihelionArg;
+		Array< Value_t >	_eccentricity;
+		Array< Value_t >	_eccFactor;			// e - e^3 / 2
+		Array< Value_t >	_eccRatio;			// sqrt( (1 + e) / (1 - e) )
+		Array< AU_t >		_semiLatusRectum;	// a * (1 - e^2), zero for orbits with zero period
+		Array< Value_t >	_sinLongOfAscNode;
+		Array< Value_t >	_cosLongOfAscNode;
+		Array< Value_t >	_sinInclination;
+		Array< Value_t >	_cosInclination;
+
+		// dynamic
+		Array< AU_t >		_positionX;
+		Array< AU_t >		_positionY;
+		Array< AU_t >		_positionZ;
+
+
+	// methods
+	public:
+		OrbitBatch () {}
+
+		usize Add (const Orbit_t &orbit);
+
+		void Reserve (usize count);
+		void Clear ();
+
+		void Update (Days_t time);
+		void Update (Days_t time, usize first, usize last);
+
+		ND_ usize			Count ()				const	{ return _orbitalPeriod.Count(); }
+		ND_ Position3_t		Position (usize i)		const	{ return Position3_t( _positionX[i], _positionY[i], _positionZ[i] ); }
+
+		ND_ ArrayCRef<AU_t>	PositionsX ()			const	{ return _positionX; }
+		ND_ ArrayCRef<AU_t>	PositionsY ()			const	{ return _positionY; }
+		ND_ ArrayCRef<AU_t>	PositionsZ ()			const	{ return _positionZ; }
+	};
+
+
+
+/*
+=================================================
+	Add
+=================================================
+*/
+	template <typename T>
+	inline usize  AxialRotationBatch<T>::Add (const Rotation_t &rotation)
+	{
+		_axisTilt.PushBack( rotation.axisTilt );
+		_period.PushBack( rotation.period );
+		_angle.PushBack( rotation.angle );
+
+		return _period.LastIndex();
+	}
+
+/*
+=================================================
+	Reserve
+=================================================
+*/
+	template <typename T>
+	inline void  AxialRotationBatch<T>::Reserve (usize count)
+	{
+		_axisTilt.Reserve( count );
+		_period.Reserve( count );
+		_angle.Reserve( count );
+	}
+
+/*
+=================================================
+	Clear
+=================================================
+*/
+	template <typename T>
+	inline void  AxialRotationBatch<T>::Clear ()
+	{
+		_axisTilt.Clear();
+		_period.Clear();
+		_angle.Clear();
+	}
+
+/*
+=================================================
+	Update
+=================================================
+*/
+	template <typename T>
+	inline void  AxialRotationBatch<T>::Update (const Days_t time)
+	{
+		ParallelFor( Count(), _BatchSize, _MinParallelCount,
+			LAMBDA( this, time ) (usize first, usize last)
+			{
+				Update( time, first, last );
+			});
+	}
+
+	template <typename T>
+	inline void  AxialRotationBatch<T>::Update (const Days_t time, usize first, usize last)
+	{
+		ASSERT( first <= last and last <= Count() );
+
+		if ( first == last )
+			return;
+
+		Days_t const*	period	= _period.ptr();
+		Rad_t *			angle	= _angle.ptr();
+
+		for (usize i = first; i < last; ++i)
+		{
+			angle[i] = Rad_t::Pi() * T(2) * ( time / period[i] );
+		}
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	Add
+=================================================
+*/
+	template <typename T>
+	inline usize  OrbitBatch<T>::Add (const Orbit_t &orbit)
+	{
+		const T				e		= orbit.eccentricity;
+		const bool			is_zero	= orbit.orbitalPeriod.IsZero();
+		const Vec<T,2>		sco		= SinCos( orbit.longOfAscNode );
+		const Vec<T,2>		sci		= SinCos( orbit.inclination );
+
+		// zero radius gives zero position like in 'Orbit::CalcPosition'
+		_orbitalPeriod.PushBack( is_zero ? Days_t( T(1) ) : orbit.orbitalPeriod );
+		_semiLatusRectum.PushBack( is_zero ? AU_t() : orbit.semiMajorAxis * ( T(1) - e*e ) );
+
+		_startTime.PushBack( orbit.startTime );
+		_perihelionArg.PushBack( orbit.perihelionArg );
+		_eccentricity.PushBack( e );
+		_eccFactor.PushBack( e - e*e*e * T(0.5) );
+		_eccRatio.PushBack( Sqrt( ( T(1) + e ) / ( T(1) - e ) ) );
+		_sinLongOfAscNode.PushBack( sco[0] );
+		_cosLongOfAscNode.PushBack( sco[1] );
+		_sinInclination.PushBack( sci[0] );
+		_cosInclination.PushBack( sci[1] );
+
+		_positionX.PushBack( orbit.position.x );
+		_positionY.PushBack( orbit.position.y );
+		_positionZ.PushBack( orbit.position.z );
+
+		return _orbitalPeriod.LastIndex();
+	}
+
+/*
+=================================================
+	Reserve
+=================================================
+*/
+	template <typename T>
+	inline void  OrbitBatch<T>::Reserve (usize count)
+	{
+		_orbitalPeriod.Reserve( count );
+		_startTime.Reserve( count );
+		_perihelionArg.Reserve( count );
+		_eccentricity.Reserve( count );
+		_eccFactor.Reserve( count );
+		_eccRatio.Reserve( count );
+		_semiLatusRectum.Reserve( count );
+		_sinLongOfAscNode.Reserve( count );
+		_cosLongOfAscNode.Reserve( count );
+		_sinInclination.Reserve( count );
+		_cosInclination.Reserve( count );
+		_positionX.Reserve( count );
+		_positionY.Reserve( count );
+		_positionZ.Reserve( count );
+	}
+
+/*
+=================================================
+	Clear
+=================================================
+*/
+	template <typename T>
+	inline void  OrbitBatch<T>::Clear ()
+	{
+		_orbitalPeriod.Clear();
+		_startTime.Clear();
+		_perihelionArg.Clear();
+		_eccentricity.Clear();
+		_eccFactor.Clear();
+		_eccRatio.Clear();
+		_semiLatusRectum.Clear();
+		_sinLongOfAscNode.Clear();
+		_cosLongOfAscNode.Clear();
+		_sinInclination.Clear();
+		_cosInclination.Clear();
+		_positionX.Clear();
+		_positionY.Clear();
+		_positionZ.Clear();
+	}
+
+/*
+=================================================
+	Update
+=================================================
+*/
+	template <typename T>
+	inline void  OrbitBatch<T>::Update (const Days_t time)
+	{
+		ParallelFor( Count(), _BatchSize, _MinParallelCount,
+			LAMBDA( this, time ) (usize first, usize last)
+			{
+				Update( time, first, last );
+			});
+	}
+
+/*
+=================================================
+	Update
+----
+	same as 'Orbit::CalcPosition'
+=================================================
+*/
+	template <typename T>
+	inline void  OrbitBatch<T>::Update (const Days_t time, usize first, usize last)
+	{
+		ASSERT( first <= last and last <= Count() );
+
+		if ( first == last )
+			return;
+
+		Days_t const*	period		= _orbitalPeriod.ptr();
+		Days_t const*	start_time	= _startTime.ptr();
+		Rad_t const*	peri_arg	= _perihelionArg.ptr();
+		T const*		ecc			= _eccentricity.ptr();
+		T const*		ecc_factor	= _eccFactor.ptr();
+		T const*		ecc_ratio	= _eccRatio.ptr();
+		AU_t const*		radius		= _semiLatusRectum.ptr();
+		T const*		sin_o		= _sinLongOfAscNode.ptr();
+		T const*		cos_o		= _cosLongOfAscNode.ptr();
+		T const*		sin_i		= _sinInclination.ptr();
+		T const*		cos_i		= _cosInclination.ptr();
+		AU_t *			pos_x		= _positionX.ptr();
+		AU_t *			pos_y		= _positionY.ptr();
+		AU_t *			pos_z		= _positionZ.ptr();
+
+		for (usize i = first; i < last; ++i)
+		{
+			const Rad_t		eo_M = T(2) * Rad_t::Pi() * ( (time + start_time[i]) / period[i] );
+			const Rad_t		eo_E = eo_M + ecc_factor[i] * Sin( eo_M );
+			const Rad_t		eo_v = T(2) * ATan( ecc_ratio[i] * Tan( eo_E * T(0.5) ) );
+			const AU_t		eo_r = radius[i] / ( T(1) + ecc[i] * Cos( eo_v ) );
+			const Vec<T,2>	scu	 = SinCos( eo_v + peri_arg[i] );
+
+			pos_x[i] = ( eo_r * ( scu[1]*cos_o[i] - scu[0]*sin_o[i]*cos_i[i] ) );
+			pos_y[i] = ( eo_r * ( scu[1]*sin_o[i] + scu[0]*cos_o[i]*cos_i[i] ) );
+			pos_z[i] = ( eo_r * scu[0] * sin_i[i] );
+		}
+	}
+
+
+}	// Astrophysics
+}	// GXPhysics
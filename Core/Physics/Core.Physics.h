@@ -12,7 +12,9 @@
 
 // Algorithms
 #include "Core/Physics/Algorithms/AcceleratedMotion.h"
+#include "Core/Physics/Algorithms/AcceleratedMotionBatch.h"
 #include "Core/Physics/Algorithms/Astrophysics.h"
 #include "Core/Physics/Algorithms/Astrophysics_Orbit.h"
+#include "Core/Physics/Algorithms/Astrophysics_OrbitBatch.h"
 
 // Shapes
@@ -280,7 +280,7 @@ namespace GXTypes
 		bool	is_zero = true;
 
 		FOR( i, _memory ) {
-			is_zero &= (_memory[i] == 0);
+			is_zero &= _memory[i].IsZero();
 		}
 		return is_zero;
 	}
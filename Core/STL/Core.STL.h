@@ -124,6 +124,7 @@
 #include "ThreadSafe/AtomicCounter.h"
 #include "ThreadSafe/MtFile.h"
 #include "ThreadSafe/Singleton.h"
+#include "ThreadSafe/ParallelFor.h"
 
 
 // Math //
@@ -24,6 +24,7 @@ namespace GXFile
 			_Archive	= 0x1000,
 			ZIP,
 			LZMA,
+			Chunked,
 		};
 
 		forceinline static bool IsArchive (type value)
@@ -0,0 +1,598 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Chunked compressed file.
+
+	Data is split into chunks of equal uncompressed size, each chunk is compressed
+	independently, so chunks are compressed and decompressed in parallel and
+	random access read decompresses only required chunks.
+
+	Layout:
+		ChunkedFileHeader
+		ChunkInfo [chunkCount]
+		compressed chunks (chunks that can't be compressed are stored as is)
+*/
+
+#pragma once
+
+#include "MemFile.h"
+#include "Core/STL/Compression/LZ4Compression.h"
+#include "Core/STL/Compression/MiniZCompression.h"
+#include "Core/STL/ThreadSafe/ParallelFor.h"
+
+namespace GX_STL
+{
+namespace GXFile
+{
+
+	//
+	// Chunk Compression Codec
+	//
+
+	struct EChunkCodec
+	{
+		enum type : uint
+		{
+			None	= 0,
+			LZ4,
+			MiniZ,
+
+		#if defined( GX_ENABLE_LZ4 )
+			Default	= LZ4,
+		#elif defined( GX_ENABLE_MINIZ )
+			Default	= MiniZ,
+		#else
+			Default	= None,
+		#endif
+		};
+
+		ND_ static bool IsSupported (type value);
+	};
+
+
+
+	namespace _file_hidden_
+	{
+
+		//
+		// Chunked File Header
+		//
+		struct ChunkedFileHeader : CompileTime::PODType
+		{
+			static constexpr uint	MAGIC	= 0x46435847;	// 'GXCF'
+			static constexpr uint	VERSION	= 1;
+
+			uint	magic				= MAGIC;
+			uint	version				= VERSION;
+			uint	codec				= 0;
+			uint	chunkSize			= 0;
+			ulong	uncompressedSize	= 0;
+			uint	chunkCount			= 0;
+			uint	_padding			= 0;
+		};
+
+
+		//
+		// Chunk Info
+		//
+		struct ChunkInfo : CompileTime::PODType
+		{
+			ulong	offset				= 0;	// from the end of chunk index
+			uint	compressedSize		= 0;	// equal to uncompressed size if chunk is not compressed
+			uint	uncompressedSize	= 0;
+		};
+
+
+		//
+		// Parallel For All
+		//
+		template <typename Fn>
+		inline bool ParallelForAll (usize count, uint maxThreads, const Fn &fn)
+		{
+			Atomic<uint>	errors{ 0 };
+
+			GXTypes::ParallelFor( count, 1, 2,
+				LAMBDA( &fn, &errors ) (usize first, usize last)
+				{
+					for (usize i = first; i < last; ++i)
+					{
+						if ( not fn( i ) )
+							errors.Inc();
+					}
+				},
+				maxThreads );
+
+			return errors.Get() == 0;
+		}
+
+
+		//
+		// Compress Chunk
+		//
+		inline bool CompressChunk (EChunkCodec::type codec, BinArrayCRef src, OUT BinaryArray &dst)
+		{
+			BinArrayRef		dst_ref;
+
+			switch ( codec )
+			{
+				case EChunkCodec::None :
+					break;
+
+			#ifdef GX_ENABLE_LZ4
+				case EChunkCodec::LZ4 : {
+					GXCompression::LZ4Compressor	comp;
+					dst.Resize( usize(comp.GetPrefferedSize( src.Size() )), false );
+					dst_ref = dst;
+					CHECK_ERR( comp.Compress( src, INOUT dst_ref ) );
+					break;
+				}
+			#endif
+
+			#ifdef GX_ENABLE_MINIZ
+				case EChunkCodec::MiniZ : {
+					GXCompression::MiniZCompressor	comp;
+					dst.Resize( usize(comp.GetPrefferedSize( src.Size() )), false );
+					dst_ref = dst;
+					CHECK_ERR( comp.Compress( src, INOUT dst_ref ) );
+					break;
+				}
+			#endif
+
+				default :
+					RETURN_ERR( "unsupported codec" );
+			}
+
+			// store uncompressed
+			if ( dst_ref.Empty() or dst_ref.Count() >= src.Count() )
+			{
+				dst.Clear();
+				dst.Append( src );
+				return true;
+			}
+
+			dst.Resize( dst_ref.Count() );
+			return true;
+		}
+
+
+		//
+		// Decompress Chunk
+		//
+		inline bool DecompressChunk (EChunkCodec::type codec, BinArrayCRef src, BinArrayRef dst)
+		{
+			if ( src.Count() == dst.Count() )
+			{
+				UnsafeMem::MemCopy( dst.ptr(), src.ptr(), dst.Size() );
+				return true;
+			}
+
+			BinArrayRef		dst_ref = dst;
+
+			switch ( codec )
+			{
+			#ifdef GX_ENABLE_LZ4
+				case EChunkCodec::LZ4 :
+					CHECK_ERR( GXCompression::LZ4Decompressor().Decompress( src, INOUT dst_ref ) );
+					break;
+			#endif
+
+			#ifdef GX_ENABLE_MINIZ
+				case EChunkCodec::MiniZ :
+					CHECK_ERR( GXCompression::MiniZDecompressor().Decompress( src, INOUT dst_ref ) );
+					break;
+			#endif
+
+				default :
+					RETURN_ERR( "unsupported codec" );
+			}
+
+			CHECK_ERR( dst_ref.Count() == dst.Count() );
+			return true;
+		}
+
+	}	// _file_hidden_
+
+
+/*
+=================================================
+	IsSupported
+=================================================
+*/
+	inline bool EChunkCodec::IsSupported (type value)
+	{
+		switch ( value )
+		{
+			case None :		return true;
+		#ifdef GX_ENABLE_LZ4
+			case LZ4 :		return true;
+		#endif
+		#ifdef GX_ENABLE_MINIZ
+			case MiniZ :	return true;
+		#endif
+		}
+		return false;
+	}
+
+
+
+	//
+	// Chunked Read File
+	//
+
+	class ChunkedRFile : public RFile
+	{
+	// types
+	public:
+		SHARED_POINTER( ChunkedRFile );
+
+		using Self			= ChunkedRFile;
+		using Header_t		= _file_hidden_::ChunkedFileHeader;
+		using ChunkInfo_t	= _file_hidden_::ChunkInfo;
+
+
+	// variables
+	private:
+		RFilePtr				_file;
+		Header_t				_header;
+		Array< ChunkInfo_t >	_chunks;
+		BytesU					_dataOffset;
+		BytesU					_pos;
+		uint					_maxThreads		= 0;
+
+		BinaryArray				_compressed;	// temporary
+		BinaryArray				_cache;			// last partially read chunk
+		usize					_cachedChunk	= UMax;
+
+
+	// methods
+	public:
+		ChunkedRFile ()		{}
+		~ChunkedRFile ()	{ _Close(); }
+
+
+		ND_ static ChunkedRFilePtr New (const RFilePtr &file, uint maxThreads = 0)
+		{
+			ChunkedRFilePtr	cfile = new Self();
+
+			if ( cfile->Create( file, maxThreads ) )
+				return cfile;
+
+			return null;
+		}
+
+
+		bool Create (const RFilePtr &file, uint maxThreads = 0)
+		{
+			_Close();
+
+			CHECK_ERR( file and file->IsOpened() );
+			CHECK_ERR( file->Read( OUT _header ) );
+
+			CHECK_ERR( _header.magic == Header_t::MAGIC );
+			CHECK_ERR( _header.version == Header_t::VERSION );
+			CHECK_ERR( EChunkCodec::IsSupported( EChunkCodec::type(_header.codec) ) );
+			CHECK_ERR( _header.chunkSize > 0 );
+			CHECK_ERR( _header.uncompressedSize / _header.chunkSize + ulong(_header.uncompressedSize % _header.chunkSize != 0) == _header.chunkCount );
+			CHECK_ERR( BytesU::SizeOf<ChunkInfo_t>() * _header.chunkCount <= file->RemainingSize() );
+
+			_chunks.Resize( _header.chunkCount );
+			CHECK_ERR( file->Read( ArrayRef<ChunkInfo_t>( _chunks ) ) );
+
+			// 'ReadBuf' requires that all chunks except the last are full
+			// and chunk data doesn't overlap and goes in the same order as chunks
+			const ulong		data_size	= ulong(file->Size() - file->Pos());
+			ulong			data_end	= 0;
+
+			FOR( i, _chunks )
+			{
+				auto const&		chunk		= _chunks[i];
+				const ulong		expected	= GXMath::Min( ulong(_header.chunkSize), _header.uncompressedSize - ulong(i) * _header.chunkSize );
+
+				CHECK_ERR( chunk.uncompressedSize == expected );
+				CHECK_ERR( chunk.compressedSize > 0 and chunk.compressedSize <= chunk.uncompressedSize );
+				CHECK_ERR( chunk.offset >= data_end and chunk.offset <= data_size );
+				CHECK_ERR( chunk.compressedSize <= data_size - chunk.offset );
+
+				data_end = chunk.offset + chunk.compressedSize;
+			}
+
+			_dataOffset	= file->Pos();
+			_file		= file;
+			_maxThreads	= maxThreads;
+			return true;
+		}
+
+
+		// RFile //
+		virtual BytesU ReadBuf (void * buf, BytesU size) noexcept override
+		{
+			if ( not IsOpened() )
+				return UMax;
+
+			size = GXMath::Min( size, RemainingSize() );
+
+			if ( size == 0 )
+				return 0_b;
+
+			const usize	chunk_size	= _header.chunkSize;
+			const usize	first		= usize(_pos) / chunk_size;
+			const usize	last		= usize(_pos + size - 1) / chunk_size;
+			ubyte *		dst			= Cast<ubyte *>( buf );
+
+			// read from single chunk, keep it in cache for the next sequential reads
+			if ( first == last )
+			{
+				CHECK_ERR( _LoadToCache( first ), 0_b );
+
+				UnsafeMem::MemCopy( dst, _cache.ptr() + (usize(_pos) - first * chunk_size), size );
+				_pos += size;
+				return size;
+			}
+
+			// read compressed data for all chunks at once
+			const BytesU	src_offset	= BytesU(usize(_chunks[first].offset));
+			const BytesU	src_size	= BytesU(usize(_chunks[last].offset) + _chunks[last].compressedSize) - src_offset;
+
+			_compressed.Resize( usize(src_size), false );
+			CHECK_ERR( _file->ReadBufFrom( _compressed.ptr(), src_size, _dataOffset + src_offset ) == src_size, 0_b );
+
+			// decompress in parallel, full chunks are decompressed directly to the output
+			const usize		begin		= usize(_pos);
+			const usize		end			= usize(_pos + size);
+			BinaryArray		tail;
+
+			const auto	Decompress	= LAMBDA( this, first, last, begin, end, dst, src_offset, &tail ) (usize idx) -> bool
+									  {
+										const usize			i		= first + idx;
+										auto const&			chunk	= _chunks[i];
+										const usize			start	= i * _header.chunkSize;
+										const BinArrayCRef	src		= BinArrayCRef( _compressed ).SubArray( usize(chunk.offset) - usize(src_offset), chunk.compressedSize );
+										const auto			codec	= EChunkCodec::type(_header.codec);
+
+										if ( start >= begin and start + chunk.uncompressedSize <= end )
+											return _file_hidden_::DecompressChunk( codec, src, BinArrayRef( dst + (start - begin), chunk.uncompressedSize ) );
+
+										BinaryArray		temp;
+										temp.Resize( chunk.uncompressedSize, false );
+										CHECK_ERR( _file_hidden_::DecompressChunk( codec, src, temp ) );
+
+										const usize		from	= GXMath::Max( start, begin );
+										const usize		to		= GXMath::Min( start + chunk.uncompressedSize, end );
+
+										UnsafeMem::MemCopy( dst + (from - begin), temp.ptr() + (from - start), BytesU(to - from) );
+
+										if ( i == last )
+											tail = RVREF(temp);
+										return true;
+									  };
+
+			CHECK_ERR( _file_hidden_::ParallelForAll( last - first + 1, _maxThreads, Decompress ), 0_b );
+
+			if ( not tail.Empty() )
+			{
+				_cache			= RVREF(tail);
+				_cachedChunk	= last;
+			}
+
+			_pos += size;
+			return size;
+		}
+
+
+		// BaseFile //
+		virtual void Close () noexcept override
+		{
+			return _Close();
+		}
+
+		virtual bool IsOpened () const noexcept override
+		{
+			return _file.IsNotNull();
+		}
+
+		virtual bool SeekSet (BytesU offset) noexcept override
+		{
+			return _SetPos( offset );
+		}
+
+		virtual bool SeekCur (BytesI offset) noexcept override
+		{
+			return _SetPos( BytesU( usize(_pos) + isize(offset) ) );
+		}
+
+		virtual bool SeekEnd (BytesU offset) noexcept override
+		{
+			return _SetPos( Size() - offset );
+		}
+
+		virtual BytesU RemainingSize () const noexcept override
+		{
+			return Size() - _pos;
+		}
+
+		virtual BytesU Size () const noexcept override
+		{
+			return BytesU( _header.uncompressedSize );
+		}
+
+		virtual BytesU Pos () const noexcept override
+		{
+			return _pos;
+		}
+
+		virtual bool IsEOF () const noexcept override
+		{
+			return Pos() >= Size();
+		}
+
+		virtual StringCRef  Name () const override
+		{
+			return _file ? _file->Name() : StringCRef();
+		}
+
+		virtual EFile::type  GetType () const override
+		{
+			return EFile::Chunked;
+		}
+
+
+		ND_ usize	ChunkCount ()	const	{ return _chunks.Count(); }
+		ND_ BytesU	ChunkSize ()	const	{ return BytesU( _header.chunkSize ); }
+
+
+	private:
+		void _Close ()
+		{
+			_file			= null;
+			_header			= Header_t();
+			_pos			= 0_b;
+			_dataOffset		= 0_b;
+			_cachedChunk	= UMax;
+			_chunks.Clear();
+			_cache.Clear();
+			_compressed.Clear();
+		}
+
+		bool _SetPos (BytesU newPos)
+		{
+			if ( newPos <= Size() )
+			{
+				_pos = newPos;
+				return true;
+			}
+			return false;
+		}
+
+		bool _LoadToCache (usize index)
+		{
+			if ( _cachedChunk == index )
+				return true;
+
+			auto const&		chunk = _chunks[index];
+
+			_compressed.Resize( chunk.compressedSize, false );
+			_cache.Resize( chunk.uncompressedSize, false );
+			_cachedChunk = UMax;
+
+			CHECK_ERR( _file->ReadBufFrom( _compressed.ptr(), _compressed.Size(), _dataOffset + BytesU(usize(chunk.offset)) ) == _compressed.Size() );
+			CHECK_ERR( _file_hidden_::DecompressChunk( EChunkCodec::type(_header.codec), _compressed, _cache ) );
+
+			_cachedChunk = index;
+			return true;
+		}
+	};
+
+
+
+	//
+	// Chunked Write File
+	//
+
+	class ChunkedWFile : public BaseMemWFile
+	{
+	// types
+	public:
+		SHARED_POINTER( ChunkedWFile );
+
+		using Self			= ChunkedWFile;
+		using Header_t		= _file_hidden_::ChunkedFileHeader;
+		using ChunkInfo_t	= _file_hidden_::ChunkInfo;
+
+	private:
+		using Parent_t		= BaseMemWFile;
+
+
+	// methods
+	public:
+		ChunkedWFile ()		{}
+		~ChunkedWFile ()	{ _Close(); }
+
+
+		ND_ static ChunkedWFilePtr New (BytesU reserve = 0_b)
+		{
+			ChunkedWFilePtr	file = new Self();
+
+			if ( file->Create( reserve ) )
+				return file;
+
+			return null;
+		}
+
+
+		bool Create (BytesU reserve)
+		{
+			_mem.Clear();
+			_mem.Reserve( usize(reserve) );
+
+			_pos	= 0_b;
+			_opened	= true;
+			return true;
+		}
+
+
+		bool Save (const WFilePtr &file, EChunkCodec::type codec = EChunkCodec::Default, BytesU chunkSize = 64_Kb, uint maxThreads = 0) const
+		{
+			CHECK_ERR( file and file->IsOpened() );
+			CHECK_ERR( EChunkCodec::IsSupported( codec ) );
+			CHECK_ERR( chunkSize > 0 and chunkSize <= BytesU(MaxValue<uint>()) );
+
+			const usize		chunk_size	= usize(chunkSize);
+			const usize		count		= (_mem.Count() + chunk_size - 1) / chunk_size;
+
+			Array< BinaryArray >	compressed;		compressed.Resize( count );
+			Array< ChunkInfo_t >	chunks;			chunks.Resize( count );
+
+			// compress
+			const auto	Compress	= LAMBDA( this, codec, chunk_size, &compressed ) (usize i) -> bool
+									  {
+										const BinArrayCRef	src = BinArrayCRef( _mem ).SubArray( i * chunk_size, GXMath::Min( chunk_size, _mem.Count() - i * chunk_size ) );
+										return _file_hidden_::CompressChunk( codec, src, OUT compressed[i] );
+									  };
+
+			CHECK_ERR( _file_hidden_::ParallelForAll( count, maxThreads, Compress ) );
+
+			// build index
+			ulong	offset = 0;
+
+			FOR( i, chunks )
+			{
+				chunks[i].offset			= offset;
+				chunks[i].compressedSize	= uint(compressed[i].Count());
+				chunks[i].uncompressedSize	= uint(GXMath::Min( chunk_size, _mem.Count() - i * chunk_size ));
+				offset						+= compressed[i].Count();
+			}
+
+			Header_t	header;
+			header.codec			= codec;
+			header.chunkSize		= uint(chunk_size);
+			header.uncompressedSize	= _mem.Count();
+			header.chunkCount		= uint(count);
+
+			// write
+			bool	written = true;
+
+			written &= file->Write( header );
+			written &= file->Write( ArrayCRef<ChunkInfo_t>( chunks ) );
+
+			for (auto& data : compressed) {
+				written &= file->Write( BinArrayCRef( data ) );
+			}
+
+			CHECK_ERR( written );
+			return true;
+		}
+
+
+		// BaseFile //
+		virtual EFile::type  GetType () const override
+		{
+			return EFile::Chunked;
+		}
+	};
+
+
+	SHARED_POINTER( ChunkedRFile );
+	SHARED_POINTER( ChunkedWFile );
+
+
+}	// GXFile
+}	// GX_STL
@@ -0,0 +1,539 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Core/STL/Math/Color/ColorBatchConverter.h"
+
+#if !defined( GX_COLOR_FORMAT_HIGH_PRECISION )
+# if defined( PLATFORM_CPU_X64 ) || defined( __SSE2__ ) || (defined( _M_IX86_FP ) && _M_IX86_FP >= 2)
+#	define GX_COLOR_BATCH_SSE2
+#	include <emmintrin.h>
+# elif defined( PLATFORM_CPU_ARM64 ) && (defined( __ARM_NEON ) || defined( __ARM_NEON__ ))
+#	define GX_COLOR_BATCH_NEON
+#	include <arm_neon.h>
+# endif
+#endif
+
+namespace GX_STL
+{
+namespace GXMath
+{
+	using Converter		= ColorFormatUtils::ColorFormatConverter;
+	using RGBA8_UNorm	= ColorFormat::RGBA8_UNorm;
+	using RGBA32f		= ColorFormat::RGBA32f;
+
+	STATIC_ASSERT( sizeof(float4) == 16 );
+	STATIC_ASSERT( sizeof(RGBA8_UNorm) == 4 );
+	STATIC_ASSERT( sizeof(half) == 2 );
+	STATIC_ASSERT( sizeof(r11g11b10f_t) == 4 );
+	STATIC_ASSERT( sizeof(rgb9_e5_t) == 4 );
+
+
+#ifdef GX_COLOR_BATCH_SSE2
+/*
+=================================================
+	HalfToFloat_SSE2
+----
+	same as 'THalf::Get', input is half bits in 32-bit lanes
+=================================================
+*/
+	static forceinline __m128  HalfToFloat_SSE2 (const __m128i &h)
+	{
+		const __m128i	bias		= _mm_set1_epi32( (127 - 15) << 23 );
+		const __m128i	sign		= _mm_slli_epi32( _mm_and_si128( h, _mm_set1_epi32( 0x8000 )), 16 );
+		const __m128i	em			= _mm_and_si128( h, _mm_set1_epi32( 0x7FFF ));
+		const __m128i	e			= _mm_and_si128( h, _mm_set1_epi32( 0x7C00 ));
+		__m128i			normal		= _mm_add_epi32( _mm_slli_epi32( em, 13 ), bias );
+
+		// Inf and NaN
+		normal = _mm_add_epi32( normal, _mm_and_si128( _mm_cmpeq_epi32( e, _mm_set1_epi32( 0x7C00 )), bias ));
+
+		// zero and denormalized, 'm * 2^-24' is exact
+		const __m128i	is_denorm	= _mm_cmpeq_epi32( e, _mm_setzero_si128() );
+		const __m128i	denorm		= _mm_castps_si128( _mm_mul_ps( _mm_cvtepi32_ps( em ), _mm_set1_ps( 1.0f / 16777216.0f )));
+		const __m128i	result		= _mm_or_si128( _mm_and_si128( is_denorm, denorm ), _mm_andnot_si128( is_denorm, normal ));
+
+		return _mm_castsi128_ps( _mm_or_si128( result, sign ));
+	}
+
+/*
+=================================================
+	FloatToHalf_SSE2
+----
+	same as 'THalf::Set', output is half bits in 32-bit lanes.
+	Denormalized values, Inf and NaN are not supported,
+	lanes with such values are marked in 'specialMask'.
+=================================================
+*/
+	static forceinline __m128i  FloatToHalf_SSE2 (const __m128 &f, OUT int &specialMask)
+	{
+		const __m128i	i		= _mm_castps_si128( f );
+		const __m128i	s		= _mm_and_si128( _mm_srli_epi32( i, 16 ), _mm_set1_epi32( 0x8000 ));
+		const __m128i	e		= _mm_sub_epi32( _mm_and_si128( _mm_srli_epi32( i, 23 ), _mm_set1_epi32( 0xFF )), _mm_set1_epi32( 127 - 15 ));
+		const __m128i	m		= _mm_and_si128( i, _mm_set1_epi32( 0x007FFFFF ));
+		const __m128i	inf		= _mm_set1_epi32( 0x7C00 );
+
+		const __m128i	tiny	= _mm_cmplt_epi32( e, _mm_set1_epi32( -10 ));
+		const __m128i	denorm	= _mm_andnot_si128( tiny, _mm_cmplt_epi32( e, _mm_set1_epi32( 1 )));
+		const __m128i	inf_nan	= _mm_cmpgt_epi32( e, _mm_set1_epi32( 0xFF - (127 - 15) - 1 ));
+
+		specialMask = _mm_movemask_epi8( _mm_or_si128( denorm, inf_nan ));
+
+		// round half up, mantissa overflow increments exponent
+		const __m128i	mr		= _mm_add_epi32( m, _mm_slli_epi32( _mm_and_si128( m, _mm_set1_epi32( 0x1000 )), 1 ));
+		__m128i			h		= _mm_add_epi32( _mm_slli_epi32( e, 10 ), _mm_srli_epi32( mr, 13 ));
+
+		// exponent overflow
+		const __m128i	ovf		= _mm_cmpgt_epi32( h, inf );
+		h = _mm_or_si128( _mm_and_si128( ovf, inf ), _mm_andnot_si128( ovf, h ));
+
+		// too small values are converted to positive zero
+		return _mm_andnot_si128( tiny, _mm_or_si128( h, s ));
+	}
+
+/*
+=================================================
+	PackHalf_SSE2
+----
+	packs 32-bit lanes to 16-bit without saturation
+=================================================
+*/
+	static forceinline __m128i  PackHalf_SSE2 (const __m128i &lo, const __m128i &hi)
+	{
+		return _mm_packs_epi32( _mm_srai_epi32( _mm_slli_epi32( lo, 16 ), 16 ),
+								_mm_srai_epi32( _mm_slli_epi32( hi, 16 ), 16 ));
+	}
+
+/*
+=================================================
+	NormFloatToInt_SSE2
+----
+	same as 'RoundToInt( x * 255.0f )' for values in range [0, 256],
+	'std::round' rounds half away from zero
+=================================================
+*/
+	static forceinline __m128i  NormFloatToInt_SSE2 (const float4 &x)
+	{
+		__m128	v		= _mm_mul_ps( _mm_loadu_ps( &x.x ), _mm_set1_ps( 255.0f ));
+				v		= _mm_min_ps( _mm_max_ps( v, _mm_set1_ps( -1.0f )), _mm_set1_ps( 256.0f ));
+		__m128i	t		= _mm_cvttps_epi32( v );
+		__m128	frac	= _mm_sub_ps( v, _mm_cvtepi32_ps( t ));
+
+		return _mm_sub_epi32( t, _mm_castps_si128( _mm_cmpge_ps( frac, _mm_set1_ps( 0.5f ))));
+	}
+#endif	// GX_COLOR_BATCH_SSE2
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	RGBA8UNormToRGBA32f
+=================================================
+*/
+	void ColorBatchConverter::RGBA8UNormToRGBA32f (const RGBA8_UNorm *src, usize count, OUT float4 *dst)
+	{
+		usize	i = 0;
+
+	#if defined( GX_COLOR_BATCH_SSE2 )
+		const __m128	scale	= _mm_set1_ps( 255.0f );
+		const __m128i	zero	= _mm_setzero_si128();
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128i	px	= _mm_loadu_si128( Cast<__m128i const *>( src + i ));
+			const __m128i	lo	= _mm_unpacklo_epi8( px, zero );
+			const __m128i	hi	= _mm_unpackhi_epi8( px, zero );
+
+			_mm_storeu_ps( &dst[i+0].x, _mm_div_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( lo, zero )), scale ));
+			_mm_storeu_ps( &dst[i+1].x, _mm_div_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( lo, zero )), scale ));
+			_mm_storeu_ps( &dst[i+2].x, _mm_div_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( hi, zero )), scale ));
+			_mm_storeu_ps( &dst[i+3].x, _mm_div_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( hi, zero )), scale ));
+		}
+
+	#elif defined( GX_COLOR_BATCH_NEON )
+		const float32x4_t	scale = vdupq_n_f32( 255.0f );
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const uint8x16_t	px	= vld1q_u8( Cast<uint8_t const *>( src + i ));
+			const uint16x8_t	lo	= vmovl_u8( vget_low_u8( px ));
+			const uint16x8_t	hi	= vmovl_u8( vget_high_u8( px ));
+
+			vst1q_f32( &dst[i+0].x, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_low_u16( lo ))), scale ));
+			vst1q_f32( &dst[i+1].x, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_high_u16( lo ))), scale ));
+			vst1q_f32( &dst[i+2].x, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_low_u16( hi ))), scale ));
+			vst1q_f32( &dst[i+3].x, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_high_u16( hi ))), scale ));
+		}
+	#endif
+
+		for (; i < count; ++i)
+		{
+			RGBA32f	col;
+			Converter::Convert( OUT col, src[i] );
+			dst[i] = float4(col);
+		}
+	}
+
+/*
+=================================================
+	RGBA32fToRGBA8UNorm
+----
+	negative values are clamped to zero
+=================================================
+*/
+	void ColorBatchConverter::RGBA32fToRGBA8UNorm (const float4 *src, usize count, OUT RGBA8_UNorm *dst)
+	{
+		usize	i = 0;
+
+	#if defined( GX_COLOR_BATCH_SSE2 )
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128i	lo = _mm_packs_epi32( NormFloatToInt_SSE2( src[i+0] ), NormFloatToInt_SSE2( src[i+1] ));
+			const __m128i	hi = _mm_packs_epi32( NormFloatToInt_SSE2( src[i+2] ), NormFloatToInt_SSE2( src[i+3] ));
+
+			_mm_storeu_si128( Cast<__m128i *>( dst + i ), _mm_packus_epi16( lo, hi ));
+		}
+
+	#elif defined( GX_COLOR_BATCH_NEON )
+		const float32x4_t	scale	= vdupq_n_f32( 255.0f );
+		const float32x4_t	min_val	= vdupq_n_f32( -1.0f );
+		const float32x4_t	max_val	= vdupq_n_f32( 256.0f );
+
+		// 'vcvtaq' rounds half away from zero like 'std::round'
+		const auto	ToInt = [&] (const float4 &x) {
+			return vcvtaq_s32_f32( vminq_f32( vmaxq_f32( vmulq_f32( vld1q_f32( &x.x ), scale ), min_val ), max_val ));
+		};
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const int16x8_t		lo = vcombine_s16( vqmovn_s32( ToInt( src[i+0] )), vqmovn_s32( ToInt( src[i+1] )));
+			const int16x8_t		hi = vcombine_s16( vqmovn_s32( ToInt( src[i+2] )), vqmovn_s32( ToInt( src[i+3] )));
+
+			vst1q_u8( Cast<uint8_t *>( dst + i ), vcombine_u8( vqmovun_s16( lo ), vqmovun_s16( hi )));
+		}
+	#endif
+
+		for (; i < count; ++i)
+		{
+			Converter::Convert( OUT dst[i], RGBA32f{ Max( src[i], float4(0.0f) ) });
+		}
+	}
+
+/*
+=================================================
+	SRGBTable
+=================================================
+*/
+	struct SRGBTable
+	{
+		float	values[256];
+
+		SRGBTable ()
+		{
+			for (uint i = 0; i < CountOf(values); ++i)
+			{
+				RGBA32f	col;
+				Converter::Convert( OUT col, RGBA8_UNorm( ubyte(i), 0, 0, 0 ));
+				values[i] = ColorUtils::FromSRGB( float4(col) ).x;
+			}
+		}
+
+		ND_ static SRGBTable const&  Instance ()
+		{
+			static const SRGBTable	table;
+			return table;
+		}
+	};
+
+/*
+=================================================
+	SRGB8ToRGBA32f
+=================================================
+*/
+	void ColorBatchConverter::SRGB8ToRGBA32f (const RGBA8_UNorm *src, usize count, OUT float4 *dst)
+	{
+		auto const&		table = SRGBTable::Instance().values;
+
+		// alpha is linear
+		RGBA8UNormToRGBA32f( src, count, OUT dst );
+
+		for (usize i = 0; i < count; ++i)
+		{
+			dst[i].x = table[ src[i].r ];
+			dst[i].y = table[ src[i].g ];
+			dst[i].z = table[ src[i].b ];
+		}
+	}
+
+/*
+=================================================
+	RGBA32fToSRGB8
+----
+	'ColorUtils::ToSRGB' is scalar, only packing is vectorized
+=================================================
+*/
+	void ColorBatchConverter::RGBA32fToSRGB8 (const float4 *src, usize count, OUT RGBA8_UNorm *dst)
+	{
+		static constexpr usize	BatchSize = 64;
+
+		float4	temp[ BatchSize ];
+
+		for (usize i = 0; i < count; i += BatchSize)
+		{
+			const usize		n = Min( count - i, BatchSize );
+
+			for (usize j = 0; j < n; ++j)
+			{
+				temp[j]		= ColorUtils::ToSRGB( src[i+j] );
+				temp[j].w	= src[i+j].w;
+			}
+
+			RGBA32fToRGBA8UNorm( temp, n, OUT dst + i );
+		}
+	}
+
+/*
+=================================================
+	SwapRB
+=================================================
+*/
+	void ColorBatchConverter::SwapRB (const RGBA8_UNorm *src, usize count, OUT RGBA8_UNorm *dst)
+	{
+		usize	i = 0;
+
+	#if defined( GX_COLOR_BATCH_SSE2 )
+		const __m128i	ga_mask	= _mm_set1_epi32( int(0xFF00FF00) );
+		const __m128i	rb_mask	= _mm_set1_epi32( 0x00FF00FF );
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128i	px	= _mm_loadu_si128( Cast<__m128i const *>( src + i ));
+			const __m128i	rb	= _mm_and_si128( px, rb_mask );
+			const __m128i	br	= _mm_or_si128( _mm_slli_epi32( rb, 16 ), _mm_srli_epi32( rb, 16 ));
+
+			_mm_storeu_si128( Cast<__m128i *>( dst + i ), _mm_or_si128( _mm_and_si128( px, ga_mask ), br ));
+		}
+
+	#elif defined( GX_COLOR_BATCH_NEON )
+		for (; i + 16 <= count; i += 16)
+		{
+			uint8x16x4_t	px = vld4q_u8( Cast<uint8_t const *>( src + i ));
+			uint8x16_t		r  = px.val[0];
+
+			px.val[0] = px.val[2];
+			px.val[2] = r;
+
+			vst4q_u8( Cast<uint8_t *>( dst + i ), px );
+		}
+	#endif
+
+		for (; i < count; ++i)
+		{
+			const RGBA8_UNorm	c = src[i];
+			dst[i] = RGBA8_UNorm( c.b, c.g, c.r, c.a );
+		}
+	}
+
+/*
+=================================================
+	HalfToFloat
+=================================================
+*/
+	void ColorBatchConverter::HalfToFloat (const half *src, usize count, OUT float *dst)
+	{
+		usize	i = 0;
+
+	#if defined( GX_COLOR_BATCH_SSE2 )
+		const __m128i	zero = _mm_setzero_si128();
+
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m128i	h = _mm_loadu_si128( Cast<__m128i const *>( src + i ));
+
+			_mm_storeu_ps( dst + i + 0, HalfToFloat_SSE2( _mm_unpacklo_epi16( h, zero )));
+			_mm_storeu_ps( dst + i + 4, HalfToFloat_SSE2( _mm_unpackhi_epi16( h, zero )));
+		}
+	#endif
+
+		for (; i < count; ++i)
+		{
+			dst[i] = src[i].Get();
+		}
+	}
+
+/*
+=================================================
+	FloatToHalf
+=================================================
+*/
+	void ColorBatchConverter::FloatToHalf (const float *src, usize count, OUT half *dst)
+	{
+		usize	i = 0;
+
+	#if defined( GX_COLOR_BATCH_SSE2 )
+		for (; i + 8 <= count; i += 8)
+		{
+			int				special0, special1;
+			const __m128i	lo = FloatToHalf_SSE2( _mm_loadu_ps( src + i + 0 ), OUT special0 );
+			const __m128i	hi = FloatToHalf_SSE2( _mm_loadu_ps( src + i + 4 ), OUT special1 );
+
+			if ( (special0 | special1) == 0 )
+			{
+				_mm_storeu_si128( Cast<__m128i *>( dst + i ), PackHalf_SSE2( lo, hi ));
+				continue;
+			}
+
+			for (usize j = i; j < i + 8; ++j) {
+				dst[j].Set( src[j] );
+			}
+		}
+	#endif
+
+		for (; i < count; ++i)
+		{
+			dst[i].Set( src[i] );
+		}
+	}
+
+/*
+=================================================
+	R11G11B10fToRGBA32f
+=================================================
+*/
+	void ColorBatchConverter::R11G11B10fToRGBA32f (const r11g11b10f_t *src, usize count, OUT float4 *dst)
+	{
+		usize	i = 0;
+
+	#if defined( GX_COLOR_BATCH_SSE2 )
+		const __m128i	mask11	= _mm_set1_epi32( 0x7FF );
+		const __m128i	mask10	= _mm_set1_epi32( 0x3FF );
+
+		for (; i + 4 <= count; i += 4)
+		{
+			// channels are stored as half without sign bit
+			const __m128i	v	= _mm_loadu_si128( Cast<__m128i const *>( src + i ));
+			__m128			r	= HalfToFloat_SSE2( _mm_slli_epi32( _mm_and_si128( _mm_srli_epi32( v, 21 ), mask11 ), 4 ));
+			__m128			g	= HalfToFloat_SSE2( _mm_slli_epi32( _mm_and_si128( _mm_srli_epi32( v, 10 ), mask11 ), 4 ));
+			__m128			b	= HalfToFloat_SSE2( _mm_slli_epi32( _mm_and_si128( v, mask10 ), 5 ));
+			__m128			a	= _mm_set1_ps( 1.0f );
+
+			_MM_TRANSPOSE4_PS( r, g, b, a );
+
+			_mm_storeu_ps( &dst[i+0].x, r );
+			_mm_storeu_ps( &dst[i+1].x, g );
+			_mm_storeu_ps( &dst[i+2].x, b );
+			_mm_storeu_ps( &dst[i+3].x, a );
+		}
+	#endif
+
+		for (; i < count; ++i)
+		{
+			const half3		c = src[i];
+			dst[i] = float4( float(c.x), float(c.y), float(c.z), 1.0f );
+		}
+	}
+
+/*
+=================================================
+	RGBA32fToR11G11B10f
+=================================================
+*/
+	void ColorBatchConverter::RGBA32fToR11G11B10f (const float4 *src, usize count, OUT r11g11b10f_t *dst)
+	{
+		usize	i = 0;
+
+	#if defined( GX_COLOR_BATCH_SSE2 )
+		const __m128i	mask = _mm_set1_epi32( 0x7FFF );
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128	r	= _mm_loadu_ps( &src[i+0].x );
+			__m128	g	= _mm_loadu_ps( &src[i+1].x );
+			__m128	b	= _mm_loadu_ps( &src[i+2].x );
+			__m128	a	= _mm_loadu_ps( &src[i+3].x );
+
+			_MM_TRANSPOSE4_PS( r, g, b, a );
+
+			int				special_r, special_g, special_b;
+			const __m128i	hr = _mm_and_si128( FloatToHalf_SSE2( r, OUT special_r ), mask );
+			const __m128i	hg = _mm_and_si128( FloatToHalf_SSE2( g, OUT special_g ), mask );
+			const __m128i	hb = _mm_and_si128( FloatToHalf_SSE2( b, OUT special_b ), mask );
+
+			if ( (special_r | special_g | special_b) != 0 )
+			{
+				for (usize j = i; j < i + 4; ++j) {
+					dst[j] = r11g11b10f_t( src[j].x, src[j].y, src[j].z );
+				}
+				continue;
+			}
+
+			// sign is ignored, exponent and high bits of mantissa are copied from half
+			const __m128i	v = _mm_or_si128( _mm_or_si128(
+										_mm_slli_epi32( _mm_srli_epi32( hr, 4 ), 21 ),
+										_mm_slli_epi32( _mm_srli_epi32( hg, 4 ), 10 )),
+										_mm_srli_epi32( hb, 5 ));
+
+			_mm_storeu_si128( Cast<__m128i *>( dst + i ), v );
+		}
+	#endif
+
+		for (; i < count; ++i)
+		{
+			dst[i] = r11g11b10f_t( src[i].x, src[i].y, src[i].z );
+		}
+	}
+
+/*
+=================================================
+	RGB9E5ToRGBA32f
+=================================================
+*/
+	void ColorBatchConverter::RGB9E5ToRGBA32f (const rgb9_e5_t *src, usize count, OUT float4 *dst)
+	{
+		usize	i = 0;
+
+	#if defined( GX_COLOR_BATCH_SSE2 )
+		const __m128i	mask = _mm_set1_epi32( 0x1FF );
+
+		for (; i + 4 <= count; i += 4)
+		{
+			// 'm * 2^(e - 24)', multiplication by power of 2 is exact
+			const __m128i	v		= _mm_loadu_si128( Cast<__m128i const *>( src + i ));
+			const __m128	scale	= _mm_castsi128_ps( _mm_slli_epi32( _mm_add_epi32( _mm_srli_epi32( v, 27 ), _mm_set1_epi32( 127 - 15 - 9 )), 23 ));
+			__m128			r		= _mm_mul_ps( _mm_cvtepi32_ps( _mm_and_si128( v, mask )), scale );
+			__m128			g		= _mm_mul_ps( _mm_cvtepi32_ps( _mm_and_si128( _mm_srli_epi32( v, 9 ), mask )), scale );
+			__m128			b		= _mm_mul_ps( _mm_cvtepi32_ps( _mm_and_si128( _mm_srli_epi32( v, 18 ), mask )), scale );
+			__m128			a		= _mm_set1_ps( 1.0f );
+
+			_MM_TRANSPOSE4_PS( r, g, b, a );
+
+			_mm_storeu_ps( &dst[i+0].x, r );
+			_mm_storeu_ps( &dst[i+1].x, g );
+			_mm_storeu_ps( &dst[i+2].x, b );
+			_mm_storeu_ps( &dst[i+3].x, a );
+		}
+	#endif
+
+		for (; i < count; ++i)
+		{
+			const float3	c = src[i];
+			dst[i] = float4( c.x, c.y, c.z, 1.0f );
+		}
+	}
+
+/*
+=================================================
+	RGBA32fToRGB9E5
+----
+	shared exponent requires 'Log2', there is no vector version
+=================================================
+*/
+	void ColorBatchConverter::RGBA32fToRGB9E5 (const float4 *src, usize count, OUT rgb9_e5_t *dst)
+	{
+		for (usize i = 0; i < count; ++i)
+		{
+			dst[i].Set( src[i].x, src[i].y, src[i].z );
+		}
+	}
+
+
+}	// GXMath
+}	// GX_STL
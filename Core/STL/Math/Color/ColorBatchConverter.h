@@ -0,0 +1,61 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Color Batch Converter - conversion of pixel rows.
+
+	Results are bit-exact with scalar converters:
+		RGBA8_UNorm <-> RGBA32f		- ColorFormatConverter::Convert
+		half <-> float				- THalf::Get / THalf::Set
+		R11G11B10F, RGB9E5			- TR11G11B10F, TRGB9_E5 'Get' and 'Set'
+		sRGB						- ColorUtils::FromSRGB / ToSRGB for RGB, alpha is linear
+
+	Uses SSE2 on x86/x64 and NEON on AArch64, other platforms use scalar converters.
+	Input and output arrays must not overlap, except 'SwapRB' that may be used in-place.
+*/
+
+#pragma once
+
+#include "Core/STL/Math/Color/ColorFormats.h"
+#include "Core/STL/Math/Color/Color.h"
+
+namespace GX_STL
+{
+namespace GXMath
+{
+
+	//
+	// Color Batch Converter
+	//
+
+	struct ColorBatchConverter final : public Noninstancable
+	{
+	// types
+	public:
+		using RGBA8_UNorm	= ColorFormat::RGBA8_UNorm;
+
+
+	// methods
+	public:
+		static void RGBA8UNormToRGBA32f (const RGBA8_UNorm *src, usize count, OUT float4 *dst);
+		static void RGBA32fToRGBA8UNorm (const float4 *src, usize count, OUT RGBA8_UNorm *dst);
+
+		static void SRGB8ToRGBA32f (const RGBA8_UNorm *src, usize count, OUT float4 *dst);
+		static void RGBA32fToSRGB8 (const float4 *src, usize count, OUT RGBA8_UNorm *dst);
+
+		// RGBA <-> BGRA
+		static void SwapRB (const RGBA8_UNorm *src, usize count, OUT RGBA8_UNorm *dst);
+
+		static void HalfToFloat (const half *src, usize count, OUT float *dst);
+		static void FloatToHalf (const float *src, usize count, OUT half *dst);
+
+		// alpha is 1.0
+		static void R11G11B10fToRGBA32f (const r11g11b10f_t *src, usize count, OUT float4 *dst);
+		static void RGBA32fToR11G11B10f (const float4 *src, usize count, OUT r11g11b10f_t *dst);
+
+		// alpha is 1.0
+		static void RGB9E5ToRGBA32f (const rgb9_e5_t *src, usize count, OUT float4 *dst);
+		static void RGBA32fToRGB9E5 (const float4 *src, usize count, OUT rgb9_e5_t *dst);
+	};
+
+
+}	// GXMath
+}	// GX_STL
@@ -143,7 +143,7 @@ namespace GXMath
 
 		static const uint	s_uSharedExpMax = ( (1<<N)-1 ) * ( 1<<(E_MAX-B-N) );
 
-		ASSERT( Any( v < Vec3_t(0) ) and "only unsigned value supported" );
+		ASSERT( not Any( v < Vec3_t(0) ) and "only unsigned value supported" );
 
 		Vec3_t		v_color = Clamp( v, Vec3_t(0), Vec3_t( FT(s_uSharedExpMax) ) );
 
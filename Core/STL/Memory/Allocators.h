@@ -4,6 +4,7 @@
 
 #include "Core/STL/Memory/MemoryViewer.h"
 #include "Core/STL/Containers/CopyStrategy.h"
+#include "Core/STL/Memory/MemoryTracker.h"
 
 namespace GX_STL
 {
@@ -21,7 +22,11 @@ namespace GXTypes
 		{
 			ASSUME( size > 0 );
 
+		#ifdef GX_MEMORY_TRACKING
+			ptr = static_cast<T *>(MemoryTracker::Allocate( sizeof(T) * size ));
+		#else
 			ptr = static_cast<T *>(::operator new( sizeof(T) * size ));
+		#endif
 			ASSERT( ptr != null and "can't allocate memory!" );
 
 			return ptr != null;
@@ -29,7 +34,11 @@ namespace GXTypes
 
 		static void Deallocate (INOUT T *&ptr) noexcept
 		{
+		#ifdef GX_MEMORY_TRACKING
+			MemoryTracker::Deallocate( ptr );
+		#else
 			::operator delete( ptr );
+		#endif
 			ptr = null;
 		}
 	};
@@ -0,0 +1,224 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Core/STL/Memory/MemoryTracker.h"
+#include "Core/STL/Log/ToString.h"
+#include <atomic>
+#include <new>
+
+namespace GX_STL
+{
+namespace GXTypes
+{
+
+	//
+	// Allocation Header
+	//
+	struct MemoryTrackerHeader
+	{
+		usize		size;
+		uint		subsystem;
+		uint		magic;
+	};
+
+	STATIC_ASSERT( sizeof(MemoryTrackerHeader) <= MemoryTracker::HeaderSize );
+
+	static constexpr uint	MemoryTrackerMagic	= 0x6D656D74;
+
+
+	//
+	// Subsystem Counters
+	//
+	struct MemoryTrackerCounters
+	{
+		std::atomic< ulong >	liveBytes	{0};
+		std::atomic< ulong >	peakBytes	{0};
+		std::atomic< ulong >	totalBytes	{0};
+		std::atomic< ulong >	allocCount	{0};
+		std::atomic< ulong >	freeCount	{0};
+		std::atomic< ulong >	budget		{0};
+		std::atomic< bool >		overBudget	{false};
+	};
+
+/*
+=================================================
+	_MemoryTrackerCounters
+----
+	counters are never destroyed, because memory may be released
+	after static objects destruction
+=================================================
+*/
+	static MemoryTrackerCounters*  _MemoryTrackerCounters ()
+	{
+		alignas(MemoryTrackerCounters) static ubyte		storage[ sizeof(MemoryTrackerCounters) * EMemorySubsystem::_Count ];
+		static MemoryTrackerCounters *					counters = new(storage) MemoryTrackerCounters[ EMemorySubsystem::_Count ];
+
+		return counters;
+	}
+
+	static thread_local EMemorySubsystem::type	_currentSubsystem	= EMemorySubsystem::Containers;
+	static thread_local bool					_insideWarning		= false;
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	ToString
+=================================================
+*/
+	const char *  EMemorySubsystem::ToString (type value)
+	{
+		switch ( value )
+		{
+			case Containers :		return "Containers";
+			case Modules :			return "Modules";
+			case GpuHostMemory :	return "GpuHostMemory";
+			case ShaderCompiler :	return "ShaderCompiler";
+			case Scripts :			return "Scripts";
+			case _Count :
+			case Unknown :			break;
+		}
+		return "Unknown";
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	Allocate
+=================================================
+*/
+	void *  MemoryTracker::Allocate (usize size) noexcept
+	{
+		return Allocate( size, _currentSubsystem );
+	}
+
+	void *  MemoryTracker::Allocate (usize size, EMemorySubsystem::type subsystem) noexcept
+	{
+		ASSERT( subsystem < EMemorySubsystem::_Count );
+
+		ubyte *		ptr = static_cast<ubyte *>(::operator new( size + HeaderSize, std::nothrow ));
+
+		if ( ptr == null )
+			return null;
+
+		MemoryTrackerHeader*	header = reinterpret_cast< MemoryTrackerHeader *>( ptr );
+		header->size		= size;
+		header->subsystem	= subsystem;
+		header->magic		= MemoryTrackerMagic;
+
+		auto&		cnt		= _MemoryTrackerCounters()[ subsystem ];
+		const ulong	live	= cnt.liveBytes.fetch_add( size, std::memory_order_relaxed ) + size;
+
+		cnt.totalBytes.fetch_add( size, std::memory_order_relaxed );
+		cnt.allocCount.fetch_add( 1, std::memory_order_relaxed );
+
+		for (ulong peak = cnt.peakBytes.load( std::memory_order_relaxed );
+			 live > peak and not cnt.peakBytes.compare_exchange_weak( INOUT peak, live, std::memory_order_relaxed );)
+		{}
+
+		// check budget
+		const ulong	budget	= cnt.budget.load( std::memory_order_relaxed );
+
+		if ( budget > 0 and live > budget and not _insideWarning and
+			 not cnt.overBudget.exchange( true, std::memory_order_relaxed ) )
+		{
+			_insideWarning = true;
+
+			LOG( "Memory budget exceeded for subsystem '"_str << EMemorySubsystem::ToString( subsystem )
+				 << "': " << ToString( BytesU(live) ) << " of " << ToString( BytesU(budget) ), ELog::Warning );
+
+			_insideWarning = false;
+		}
+
+		return ptr + HeaderSize;
+	}
+
+/*
+=================================================
+	Deallocate
+=================================================
+*/
+	void MemoryTracker::Deallocate (void *ptr) noexcept
+	{
+		if ( ptr == null )
+			return;
+
+		ubyte *					base	= static_cast<ubyte *>(ptr) - HeaderSize;
+		MemoryTrackerHeader*	header	= reinterpret_cast< MemoryTrackerHeader *>( base );
+
+		ASSERT( header->magic == MemoryTrackerMagic and "memory was not allocated by tracker" );
+		ASSERT( header->subsystem < EMemorySubsystem::_Count );
+
+		auto&		cnt		= _MemoryTrackerCounters()[ header->subsystem ];
+		const ulong	live	= cnt.liveBytes.fetch_sub( header->size, std::memory_order_relaxed ) - header->size;
+
+		cnt.freeCount.fetch_add( 1, std::memory_order_relaxed );
+
+		if ( live <= cnt.budget.load( std::memory_order_relaxed ) )
+			cnt.overBudget.store( false, std::memory_order_relaxed );
+
+		header->magic = 0;
+		::operator delete( base );
+	}
+
+/*
+=================================================
+	SetSubsystem
+=================================================
+*/
+	EMemorySubsystem::type  MemoryTracker::SetSubsystem (EMemorySubsystem::type value)
+	{
+		ASSERT( value < EMemorySubsystem::_Count );
+
+		const auto	prev = _currentSubsystem;
+		_currentSubsystem = value;
+		return prev;
+	}
+
+/*
+=================================================
+	CurrentSubsystem
+=================================================
+*/
+	EMemorySubsystem::type  MemoryTracker::CurrentSubsystem ()
+	{
+		return _currentSubsystem;
+	}
+
+/*
+=================================================
+	SetBudget
+=================================================
+*/
+	void MemoryTracker::SetBudget (EMemorySubsystem::type subsystem, ulong bytes)
+	{
+		CHECK_ERR( subsystem < EMemorySubsystem::_Count, void() );
+
+		auto&	cnt = _MemoryTrackerCounters()[ subsystem ];
+
+		cnt.budget.store( bytes, std::memory_order_relaxed );
+		cnt.overBudget.store( false, std::memory_order_relaxed );
+	}
+
+/*
+=================================================
+	GetStatistic
+=================================================
+*/
+	bool MemoryTracker::GetStatistic (EMemorySubsystem::type subsystem, OUT Statistic &result)
+	{
+		CHECK_ERR( subsystem < EMemorySubsystem::_Count );
+
+		auto&	cnt = _MemoryTrackerCounters()[ subsystem ];
+
+		result.liveBytes	= cnt.liveBytes.load( std::memory_order_relaxed );
+		result.peakBytes	= cnt.peakBytes.load( std::memory_order_relaxed );
+		result.totalBytes	= cnt.totalBytes.load( std::memory_order_relaxed );
+		result.allocCount	= cnt.allocCount.load( std::memory_order_relaxed );
+		result.freeCount	= cnt.freeCount.load( std::memory_order_relaxed );
+		result.budget		= cnt.budget.load( std::memory_order_relaxed );
+		return true;
+	}
+
+}	// GXTypes
+}	// GX_STL
@@ -0,0 +1,117 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Memory Tracker - instrumented allocation layer.
+
+	Each allocation has a small header with size and subsystem tag,
+	so deallocation doesn't require size and subsystem.
+	Subsystem is selected per thread by 'GX_MEMORY_SCOPE'.
+	Default allocators use tracker only when 'GX_MEMORY_TRACKING' is defined.
+*/
+
+#pragma once
+
+#include "Core/STL/Types/Noninstancable.h"
+#include "Core/STL/Types/Noncopyable.h"
+
+namespace GX_STL
+{
+namespace GXTypes
+{
+
+	//
+	// Memory Subsystem
+	//
+
+	struct EMemorySubsystem
+	{
+		enum type : uint
+		{
+			Containers		= 0,	// default
+			Modules,
+			GpuHostMemory,
+			ShaderCompiler,
+			Scripts,
+			_Count,
+			Unknown			= uint(-1),
+		};
+
+		ND_ static const char *  ToString (type value);
+	};
+
+
+
+	//
+	// Memory Tracker
+	//
+
+	class MemoryTracker final : public Noninstancable
+	{
+	// types
+	public:
+		struct Statistic
+		{
+			ulong	liveBytes	= 0;
+			ulong	peakBytes	= 0;
+			ulong	totalBytes	= 0;	// total allocated bytes
+			ulong	allocCount	= 0;	// total number of allocations
+			ulong	freeCount	= 0;
+			ulong	budget		= 0;	// soft limit, 0 - unlimited
+		};
+
+
+		//
+		// Scoped Subsystem
+		//
+		struct ScopedSubsystem final : Noncopyable
+		{
+		private:
+			const EMemorySubsystem::type	_prev;
+
+		public:
+			explicit ScopedSubsystem (EMemorySubsystem::type value) : _prev{ SetSubsystem( value ) } {}
+			~ScopedSubsystem ()		{ SetSubsystem( _prev ); }
+		};
+
+
+	// constants
+	public:
+		static constexpr usize	HeaderSize	= 16;	// keeps default alignment of 'operator new'
+
+
+	// methods
+	public:
+		// uses subsystem of current thread
+		ND_ static void *  Allocate (usize size) noexcept;
+		ND_ static void *  Allocate (usize size, EMemorySubsystem::type subsystem) noexcept;
+			static void    Deallocate (void *ptr) noexcept;
+
+		// returns previous subsystem for current thread
+		static EMemorySubsystem::type  SetSubsystem (EMemorySubsystem::type value);
+		ND_ static EMemorySubsystem::type  CurrentSubsystem ();
+
+		// warning will be written when live memory exceeds budget
+		static void SetBudget (EMemorySubsystem::type subsystem, ulong bytes);
+
+		static bool GetStatistic (EMemorySubsystem::type subsystem, OUT Statistic &result);
+
+		ND_ static constexpr bool  IsEnabled ()
+		{
+		#ifdef GX_MEMORY_TRACKING
+			return true;
+		#else
+			return false;
+		#endif
+		}
+	};
+
+
+}	// GXTypes
+}	// GX_STL
+
+
+#ifdef GX_MEMORY_TRACKING
+#	define GX_MEMORY_SCOPE( _subsystem_ ) \
+		::GX_STL::GXTypes::MemoryTracker::ScopedSubsystem	AUXDEF_UNITE_RAW( __memScope, __COUNTER__ ){ (_subsystem_) }
+#else
+#	define GX_MEMORY_SCOPE( _subsystem_ )
+#endif
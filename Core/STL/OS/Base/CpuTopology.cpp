@@ -0,0 +1,307 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Core/STL/OS/Base/CpuTopology.h"
+#include "Core/STL/Algorithms/Sorts.h"
+#include "Core/STL/Log/ToString.h"
+#include "Core/STL/Math/MathFunc.h"
+
+#if not defined( PLATFORM_BASE_POSIX ) and not defined( PLATFORM_WINDOWS )
+#	include <thread>
+#endif
+
+namespace GX_STL
+{
+namespace OS
+{
+
+/*
+=================================================
+	_BitCount
+=================================================
+*/
+	static usize _BitCount (const CpuMask_t &mask)
+	{
+		usize	cnt = 0;
+		for (usize i = 0; i < mask.Count(); ++i) {
+			cnt += usize(mask.Get( i ));
+		}
+		return cnt;
+	}
+
+/*
+=================================================
+	_FirstBit
+=================================================
+*/
+	static usize _FirstBit (const CpuMask_t &mask)
+	{
+		for (usize i = 0; i < mask.Count(); ++i) {
+			if ( mask.Get( i ) )
+				return i;
+		}
+		return UMax;
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	Get
+=================================================
+*/
+	CpuTopology const&  CpuTopology::Get ()
+	{
+		static const CpuTopology	topology = LAMBDA() ()
+		{
+			CpuTopology	tmp;
+			CHECK( tmp.Query() );
+			return tmp;
+		}();
+
+		return topology;
+	}
+
+/*
+=================================================
+	AllCores
+=================================================
+*/
+	CpuMask_t  CpuTopology::AllCores () const
+	{
+		CpuMask_t	mask;
+
+		for (auto& lc : logicalCores) {
+			mask.Set( lc.index );
+		}
+		return mask;
+	}
+
+/*
+=================================================
+	GetCoreMask
+----
+	returns mask with all SMT siblings of physical core,
+	index is wrapped so that any thread index can be used.
+=================================================
+*/
+	CpuMask_t  CpuTopology::GetCoreMask (uint physicalCore) const
+	{
+		if ( physicalCores.Empty() )
+			return CpuMask_t();
+
+		return physicalCores[ physicalCore % physicalCores.Count() ].siblings;
+	}
+
+/*
+=================================================
+	GetLogicalCoreMask
+----
+	logical cores are enumerated first by physical core
+	and then by SMT sibling, so sequential indices
+	are placed on different physical cores.
+=================================================
+*/
+	CpuMask_t  CpuTopology::GetLogicalCoreMask (uint logicalCore) const
+	{
+		CpuMask_t	mask;
+
+		if ( physicalCores.Empty() )
+			return mask;
+
+		const usize			core_count	= physicalCores.Count();
+		CpuMask_t const&	siblings	= physicalCores[ logicalCore % core_count ].siblings;
+		usize				smt_idx		= (logicalCore / core_count) % GXMath::Max( _BitCount( siblings ), usize(1) );
+
+		for (usize i = 0; i < siblings.Count(); ++i)
+		{
+			if ( not siblings.Get( i ) )
+				continue;
+
+			if ( smt_idx-- == 0 ) {
+				mask.Set( i );
+				break;
+			}
+		}
+		return mask;
+	}
+
+/*
+=================================================
+	ToString
+=================================================
+*/
+	String  CpuTopology::ToString () const
+	{
+		String	str;
+
+		str << "CPU topology: " << LogicalCoreCount() << " logical cores, "
+			<< PhysicalCoreCount() << " physical cores, "
+			<< NumaNodeCount() << " numa nodes";
+
+		for (auto& core : physicalCores)
+		{
+			str << "\n  core [";
+
+			for (usize i = 0, j = 0; i < core.siblings.Count(); ++i) {
+				if ( core.siblings.Get( i ) )
+					str << (j++ ? ", " : "") << i;
+			}
+			str << "], package: " << core.packageId;
+		}
+
+		for (auto& cache : caches)
+		{
+			str << "\n  L" << cache.level << " cache " << GXTypes::ToString( cache.size )
+				<< ", shared between " << _BitCount( cache.cpus ) << " logical cores";
+		}
+		return str;
+	}
+
+/*
+=================================================
+	_Clear
+=================================================
+*/
+	void CpuTopology::_Clear ()
+	{
+		logicalCores.Clear();
+		physicalCores.Clear();
+		caches.Clear();
+		numaNodes.Clear();
+	}
+
+/*
+=================================================
+	_Validate
+----
+	builds 'logicalCores' from masks that
+	was filled by platform dependent code.
+=================================================
+*/
+	void CpuTopology::_Validate ()
+	{
+		struct CoreCmp {
+			bool operator () (const PhysicalCore &left, const PhysicalCore &right) const {
+				return	left.packageId != right.packageId ? left.packageId > right.packageId :
+						_FirstBit( left.siblings ) > _FirstBit( right.siblings );
+			}
+		};
+
+		for (usize i = 0; i < physicalCores.Count();)
+		{
+			if ( physicalCores[i].siblings.IsZero() )
+				physicalCores.Erase( i );
+			else
+				++i;
+		}
+
+		Sort( physicalCores, CoreCmp() );
+
+		if ( numaNodes.Empty() )
+		{
+			CpuMask_t	all;
+			for (auto& core : physicalCores)
+			for (usize i = 0; i < core.siblings.Count(); ++i)
+			{
+				if ( core.siblings.Get( i ) )
+					all.Set( i );
+			}
+			numaNodes.PushBack( all );
+		}
+
+		logicalCores.Clear();
+
+		for (usize i = 0; i < CpuMask_t::STATIC_COUNT; ++i)
+		{
+			LogicalCore		lc;
+			lc.index = uint(i);
+
+			FOR( j, physicalCores ) {
+				if ( physicalCores[j].siblings.Get( i ) ) {
+					lc.coreIndex = uint(j);
+					lc.packageId = physicalCores[j].packageId;
+					break;
+				}
+			}
+
+			if ( lc.coreIndex == UNKNOWN )
+				continue;
+
+			FOR( j, numaNodes ) {
+				if ( numaNodes[j].Get( i ) ) {
+					lc.numaNode = uint(j);
+					break;
+				}
+			}
+
+			FOR( j, caches ) {
+				if ( caches[j].cpus.Get( i ) ) {
+					(caches[j].level == 2 ? lc.l2Cache : lc.l3Cache) = uint(j);
+				}
+			}
+
+			logicalCores.PushBack( lc );
+		}
+	}
+//-----------------------------------------------------------------------------
+
+
+#if not defined( PLATFORM_BASE_POSIX ) and not defined( PLATFORM_WINDOWS )
+/*
+=================================================
+	Query
+=================================================
+*/
+	bool CpuTopology::Query ()
+	{
+		_Clear();
+
+		const uint	count = GXMath::Clamp( std::thread::hardware_concurrency(), 1u, uint(CpuMask_t::STATIC_COUNT) );
+
+		for (uint i = 0; i < count; ++i)
+		{
+			PhysicalCore	core;
+			core.siblings.Set( i );
+			physicalCores.PushBack( core );
+		}
+
+		_Validate();
+		return true;
+	}
+
+/*
+=================================================
+	SetCurrentThreadAffinity
+=================================================
+*/
+	bool CpuTopology::SetCurrentThreadAffinity (const CpuMask_t &)
+	{
+		return false;
+	}
+
+/*
+=================================================
+	GetCurrentThreadAffinity
+=================================================
+*/
+	bool CpuTopology::GetCurrentThreadAffinity (OUT CpuMask_t &mask)
+	{
+		mask = Get().AllCores();
+		return false;
+	}
+
+/*
+=================================================
+	GetCurrentCpu
+=================================================
+*/
+	uint CpuTopology::GetCurrentCpu ()
+	{
+		return UNKNOWN;
+	}
+
+#endif	// not PLATFORM_BASE_POSIX and not PLATFORM_WINDOWS
+
+}	// OS
+}	// GX_STL
@@ -0,0 +1,99 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#pragma once
+
+#include "Core/STL/OS/Base/Common.h"
+#include "Core/STL/Containers/StaticBitArray.h"
+#include "Core/STL/Dimensions/ByteAndBit.h"
+
+namespace GX_STL
+{
+namespace OS
+{
+
+	using CpuMask_t		= StaticBitArray< 256 >;	// one bit per logical processor
+
+
+
+	//
+	// CPU Topology
+	//
+
+	struct CpuTopology final
+	{
+	// types
+	public:
+		static constexpr uint	UNKNOWN	= UMax;
+
+		struct LogicalCore
+		{
+			uint	index		= UNKNOWN;		// OS processor index, used as bit index in 'CpuMask_t'
+			uint	coreIndex	= UNKNOWN;		// index in 'physicalCores'
+			uint	packageId	= 0;
+			uint	numaNode	= 0;
+			uint	l2Cache		= UNKNOWN;		// index in 'caches'
+			uint	l3Cache		= UNKNOWN;		// index in 'caches'
+		};
+
+		struct PhysicalCore
+		{
+			CpuMask_t	siblings;				// SMT threads that are share this core
+			uint		packageId	= 0;
+		};
+
+		struct CacheDomain
+		{
+			CpuMask_t	cpus;					// logical processors that are share this cache
+			BytesU		size;
+			uint		level		= 0;
+		};
+
+		using LogicalCores_t	= Array< LogicalCore >;
+		using PhysicalCores_t	= Array< PhysicalCore >;
+		using Caches_t			= Array< CacheDomain >;
+		using NumaNodes_t		= Array< CpuMask_t >;
+
+
+	// variables
+	public:
+		LogicalCores_t		logicalCores;		// sorted by 'index'
+		PhysicalCores_t		physicalCores;		// sorted by package and first sibling
+		Caches_t			caches;				// only shared L2 and L3 data/unified caches
+		NumaNodes_t			numaNodes;
+
+
+	// methods
+	public:
+		CpuTopology () {}
+
+		// Implement for current platform
+		bool Query ();
+
+		ND_ uint		LogicalCoreCount ()		const	{ return uint(logicalCores.Count()); }
+		ND_ uint		PhysicalCoreCount ()	const	{ return uint(physicalCores.Count()); }
+		ND_ uint		NumaNodeCount ()		const	{ return uint(numaNodes.Count()); }
+		ND_ bool		HasSMT ()				const	{ return LogicalCoreCount() > PhysicalCoreCount(); }
+
+		ND_ CpuMask_t	AllCores () const;
+		ND_ CpuMask_t	GetCoreMask (uint physicalCore) const;
+		ND_ CpuMask_t	GetLogicalCoreMask (uint logicalCore) const;
+
+		ND_ String		ToString () const;
+
+		// returns topology of current machine, queried once
+		ND_ static CpuTopology const&	Get ();
+
+
+		// Implement for current platform
+		static bool		SetCurrentThreadAffinity (const CpuMask_t &mask);
+		static bool		GetCurrentThreadAffinity (OUT CpuMask_t &mask);
+		ND_ static uint	GetCurrentCpu ();
+
+	private:
+		void _Clear ();
+		void _Validate ();
+	};
+
+
+}	// OS
+}	// GX_STL
@@ -47,6 +47,7 @@
 #endif
 
 #include "Core/STL/OS/Base/BaseFileSystem.h"
+#include "Core/STL/OS/Base/CpuTopology.h"
 #include "Core/STL/OS/Base/Endianes.h"
 
 
@@ -0,0 +1,364 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Core/STL/Common/Platforms.h"
+
+#ifdef PLATFORM_BASE_POSIX
+
+#ifndef _GNU_SOURCE
+#	define _GNU_SOURCE
+#endif
+
+#include "Core/STL/OS/Posix/PosixHeader.h"
+#include "Core/STL/OS/Base/CpuTopology.h"
+#include "Core/STL/Algorithms/StringUtils.h"
+#include <sched.h>
+
+namespace GX_STL
+{
+namespace OS
+{
+
+/*
+=================================================
+	_ReadSysFile
+----
+	files in '/sys' reports invalid size,
+	so read it until end of file.
+=================================================
+*/
+	static bool _ReadSysFile (StringCRef path, OUT String &result)
+	{
+		result.Clear();
+
+		FILE*	file = ::fopen( path.cstr(), "r" );
+		if ( file == null )
+			return false;
+
+		char	buf[256];
+		usize	readn;
+
+		while ( (readn = ::fread( buf, 1, CountOf(buf), file )) > 0 )
+		{
+			result << StringCRef( buf, readn );
+		}
+		::fclose( file );
+
+		// remove line break
+		while ( not result.Empty() and (result.Back() == '\n' or result.Back() == ' ') ) {
+			result.PopBack();
+		}
+		return not result.Empty();
+	}
+
+/*
+=================================================
+	_ReadSysUInt
+=================================================
+*/
+	static bool _ReadSysUInt (StringCRef path, OUT uint &result)
+	{
+		String	str;
+		if ( not _ReadSysFile( path, OUT str ) )
+			return false;
+
+		result = uint(StringUtils::ToInt32( str ));
+		return true;
+	}
+
+/*
+=================================================
+	_ParseCpuList
+----
+	format: "0-3,8,10-11"
+=================================================
+*/
+	static bool _ParseCpuList (StringCRef str, OUT CpuMask_t &mask)
+	{
+		mask = CpuMask_t();
+
+		usize	pos = 0;
+
+		while ( pos < str.Length() )
+		{
+			uint	first	= 0;
+			uint	last	= 0;
+			usize	start	= pos;
+
+			for (; pos < str.Length() and str[pos] >= '0' and str[pos] <= '9'; ++pos) {
+				first = first * 10 + uint(str[pos] - '0');
+			}
+			CHECK_ERR( pos > start );
+
+			last = first;
+
+			if ( pos < str.Length() and str[pos] == '-' )
+			{
+				start = ++pos;
+				last  = 0;
+				for (; pos < str.Length() and str[pos] >= '0' and str[pos] <= '9'; ++pos) {
+					last = last * 10 + uint(str[pos] - '0');
+				}
+				CHECK_ERR( pos > start );
+			}
+
+			for (uint i = first; i <= last and i < mask.Count(); ++i) {
+				mask.Set( i );
+			}
+
+			if ( pos < str.Length() )
+			{
+				CHECK_ERR( str[pos] == ',' );
+				++pos;
+			}
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_ReadCpuList
+=================================================
+*/
+	static bool _ReadCpuList (StringCRef path, OUT CpuMask_t &mask)
+	{
+		String	str;
+		return _ReadSysFile( path, OUT str ) and _ParseCpuList( str, OUT mask );
+	}
+
+/*
+=================================================
+	_ParseCacheSize
+----
+	format: "32K", "8192K", "1M"
+=================================================
+*/
+	static BytesU _ParseCacheSize (StringCRef str)
+	{
+		ulong	value	= 0;
+		usize	pos		= 0;
+
+		for (; pos < str.Length() and str[pos] >= '0' and str[pos] <= '9'; ++pos) {
+			value = value * 10 + ulong(str[pos] - '0');
+		}
+
+		if ( pos < str.Length() )
+		{
+			switch ( str[pos] ) {
+				case 'K' :	value <<= 10;	break;
+				case 'M' :	value <<= 20;	break;
+				case 'G' :	value <<= 30;	break;
+			}
+		}
+		return BytesU( value );
+	}
+
+/*
+=================================================
+	_ReadProcessAffinity
+----
+	affinity of main thread is used, because
+	current thread may be already pinned.
+=================================================
+*/
+	static bool _ReadProcessAffinity (OUT CpuMask_t &mask)
+	{
+		mask = CpuMask_t();
+
+		cpu_set_t	cpu_set;
+		CPU_ZERO( &cpu_set );
+
+		if ( ::sched_getaffinity( ::getpid(), sizeof(cpu_set), &cpu_set ) != 0 )
+			return false;
+
+		for (usize i = 0; i < mask.Count() and i < CPU_SETSIZE; ++i)
+		{
+			if ( CPU_ISSET( i, &cpu_set ) )
+				mask.Set( i );
+		}
+		return mask.IsNotZero();
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	Query
+----
+	reads topology from '/sys/devices/system',
+	see https://www.kernel.org/doc/Documentation/cputopology.txt
+=================================================
+*/
+	bool CpuTopology::Query ()
+	{
+		_Clear();
+
+		const String	cpu_path	= "/sys/devices/system/cpu/";
+		const String	node_path	= "/sys/devices/system/node/";
+
+		CpuMask_t	online;
+
+		// only cores that process is allowed to run on,
+		// cores excluded by taskset or cgroup cpuset are not reported
+		if ( not _ReadProcessAffinity( OUT online ) and
+			 not _ReadCpuList( cpu_path + "online", OUT online ) )
+		{
+			// '/sys' is not accessible, use processor count
+			const long	count = ::sysconf( _SC_NPROCESSORS_ONLN );
+
+			for (long i = 0; i < count and usize(i) < online.Count(); ++i) {
+				online.Set( usize(i) );
+			}
+		}
+
+		CHECK_ERR( online.IsNotZero() );
+
+		for (usize i = 0; i < online.Count(); ++i)
+		{
+			if ( not online.Get( i ) )
+				continue;
+
+			const String	topology	= String(cpu_path) << "cpu" << i << "/topology/";
+			const String	cache		= String(cpu_path) << "cpu" << i << "/cache/index";
+
+			// physical core
+			PhysicalCore	core;
+
+			if ( _ReadCpuList( topology + "thread_siblings_list", OUT core.siblings ) )
+			{
+				// remove siblings that are not allowed
+				for (usize j = 0; j < core.siblings.Count(); ++j)
+				{
+					if ( core.siblings.Get( j ) and not online.Get( j ) )
+						core.siblings.Reset( j );
+				}
+			}
+			else
+				core.siblings.Set( i );
+
+			if ( not _ReadSysUInt( topology + "physical_package_id", OUT core.packageId ) )
+				core.packageId = 0;
+
+			bool	found = false;
+			for (auto& c : physicalCores) {
+				found |= (c.siblings == core.siblings);
+			}
+
+			if ( not found )
+				physicalCores.PushBack( core );
+
+
+			// caches
+			for (uint j = 0; ; ++j)
+			{
+				const String	index_path	= String(cache) << j << "/";
+				CacheDomain		domain;
+				String			type;
+				String			size;
+
+				if ( not _ReadSysUInt( index_path + "level", OUT domain.level ) )
+					break;
+
+				if ( domain.level < 2 or domain.level > 3 )
+					continue;
+
+				if ( _ReadSysFile( index_path + "type", OUT type ) and type == "Instruction" )
+					continue;
+
+				if ( not _ReadCpuList( index_path + "shared_cpu_list", OUT domain.cpus ) )
+					continue;
+
+				if ( _ReadSysFile( index_path + "size", OUT size ) )
+					domain.size = _ParseCacheSize( size );
+
+				found = false;
+				for (auto& c : caches) {
+					found |= (c.level == domain.level and c.cpus == domain.cpus);
+				}
+
+				if ( not found )
+					caches.PushBack( domain );
+			}
+		}
+
+		// numa nodes
+		CpuMask_t	nodes;
+
+		if ( _ReadCpuList( node_path + "online", OUT nodes ) )
+		{
+			for (usize i = 0; i < nodes.Count(); ++i)
+			{
+				CpuMask_t	node_cpus;
+
+				if ( nodes.Get( i ) and
+					 _ReadCpuList( String(node_path) << "node" << i << "/cpulist", OUT node_cpus ) )
+				{
+					numaNodes.PushBack( node_cpus );
+				}
+			}
+		}
+
+		_Validate();
+		return not physicalCores.Empty();
+	}
+
+/*
+=================================================
+	SetCurrentThreadAffinity
+=================================================
+*/
+	bool CpuTopology::SetCurrentThreadAffinity (const CpuMask_t &mask)
+	{
+		CHECK_ERR( mask.IsNotZero() );
+
+		cpu_set_t	cpu_set;
+		CPU_ZERO( &cpu_set );
+
+		for (usize i = 0; i < mask.Count() and i < CPU_SETSIZE; ++i)
+		{
+			if ( mask.Get( i ) )
+				CPU_SET( i, &cpu_set );
+		}
+
+		// pid 0 - calling thread
+		return ::sched_setaffinity( 0, sizeof(cpu_set), &cpu_set ) == 0;
+	}
+
+/*
+=================================================
+	GetCurrentThreadAffinity
+=================================================
+*/
+	bool CpuTopology::GetCurrentThreadAffinity (OUT CpuMask_t &mask)
+	{
+		mask = CpuMask_t();
+
+		cpu_set_t	cpu_set;
+		CPU_ZERO( &cpu_set );
+
+		if ( ::sched_getaffinity( 0, sizeof(cpu_set), &cpu_set ) != 0 )
+			return false;
+
+		for (usize i = 0; i < mask.Count() and i < CPU_SETSIZE; ++i)
+		{
+			if ( CPU_ISSET( i, &cpu_set ) )
+				mask.Set( i );
+		}
+		return true;
+	}
+
+/*
+=================================================
+	GetCurrentCpu
+=================================================
+*/
+	uint CpuTopology::GetCurrentCpu ()
+	{
+		const int	cpu = ::sched_getcpu();
+		return cpu < 0 ? UNKNOWN : uint(cpu);
+	}
+
+}	// OS
+}	// GX_STL
+
+#endif	// PLATFORM_BASE_POSIX
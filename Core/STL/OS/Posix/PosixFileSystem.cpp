@@ -5,7 +5,7 @@
 #ifdef PLATFORM_BASE_POSIX
 
 #include "Core/STL/OS/Posix/PosixHeader.h"
-#include "Core/STL/OS/Posix/FileSystem.h"
+#include "Core/STL/OS/Posix/PosixFileSystem.h"
 
 namespace GX_STL
 {
@@ -209,8 +209,11 @@ namespace OS
 */
 	bool PosixFileSystem::MoveFile (StringCRef oldName, StringCRef newName, bool async)
 	{
-		TODO("MoveFile");
-		return false;
+		ASSERT( not async );	// not supported
+		GX_UNUSED( async );
+
+		// replaces 'newName' atomically if it is exist
+		return ::rename( oldName.cstr(), newName.cstr() ) == 0;
 	}
 	
 /*
@@ -41,7 +41,6 @@ namespace OS
 		static bool CopyFile (StringCRef fromFile, StringCRef toFile);
 		static bool CopyDirectory (StringCRef fromDir, StringCRef toDir);
 
-		// TODO: MoveFile
 		// TODO: MoveDirectory
 
 		static bool MoveFile (StringCRef oldName, StringCRef newName, bool async = false);
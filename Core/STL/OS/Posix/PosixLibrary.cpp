@@ -5,7 +5,7 @@
 #if defined( PLATFORM_BASE_POSIX ) and defined( GX_USE_NATIVE_API )
 
 #include "Core/STL/OS/Posix/PosixHeader.h"
-#include "Core/STL/OS/Posix/Library.h"
+#include "Core/STL/OS/Posix/PosixLibrary.h"
 #include "Core/STL/OS/Base/BaseFileSystem.h"
 
 namespace GX_STL
@@ -65,7 +65,7 @@ namespace OS
 
 		Unload();
 
-		_library		= ::dlopen( name.cstr(), RTLD_GLOBAL );
+		_library		= ::dlopen( name.cstr(), RTLD_LAZY | RTLD_GLOBAL );
 		_name			= name;
 		_freeWhenDelete = canFree;
 			
@@ -82,7 +82,7 @@ namespace OS
 		Unload();
 
 		_freeWhenDelete		= true;
-		_library			= ::dlopen( null, RTLD_GLOBAL );
+		_library			= ::dlopen( null, RTLD_LAZY | RTLD_GLOBAL );
 
 		Dl_info	info;
 
@@ -7,7 +7,7 @@
 #if defined( PLATFORM_BASE_POSIX ) and defined( GX_USE_NATIVE_API )
 
 #include "Core/STL/OS/Posix/OSPosix.h"
-#include "Core/STL/OS/Posix/FileSystem.h"
+#include "Core/STL/OS/Posix/PosixFileSystem.h"
 
 namespace GX_STL
 {
@@ -58,8 +58,14 @@ namespace OS
 			ASSERT( IsValid() );
 			ASSERT( not procName.Empty() );
 
-			T * tmp = ReferenceCast<T>( GetProc( procName ) );
-			return tmp != null;
+			T tmp = ReferenceCast<T>( GetProc( procName ) );
+
+			if ( tmp != null )
+			{
+				proc = tmp;
+				return true;
+			}
+			return false;
 		}
 
 	private:
@@ -5,6 +5,7 @@
 #if defined( PLATFORM_BASE_POSIX ) and defined( GX_USE_NATIVE_API )
 
 #include <signal.h>
+#include <sched.h>
 
 namespace GX_STL
 {
@@ -51,6 +52,34 @@ namespace OS
 		return false;
 	}
 	
+/*
+=================================================
+	SetAffinity
+=================================================
+*/
+	bool CurrentThread::SetAffinity (const CpuMask_t &mask) const
+	{
+		CHECK_ERR( IsValid() );
+
+	#ifdef PLATFORM_ANDROID
+		// bionic has no 'pthread_setaffinity_np'
+		return IsCurrent() and CpuTopology::SetCurrentThreadAffinity( mask );
+
+	#else
+		CHECK_ERR( mask.IsNotZero() );
+
+		cpu_set_t	cpu_set;
+		CPU_ZERO( &cpu_set );
+
+		for (usize i = 0; i < mask.Count() and i < CPU_SETSIZE; ++i)
+		{
+			if ( mask.Get( i ) )
+				CPU_SET( i, &cpu_set );
+		}
+		return ::pthread_setaffinity_np( _thread, sizeof(cpu_set), &cpu_set ) == 0;
+	#endif
+	}
+	
 /*
 =================================================
 	GetCurrentThreadId
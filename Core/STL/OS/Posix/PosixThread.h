@@ -7,6 +7,7 @@
 #if defined( PLATFORM_BASE_POSIX ) and defined( GX_USE_NATIVE_API )
 
 #include "Core/STL/OS/Posix/OSPosix.h"
+#include "Core/STL/OS/Base/CpuTopology.h"
 #include <pthread.h>
 
 namespace GX_STL
@@ -56,6 +57,7 @@ namespace OS
 		ND_ bool  IsCurrent () const;
 
 		bool SetPriority (EThreadPriority::type priority) const;
+		bool SetAffinity (const CpuMask_t &mask) const;
 
 		ND_ static usize GetCurrentThreadId ();
 
@@ -37,6 +37,18 @@ namespace OS
 		::gettimeofday( OUT &tv, null );
 		return TimeL::FromMicroSeconds( ulong(tv.tv_sec) * 1000000 + tv.tv_usec );
 	}
+		
+/*
+=================================================
+	GetTimeNanoSec
+=================================================
+*/
+	TimeL PerformanceTimer::GetTimeNanoSec () const
+	{
+		timespec ts;
+		::clock_gettime( CLOCK_MONOTONIC, OUT &ts );
+		return TimeL::FromNanoSeconds( ulong(ts.tv_sec) * 1000'000'000 + ts.tv_nsec );
+	}
 
 # endif	// GX_USE_NATIVE_API
 //-----------------------------------------------------------------------------
@@ -30,6 +30,9 @@ namespace OS
 		// microseconds
 		ND_ TimeL  GetTimeMicroSec () const;
 
+		// nanoseconds, monotonic
+		ND_ TimeL  GetTimeNanoSec () const;
+
 		template <typename T>
 		ND_ T  Get (const T& = T()) const;
 	};
@@ -81,6 +81,21 @@ namespace OS
 		return false;
 	}
 	
+/*
+=================================================
+	SetAffinity
+----
+	SDL has no affinity API, so only current thread is supported
+=================================================
+*/
+	bool CurrentThread::SetAffinity (const CpuMask_t &mask) const
+	{
+		ASSERT( IsValid() );
+		ASSERT( IsCurrent() );
+
+		return IsCurrent() and CpuTopology::SetCurrentThreadAffinity( mask );
+	}
+	
 /*
 =================================================
 	GetCurrentThreadId
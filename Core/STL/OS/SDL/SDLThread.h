@@ -7,6 +7,7 @@
 #ifdef PLATFORM_SDL
 
 #include "Core/STL/OS/SDL/OS_SDL.h"
+#include "Core/STL/OS/Base/CpuTopology.h"
 
 namespace GX_STL
 {
@@ -59,6 +60,7 @@ namespace OS
 		ND_ bool  IsCurrent () const;
 
 		bool SetPriority (EThreadPriority::type priority) const;
+		bool SetAffinity (const CpuMask_t &mask) const;
 
 		ND_ static usize GetCurrentThreadId ();
 
@@ -43,6 +43,13 @@ namespace OS
 			return TimeL().FromTime( GetTime() );
 		}
 
+		// nanoseconds, monotonic
+		ND_ forceinline TimeL  GetTimeNanoSec () const
+		{
+			const ulong	counter = ::SDL_GetPerformanceCounter();
+			return TimeL::FromNanoSeconds( (counter / _freq) * 1000'000'000 + ((counter % _freq) * 1000'000'000) / _freq );
+		}
+
 		template <typename T>
 		ND_ T  Get (const T& = T()) const;
 	};
@@ -79,6 +79,18 @@ namespace OS
 		return false;
 	}
 	
+/*
+=================================================
+	SetAffinity
+----
+	only current thread is supported
+=================================================
+*/
+	bool CurrentThread::SetAffinity (const CpuMask_t &mask) const
+	{
+		return IsCurrent() and CpuTopology::SetCurrentThreadAffinity( mask );
+	}
+	
 /*
 =================================================
 	GetCurrentThreadId
@@ -196,6 +208,18 @@ namespace OS
 	{
 		return std::this_thread::get_id() == _thread.get_id();
 	}
+	
+/*
+=================================================
+	SetAffinity
+----
+	only current thread is supported
+=================================================
+*/
+	bool Thread::SetAffinity (const CpuMask_t &mask) const
+	{
+		return IsCurrent() and CpuTopology::SetCurrentThreadAffinity( mask );
+	}
 
 /*
 =================================================
@@ -8,6 +8,7 @@
 #if defined( GX_USE_STD ) and not defined( PLATFORM_SDL )
 
 #include "Core/STL/OS/Base/Common.h"
+#include "Core/STL/OS/Base/CpuTopology.h"
 #include <thread>
 
 namespace GX_STL
@@ -49,6 +50,7 @@ namespace OS
 		ND_ bool  IsValid () const;
 
 		bool SetPriority (EThreadPriority::type priority) const;
+		bool SetAffinity (const CpuMask_t &mask) const;
 
 		ND_ static usize GetCurrentThreadId ();
 
@@ -95,6 +97,7 @@ namespace OS
 		bool IsCurrent () const;
 		
 		bool SetPriority (EThreadPriority::type priority) const;
+		bool SetAffinity (const CpuMask_t &mask) const;
 
 		bool Create (PThreadProc_t proc, void *param = null);
 		void Delete () noexcept;
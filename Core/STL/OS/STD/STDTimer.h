@@ -31,6 +31,9 @@ namespace OS
 		// microseconds
 		ND_ TimeL  GetTimeMicroSec () const;
 
+		// nanoseconds, monotonic
+		ND_ TimeL  GetTimeNanoSec () const;
+
 		template <typename T>
 		ND_ T  Get (const T& = T()) const;
 	};
@@ -56,6 +59,17 @@ namespace OS
 		return TimeL::FromNanoSeconds( std::chrono::high_resolution_clock::now().time_since_epoch().count() );
 	}
 	
+/*
+=================================================
+	GetTimeNanoSec
+=================================================
+*/
+	inline TimeL PerformanceTimer::GetTimeNanoSec () const
+	{
+		using namespace std::chrono;
+		return TimeL::FromNanoSeconds( duration_cast<nanoseconds>( steady_clock::now().time_since_epoch() ).count() );
+	}
+	
 /*
 =================================================
 	Get
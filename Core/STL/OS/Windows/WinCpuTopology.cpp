@@ -0,0 +1,184 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Core/STL/Common/Platforms.h"
+#include "Core/Config/STL.Config.h"
+
+#if defined( PLATFORM_WINDOWS )
+
+#include "Core/STL/OS/Base/CpuTopology.h"
+#include "Core/STL/OS/Windows/WinHeader.h"
+
+namespace GX_STL
+{
+namespace OS
+{
+
+/*
+=================================================
+	_MaskFromAffinity
+=================================================
+*/
+	static CpuMask_t  _MaskFromAffinity (KAFFINITY affinity)
+	{
+		CpuMask_t	mask;
+
+		for (usize i = 0; i < sizeof(affinity)*8 and i < mask.Count(); ++i)
+		{
+			if ( (affinity >> i) & 1 )
+				mask.Set( i );
+		}
+		return mask;
+	}
+
+/*
+=================================================
+	_AffinityFromMask
+=================================================
+*/
+	static DWORD_PTR  _AffinityFromMask (const CpuMask_t &mask)
+	{
+		DWORD_PTR	affinity = 0;
+
+		for (usize i = 0; i < sizeof(affinity)*8 and i < mask.Count(); ++i)
+		{
+			if ( mask.Get( i ) )
+				affinity |= (DWORD_PTR(1) << i);
+		}
+		return affinity;
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	Query
+----
+	only first processor group (64 logical processors)
+	is supported
+=================================================
+*/
+	bool CpuTopology::Query ()
+	{
+		using Info_t = SYSTEM_LOGICAL_PROCESSOR_INFORMATION;
+
+		_Clear();
+
+		DWORD	length = 0;
+		::GetLogicalProcessorInformation( null, OUT &length );
+		CHECK_ERR( ::GetLastError() == ERROR_INSUFFICIENT_BUFFER );
+
+		Array< Info_t >		infos;
+		infos.Resize( length / sizeof(Info_t) );
+
+		CHECK_ERR( ::GetLogicalProcessorInformation( infos.ptr(), INOUT &length ) != FALSE );
+
+		Array< Pair< KAFFINITY, uint > >	packages;
+
+		for (auto& info : infos)
+		{
+			if ( info.Relationship == RelationProcessorPackage )
+			{
+				packages.PushBack({ info.ProcessorMask, uint(packages.Count()) });
+			}
+		}
+
+		for (auto& info : infos)
+		{
+			switch ( info.Relationship )
+			{
+				case RelationProcessorCore :
+				{
+					PhysicalCore	core;
+					core.siblings = _MaskFromAffinity( info.ProcessorMask );
+
+					for (auto& pkg : packages) {
+						if ( (pkg.first & info.ProcessorMask) != 0 )
+							core.packageId = pkg.second;
+					}
+					physicalCores.PushBack( core );
+					break;
+				}
+
+				case RelationCache :
+				{
+					if ( (info.Cache.Level != 2 and info.Cache.Level != 3) or
+						 info.Cache.Type == CacheInstruction )
+						break;
+
+					CacheDomain		domain;
+					domain.cpus		= _MaskFromAffinity( info.ProcessorMask );
+					domain.size		= BytesU( info.Cache.Size );
+					domain.level	= info.Cache.Level;
+					caches.PushBack( domain );
+					break;
+				}
+
+				case RelationNumaNode :
+				{
+					numaNodes.PushBack( _MaskFromAffinity( info.ProcessorMask ) );
+					break;
+				}
+			}
+		}
+
+		_Validate();
+		return not physicalCores.Empty();
+	}
+
+/*
+=================================================
+	SetCurrentThreadAffinity
+=================================================
+*/
+	bool CpuTopology::SetCurrentThreadAffinity (const CpuMask_t &mask)
+	{
+		const DWORD_PTR	affinity = _AffinityFromMask( mask );
+		CHECK_ERR( affinity != 0 );
+
+		return ::SetThreadAffinityMask( ::GetCurrentThread(), affinity ) != 0;
+	}
+
+/*
+=================================================
+	GetCurrentThreadAffinity
+----
+	there is no 'GetThreadAffinityMask',
+	so set process affinity and restore previous value.
+=================================================
+*/
+	bool CpuTopology::GetCurrentThreadAffinity (OUT CpuMask_t &mask)
+	{
+		DWORD_PTR	process_mask	= 0;
+		DWORD_PTR	system_mask		= 0;
+
+		mask = CpuMask_t();
+
+		if ( ::GetProcessAffinityMask( ::GetCurrentProcess(), OUT &process_mask, OUT &system_mask ) == FALSE )
+			return false;
+
+		const DWORD_PTR	prev = ::SetThreadAffinityMask( ::GetCurrentThread(), process_mask );
+
+		if ( prev == 0 )
+			return false;
+
+		::SetThreadAffinityMask( ::GetCurrentThread(), prev );
+
+		mask = _MaskFromAffinity( prev );
+		return true;
+	}
+
+/*
+=================================================
+	GetCurrentCpu
+=================================================
+*/
+	uint CpuTopology::GetCurrentCpu ()
+	{
+		return uint(::GetCurrentProcessorNumber());
+	}
+
+}	// OS
+}	// GX_STL
+
+#endif	// PLATFORM_WINDOWS
@@ -72,6 +72,27 @@ namespace OS
 		return SetThreadPriority( _thread.Get<HANDLE>(), priority ) != FALSE;
 	}
 	
+/*
+=================================================
+	SetAffinity
+----
+	only first processor group is supported
+=================================================
+*/
+	bool CurrentThread::SetAffinity (const CpuMask_t &mask) const
+	{
+		DWORD_PTR	affinity = 0;
+
+		for (usize i = 0; i < sizeof(affinity)*8 and i < mask.Count(); ++i)
+		{
+			if ( mask.Get( i ) )
+				affinity |= (DWORD_PTR(1) << i);
+		}
+
+		CHECK_ERR( affinity != 0 );
+		return SetThreadAffinityMask( _thread.Get<HANDLE>(), affinity ) != 0;
+	}
+	
 /*
 =================================================
 	GetCurrentThreadId
@@ -8,6 +8,7 @@
 #if defined( PLATFORM_WINDOWS ) and defined( GX_USE_NATIVE_API )
 
 #include "Core/STL/OS/Windows/OSWindows.h"
+#include "Core/STL/OS/Base/CpuTopology.h"
 
 namespace GX_STL
 {
@@ -69,6 +70,7 @@ namespace OS
 		ND_ bool IsValid () const;
 
 		bool SetPriority (EThreadPriority::type priority) const;
+		bool SetAffinity (const CpuMask_t &mask) const;
 
 
 		ND_ static usize GetCurrentThreadId ();
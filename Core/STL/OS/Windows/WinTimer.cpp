@@ -50,6 +50,25 @@ namespace OS
 		QueryPerformanceCounter( &perf_counter );
 		return TimeL::FromMicroSeconds( (perf_counter.QuadPart * 1000'000) / _liFreq.Get<LARGE_INTEGER>().QuadPart );
 	}
+		
+/*
+=================================================
+	GetTimeNanoSec
+----
+	counter is splitted to avoid overflow
+=================================================
+*/
+	TimeL PerformanceTimer::GetTimeNanoSec () const
+	{
+		LARGE_INTEGER	perf_counter;
+		QueryPerformanceCounter( &perf_counter );
+
+		const ilong		freq	= _liFreq.Get<LARGE_INTEGER>().QuadPart;
+		const ilong		sec		= perf_counter.QuadPart / freq;
+		const ilong		rem		= perf_counter.QuadPart % freq;
+
+		return TimeL::FromNanoSeconds( sec * 1000'000'000 + (rem * 1000'000'000) / freq );
+	}
 
 # endif	// GX_USE_NATIVE_API
 //-----------------------------------------------------------------------------
@@ -0,0 +1,164 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Core/STL/ThreadSafe/ParallelFor.h"
+#include "Core/STL/ThreadSafe/Singleton.h"
+
+namespace GX_STL
+{
+namespace GXTypes
+{
+
+/*
+=================================================
+	constructor
+----
+	current thread participates in each job,
+	so one core is left for it.
+=================================================
+*/
+	ParallelJobPool::ParallelJobPool (uint threadCount)
+	{
+		if ( threadCount == 0 )
+			threadCount = GXMath::Max( OS::CpuTopology::Get().PhysicalCoreCount(), 1u ) - 1;
+
+		_workers.Reserve( threadCount );
+
+		for (uint i = 0; i < threadCount; ++i)
+		{
+			_workers.PushBack( UniquePtr<Worker>{ new Worker() } );
+
+			auto&	w = *_workers.Back();
+			w.pool	= this;
+			w.index	= i;
+
+			if ( not w.thread.Create( &_WorkerProc, &w ) )
+			{
+				WARNING( "failed to create worker thread" );
+				_workers.PopBack();
+				break;
+			}
+		}
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	ParallelJobPool::~ParallelJobPool ()
+	{
+		_lock.Lock();
+		_looping = false;
+		_wakeUp.Broadcast();
+		_lock.Unlock();
+
+		for (auto& w : _workers) {
+			w->thread.Wait();
+		}
+	}
+
+/*
+=================================================
+	Instance
+----
+	threads are created on first use.
+=================================================
+*/
+	ParallelJobPool&  ParallelJobPool::Instance ()
+	{
+		return *SingletonMultiThread::Instance< ParallelJobPool >();
+	}
+
+/*
+=================================================
+	Run
+----
+	'proc' must be safe to call from several threads at once
+	and must return when there is no more work.
+	Current thread executes 'proc' too, so all work is done
+	even if no worker has joined.
+	If pool is busy (nested or concurrent call) 'proc' is
+	executed in current thread only, this can't deadlock.
+=================================================
+*/
+	void ParallelJobPool::Run (JobProc_t proc, void *param, uint maxHelpers)
+	{
+		ASSERT( proc != null );
+
+		if ( maxHelpers == 0 or _workers.Empty() or not _runLock.TryLock() )
+		{
+			proc( param );
+			return;
+		}
+
+		_lock.Lock();
+		_proc		= proc;
+		_param		= param;
+		_requested	= GXMath::Min( maxHelpers, ThreadCount() );
+		++_jobIndex;
+		_wakeUp.Broadcast();
+		_lock.Unlock();
+
+		proc( param );
+
+		// workers that have not joined yet must skip this job,
+		// wait for others because 'param' may be on the caller stack
+		_lock.Lock();
+		_requested = 0;
+
+		while ( _active > 0 ) {
+			_finished.Wait( _lock );
+		}
+
+		_proc	= null;
+		_param	= null;
+		_lock.Unlock();
+
+		_runLock.Unlock();
+	}
+
+/*
+=================================================
+	_WorkerProc
+=================================================
+*/
+	void ParallelJobPool::_WorkerProc (void *param)
+	{
+		Worker *			w			= Cast<Worker *>(param);
+		ParallelJobPool&	self		= *w->pool;
+		uint				last_job	= 0;
+
+		self._lock.Lock();
+
+		for (;;)
+		{
+			while ( self._looping and (self._jobIndex == last_job or self._requested == 0) ) {
+				self._wakeUp.Wait( self._lock );
+			}
+
+			if ( not self._looping )
+				break;
+
+			last_job = self._jobIndex;
+			--self._requested;
+			++self._active;
+
+			const JobProc_t	proc		= self._proc;
+			void *			job_param	= self._param;
+
+			self._lock.Unlock();
+
+			proc( job_param );
+
+			self._lock.Lock();
+
+			if ( --self._active == 0 )
+				self._finished.Signal();
+		}
+
+		self._lock.Unlock();
+	}
+
+
+}	// GXTypes
+}	// GX_STL
@@ -0,0 +1,134 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Shared data-parallel loop.
+	Work is distributed between persistent threads of 'ParallelJobPool',
+	so there is no thread creation per call.
+*/
+
+#pragma once
+
+#include "Core/STL/Containers/Array.h"
+#include "Core/STL/Types/UniquePtr.h"
+#include "Core/STL/ThreadSafe/Atomic.h"
+#include "Core/STL/OS/OSLowLevel.h"
+
+namespace GX_STL
+{
+namespace GXTypes
+{
+
+	//
+	// Parallel Job Pool
+	//
+
+	struct ParallelJobPool final : public Noncopyable
+	{
+	// types
+	public:
+		using JobProc_t	= void (*) (void *param);
+
+	private:
+		struct Worker
+		{
+			OS::Thread			thread;
+			ParallelJobPool *	pool	= null;
+			uint				index	= 0;
+		};
+
+
+	// variables
+	private:
+		Array< UniquePtr< Worker > >	_workers;
+
+		Mutex					_runLock;		// only one job at a time
+		Mutex					_lock;
+		OS::ConditionVariable	_wakeUp;
+		OS::ConditionVariable	_finished;
+
+		JobProc_t				_proc		= null;
+		void *					_param		= null;
+		uint					_jobIndex	= 0;
+		uint					_requested	= 0;	// number of workers that may join current job
+		uint					_active		= 0;	// number of workers that are executing current job
+		bool					_looping	= true;
+
+
+	// methods
+	public:
+		explicit ParallelJobPool (uint threadCount = 0);
+		~ParallelJobPool ();
+
+		void Run (JobProc_t proc, void *param, uint maxHelpers);
+
+		ND_ uint  ThreadCount ()	const	{ return uint(_workers.Count()); }
+
+		ND_ static ParallelJobPool&  Instance ();
+
+	private:
+		static void _WorkerProc (void *param);
+	};
+
+
+/*
+=================================================
+	ParallelFor
+----
+	calls 'fn( first, last )' for ranges of 'batchSize' elements,
+	ranges are distributed dynamically between threads of shared pool,
+	current thread is used as worker too.
+	Small arrays are processed in current thread only.
+	'maxThreads' is total number of threads including current,
+	zero means all pool threads.
+=================================================
+*/
+	template <typename Fn>
+	inline void ParallelFor (usize count, usize batchSize, usize minParallelCount, const Fn &fn, uint maxThreads = 0)
+	{
+		struct SharedData
+		{
+			Fn const*		fn;
+			usize			count;
+			usize			batchSize;
+			Atomic<usize>	next;
+
+			static void Run (void *param)
+			{
+				SharedData *	self = Cast<SharedData *>(param);
+
+				// 'Add' returns new value
+				for (usize last = self->next.Add( self->batchSize ); last - self->batchSize < self->count;
+					 last = self->next.Add( self->batchSize ))
+				{
+					(*self->fn)( last - self->batchSize, GXMath::Min( last, self->count ) );
+				}
+			}
+		};
+
+		ASSERT( batchSize > 0 );
+
+		if ( count == 0 )
+			return;
+
+		const usize	batch_count	= (count + batchSize-1) / batchSize;
+		usize		helpers		= batch_count - 1;
+
+		if ( maxThreads > 0 )
+			helpers = GXMath::Min( helpers, usize(maxThreads - 1) );
+
+		if ( helpers == 0 or count < minParallelCount )
+		{
+			fn( usize(0), count );
+			return;
+		}
+
+		SharedData	shared;
+		shared.fn			= &fn;
+		shared.count		= count;
+		shared.batchSize	= batchSize;
+
+		ParallelJobPool::Instance().Run( &SharedData::Run, &shared, uint(GXMath::Min( helpers, usize(MaxValue<uint>()) )) );
+	}
+
+
+}	// GXTypes
+}	// GX_STL
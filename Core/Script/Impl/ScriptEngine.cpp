@@ -17,6 +17,11 @@ namespace GXScript
 	{
 		using namespace AngelScript;
 
+		// memory functions must be set before any engine is created
+		#ifdef GX_MEMORY_TRACKING
+			asSetGlobalMemoryFunctions( &_Allocate, &_Deallocate );
+		#endif
+
 		_engine = asCreateScriptEngine( ANGELSCRIPT_VERSION );
 
 		_engine->SetMessageCallback( asFUNCTION( _MessageCallback ), 0, asCALL_CDECL );
@@ -85,6 +90,23 @@ namespace GXScript
 		_objects.Add( obj );
 	}
 	
+/*
+=================================================
+	_Allocate / _Deallocate
+----
+	used only when memory tracking enabled
+=================================================
+*/
+	void* ScriptEngine::_Allocate (size_t size)
+	{
+		return MemoryTracker::Allocate( size, EMemorySubsystem::Scripts );
+	}
+
+	void  ScriptEngine::_Deallocate (void *ptr)
+	{
+		MemoryTracker::Deallocate( ptr );
+	}
+
 /*
 =================================================
 	_MessageCallback
@@ -100,6 +100,9 @@ namespace GXScript
 
 	private:
 		static void _MessageCallback (const AngelScript::asSMessageInfo *msg, void *param);
+
+		static void* _Allocate (size_t size);
+		static void  _Deallocate (void *ptr);
 	};
 	
 
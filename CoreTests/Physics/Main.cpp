@@ -5,6 +5,7 @@
 
 extern void Test_Dimensions_PhysicsValue ();
 extern void Test_Algorithms_Orbit ();
+extern void Test_Algorithms_Batch ();
 
 using namespace GX_STL;
 using namespace GX_STL::GXTypes;
@@ -19,6 +20,7 @@ int main ()
 	Test_Dimensions_PhysicsValue();
 
 	Test_Algorithms_Orbit();
+	Test_Algorithms_Batch();
 	
 	LOG( "Tests Finished!", ELog::Info );
 
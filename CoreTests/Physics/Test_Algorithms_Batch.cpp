@@ -0,0 +1,142 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CoreTests/Physics/Common.h"
+#include "Core/Physics/Dimensions/DefaultTypes.h"
+
+using namespace GXPhysics;
+using namespace GXPhysics::Astrophysics;
+
+
+// large enough for parallel update
+static constexpr usize	BatchCount = 100003;
+
+
+template <typename T>
+static bool NearlyEquals (const T &a, const T &b, const T &scale)
+{
+	return Abs( a.ref() - b.ref() ) <= Abs( scale.ref() ) * 1.0e-4_r;
+}
+
+
+static void TestOrbitBatch ()
+{
+	Array< Orbit<real> >	orbits;
+	OrbitBatch<real>		batch;
+
+	orbits.Resize( BatchCount );
+	batch.Reserve( orbits.Count() );
+
+	FOR( i, orbits )
+	{
+		Orbit<real>&	o = orbits[i];
+		const real		k = real(i % 1000) / 1000.0_r;
+
+		o.semiMajorAxis	= AstronomicalUnits( 0.5_r + k * 30.0_r );
+		o.orbitalPeriod	= i % 997 == 0 ? Days() : Days( 80.0_r + k * 60000.0_r );
+		o.longOfAscNode	= (Rad) Deg( k * 360.0_r );
+		o.inclination	= (Rad) Deg( real(i % 17) );
+		o.perihelionArg	= (Rad) Deg( 360.0_r - k * 360.0_r );
+		o.eccentricity	= real(i % 9) * 0.02_r;
+		o.startTime		= Days( real(i % 365) );
+
+		TEST( batch.Add( o ) == i );
+	}
+
+	const Days	times[] = { Days( 0.0_r ), Days( 17.5_r ), Days( 36525.0_r ) };
+
+	for (auto& t : times)
+	{
+		batch.Update( t );
+
+		FOR( i, orbits )
+		{
+			Orbit<real>&	o = orbits[i];
+			o.Update( t );
+
+			const auto	pos = batch.Position( i );
+
+			TEST( NearlyEquals( pos.x, o.position.x, o.semiMajorAxis ) );
+			TEST( NearlyEquals( pos.y, o.position.y, o.semiMajorAxis ) );
+			TEST( NearlyEquals( pos.z, o.position.z, o.semiMajorAxis ) );
+		}
+	}
+}
+
+
+static void TestAxialRotationBatch ()
+{
+	Array< AxialRotation<real> >	rotations;
+	AxialRotationBatch<real>		batch;
+
+	rotations.Resize( BatchCount );
+
+	FOR( i, rotations )
+	{
+		rotations[i] = AxialRotation<real>( (Rad) Deg( real(i % 90) ), Days( 0.1_r + real(i % 500) ) );
+		batch.Add( rotations[i] );
+	}
+
+	const Days	time{ 123.4_r };
+
+	batch.Update( time );
+
+	FOR( i, rotations )
+	{
+		rotations[i].Update( time );
+		TEST( Equals( batch.Angle( i ).ref(), rotations[i].angle.ref() ) );
+	}
+}
+
+
+static void TestAcceleratedMotionBatch ()
+{
+	using Batch_t = AcceleratedMotionBatch< Meters, MetersPerSeconds, MetersPerSquareSeconds >;
+
+	Batch_t								batch;
+	Array< Meters3 >					pos;
+	Array< MetersPerSeconds3 >			vel;
+	Array< MetersPerSquareSeconds3 >	accel;
+
+	pos.Resize( BatchCount );
+	vel.Resize( BatchCount );
+	accel.Resize( BatchCount );
+
+	FOR( i, pos )
+	{
+		const real	k = real(i % 100);
+
+		pos[i]		= Meters3( Meters( k ), Meters( -k ), Meters( k * 10.0_r ) );
+		vel[i]		= MetersPerSeconds3( MetersPerSeconds( 1.0_r ), MetersPerSeconds( k ), MetersPerSeconds( -2.0_r ) );
+		accel[i]	= MetersPerSquareSeconds3( MetersPerSquareSeconds( 0.0_r ), MetersPerSquareSeconds( -9.8_r ), MetersPerSquareSeconds( k * 0.1_r ) );
+
+		batch.Add( pos[i], vel[i], accel[i] );
+	}
+
+	const Seconds	dt{ 0.016_r };
+
+	for (uint step = 0; step < 4; ++step)
+	{
+		batch.Integrate( dt );
+
+		FOR( i, pos )
+		{
+			for (uint j = 0; j < 3; ++j) {
+				UniformlyAcceleratedMotion( INOUT pos[i][j], INOUT vel[i][j], accel[i][j], dt );
+			}
+		}
+	}
+
+	FOR( i, pos )
+	{
+		TEST( All( Equals( batch.Position( i ), pos[i] )) );
+		TEST( All( Equals( batch.Velocity( i ), vel[i] )) );
+	}
+}
+
+
+extern void Test_Algorithms_Batch ()
+{
+	TestOrbitBatch();
+	TestAxialRotationBatch();
+	TestAcceleratedMotionBatch();
+}
@@ -36,6 +36,7 @@ extern void Test_Containers_Pool ();
 extern void Test_Math_Abs ();
 extern void Test_Math_Color ();
 extern void Test_Math_ColorFormat ();
+extern void Test_Math_ColorBatchConverter ();
 extern void Test_Math_ImageUtils ();
 extern void Test_Math_Transform ();
 extern void Test_Math_Factorial ();
@@ -59,8 +60,14 @@ extern void Test_Algorithms_InvokeWithVariant ();
 extern void Test_Algorithms_Range ();
 
 extern void Test_OS_Atomic ();
+extern void Test_OS_CpuTopology ();
 extern void Test_OS_Date ();
 extern void Test_OS_FileSystem ();
+extern void Test_OS_ParallelFor ();
+
+extern void Test_Files_ChunkedFile ();
+
+extern void Test_Memory_MemoryTracker ();
 
 extern void Test_Temp ();
 
@@ -101,6 +108,7 @@ int main ()
 	Test_Math_Abs();
 	Test_Math_Color();
 	Test_Math_ColorFormat();
+	Test_Math_ColorBatchConverter();
 	Test_Math_ImageUtils();
 	Test_Math_Transform();
 	Test_Math_Factorial();
@@ -124,8 +132,14 @@ int main ()
 	Test_Algorithms_Range();
 
 	Test_OS_Atomic();
+	Test_OS_CpuTopology();
 	Test_OS_Date();
 	Test_OS_FileSystem();
+	Test_OS_ParallelFor();
+
+	Test_Files_ChunkedFile();
+
+	Test_Memory_MemoryTracker();
 	
 	LOG( "Tests Finished!", ELog::Info );
 
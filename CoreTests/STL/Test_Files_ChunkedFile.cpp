@@ -0,0 +1,143 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CoreTests/STL/Common.h"
+#include "Core/STL/Files/ChunkedFile.h"
+
+using namespace GX_STL;
+using namespace GX_STL::GXTypes;
+using namespace GX_STL::GXFile;
+
+
+static void GenData (usize size, OUT BinaryArray &data)
+{
+	data.Resize( size );
+
+	// partially compressible data
+	FOR( i, data ) {
+		data[i] = ubyte( (i * 7) ^ (i >> 9) );
+	}
+}
+
+
+static void TestRoundTrip (EChunkCodec::type codec)
+{
+	BinaryArray		data;
+	GenData( 1000 * 1000 + 123, OUT data );
+
+	ChunkedWFilePtr	wfile = ChunkedWFile::New();
+	TEST( wfile->Write( BinArrayCRef(data) ) );
+
+	MemWFilePtr		packed = MemWFile::New();
+	TEST( wfile->Save( packed, codec, 64_Kb, 4 ) );
+
+	MemRFilePtr		mfile = MemRFile::New();
+	TEST( mfile->CreateFromMemWFile( packed, MemRFile::EFlag::MOVE ) );
+
+	ChunkedRFilePtr	rfile = ChunkedRFile::New( mfile, 4 );
+	TEST( rfile );
+	TEST( rfile->Size() == data.Size() );
+	TEST( rfile->ChunkCount() == (data.Count() + 64*1024 - 1) / (64*1024) );
+
+	// read all
+	BinaryArray		unpacked;
+	unpacked.Resize( data.Count() );
+
+	TEST( rfile->Read( BinArrayRef(unpacked) ) );
+	TEST( unpacked == data );
+
+	// random access
+	const usize	offsets[]	= { 0, 10, 65535, 65536, 100000, 500000, data.Count() - 100 };
+	const usize	sizes[]		= { 1, 100, 2, 70000, 300000, 1 };
+
+	for (usize off : offsets)
+	{
+		for (usize sz : sizes)
+		{
+			sz = GXMath::Min( sz, data.Count() - off );
+
+			unpacked.Resize( sz );
+			TEST( rfile->SeekSet( BytesU(off) ) );
+			TEST( rfile->Read( BinArrayRef(unpacked) ) );
+			TEST( BinArrayCRef(unpacked) == BinArrayCRef(data).SubArray( off, sz ) );
+		}
+	}
+}
+
+
+static bool OpenModified (const BinaryArray &packed, void (*modify) (INOUT BinaryArray &))
+{
+	BinaryArray		data = packed;
+	modify( INOUT data );
+
+	MemRFilePtr		mfile = MemRFile::New();
+	TEST( mfile->CreateFromArray( data, MemRFile::EFlag::MOVE ) );
+
+	return ChunkedRFile::New( mfile ).IsNotNull();
+}
+
+
+static void TestMalformedChunkTable ()
+{
+	using Header_t		= ChunkedRFile::Header_t;
+	using ChunkInfo_t	= ChunkedRFile::ChunkInfo_t;
+
+	BinaryArray		data;
+	GenData( 5 * 1024 + 100, OUT data );
+
+	ChunkedWFilePtr	wfile = ChunkedWFile::New();
+	TEST( wfile->Write( BinArrayCRef(data) ) );
+
+	MemWFilePtr		packed_file = MemWFile::New();
+	TEST( wfile->Save( packed_file, EChunkCodec::None, 1_Kb ) );
+
+	MemRFilePtr		mfile = MemRFile::New();
+	TEST( mfile->CreateFromMemWFile( packed_file, MemRFile::EFlag::MOVE ) );
+
+	const BinaryArray	packed = mfile->GetData();
+
+	struct Util {
+		static Header_t&	Header (BinaryArray &arr)				{ return *Cast<Header_t *>( arr.ptr() ); }
+		static ChunkInfo_t&	Chunk (BinaryArray &arr, usize i)		{ return Cast<ChunkInfo_t *>( arr.ptr() + sizeof(Header_t) )[i]; }
+	};
+
+	TEST( OpenModified( packed, [] (BinaryArray &) {} ) );
+
+	// chunk in the middle is not full
+	TEST( not OpenModified( packed, [] (BinaryArray &arr) { Util::Chunk( arr, 2 ).uncompressedSize -= 1; } ));
+
+	// last chunk is larger than remaining size
+	TEST( not OpenModified( packed, [] (BinaryArray &arr) { Util::Chunk( arr, 5 ).uncompressedSize = 1024; } ));
+
+	// overlapped chunks
+	TEST( not OpenModified( packed, [] (BinaryArray &arr) { Util::Chunk( arr, 3 ).offset -= 1; } ));
+
+	// offset goes backwards
+	TEST( not OpenModified( packed, [] (BinaryArray &arr) { Util::Chunk( arr, 4 ).offset = 0; } ));
+
+	// compressed data is out of file
+	TEST( not OpenModified( packed, [] (BinaryArray &arr) { Util::Chunk( arr, 5 ).offset += 1000; } ));
+
+	// truncated file
+	TEST( not OpenModified( packed, [] (BinaryArray &arr) { arr.Resize( arr.Count() - 10 ); } ));
+
+	// chunk count doesn't match uncompressed size
+	TEST( not OpenModified( packed, [] (BinaryArray &arr) { Util::Header( arr ).uncompressedSize += 1024; } ));
+
+	// chunk table is larger than file
+	TEST( not OpenModified( packed, [] (BinaryArray &arr) { Util::Header( arr ).chunkCount = 1 << 30;  Util::Header( arr ).uncompressedSize = ulong(1) << 40; } ));
+}
+
+
+extern void Test_Files_ChunkedFile ()
+{
+	TestMalformedChunkTable();
+
+	TestRoundTrip( EChunkCodec::None );
+
+	#ifdef GX_ENABLE_LZ4
+		TestRoundTrip( EChunkCodec::LZ4 );
+	#endif
+	#ifdef GX_ENABLE_MINIZ
+		TestRoundTrip( EChunkCodec::MiniZ );
+	#endif
+}
@@ -0,0 +1,256 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CoreTests/STL/Common.h"
+#include "Core/STL/Math/Color/ColorBatchConverter.h"
+
+using namespace GX_STL;
+using namespace GX_STL::GXTypes;
+using namespace GX_STL::GXMath;
+using namespace GX_STL::GXMath::ColorFormat;
+using namespace GX_STL::GXMath::ColorFormatUtils;
+
+
+// odd count to test tail processing
+static constexpr usize	BatchCount = 1003;
+
+
+static uint NextRandom (INOUT uint &seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return seed;
+}
+
+
+static bool BitEqual (const float4 &a, const float4 &b)
+{
+	return	ReferenceCast<uint>(a.x) == ReferenceCast<uint>(b.x) and
+			ReferenceCast<uint>(a.y) == ReferenceCast<uint>(b.y) and
+			ReferenceCast<uint>(a.z) == ReferenceCast<uint>(b.z) and
+			ReferenceCast<uint>(a.w) == ReferenceCast<uint>(b.w);
+}
+
+
+static void ColorBatch_RGBA8 ()
+{
+	Array< RGBA8_UNorm >	src;	src.Resize( BatchCount );
+	Array< RGBA8_UNorm >	dst;	dst.Resize( BatchCount );
+	Array< float4 >			fdst;	fdst.Resize( BatchCount );
+
+	FOR( i, src ) {
+		src[i] = RGBA8_UNorm( ubyte(i), ubyte(i * 7), ubyte(255 - i), ubyte(i * 13) );
+	}
+
+	ColorBatchConverter::RGBA8UNormToRGBA32f( src.ptr(), src.Count(), OUT fdst.ptr() );
+
+	FOR( i, src )
+	{
+		RGBA32f	ref;
+		ColorFormatConverter::Convert( OUT ref, src[i] );
+		TEST( BitEqual( fdst[i], float4(ref) ) );
+	}
+
+	ColorBatchConverter::RGBA32fToRGBA8UNorm( fdst.ptr(), fdst.Count(), OUT dst.ptr() );
+
+	FOR( i, src ) {
+		TEST( src[i] == dst[i] );
+	}
+
+	ColorBatchConverter::SwapRB( src.ptr(), src.Count(), OUT dst.ptr() );
+
+	FOR( i, src ) {
+		TEST( dst[i] == RGBA8_UNorm( src[i].b, src[i].g, src[i].r, src[i].a ) );
+	}
+
+	// in-place
+	ColorBatchConverter::SwapRB( dst.ptr(), dst.Count(), OUT dst.ptr() );
+
+	FOR( i, src ) {
+		TEST( src[i] == dst[i] );
+	}
+}
+
+
+static void ColorBatch_FloatToRGBA8 ()
+{
+	Array< float4 >			src;	src.Resize( BatchCount );
+	Array< RGBA8_UNorm >	dst;	dst.Resize( BatchCount );
+	uint					seed = 1;
+
+	// rounding boundaries and out of range values,
+	// negative values are not tested, scalar converter clamps them as unsigned
+	FOR( i, src )
+	{
+		const float	a = float(i % 256) / 255.0f;
+		const float	b = (float(i % 256) + 0.5f) / 255.0f;
+		const float	c = float(NextRandom( seed ) % 100000) * 1.0e-4f;
+		const float	d = float(NextRandom( seed ) % 1000) * 0.01f;
+
+		src[i] = float4( a, b, c, d );
+	}
+
+	ColorBatchConverter::RGBA32fToRGBA8UNorm( src.ptr(), src.Count(), OUT dst.ptr() );
+
+	FOR( i, src )
+	{
+		RGBA8_UNorm	ref;
+		ColorFormatConverter::Convert( OUT ref, RGBA32f{ src[i] } );
+		TEST( ref == dst[i] );
+	}
+}
+
+
+static void ColorBatch_SRGB ()
+{
+	Array< RGBA8_UNorm >	src;	src.Resize( BatchCount );
+	Array< RGBA8_UNorm >	dst;	dst.Resize( BatchCount );
+	Array< float4 >			fdst;	fdst.Resize( BatchCount );
+
+	FOR( i, src ) {
+		src[i] = RGBA8_UNorm( ubyte(i), ubyte(i * 3), ubyte(i * 5), ubyte(i * 11) );
+	}
+
+	ColorBatchConverter::SRGB8ToRGBA32f( src.ptr(), src.Count(), OUT fdst.ptr() );
+
+	FOR( i, src )
+	{
+		RGBA32f	col;
+		ColorFormatConverter::Convert( OUT col, src[i] );
+
+		float4	ref = ColorUtils::FromSRGB( float4(col) );
+		ref.w = col.a;
+
+		TEST( BitEqual( fdst[i], ref ) );
+	}
+
+	ColorBatchConverter::RGBA32fToSRGB8( fdst.ptr(), fdst.Count(), OUT dst.ptr() );
+
+	FOR( i, fdst )
+	{
+		float4	col = ColorUtils::ToSRGB( fdst[i] );
+		col.w = fdst[i].w;
+
+		RGBA8_UNorm	ref;
+		ColorFormatConverter::Convert( OUT ref, RGBA32f{ col } );
+		TEST( ref == dst[i] );
+	}
+}
+
+
+static void ColorBatch_Half ()
+{
+	// all half values
+	Array< half >	hsrc;	hsrc.Resize( 1 << 16 );
+	Array< float >	fdst;	fdst.Resize( hsrc.Count() );
+
+	FOR( i, hsrc ) {
+		ReferenceCast<ushort>( hsrc[i] ) = ushort(i);
+	}
+
+	ColorBatchConverter::HalfToFloat( hsrc.ptr(), hsrc.Count(), OUT fdst.ptr() );
+
+	FOR( i, hsrc ) {
+		TEST( ReferenceCast<uint>( fdst[i] ) == ReferenceCast<uint>( hsrc[i].Get() ) );
+	}
+
+	// random bit patterns, includes denormalized values, Inf and NaN
+	Array< float >	fsrc;	fsrc.Resize( BatchCount * 64 );
+	Array< half >	hdst;	hdst.Resize( fsrc.Count() );
+	uint			seed = 7;
+
+	FOR( i, fsrc )
+	{
+		uint	bits = NextRandom( seed );
+
+		// most values in half range
+		if ( i & 1 )
+			bits = (bits & 0x83FFFFFF) | 0x38000000;
+
+		ReferenceCast<uint>( fsrc[i] ) = bits;
+	}
+
+	ColorBatchConverter::FloatToHalf( fsrc.ptr(), fsrc.Count(), OUT hdst.ptr() );
+
+	FOR( i, fsrc )
+	{
+		half	ref;	ref.Set( fsrc[i] );
+		TEST( ReferenceCast<ushort>( hdst[i] ) == ReferenceCast<ushort>( ref ) );
+	}
+}
+
+
+static void ColorBatch_R11G11B10F ()
+{
+	Array< r11g11b10f_t >	src;	src.Resize( BatchCount * 16 );
+	Array< r11g11b10f_t >	dst;	dst.Resize( src.Count() );
+	Array< float4 >			fdst;	fdst.Resize( src.Count() );
+	uint					seed = 3;
+
+	FOR( i, src ) {
+		ReferenceCast<uint>( src[i] ) = NextRandom( seed );
+	}
+
+	ColorBatchConverter::R11G11B10fToRGBA32f( src.ptr(), src.Count(), OUT fdst.ptr() );
+
+	FOR( i, src )
+	{
+		const half3		c = src[i];
+		TEST( BitEqual( fdst[i], float4( float(c.x), float(c.y), float(c.z), 1.0f ) ));
+	}
+
+	// positive finite values only
+	FOR( i, fdst )
+	{
+		fdst[i] = float4( float(NextRandom( seed ) % 100000) * 1.0e-3f,
+						  float(NextRandom( seed ) % 100000) * 1.0e-7f,
+						  float(NextRandom( seed ) % 1000),
+						  0.0f );
+	}
+
+	ColorBatchConverter::RGBA32fToR11G11B10f( fdst.ptr(), fdst.Count(), OUT dst.ptr() );
+
+	FOR( i, fdst )
+	{
+		const r11g11b10f_t	ref( fdst[i].x, fdst[i].y, fdst[i].z );
+		TEST( ReferenceCast<uint>( dst[i] ) == ReferenceCast<uint>( ref ) );
+	}
+}
+
+
+static void ColorBatch_RGB9E5 ()
+{
+	Array< rgb9_e5_t >	src;	src.Resize( BatchCount * 16 );
+	Array< rgb9_e5_t >	dst;	dst.Resize( src.Count() );
+	Array< float4 >		fdst;	fdst.Resize( src.Count() );
+	uint				seed = 5;
+
+	FOR( i, src ) {
+		ReferenceCast<uint>( src[i] ) = NextRandom( seed );
+	}
+
+	ColorBatchConverter::RGB9E5ToRGBA32f( src.ptr(), src.Count(), OUT fdst.ptr() );
+
+	FOR( i, src )
+	{
+		const float3	c = src[i];
+		TEST( BitEqual( fdst[i], float4( c.x, c.y, c.z, 1.0f ) ));
+	}
+
+	ColorBatchConverter::RGBA32fToRGB9E5( fdst.ptr(), fdst.Count(), OUT dst.ptr() );
+
+	FOR( i, fdst )
+	{
+		const rgb9_e5_t	ref( fdst[i].x, fdst[i].y, fdst[i].z );
+		TEST( ReferenceCast<uint>( dst[i] ) == ReferenceCast<uint>( ref ) );
+	}
+}
+
+
+extern void Test_Math_ColorBatchConverter ()
+{
+	ColorBatch_RGBA8();
+	ColorBatch_FloatToRGBA8();
+	ColorBatch_SRGB();
+	ColorBatch_Half();
+	ColorBatch_R11G11B10F();
+	ColorBatch_RGB9E5();
+}
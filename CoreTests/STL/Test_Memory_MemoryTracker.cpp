@@ -0,0 +1,87 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CoreTests/STL/Common.h"
+#include "Core/STL/Memory/MemoryTracker.h"
+
+using namespace GX_STL;
+using namespace GX_STL::GXTypes;
+
+
+static MemoryTracker::Statistic  GetStat (EMemorySubsystem::type subsystem)
+{
+	MemoryTracker::Statistic	stat;
+	TEST( MemoryTracker::GetStatistic( subsystem, OUT stat ) );
+	return stat;
+}
+
+
+static void TestCounters ()
+{
+	const auto	subsystem	= EMemorySubsystem::Scripts;
+	const auto	before		= GetStat( subsystem );
+
+	void*	ptr0 = MemoryTracker::Allocate( 100, subsystem );
+	void*	ptr1 = MemoryTracker::Allocate( 1000, subsystem );
+
+	TEST( ptr0 != null and ptr1 != null );
+	TEST( (usize(ptr0) & 0xF) == 0 );
+
+	const auto	live = GetStat( subsystem );
+	TEST( live.liveBytes == before.liveBytes + 1100 );
+	TEST( live.peakBytes >= live.liveBytes );
+	TEST( live.allocCount == before.allocCount + 2 );
+
+	MemoryTracker::Deallocate( ptr0 );
+	MemoryTracker::Deallocate( ptr1 );
+
+	const auto	after = GetStat( subsystem );
+	TEST( after.liveBytes == before.liveBytes );
+	TEST( after.peakBytes == live.peakBytes );
+	TEST( after.freeCount == before.freeCount + 2 );
+}
+
+
+static void TestScope ()
+{
+	TEST( MemoryTracker::CurrentSubsystem() == EMemorySubsystem::Containers );
+	{
+		MemoryTracker::ScopedSubsystem	scope{ EMemorySubsystem::ShaderCompiler };
+		TEST( MemoryTracker::CurrentSubsystem() == EMemorySubsystem::ShaderCompiler );
+
+		const auto	before	= GetStat( EMemorySubsystem::ShaderCompiler );
+		void*		ptr		= MemoryTracker::Allocate( 64 );
+
+		TEST( GetStat( EMemorySubsystem::ShaderCompiler ).liveBytes == before.liveBytes + 64 );
+		MemoryTracker::Deallocate( ptr );
+	}
+	TEST( MemoryTracker::CurrentSubsystem() == EMemorySubsystem::Containers );
+}
+
+
+static void TestBudget ()
+{
+	const auto	subsystem = EMemorySubsystem::GpuHostMemory;
+
+	MemoryTracker::SetBudget( subsystem, GetStat( subsystem ).liveBytes + 256 );
+
+	// must write warning once
+	void*	ptr0 = MemoryTracker::Allocate( 200, subsystem );
+	void*	ptr1 = MemoryTracker::Allocate( 200, subsystem );
+	void*	ptr2 = MemoryTracker::Allocate( 200, subsystem );
+
+	MemoryTracker::Deallocate( ptr0 );
+	MemoryTracker::Deallocate( ptr1 );
+	MemoryTracker::Deallocate( ptr2 );
+
+	MemoryTracker::SetBudget( subsystem, 0 );
+}
+
+
+extern void Test_Memory_MemoryTracker ()
+{
+	TestCounters();
+	TestScope();
+	TestBudget();
+
+	LOG( "Test_Memory_MemoryTracker - OK", ELog::Info );
+}
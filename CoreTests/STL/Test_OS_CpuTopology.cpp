@@ -0,0 +1,60 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CoreTests/STL/Common.h"
+
+using namespace GX_STL;
+using namespace GX_STL::GXTypes;
+using namespace GX_STL::GXMath;
+
+
+static void CpuTopology_Test1 ()
+{
+	OS::CpuTopology const&	topology = OS::CpuTopology::Get();
+
+	TEST( topology.LogicalCoreCount() > 0 );
+	TEST( topology.PhysicalCoreCount() > 0 );
+	TEST( topology.LogicalCoreCount() >= topology.PhysicalCoreCount() );
+	TEST( topology.NumaNodeCount() > 0 );
+
+	for (auto& lc : topology.logicalCores)
+	{
+		TEST( lc.coreIndex < topology.PhysicalCoreCount() );
+		TEST( topology.physicalCores[ lc.coreIndex ].siblings.Get( lc.index ) );
+		TEST( topology.AllCores().Get( lc.index ) );
+	}
+
+	// index must be wrapped
+	TEST( topology.GetCoreMask( 0 ) == topology.GetCoreMask( topology.PhysicalCoreCount() ) );
+	TEST( topology.GetLogicalCoreMask( 0 ).IsNotZero() );
+
+	DEBUG_CONSOLE( topology.ToString().cstr() );
+}
+
+
+static void CpuTopology_Test2 ()
+{
+	OS::CpuTopology const&	topology = OS::CpuTopology::Get();
+	OS::CpuMask_t			prev;
+
+	if ( not OS::CpuTopology::GetCurrentThreadAffinity( OUT prev ) )
+		return;	// not supported
+
+	const OS::CpuMask_t		mask = topology.GetCoreMask( topology.PhysicalCoreCount()-1 );
+
+	if ( OS::CpuTopology::SetCurrentThreadAffinity( mask ) )
+	{
+		OS::CurrentThread::Yield();
+
+		const uint	cpu = OS::CpuTopology::GetCurrentCpu();
+		TEST( cpu == OS::CpuTopology::UNKNOWN or mask.Get( cpu ) );
+	}
+
+	TEST( OS::CpuTopology::SetCurrentThreadAffinity( prev ) );
+}
+
+
+extern void Test_OS_CpuTopology ()
+{
+	CpuTopology_Test1();
+	CpuTopology_Test2();
+}
@@ -0,0 +1,98 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CoreTests/STL/Common.h"
+
+using namespace GX_STL;
+using namespace GX_STL::GXTypes;
+using namespace GX_STL::GXMath;
+
+
+static void ParallelFor_Test1 ()
+{
+	// each element must be processed exactly once
+	const usize	counts[] = { 0, 1, 7, 1000, 100003 };
+
+	for (auto count : counts)
+	{
+		Array< uint >	data;
+		data.Resize( count );
+
+		for (auto& d : data) {
+			d = 0;
+		}
+
+		ParallelFor( count, 64, 0,
+			[&data] (usize first, usize last)
+			{
+				TEST( first < last and last <= data.Count() );
+
+				for (usize i = first; i < last; ++i) {
+					++data[i];
+				}
+			});
+
+		FOR( i, data ) {
+			TEST( data[i] == 1 );
+		}
+	}
+}
+
+
+static void ParallelFor_Test2 ()
+{
+	// small arrays are processed in current thread by single call
+	uint	calls = 0;
+
+	ParallelFor( 100, 1, 1000,
+		[&calls] (usize first, usize last)
+		{
+			TEST( first == 0 and last == 100 );
+			++calls;
+		});
+
+	TEST( calls == 1 );
+}
+
+
+static void ParallelFor_Test3 ()
+{
+	// nested call must not deadlock
+	Atomic<usize>	sum{ 0 };
+
+	ParallelFor( 64, 1, 0,
+		[&sum] (usize first, usize last)
+		{
+			for (usize i = first; i < last; ++i)
+			{
+				ParallelFor( 100, 10, 0,
+					[&sum] (usize f, usize l) { sum.Add( l - f ); });
+			}
+		});
+
+	TEST( sum.Get() == 64 * 100 );
+}
+
+
+static void ParallelFor_Test4 ()
+{
+	// pool must be reused many times
+	Atomic<usize>	sum{ 0 };
+
+	for (uint j = 0; j < 1000; ++j)
+	{
+		ParallelFor( 256, 4, 0,
+			[&sum] (usize first, usize last) { sum.Add( last - first ); },
+			2 );
+	}
+
+	TEST( sum.Get() == 1000 * 256 );
+}
+
+
+extern void Test_OS_ParallelFor ()
+{
+	ParallelFor_Test1();
+	ParallelFor_Test2();
+	ParallelFor_Test3();
+	ParallelFor_Test4();
+}
@@ -183,6 +183,10 @@ namespace Base
 */
 	bool FileDataInput::_ReadMemRange (const DSMsg::ReadMemRange &msg)
 	{
+		if ( msg.hasPosition ) {
+			CHECK( _file->SeekSet( msg.position ) );
+		}
+
 		BytesU	readn = _file->ReadBuf( msg.writableBuffer->RawPtr(), msg.writableBuffer->Size() );
 		
 		msg.result.Set( msg.writableBuffer->SubArray( 0, usize(readn) ) );
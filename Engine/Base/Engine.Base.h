@@ -10,6 +10,7 @@
 
 #include "Engine/Base/Public/TaskModule.h"
 #include "Engine/Base/Tasks/AsyncTask.h"
+#include "Engine/Base/Tasks/JobScheduler.h"
 
 #include "Engine/Base/Public/ParallelThread.h"
 
@@ -90,7 +90,7 @@ namespace Base
 		_SubscribeOnMsg( this, &MainSystem::_DetachModule_Impl );
 		_SubscribeOnMsg( this, &MainSystem::_FindModule_Impl );
 		_SubscribeOnMsg( this, &MainSystem::_ModulesDeepSearch_Impl );
-		_SubscribeOnMsg( this, &MainSystem::_Update_Impl );
+		_SubscribeOnMsg( this, &MainSystem::_Update );
 		_SubscribeOnMsg( this, &MainSystem::_Link_Impl );
 		_SubscribeOnMsg( this, &MainSystem::_Compose_Impl );
 		_SubscribeOnMsg( this, &MainSystem::_Delete );
@@ -140,6 +140,21 @@ namespace Base
 		return true;
 	}
 
+/*
+=================================================
+	_Update
+----
+	main system is updated once per frame,
+	so it is used as frame boundary for profiler
+=================================================
+*/
+	bool MainSystem::_Update (const ModuleMsg::Update &msg)
+	{
+		CpuProfiler::FrameMark();
+
+		return _Update_Impl( msg );
+	}
+
 /*
 =================================================
 	_CreateThreadManager
@@ -64,6 +64,7 @@ namespace Base
 	// message handlers
 	private:
 		bool _Delete (const ModuleMsg::Delete &);
+		bool _Update (const ModuleMsg::Update &);
 
 	private:
 		void _Create () noexcept;
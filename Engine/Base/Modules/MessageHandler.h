@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/Base/Common/BaseObject.h"
+#include "Engine/Base/Modules/ModuleAllocator.h"
 
 namespace Engine
 {
@@ -74,7 +75,8 @@ namespace Base
 			Callback_t		func	= null;
 		};
 
-		using HandlersMap_t		= MultiMap< HandlerKey, Handler >;
+		using HandlerPair_t		= Pair< HandlerKey, Handler >;
+		using HandlersMap_t		= MultiMap< HandlerKey, Handler, AutoDetectCopyStrategy< HandlerPair_t >::type, PooledMemoryContainer< HandlerPair_t > >;
 
 
 	// variables
@@ -3,6 +3,8 @@
 	using FixedMapRange_t	= MixedSizeArray< MessageHandler::Handler, 32 >;
 	using HandlerSearch		= MessageHandler::HandlerSearch;
 
+	GX_PROFILE_MODULE_ZONE( var_msg.GetValueTypeId().Name(), GetModuleID() );
+
 	FixedMapRange_t	temp;
 	{
 		auto&	handlers = _msgHandler._handlers;
@@ -4,6 +4,7 @@
 #include "Engine/Base/Public/TaskModule.h"
 #include "Engine/Base/Public/ParallelThread.h"
 #include "Engine/Base/Modules/ModuleAsyncTasks.h"
+#include "Engine/Base/Modules/ModuleRegistry.h"
 
 namespace Engine
 {
@@ -24,6 +25,7 @@ namespace Base
 		_moduleCfg( config ),
 		_supportedEvents( *eventTypes )
 	{
+		ModuleRegistry::Instance().Register( this );
 	}
 	
 /*
@@ -38,6 +40,8 @@ namespace Base
 		CHECK( _attachments.Empty() );
 		CHECK( _parents.Empty() );
 		CHECK( _manager.IsNull() );
+
+		ModuleRegistry::Instance().Unregister( this );
 	}
 	
 /*
@@ -83,24 +87,23 @@ namespace Base
 									  ((unit->GetModuleID() & TModID::_IDMask) == TModID::_ID) or
 										mustBeUniqueID;
 		
-		for (auto& attachment : _attachments)
+		// use indices instead of iterating all attachments
+		if ( not _moduleCfg.multiAttachment and _IsAttachedByID( unit ) )
 		{
-			if ( attachment.second == unit and not _moduleCfg.multiAttachment )
-			{
-				LOG( "module is already attached!", ELog::Warning );
-				return true;
-			}
-
-			if ( not name.Empty() and attachment.first == name )
-			{
-				RETURN_ERR( "module with name: \"" << name << "\" is already attached!" );
-			}
+			LOG( "module is already attached!", ELog::Warning );
+			return true;
+		}
 
-			if ( attachment.second->GetModuleID() == unit->GetModuleID() and must_be_unique )
-				RETURN_ERR( "module with ID '" << ToString( GModID::type(unit->GetModuleID()) ) << "' is alredy attached" );
+		if ( not name.Empty() and _nameIndex.IsExist( name ) )
+		{
+			RETURN_ERR( "module with name: \"" << name << "\" is already attached!" );
 		}
 
+		if ( must_be_unique and _idIndex.IsExist( unit->GetModuleID() ) )
+			RETURN_ERR( "module with ID '" << ToString( GModID::type(unit->GetModuleID()) ) << "' is alredy attached" );
+
 		_attachments.PushBack({ name, unit });
+		_AddToIndex( name, unit );
 
 		ModuleMsg::OnModuleAttached		on_attached{ this, name, unit };
 
@@ -141,6 +144,7 @@ namespace Base
 				_SendForEachAttachments( on_detached );
 				_SendUncheckedEvent( on_detached );
 
+				_RemoveFromIndex( _attachments[i].first, unit );
 				_attachments.Erase( i );
 				return true;
 			}
@@ -179,6 +183,7 @@ namespace Base
 			_SendForEachAttachments( on_detached );
 			_SendUncheckedEvent( on_detached );
 
+			_RemoveFromIndex( _attachments[i].first, _attachments[i].second );
 			_attachments.Erase( i );
 		}};
 
@@ -196,6 +201,66 @@ namespace Base
 		return true;
 	}
 
+/*
+=================================================
+	_AddToIndex
+=================================================
+*/
+	void Module::_AddToIndex (const ModuleName_t &name, const ModulePtr &unit)
+	{
+		if ( not name.Empty() )
+			_nameIndex.Add( name, unit );
+
+		_idIndex.Add( unit->GetModuleID(), unit );
+	}
+	
+/*
+=================================================
+	_RemoveFromIndex
+----
+	removes only one record for multi-attachment
+=================================================
+*/
+	void Module::_RemoveFromIndex (const ModuleName_t &name, const ModulePtr &unit)
+	{
+		if ( not name.Empty() )
+			_nameIndex.Erase( name );
+
+		usize	idx;
+		if ( _idIndex.FindFirstIndex( unit->GetModuleID(), OUT idx ) )
+		{
+			for (; idx < _idIndex.Count() and _idIndex[idx].first == unit->GetModuleID(); ++idx)
+			{
+				if ( _idIndex[idx].second == unit ) {
+					_idIndex.EraseByIndex( idx );
+					break;
+				}
+			}
+		}
+
+		// cache may contains detached module
+		_searchCache.Clear();
+	}
+	
+/*
+=================================================
+	_IsAttachedByID
+=================================================
+*/
+	bool Module::_IsAttachedByID (const ModulePtr &unit) const
+	{
+		usize	idx;
+		if ( not _idIndex.FindFirstIndex( unit->GetModuleID(), OUT idx ) )
+			return false;
+
+		for (; idx < _idIndex.Count() and _idIndex[idx].first == unit->GetModuleID(); ++idx)
+		{
+			if ( _idIndex[idx].second == unit )
+				return true;
+		}
+		return false;
+	}
+
 /*
 =================================================
 	_DetachAllAttachments
@@ -470,11 +535,27 @@ namespace Base
 */
 	bool Module::_FindAttachment (ArrayCRef<TypeId> messages, ArrayCRef<TypeId> events, OUT ModulePtr &result) const
 	{
+		const usize				key = _SignatureHash( messages, events );
+		SearchCache_t::iterator	iter;
+
+		// message handlers may be changed after attachment, so cached module must be validated
+		if ( _searchCache.Find( key, OUT iter ) )
+		{
+			if ( iter->second->SupportsAllMessages( messages ) and
+				 iter->second->GetSupportedEvents().HasAllTypes( events ) )
+			{
+				result = iter->second;
+				return true;
+			}
+			_searchCache.EraseByIter( iter );
+		}
+
 		for (auto& attachment : _attachments)
 		{
 			if ( attachment.second->SupportsAllMessages( messages ) and
 				 attachment.second->GetSupportedEvents().HasAllTypes( events ) )
 			{
+				_searchCache.Add( key, attachment.second );
 				result = attachment.second;
 				return true;
 			}
@@ -482,6 +563,27 @@ namespace Base
 		return false;
 	}
 	
+/*
+=================================================
+	_SignatureHash
+=================================================
+*/
+	usize Module::_SignatureHash (ArrayCRef<TypeId> messages, ArrayCRef<TypeId> events)
+	{
+		HashResult	hash = HashOf( messages.Count() );
+
+		for (auto& id : messages) {
+			hash += HashOf( id );
+		}
+
+		hash += HashOf( events.Count() );
+
+		for (auto& id : events) {
+			hash += HashOf( id );
+		}
+		return hash.Get();
+	}
+	
 /*
 =================================================
 	_FindParent
@@ -568,11 +670,10 @@ namespace Base
 	{
 		CHECK_ERR( _ownThread == ThreadID::GetCurrent() );
 
-		for (auto& attachment : _attachments)
-		{
-			if ( attachment.second->GetModuleID() == id )
-				return attachment.second;
-		}
+		usize	idx;
+		if ( _idIndex.FindFirstIndex( id, OUT idx ) )
+			return _idIndex[idx].second;
+
 		return null;
 	}
 	
@@ -585,11 +686,11 @@ namespace Base
 	{
 		CHECK_ERR( _ownThread == ThreadID::GetCurrent() );
 		
-		for (auto& attachment : _attachments)
-		{
-			if ( attachment.first == name )
-				return attachment.second;
-		}
+		NameIndex_t::const_iterator	iter;
+
+		if ( _nameIndex.Find( ModuleName_t(name), OUT iter ) )
+			return iter->second;
+
 		return null;
 	}
 	
@@ -643,9 +744,50 @@ namespace Base
 	_ModulesDeepSearch_Impl
 =================================================
 */
-	bool Module::_ModulesDeepSearch_Impl (const ModuleMsg::ModulesDeepSearch &)
+	bool Module::_ModulesDeepSearch_Impl (const ModuleMsg::ModulesDeepSearch &msg)
+	{
+		CHECK_ERR( msg.result );
+
+		// get candidates from global registry instead of walking through all graph,
+		// then check that candidate is ancestor or descendant of this module.
+		Array< ModulePtr >	candidates;
+
+		for (auto& id : msg.ids) {
+			ModuleRegistry::Instance().FindAll( id, INOUT candidates );
+		}
+
+		for (auto& mod : candidates)
+		{
+			if ( mod.RawPtr() == this )
+				continue;
+
+			if ( (msg.downDeep > 0 and mod->_IsAncestor( this, msg.downDeep )) or
+				 (msg.upDeep > 0 and _IsAncestor( mod.RawPtr(), msg.upDeep )) )
+			{
+				msg.result->PushBack( mod );
+			}
+		}
+		return true;
+	}
+	
+/*
+=================================================
+	_IsAncestor
+----
+	returns true if 'other' is parent of this module
+	on depth less or equal than 'maxDepth'.
+=================================================
+*/
+	bool Module::_IsAncestor (const Module *other, uint maxDepth) const
 	{
-		TODO( "" );
+		if ( maxDepth == 0 )
+			return false;
+
+		for (auto& parent : _parents)
+		{
+			if ( parent.RawPtr() == other or parent->_IsAncestor( other, maxDepth-1 ) )
+				return true;
+		}
 		return false;
 	}
 
@@ -7,6 +7,8 @@
 #include "Engine/Base/Public/ProfilingMessages.h"
 #include "Engine/Base/Common/BaseObject.h"
 #include "Engine/Base/Modules/MessageHandler.h"
+#include "Engine/Base/Modules/ModuleAllocator.h"
+#include "Engine/Base/Profiling/CpuProfiler.h"
 
 namespace Engine
 {
@@ -49,6 +51,9 @@ namespace Base
 		using ModuleName_t			= ModuleMsg::ModuleName_t;
 		using AttachedModules_t		= MixedSizeArray< Pair< ModuleName_t, ModulePtr >, 8 >;		//Array<Pair< ModuleName_t, ModulePtr >>;
 		using ParentModules_t		= MixedSizeSet< ModulePtr, 8 >;								//Set< ModulePtr >;
+		using NameIndex_t			= HashMap< ModuleName_t, ModulePtr >;
+		using IDIndex_t				= MultiHashMap< UntypedID_t, ModulePtr >;
+		using SearchCache_t			= HashMap< usize, ModulePtr >;								// messages and events signature -> attachment
 		using EHandlerPriority		= MessageHandler::EPriority;
 
 		template <typename ...Types>
@@ -93,6 +98,9 @@ namespace Base
 		ModulePtr				_manager;
 		ParentModules_t			_parents;
 		AttachedModules_t		_attachments;
+		NameIndex_t				_nameIndex;			// attachments by name, names are unique
+		IDIndex_t				_idIndex;			// attachments by module ID
+		mutable SearchCache_t	_searchCache;		// cached result of '_FindAttachment'
 		EState					_state;
 		const ThreadID			_ownThread;
 		const ModuleConfig		_moduleCfg;
@@ -155,6 +163,10 @@ namespace Base
 		ND_ EState				GetState ()					const	{ return _state; }
 		ND_ ThreadID			GetThreadID ()				const	{ return _ownThread; }
 
+		// modules are recycled by 'ModuleAllocator', use 'New<T>()' to create module
+		static void * operator new (size_t size) noexcept				{ return ModuleAllocator::Instance().Allocate( size ); }
+		static void   operator delete (void *ptr, size_t size) noexcept	{ ModuleAllocator::Instance().Deallocate( ptr, size ); }
+
 		
 	// hidden methods
 	protected:
@@ -222,6 +234,14 @@ namespace Base
 		bool _DetachSingle (const ModulePtr &unit);
 		bool _DetachMulti (const ModulePtr &unit);
 
+		void _AddToIndex (const ModuleName_t &name, const ModulePtr &unit);
+		void _RemoveFromIndex (const ModuleName_t &name, const ModulePtr &unit);
+		
+		ND_ bool _IsAttachedByID (const ModulePtr &unit) const;
+		ND_ bool _IsAncestor (const Module *other, uint maxDepth) const;
+
+		ND_ static usize _SignatureHash (ArrayCRef<TypeId> messages, ArrayCRef<TypeId> events);
+
 
 	// message handlers with implementation
 	protected:
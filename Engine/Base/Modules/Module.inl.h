@@ -30,7 +30,15 @@ namespace Base
 	{
         STATIC_ASSERT( typename MsgT::__is_message(true) );
 		
-		GX_PROFILE_MSG( _SendUncheckedEvent( ProfilingMsg::OnSendMsg{ this, msg }) );
+		// event handlers are not thread safe, so event is sent only from own thread
+		GX_PROFILE_MSG(
+			const bool	is_async = (_ownThread != ThreadID::GetCurrent());
+
+			if ( not is_async )
+				_SendUncheckedEvent( ProfilingMsg::OnSendMsg{ this, msg });
+
+			MessageStatistic::ScopedMessage		msg_stat{ TypeIdOf<MsgT>(), GetModuleID(), is_async };
+		)
 		
 		VariantCRef		var_msg = VariantCRef::FromConst( msg );
 
@@ -0,0 +1,207 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Base/Modules/ModuleAllocator.h"
+
+namespace Engine
+{
+namespace Base
+{
+
+/*
+=================================================
+	_SysAlloc / _SysFree
+----
+	memory is tagged as 'Modules' when tracking enabled
+=================================================
+*/
+	void *  ModuleAllocator::_SysAlloc (usize size)
+	{
+	#ifdef GX_MEMORY_TRACKING
+		return MemoryTracker::Allocate( size, EMemorySubsystem::Modules );
+	#else
+		return ::operator new( size, std::nothrow );
+	#endif
+	}
+
+	void ModuleAllocator::_SysFree (void *ptr)
+	{
+	#ifdef GX_MEMORY_TRACKING
+		MemoryTracker::Deallocate( ptr );
+	#else
+		::operator delete( ptr );
+	#endif
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	ModuleAllocator::ModuleAllocator ()
+	{
+	}
+
+/*
+=================================================
+	destructor
+----
+	slabs are released only if all blocks are returned to the pool,
+	otherwise some modules are still alive and memory will be leaked.
+=================================================
+*/
+	ModuleAllocator::~ModuleAllocator ()
+	{
+		for (usize i = 0; i < _PoolCount; ++i)
+		{
+			auto&	pool = _pools[i];
+			SCOPELOCK( pool.lock );
+
+			if ( pool.liveBlocks > 0 )
+			{
+				WARNING( "not all modules are released" );
+				continue;
+			}
+
+			for (auto& slab : pool.slabs) {
+				_SysFree( slab );
+			}
+			pool.slabs.Clear();
+			pool.freeList		= null;
+			pool.pooledBlocks	= 0;
+		}
+	}
+
+/*
+=================================================
+	Instance
+=================================================
+*/
+	ModuleAllocator&  ModuleAllocator::Instance ()
+	{
+		static ModuleAllocator	inst;
+		return inst;
+	}
+
+/*
+=================================================
+	Allocate
+=================================================
+*/
+	void *  ModuleAllocator::Allocate (usize size) noexcept
+	{
+		ASSERT( size > 0 );
+
+		if ( size > _MaxBlockSize )
+		{
+			_heapBlocks.Inc();
+			return _SysAlloc( size );
+		}
+
+		const usize	idx		= _PoolIndex( size );
+		auto&		pool	= _pools[idx];
+
+		SCOPELOCK( pool.lock );
+
+		if ( pool.freeList == null )
+			_AllocateSlab( idx, pool );
+
+		FreeBlock*	block = pool.freeList;
+		CHECK_ERR( block != null );
+
+		pool.freeList = block->next;
+		--pool.pooledBlocks;
+		++pool.liveBlocks;
+
+		return block;
+	}
+
+/*
+=================================================
+	Deallocate
+=================================================
+*/
+	void ModuleAllocator::Deallocate (void *ptr, usize size) noexcept
+	{
+		if ( ptr == null )
+			return;
+
+		if ( size > _MaxBlockSize )
+		{
+			_heapBlocks.Dec();
+			_SysFree( ptr );
+			return;
+		}
+
+		auto&		pool	= _pools[ _PoolIndex( size ) ];
+		FreeBlock*	block	= Cast<FreeBlock *>( ptr );
+
+		SCOPELOCK( pool.lock );
+		ASSERT( pool.liveBlocks > 0 );
+
+		block->next		= pool.freeList;
+		pool.freeList	= block;
+		++pool.pooledBlocks;
+		--pool.liveBlocks;
+	}
+
+/*
+=================================================
+	_AllocateSlab
+----
+	pool must be locked
+=================================================
+*/
+	void ModuleAllocator::_AllocateSlab (usize index, Pool &pool)
+	{
+		const usize	block_size	= _BlockSize( index );
+		const usize	count		= GXMath::Max( _SlabSize / block_size, _MinSlabBlocks );
+		ubyte *		slab		= Cast<ubyte *>( _SysAlloc( block_size * count ) );
+
+		CHECK_ERR( slab != null, void() );
+
+		pool.slabs.PushBack( slab );
+
+		// push in reverse order, so first allocated block will be at the beginning of slab
+		for (usize i = count; i > 0; --i)
+		{
+			FreeBlock*	block = Cast<FreeBlock *>( slab + (i-1) * block_size );
+
+			block->next		= pool.freeList;
+			pool.freeList	= block;
+		}
+		pool.pooledBlocks += count;
+	}
+
+/*
+=================================================
+	GetStatistics
+----
+	returns only pools that was used
+=================================================
+*/
+	void ModuleAllocator::GetStatistics (OUT Statistics_t &result)
+	{
+		result.Clear();
+
+		for (usize i = 0; i < _PoolCount; ++i)
+		{
+			auto&	pool = _pools[i];
+			SCOPELOCK( pool.lock );
+
+			if ( pool.slabs.Empty() )
+				continue;
+
+			PoolStatistics	stat;
+			stat.blockSize		= BytesU( _BlockSize( i ) );
+			stat.liveBlocks		= pool.liveBlocks;
+			stat.pooledBlocks	= pool.pooledBlocks;
+			stat.slabs			= pool.slabs.Count();
+
+			result.PushBack( stat );
+		}
+	}
+
+}	// Base
+}	// Engine
@@ -0,0 +1,198 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#pragma once
+
+#include "Engine/Base/Common/Common.h"
+
+namespace Engine
+{
+namespace Base
+{
+
+	//
+	// Module Allocator
+	//
+	//	Slab allocator for modules and their message handler tables.
+	//	Memory is split into pools by size class, each pool allocates slabs
+	//	of blocks and keeps released blocks in free list for recycling,
+	//	so transient modules don't hit the heap after warmup.
+	//	Large allocations are passed to the default allocator.
+	//
+
+	class ModuleAllocator final : public Noncopyable
+	{
+	// types
+	public:
+		struct PoolStatistics
+		{
+			BytesU		blockSize;
+			usize		liveBlocks		= 0;	// allocated and used
+			usize		pooledBlocks	= 0;	// allocated and free
+			usize		slabs			= 0;
+		};
+
+		using Statistics_t	= Array< PoolStatistics >;
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock *		next;
+		};
+
+		struct Pool
+		{
+			Mutex			lock;
+			FreeBlock *		freeList		= null;
+			Array< void *>	slabs;
+			usize			liveBlocks		= 0;
+			usize			pooledBlocks	= 0;
+		};
+
+
+	// constants
+	private:
+		static constexpr usize	_Granularity	= 64;		// cache line size
+		static constexpr usize	_MaxBlockSize	= 4 << 10;
+		static constexpr usize	_SlabSize		= 64 << 10;
+		static constexpr usize	_MinSlabBlocks	= 8;
+		static constexpr usize	_PoolCount		= _MaxBlockSize / _Granularity;
+
+
+	// variables
+	private:
+		Pool			_pools[ _PoolCount ];
+		Atomic<usize>	_heapBlocks;
+
+
+	// methods
+	private:
+		ModuleAllocator ();
+		~ModuleAllocator ();
+
+	public:
+		ND_ static ModuleAllocator&  Instance ();
+
+		ND_ void *	Allocate (usize size) noexcept;
+			void	Deallocate (void *ptr, usize size) noexcept;
+
+			void	GetStatistics (OUT Statistics_t &result);
+		ND_ usize	HeapBlockCount ()	const	{ return _heapBlocks.Get(); }
+
+	private:
+		ND_ static usize  _PoolIndex (usize size)	{ return (size + _Granularity - 1) / _Granularity - 1; }
+		ND_ static usize  _BlockSize (usize index)	{ return (index + 1) * _Granularity; }
+
+		void _AllocateSlab (usize index, Pool &pool);
+
+		ND_ static void *  _SysAlloc (usize size);
+		static void _SysFree (void *ptr);
+	};
+
+
+
+	//
+	// Pooled Memory Container
+	//
+	//	Memory container for GX_STL containers that uses 'ModuleAllocator'.
+	//
+
+	template <typename T>
+	struct PooledMemoryContainer : public CompileTime::FastCopyable
+	{
+	// types
+	public:
+		using Self		= PooledMemoryContainer< T >;
+		using Value_t	= T;
+
+
+	// variables
+	private:
+		T *		_memory	= null;
+		usize	_bytes	= 0;
+
+
+	// methods
+	public:
+		PooledMemoryContainer ()
+		{}
+
+		PooledMemoryContainer (Self &&other)
+		{
+			MoveFrom( other );
+		}
+
+		PooledMemoryContainer (const Self &) = delete;
+
+		~PooledMemoryContainer ()
+		{
+			Deallocate();
+		}
+
+		Self & operator = (Self &&other)
+		{
+			MoveFrom( other );
+			return *this;
+		}
+
+		ND_ T *			Pointer ()			{ return _memory; }
+		ND_ T const *	Pointer ()	const	{ return _memory; }
+
+		ND_ constexpr bool	IsStatic ()	const	{ return false; }
+
+		bool Allocate (INOUT usize &size, bool allowReserve = true) noexcept
+		{
+			STATIC_ASSERT( alignof(T) <= alignof(void*) );
+
+			Deallocate();
+
+			if ( allowReserve )
+			{
+				const usize	nom	= GlobalConst::STL_MemContainerResizingNominator;
+				const usize	den	= GlobalConst::STL_MemContainerResizingDenominator;
+
+				size += (size * nom + den - 1) / den + GlobalConst::STL_MemContainerResizingMinSize;
+			}
+
+			_bytes	= size * sizeof(T);
+			_memory	= Cast<T *>( ModuleAllocator::Instance().Allocate( _bytes ) );
+
+			CHECK_ERR( _memory != null );
+			return true;
+		}
+
+		void Deallocate () noexcept
+		{
+			if ( _memory != null )
+			{
+				ModuleAllocator::Instance().Deallocate( _memory, _bytes );
+				_memory	= null;
+				_bytes	= 0;
+			}
+		}
+
+		ND_ static constexpr usize  MaxSize ()
+		{
+			return UMax;
+		}
+
+		void MoveFrom (INOUT Self &other) noexcept
+		{
+			Deallocate();
+
+			_memory	= other._memory;
+			_bytes	= other._bytes;
+
+			other._memory	= null;
+			other._bytes	= 0;
+		}
+
+		void SwapMemory (Self &other) noexcept
+		{
+			SwapValues( _memory, other._memory );
+			SwapValues( _bytes, other._bytes );
+		}
+	};
+
+
+}	// Base
+}	// Engine
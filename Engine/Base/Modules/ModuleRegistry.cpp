@@ -0,0 +1,153 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Base/Modules/ModuleRegistry.h"
+#include "Engine/Base/Modules/Module.h"
+
+namespace Engine
+{
+namespace Base
+{
+	
+/*
+=================================================
+	Instance
+=================================================
+*/
+	ModuleRegistry&  ModuleRegistry::Instance ()
+	{
+		static ModuleRegistry	inst;
+		return inst;
+	}
+	
+/*
+=================================================
+	_GetShard
+=================================================
+*/
+	ModuleRegistry::Shard&  ModuleRegistry::_GetShard (UntypedID_t id)
+	{
+		return _shards[ std::hash<UntypedID_t>()( id ) % _ShardCount ];
+	}
+
+/*
+=================================================
+	Register
+=================================================
+*/
+	void ModuleRegistry::Register (Module *mod)
+	{
+		CHECK_ERR( mod != null, void() );
+
+		const UntypedID_t	id		= mod->GetModuleID();
+		Shard&				shard	= _GetShard( id );
+
+		SCOPELOCK( shard.lock );
+
+		ModuleType&		type = shard.types[ id ];
+
+		type.stat.id = id;
+		++type.stat.live;
+		++type.stat.created;
+
+		const bool	inserted = type.modules.insert( mod ).second;
+		ASSERT( inserted );
+		GX_UNUSED( inserted );
+	}
+	
+/*
+=================================================
+	Unregister
+=================================================
+*/
+	void ModuleRegistry::Unregister (Module *mod)
+	{
+		CHECK_ERR( mod != null, void() );
+		
+		const UntypedID_t	id		= mod->GetModuleID();
+		Shard&				shard	= _GetShard( id );
+
+		SCOPELOCK( shard.lock );
+
+		auto	iter = shard.types.find( id );
+		if ( iter == shard.types.end() )
+			return;
+
+		if ( iter->second.modules.erase( mod ) > 0 )
+		{
+			ASSERT( iter->second.stat.live > 0 );
+			--iter->second.stat.live;
+		}
+	}
+	
+/*
+=================================================
+	FindAll
+----
+	modules in 'Deleting' state are skipped
+=================================================
+*/
+	bool ModuleRegistry::FindAll (UntypedID_t id, INOUT Array<ModulePtr> &result)
+	{
+		Shard&	shard = _GetShard( id );
+
+		SCOPELOCK( shard.lock );
+		
+		auto	iter = shard.types.find( id );
+		if ( iter == shard.types.end() )
+			return false;
+
+		const ThreadID	curr_thread	= ThreadID::GetCurrent();
+		const usize		prev_count	= result.Count();
+
+		for (Module* mod : iter->second.modules)
+		{
+			if ( mod->GetThreadID() == curr_thread and
+				 mod->GetState() != Module::EState::Deleting )
+			{
+				result.PushBack( mod );
+			}
+		}
+		return result.Count() > prev_count;
+	}
+	
+/*
+=================================================
+	Count
+=================================================
+*/
+	usize ModuleRegistry::Count ()
+	{
+		usize	count = 0;
+
+		for (auto& shard : _shards)
+		{
+			SCOPELOCK( shard.lock );
+
+			for (auto& type : shard.types) {
+				count += type.second.modules.size();
+			}
+		}
+		return count;
+	}
+	
+/*
+=================================================
+	GetStatistics
+=================================================
+*/
+	void ModuleRegistry::GetStatistics (OUT Statistics_t &result)
+	{
+		result.Clear();
+
+		for (auto& shard : _shards)
+		{
+			SCOPELOCK( shard.lock );
+
+			for (auto& type : shard.types) {
+				result.PushBack( type.second.stat );
+			}
+		}
+	}
+
+}	// Base
+}	// Engine
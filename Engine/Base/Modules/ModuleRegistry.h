@@ -0,0 +1,86 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#pragma once
+
+#include "Engine/Base/Public/ModuleMessages.h"
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Engine
+{
+namespace Base
+{
+
+	//
+	// Module Registry
+	//
+	//	Global index of all alive modules by module ID.
+	//	Modules are registered in constructor and unregistered in destructor,
+	//	search returns only modules that belongs to the current thread,
+	//	so lifetime of returned module is synchronized with caller.
+	//	Also counts live and created modules for each module ID,
+	//	memory usage is counted by 'ModuleAllocator'.
+	//
+
+	class ModuleRegistry final : public Noncopyable
+	{
+	// types
+	private:
+		using UntypedID_t	= ModuleMsg::UntypedID_t;
+
+	public:
+		struct TypeStatistics
+		{
+			UntypedID_t		id		= 0;
+			usize			live	= 0;
+			usize			created	= 0;	// total number of created modules
+		};
+
+		using Statistics_t	= Array< TypeStatistics >;
+
+	private:
+		struct ModuleType
+		{
+			std::unordered_set< Module * >	modules;
+			TypeStatistics					stat;
+		};
+
+		using ModuleTypes_t	= std::unordered_map< UntypedID_t, ModuleType >;
+
+		// module types are distributed between shards to reduce lock contention
+		struct Shard
+		{
+			Mutex			lock;
+			ModuleTypes_t	types;
+		};
+
+		static constexpr uint	_ShardCount	= 16;
+
+
+	// variables
+	private:
+		Shard		_shards[ _ShardCount ];
+
+
+	// methods
+	private:
+		ModuleRegistry () {}
+
+		ND_ Shard&  _GetShard (UntypedID_t id);
+
+	public:
+		ND_ static ModuleRegistry&  Instance ();
+
+		void Register (Module *mod);
+		void Unregister (Module *mod);
+
+		bool FindAll (UntypedID_t id, INOUT Array<ModulePtr> &result);
+
+		ND_ usize  Count ();
+
+		void GetStatistics (OUT Statistics_t &result);
+	};
+
+
+}	// Base
+}	// Engine
@@ -0,0 +1,396 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Base/Profiling/CpuProfiler.h"
+#include "Core/STL/Files/HDDFile.h"
+#include "Core/STL/ThreadSafe/Singleton.h"
+#include "Core/STL/Math/Mathematics.h"
+
+#if defined(COMPILER_GCC) or defined(COMPILER_CLANG)
+#	include <cxxabi.h>
+#endif
+
+namespace Engine
+{
+namespace Base
+{
+
+	//
+	// Thread Buffer
+	//
+	struct CpuProfiler::ThreadBuffer
+	{
+		Array< Zone >				zones;				// ring buffer
+		std::atomic< usize >		written		{0};	// total number of written zones
+		std::atomic< ModuleID_t >	threadId	{0};
+		uint						index		= 0;
+		uint						depth		= 0;	// accessed only by owner thread
+
+		ThreadBuffer ()
+		{
+			zones.Resize( ZonesPerThread );
+		}
+	};
+
+
+	//
+	// Global State
+	//
+	struct CpuProfiler::GlobalState
+	{
+		Mutex								lock;
+		Array< UniquePtr< ThreadBuffer > >	buffers;			// protected by 'lock'
+		std::atomic< ulong >				frames[MaxFrames];	// ring buffer
+		std::atomic< usize >				frameCount	{0};
+		std::atomic< ulong >				startTime	{0};
+		std::atomic< uint >					lastFrames	{0};
+
+		GlobalState ()
+		{
+			for (auto& f : frames) { f.store( 0, std::memory_order_relaxed ); }
+		}
+	};
+//-----------------------------------------------------------------------------
+
+
+	AtomicFlag	CpuProfiler::_enabled{ false };
+
+/*
+=================================================
+	_State
+=================================================
+*/
+	CpuProfiler::GlobalState&  CpuProfiler::_State ()
+	{
+		return *SingletonMultiThread::Instance< GlobalState >();
+	}
+
+/*
+=================================================
+	Now
+----
+	monotonic clock in nanoseconds
+=================================================
+*/
+	ulong  CpuProfiler::Now ()
+	{
+		static const OS::PerformanceTimer	timer;
+		return ulong(timer.GetTimeNanoSec().NanoSeconds());
+	}
+
+/*
+=================================================
+	Start
+=================================================
+*/
+	void CpuProfiler::Start (uint lastFrames)
+	{
+		auto&	st = _State();
+
+		st.lastFrames.store( GXMath::Min( lastFrames, MaxFrames ), std::memory_order_relaxed );
+		st.startTime.store( Now(), std::memory_order_release );
+
+		_enabled.StoreAndSync( true );
+	}
+
+/*
+=================================================
+	Stop
+=================================================
+*/
+	void CpuProfiler::Stop ()
+	{
+		_enabled.StoreAndSync( false );
+	}
+
+/*
+=================================================
+	FrameMark
+=================================================
+*/
+	void CpuProfiler::FrameMark ()
+	{
+		if ( not IsEnabled() )
+			return;
+
+		auto&		st		= _State();
+		const usize	index	= st.frameCount.load( std::memory_order_relaxed );
+
+		st.frames[ index % MaxFrames ].store( Now(), std::memory_order_relaxed );
+		st.frameCount.store( index + 1, std::memory_order_release );
+	}
+
+/*
+=================================================
+	SetThreadModule
+=================================================
+*/
+	void CpuProfiler::SetThreadModule (ModuleID_t id)
+	{
+		_GetThreadBuffer()->threadId.store( id, std::memory_order_relaxed );
+	}
+
+/*
+=================================================
+	_GetThreadBuffer
+----
+	buffer is allocated once for each thread
+	and never released, so pointer is always valid.
+=================================================
+*/
+	CpuProfiler::ThreadBuffer*  CpuProfiler::_GetThreadBuffer ()
+	{
+		static thread_local ThreadBuffer *	buffer = null;
+
+		if ( buffer == null )
+		{
+			auto&	st = _State();
+			SCOPELOCK( st.lock );
+
+			st.buffers.PushBack( UniquePtr<ThreadBuffer>{ new ThreadBuffer() } );
+
+			buffer			= st.buffers.Back().ptr();
+			buffer->index	= uint(st.buffers.LastIndex());
+		}
+		return buffer;
+	}
+
+/*
+=================================================
+	_BeginZone
+=================================================
+*/
+	ulong  CpuProfiler::_BeginZone ()
+	{
+		++_GetThreadBuffer()->depth;
+		return Now();
+	}
+
+/*
+=================================================
+	_EndZone
+=================================================
+*/
+	void CpuProfiler::_EndZone (const char *name, ModuleID_t moduleId, ulong begin)
+	{
+		const ulong		end		= Now();
+		ThreadBuffer*	buf		= _GetThreadBuffer();
+		const usize		pos		= buf->written.load( std::memory_order_relaxed );
+		Zone &			zone	= buf->zones[ pos & (ZonesPerThread - 1) ];
+
+		--buf->depth;
+
+		zone.name		= name;
+		zone.moduleId	= moduleId;
+		zone.begin		= begin;
+		zone.end		= end;
+		zone.depth		= buf->depth;
+
+		buf->written.store( pos + 1, std::memory_order_release );
+	}
+
+/*
+=================================================
+	GetCapture
+----
+	zones are copied without locking writers,
+	so zones that may be overwritten during copying are dropped.
+=================================================
+*/
+	bool CpuProfiler::GetCapture (OUT Capture &result)
+	{
+		STATIC_ASSERT( GXMath::IsPowerOfTwo( ZonesPerThread ) );
+
+		auto&	st = _State();
+
+		result = Capture{};
+		result.begin	= st.startTime.load( std::memory_order_acquire );
+		result.end		= Now();
+
+		CHECK_ERR( result.begin > 0 );	// profiler was not started
+
+		// frames
+		const usize	frame_count	= st.frameCount.load( std::memory_order_acquire );
+		const usize	num_frames	= GXMath::Min( frame_count, usize(MaxFrames) );
+		const uint	last_frames	= st.lastFrames.load( std::memory_order_relaxed );
+
+		for (usize i = frame_count - num_frames; i < frame_count; ++i)
+		{
+			const ulong	time = st.frames[ i % MaxFrames ].load( std::memory_order_relaxed );
+
+			if ( time >= result.begin and time <= result.end )
+				result.frames.PushBack( time );
+		}
+
+		if ( last_frames > 0 and result.frames.Count() > last_frames )
+		{
+			result.frames.Erase( 0, result.frames.Count() - last_frames );
+			result.begin = result.frames.Front();
+		}
+
+		// zones
+		SCOPELOCK( st.lock );
+
+		for (auto& buf : st.buffers)
+		{
+			ThreadZones		tz;
+			tz.threadId	= buf->threadId.load( std::memory_order_relaxed );
+			tz.index	= buf->index;
+
+			const usize		written	= buf->written.load( std::memory_order_acquire );
+			const usize		first	= written > ZonesPerThread ? written - ZonesPerThread : 0;
+
+			tz.zones.Reserve( written - first );
+
+			for (usize i = first; i < written; ++i) {
+				tz.zones.PushBack( buf->zones[ i & (ZonesPerThread - 1) ] );
+			}
+
+			std::atomic_thread_fence( std::memory_order_acquire );
+
+			const usize		written2	= buf->written.load( std::memory_order_relaxed );
+			const usize		valid		= written2 >= ZonesPerThread ? written2 - ZonesPerThread + 1 : 0;
+			usize			j			= 0;
+
+			FOR( i, tz.zones )
+			{
+				const Zone&	z = tz.zones[i];
+
+				if ( first + i >= valid and z.begin >= result.begin and z.end <= result.end )
+					tz.zones[j++] = z;
+			}
+			tz.zones.Resize( j );
+
+			if ( not tz.zones.Empty() )
+				result.threads.PushBack( RVREF(tz) );
+		}
+		return true;
+	}
+
+/*
+=================================================
+	AppendTypeName
+----
+	message zones use type name, which may be mangled
+=================================================
+*/
+	void CpuProfiler::AppendTypeName (const char *name, INOUT String &str)
+	{
+		if ( name == null or name[0] == 0 ) {
+			str << "unknown";
+			return;
+		}
+
+	#if defined(COMPILER_GCC) or defined(COMPILER_CLANG)
+		int		status		= 0;
+		char *	demangled	= abi::__cxa_demangle( name, null, null, OUT &status );
+
+		if ( status == 0 and demangled != null )
+		{
+			str << demangled;
+			::free( demangled );
+			return;
+		}
+	#endif
+
+		for (const char* c = name; *c; ++c)
+		{
+			if ( *c == '"' or *c == '\\' )
+				str << '\\';
+			str << *c;
+		}
+	}
+
+/*
+=================================================
+	_AppendMicroseconds
+=================================================
+*/
+	void CpuProfiler::_AppendMicroseconds (ulong ns, INOUT String &str)
+	{
+		const uint	frac = uint(ns % 1000);
+
+		str << (ns / 1000) << '.' << (frac < 100 ? "0" : "") << (frac < 10 ? "0" : "") << frac;
+	}
+
+/*
+=================================================
+	ToChromeTrace
+=================================================
+*/
+	bool CpuProfiler::ToChromeTrace (const Capture &capture, OUT String &json)
+	{
+		json.Clear();
+		json << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+		bool	first = true;
+		auto	AddSeparator = LAMBDA( &first, &json ) ()
+		{
+			if ( not first )
+				json << ",\n";
+			first = false;
+		};
+
+		for (auto& tz : capture.threads)
+		{
+			AddSeparator();
+			json << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << tz.index << ",\"args\":{\"name\":\"";
+
+			if ( tz.threadId )
+				json << GModID::ToString( GModID::type(tz.threadId) );
+			else
+				json << "thread " << tz.index;
+
+			json << "\"}}";
+
+			for (auto& z : tz.zones)
+			{
+				AddSeparator();
+				json << "{\"ph\":\"X\",\"name\":\"";
+				AppendTypeName( z.name, INOUT json );
+				json << "\",\"pid\":1,\"tid\":" << tz.index << ",\"ts\":";
+				_AppendMicroseconds( z.begin - capture.begin, INOUT json );
+				json << ",\"dur\":";
+				_AppendMicroseconds( z.end - z.begin, INOUT json );
+
+				if ( z.moduleId )
+					json << ",\"args\":{\"module\":\"" << GModID::ToString( GModID::type(z.moduleId) ) << "\"}";
+
+				json << "}";
+			}
+		}
+
+		FOR( i, capture.frames )
+		{
+			AddSeparator();
+			json << "{\"ph\":\"i\",\"s\":\"g\",\"name\":\"Frame " << i << "\",\"pid\":1,\"tid\":0,\"ts\":";
+			_AppendMicroseconds( capture.frames[i] - capture.begin, INOUT json );
+			json << "}";
+		}
+
+		json << "\n]}\n";
+		return true;
+	}
+
+/*
+=================================================
+	SaveChromeTrace
+=================================================
+*/
+	bool CpuProfiler::SaveChromeTrace (StringCRef filename)
+	{
+		Capture		capture;
+		CHECK_ERR( GetCapture( OUT capture ) );
+
+		String		json;
+		CHECK_ERR( ToChromeTrace( capture, OUT json ) );
+
+		GXFile::WFilePtr	file = GXFile::HddWFile::New( filename );
+		CHECK_ERR( file );
+		CHECK_ERR( file->Write( StringCRef(json) ) );
+
+		LOG( "CPU profiler trace saved to '"_str << filename << "'", ELog::Info );
+		return true;
+	}
+
+}	// Base
+}	// Engine
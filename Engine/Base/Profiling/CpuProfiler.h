@@ -0,0 +1,141 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Hierarchical CPU profiler.
+
+	Each thread writes zones into its own ring buffer without locks,
+	reader copies buffers and drops zones that may be overwritten during copying.
+	Enabled zone costs two timer queries and a single store,
+	disabled zone costs a single relaxed load.
+*/
+
+#pragma once
+
+#include "Engine/Base/Common/EModuleGroup.h"
+#include "Core/STL/ThreadSafe/AtomicFlag.h"
+
+namespace Engine
+{
+namespace Base
+{
+
+	//
+	// CPU Profiler
+	//
+
+	class CpuProfiler final : public Noninstancable
+	{
+	// types
+	public:
+		using ModuleID_t	= ulong;		// same as 'ModuleMsg::UntypedID_t'
+
+		struct Zone : CompileTime::PODStruct
+		{
+			const char *	name		= null;		// must be static string
+			ModuleID_t		moduleId	= 0;		// module that handles zone, 0 if unknown
+			ulong			begin		= 0;		// in nanoseconds
+			ulong			end			= 0;
+			uint			depth		= 0;
+		};
+
+		struct ThreadZones
+		{
+			ModuleID_t		threadId	= 0;		// thread module ID, 0 if unknown
+			uint			index		= 0;		// unique thread index
+			Array<Zone>		zones;
+		};
+
+		struct Capture
+		{
+			Array<ThreadZones>	threads;
+			Array<ulong>		frames;			// begin time of frames
+			ulong				begin	= 0;
+			ulong				end		= 0;
+		};
+
+
+		//
+		// Scoped Zone
+		//
+		struct ScopedZone final : Noncopyable
+		{
+		private:
+			const char *	_name;
+			ModuleID_t		_moduleId;
+			ulong			_begin		= 0;
+
+		public:
+			forceinline explicit ScopedZone (const char *name, ModuleID_t moduleId = 0) :
+				_name{name}, _moduleId{moduleId}
+			{
+				if ( IsEnabled() )
+					_begin = _BeginZone();
+			}
+
+			forceinline ~ScopedZone ()
+			{
+				if ( _begin )
+					_EndZone( _name, _moduleId, _begin );
+			}
+		};
+
+	private:
+		struct ThreadBuffer;
+		struct GlobalState;
+
+
+	// constants
+	public:
+		static constexpr uint	ZonesPerThread	= 1u << 16;
+		static constexpr uint	MaxFrames		= 256;
+
+
+	// variables
+	private:
+		static AtomicFlag	_enabled;
+
+
+	// methods
+	public:
+		// 'lastFrames' - ring buffer mode, only zones from last N frames will be captured,
+		// 0 - all zones since start while they fit into thread buffers.
+		static void Start (uint lastFrames = 0);
+		static void Stop ();
+
+		ND_ forceinline static bool  IsEnabled ()		{ return bool(_enabled); }
+
+		// frame boundary, must be called from single thread
+		static void FrameMark ();
+
+		static void SetThreadModule (ModuleID_t id);
+
+		static bool GetCapture (OUT Capture &result);
+
+		// chrome://tracing and Perfetto compatible json
+		static bool ToChromeTrace (const Capture &capture, OUT String &json);
+		static bool SaveChromeTrace (StringCRef filename);
+
+		ND_ static ulong  Now ();
+
+		// demangles type name if needed
+		static void AppendTypeName (const char *name, INOUT String &str);
+
+	private:
+		ND_ static ulong  _BeginZone ();
+		static void _EndZone (const char *name, ModuleID_t moduleId, ulong begin);
+
+		ND_ static ThreadBuffer*  _GetThreadBuffer ();
+		ND_ static GlobalState&   _State ();
+
+		static void _AppendMicroseconds (ulong ns, INOUT String &str);
+	};
+
+
+}	// Base
+}	// Engine
+
+
+#define GX_PROFILE_ZONE( _name_ ) \
+	::Engine::Base::CpuProfiler::ScopedZone		AUXDEF_UNITE_RAW( __cpuZone, __COUNTER__ ){ (_name_) }
+
+#define GX_PROFILE_MODULE_ZONE( _name_, _moduleId_ ) \
+	::Engine::Base::CpuProfiler::ScopedZone		AUXDEF_UNITE_RAW( __cpuZone, __COUNTER__ ){ (_name_), ::Engine::Base::CpuProfiler::ModuleID_t(_moduleId_) }
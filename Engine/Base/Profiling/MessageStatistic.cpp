@@ -0,0 +1,430 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Base/Profiling/MessageStatistic.h"
+#include "Core/STL/Files/HDDFile.h"
+#include "Core/STL/ThreadSafe/Singleton.h"
+#include "Core/STL/Math/Mathematics.h"
+
+namespace Engine
+{
+namespace Base
+{
+
+	//
+	// Statistic Key
+	//
+	struct MessageStatistic::StatisticKey
+	{
+	// variables
+		TypeId			msgType;
+		ModuleID_t		sender	= 0;
+		ModuleID_t		target	= 0;
+
+	// methods
+		StatisticKey () {}
+		StatisticKey (TypeId msgType, ModuleID_t sender, ModuleID_t target) :
+			msgType{msgType}, sender{sender}, target{target} {}
+
+		bool operator == (const StatisticKey &right) const
+		{
+			return msgType == right.msgType and sender == right.sender and target == right.target;
+		}
+
+		bool operator >  (const StatisticKey &right) const
+		{
+			return	msgType != right.msgType ?	msgType > right.msgType :
+					sender  != right.sender  ?	sender  > right.sender  :
+												target  > right.target;
+		}
+	};
+
+
+	//
+	// Thread Statistic
+	//
+	struct MessageStatistic::ThreadStatistic
+	{
+		using Entries_t	= Map< StatisticKey, Entry >;
+
+		Mutex			lock;			// writer is owner thread, so lock is almost always uncontended
+		Entries_t		entries;
+		ModuleID_t		current		= 0;	// accessed only by owner thread
+	};
+
+
+	//
+	// Global State
+	//
+	struct MessageStatistic::GlobalState
+	{
+		Mutex									lock;
+		Array< UniquePtr< ThreadStatistic > >	threads;	// protected by 'lock'
+	};
+//-----------------------------------------------------------------------------
+
+
+	AtomicFlag	MessageStatistic::_enabled{ false };
+
+/*
+=================================================
+	_State
+=================================================
+*/
+	MessageStatistic::GlobalState&  MessageStatistic::_State ()
+	{
+		return *SingletonMultiThread::Instance< GlobalState >();
+	}
+
+/*
+=================================================
+	Start
+=================================================
+*/
+	void MessageStatistic::Start ()
+	{
+		_enabled.StoreAndSync( true );
+	}
+
+/*
+=================================================
+	Stop
+=================================================
+*/
+	void MessageStatistic::Stop ()
+	{
+		_enabled.StoreAndSync( false );
+	}
+
+/*
+=================================================
+	Reset
+=================================================
+*/
+	void MessageStatistic::Reset ()
+	{
+		auto&	st = _State();
+		SCOPELOCK( st.lock );
+
+		for (auto& thread : st.threads)
+		{
+			SCOPELOCK( thread->lock );
+			thread->entries.Clear();
+		}
+	}
+
+/*
+=================================================
+	_GetThreadStatistic
+----
+	statistic is allocated once for each thread
+	and never released, so pointer is always valid.
+=================================================
+*/
+	MessageStatistic::ThreadStatistic*  MessageStatistic::_GetThreadStatistic ()
+	{
+		static thread_local ThreadStatistic *	stat = null;
+
+		if ( stat == null )
+		{
+			auto&	st = _State();
+			SCOPELOCK( st.lock );
+
+			st.threads.PushBack( UniquePtr<ThreadStatistic>{ new ThreadStatistic() } );
+			stat = st.threads.Back().ptr();
+		}
+		return stat;
+	}
+
+/*
+=================================================
+	CurrentModule
+=================================================
+*/
+	MessageStatistic::ModuleID_t  MessageStatistic::CurrentModule ()
+	{
+		return _GetThreadStatistic()->current;
+	}
+
+/*
+=================================================
+	_SetCurrentModule
+----
+	returns previous module
+=================================================
+*/
+	MessageStatistic::ModuleID_t  MessageStatistic::_SetCurrentModule (ModuleID_t id)
+	{
+		ThreadStatistic*	stat	= _GetThreadStatistic();
+		const ModuleID_t	prev	= stat->current;
+
+		stat->current = id;
+		return prev;
+	}
+
+/*
+=================================================
+	_Record
+=================================================
+*/
+	void MessageStatistic::_Record (TypeId msgType, ModuleID_t sender, ModuleID_t target, bool isAsync, ulong time)
+	{
+		ThreadStatistic*	stat = _GetThreadStatistic();
+		SCOPELOCK( stat->lock );
+
+		ThreadStatistic::Entries_t::iterator	iter;
+
+		if ( not stat->entries.Find( StatisticKey{ msgType, sender, target }, OUT iter ) )
+		{
+			Entry	entry;
+			entry.msgType	= msgType;
+			entry.sender	= sender;
+			entry.target	= target;
+
+			iter = stat->entries.Add( StatisticKey{ msgType, sender, target }, entry );
+		}
+
+		Entry&	entry = iter->second;
+
+		entry.count			+= 1;
+		entry.asyncCount	+= uint(isAsync);
+		entry.totalTime		+= time;
+		entry.maxTime		 = GXMath::Max( entry.maxTime, time );
+	}
+
+/*
+=================================================
+	GetStatistic
+----
+	merges statistic from all threads
+=================================================
+*/
+	void MessageStatistic::GetStatistic (OUT Entries_t &result)
+	{
+		auto&						st = _State();
+		ThreadStatistic::Entries_t	merged;
+
+		result.Clear();
+
+		SCOPELOCK( st.lock );
+
+		for (auto& thread : st.threads)
+		{
+			SCOPELOCK( thread->lock );
+
+			for (auto& src : thread->entries)
+			{
+				ThreadStatistic::Entries_t::iterator	iter;
+
+				if ( not merged.Find( src.first, OUT iter ) )
+				{
+					merged.Add( src.first, src.second );
+					continue;
+				}
+
+				Entry&	dst = iter->second;
+
+				dst.count		+= src.second.count;
+				dst.asyncCount	+= src.second.asyncCount;
+				dst.totalTime	+= src.second.totalTime;
+				dst.maxTime		 = GXMath::Max( dst.maxTime, src.second.maxTime );
+			}
+		}
+
+		result.Reserve( merged.Count() );
+
+		for (auto& entry : merged) {
+			result.PushBack( entry.second );
+		}
+	}
+
+/*
+=================================================
+	_AppendModuleName
+=================================================
+*/
+	void MessageStatistic::_AppendModuleName (ModuleID_t id, INOUT String &str)
+	{
+		if ( id == 0 )
+			str << "external";
+		else
+			str << GModID::ToString( GModID::type(id) );
+	}
+
+/*
+=================================================
+	ToReport
+=================================================
+*/
+	void MessageStatistic::ToReport (const Entries_t &entries, OUT String &report)
+	{
+		const auto	AppendTimes = LAMBDA( &report ) (const Entry &e)
+		{
+			report	<< "count: " << e.count << ", async: " << e.asyncCount
+					<< ", total: " << ToString( TimeD::FromNanoSeconds( double(e.totalTime) ))
+					<< ", average: " << ToString( TimeD::FromNanoSeconds( double(e.totalTime) / GXMath::Max( e.count, ulong(1) ) ))
+					<< ", max: " << ToString( TimeD::FromNanoSeconds( double(e.maxTime) ));
+		};
+
+		const auto	SortByTime = LAMBDA() (const Entry &lhs, const Entry &rhs)
+		{
+			return lhs.totalTime < rhs.totalTime;	// descending order
+		};
+
+		// group by message type
+		Entries_t	by_type;
+
+		for (auto& e : entries)
+		{
+			usize	i = 0;
+			for (; i < by_type.Count() and by_type[i].msgType != e.msgType; ++i) {}
+
+			if ( i == by_type.Count() )
+			{
+				by_type.PushBack( e );
+				by_type.Back().sender = by_type.Back().target = 0;
+				continue;
+			}
+
+			Entry&	dst = by_type[i];
+
+			dst.count		+= e.count;
+			dst.asyncCount	+= e.asyncCount;
+			dst.totalTime	+= e.totalTime;
+			dst.maxTime		 = GXMath::Max( dst.maxTime, e.maxTime );
+		}
+
+		Entries_t	by_pair = entries;
+
+		Sort( by_type, SortByTime );
+		Sort( by_pair, SortByTime );
+
+		report.Clear();
+		report << "Message statistic, sorted by total time\n\nBy message type:\n";
+
+		for (auto& e : by_type)
+		{
+			report << "  ";
+			CpuProfiler::AppendTypeName( e.msgType.Name(), INOUT report );
+			report << "\n      ";
+			AppendTimes( e );
+			report << '\n';
+		}
+
+		report << "\nBy sender -> target:\n";
+
+		for (auto& e : by_pair)
+		{
+			report << "  ";
+			_AppendModuleName( e.sender, INOUT report );
+			report << " -> ";
+			_AppendModuleName( e.target, INOUT report );
+			report << " : ";
+			CpuProfiler::AppendTypeName( e.msgType.Name(), INOUT report );
+			report << "\n      ";
+			AppendTimes( e );
+			report << '\n';
+		}
+	}
+
+/*
+=================================================
+	ToGraph
+----
+	edge thickness depends on message count
+=================================================
+*/
+	void MessageStatistic::ToGraph (const Entries_t &entries, OUT String &graph)
+	{
+		// group by sender and target
+		Entries_t	edges;
+		ulong		max_count	= 1;
+
+		for (auto& e : entries)
+		{
+			usize	i = 0;
+			for (; i < edges.Count() and (edges[i].sender != e.sender or edges[i].target != e.target); ++i) {}
+
+			if ( i == edges.Count() )
+				edges.PushBack( e );
+			else
+			{
+				edges[i].count		+= e.count;
+				edges[i].asyncCount	+= e.asyncCount;
+				edges[i].totalTime	+= e.totalTime;
+			}
+			max_count = GXMath::Max( max_count, edges[i].count );
+		}
+
+		graph.Clear();
+		graph << "digraph MessageFlow {\n"
+			  << "\tnode [shape=box];\n";
+
+		for (auto& e : edges)
+		{
+			const float	width = 1.0f + 4.0f * float(e.count) / float(max_count);
+
+			graph << "\t\"";
+			_AppendModuleName( e.sender, INOUT graph );
+			graph << "\" -> \"";
+			_AppendModuleName( e.target, INOUT graph );
+			graph << "\" [label=\"" << e.count;
+
+			if ( e.asyncCount > 0 )
+				graph << " (async " << e.asyncCount << ')';
+
+			graph << "\\n" << ToString( TimeD::FromNanoSeconds( double(e.totalTime) ))
+				  << "\", penwidth=" << width;
+
+			if ( e.asyncCount > 0 )
+				graph << ", style=dashed";
+
+			graph << "];\n";
+		}
+
+		graph << "}\n";
+	}
+
+/*
+=================================================
+	SaveReport
+=================================================
+*/
+	bool MessageStatistic::SaveReport (StringCRef filename)
+	{
+		Entries_t	entries;
+		GetStatistic( OUT entries );
+
+		String		report;
+		ToReport( entries, OUT report );
+
+		GXFile::WFilePtr	file = GXFile::HddWFile::New( filename );
+		CHECK_ERR( file );
+		CHECK_ERR( file->Write( StringCRef(report) ) );
+
+		LOG( "Message statistic saved to '"_str << filename << "'", ELog::Info );
+		return true;
+	}
+
+/*
+=================================================
+	SaveGraph
+=================================================
+*/
+	bool MessageStatistic::SaveGraph (StringCRef filename)
+	{
+		Entries_t	entries;
+		GetStatistic( OUT entries );
+
+		String		graph;
+		ToGraph( entries, OUT graph );
+
+		GXFile::WFilePtr	file = GXFile::HddWFile::New( filename );
+		CHECK_ERR( file );
+		CHECK_ERR( file->Write( StringCRef(graph) ) );
+
+		LOG( "Message flow graph saved to '"_str << filename << "'", ELog::Info );
+		return true;
+	}
+
+}	// Base
+}	// Engine
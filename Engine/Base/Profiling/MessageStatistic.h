@@ -0,0 +1,122 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Message flow statistic.
+
+	Aggregates message count and handler time per message type
+	and per sender -> target pair.
+	Sender is a module that was handling message on the current thread
+	when new message was sent.
+	Used only when GX_PROFILE_MSG is enabled.
+	Handler time is taken from monotonic clock (CpuProfiler::Now).
+*/
+
+#pragma once
+
+#include "Engine/Base/Profiling/CpuProfiler.h"
+
+namespace Engine
+{
+namespace Base
+{
+
+	//
+	// Message Statistic
+	//
+
+	class MessageStatistic final : public Noninstancable
+	{
+	// types
+	public:
+		using ModuleID_t	= CpuProfiler::ModuleID_t;
+
+		struct Entry
+		{
+			TypeId			msgType;
+			ModuleID_t		sender		= 0;		// 0 if message was sent outside of message handler
+			ModuleID_t		target		= 0;
+			ulong			count		= 0;
+			ulong			asyncCount	= 0;		// messages that was sent from another thread
+			ulong			totalTime	= 0;		// in nanoseconds, includes nested messages
+			ulong			maxTime		= 0;
+		};
+
+		using Entries_t		= Array< Entry >;
+
+
+		//
+		// Scoped Message
+		//
+		struct ScopedMessage final : Noncopyable
+		{
+		private:
+			const TypeId		_msgType;
+			const ModuleID_t	_target;
+			ModuleID_t			_sender;
+			ulong				_begin		= 0;
+			const bool			_isAsync;
+
+		public:
+			forceinline ScopedMessage (TypeId msgType, ModuleID_t target, bool isAsync) :
+				_msgType{msgType}, _target{target}, _isAsync{isAsync}
+			{
+				_sender = _SetCurrentModule( target );
+
+				if ( IsEnabled() )
+					_begin = CpuProfiler::Now();
+			}
+
+			forceinline ~ScopedMessage ()
+			{
+				_SetCurrentModule( _sender );
+
+				if ( _begin )
+					_Record( _msgType, _sender, _target, _isAsync, CpuProfiler::Now() - _begin );
+			}
+		};
+
+	private:
+		struct StatisticKey;
+		struct ThreadStatistic;
+		struct GlobalState;
+
+
+	// variables
+	private:
+		static AtomicFlag	_enabled;
+
+
+	// methods
+	public:
+		static void Start ();
+		static void Stop ();
+		static void Reset ();
+
+		ND_ forceinline static bool  IsEnabled ()		{ return bool(_enabled); }
+
+		// returns module which handles message on current thread
+		ND_ static ModuleID_t  CurrentModule ();
+
+		static void GetStatistic (OUT Entries_t &result);
+
+		// report is sorted by total time
+		static void ToReport (const Entries_t &entries, OUT String &report);
+
+		// graphviz dot file, edges are sender -> target
+		static void ToGraph (const Entries_t &entries, OUT String &graph);
+
+		static bool SaveReport (StringCRef filename);
+		static bool SaveGraph (StringCRef filename);
+
+	private:
+		static ModuleID_t  _SetCurrentModule (ModuleID_t id);
+		static void _Record (TypeId msgType, ModuleID_t sender, ModuleID_t target, bool isAsync, ulong time);
+
+		ND_ static ThreadStatistic*  _GetThreadStatistic ();
+		ND_ static GlobalState&      _State ();
+
+		static void _AppendModuleName (ModuleID_t id, INOUT String &str);
+	};
+
+
+}	// Base
+}	// Engine
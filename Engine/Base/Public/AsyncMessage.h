@@ -1,6 +1,11 @@
 // Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
 /*
 	AsyncMessage - lightweight async operation.
+
+	Function object is stored inside the message (small buffer optimization),
+	so message queue stores it in fixed size slots and pushing a typical message
+	doesn't allocate memory. Large function objects are allocated in the heap.
+	Message is moved through the all layers, captured values are copied only once.
 */
 
 #pragma once
@@ -13,6 +18,65 @@ namespace Engine
 namespace Base
 {
 
+	namespace _BaseAsyncMsgHidden_
+	{
+
+		//
+		// Async Function Interface
+		//
+		struct AsyncFuncInterface
+		{
+			virtual ~AsyncFuncInterface ()								{}
+				virtual void	Process (GlobalSystemsRef gs)	const = 0;
+				virtual void	MoveTo (BinArrayRef buf)		= 0;
+				virtual void	CopyTo (BinArrayRef buf)		const = 0;
+			ND_ virtual bool	IsInline ()						const = 0;
+		};
+
+
+		//
+		// Inline Async Function
+		//
+		template <typename FN>
+		struct InlineAsyncFunc final : AsyncFuncInterface
+		{
+		// variables
+			mutable FN		_func;
+
+		// methods
+			explicit InlineAsyncFunc (FN &&func) : _func{ RVREF(func) } {}
+			explicit InlineAsyncFunc (const FN &func) : _func{ func } {}
+
+			void	Process (GlobalSystemsRef gs)	const override	{ _func( gs ); }
+			void	MoveTo (BinArrayRef buf)		override		{ PlacementNew< InlineAsyncFunc >( buf, RVREF(_func) ); }
+			void	CopyTo (BinArrayRef buf)		const override	{ PlacementNew< InlineAsyncFunc >( buf, _func ); }
+			bool	IsInline ()						const override	{ return true; }
+		};
+
+
+		//
+		// Heap Async Function
+		//
+		template <typename FN>
+		struct HeapAsyncFunc final : AsyncFuncInterface
+		{
+		// variables
+			FN *	_func;
+
+		// methods
+			explicit HeapAsyncFunc (FN *func) : _func{ func } {}
+			~HeapAsyncFunc ()										{ if ( _func ) delete _func; }
+
+			void	Process (GlobalSystemsRef gs)	const override	{ (*_func)( gs ); }
+			void	MoveTo (BinArrayRef buf)		override		{ PlacementNew< HeapAsyncFunc >( buf, _func );  _func = null; }
+			void	CopyTo (BinArrayRef buf)		const override	{ PlacementNew< HeapAsyncFunc >( buf, new FN{ *_func } ); }
+			bool	IsInline ()						const override	{ return false; }
+		};
+
+	}	// _BaseAsyncMsgHidden_
+
+
+
 	//
 	// Async Message
 	//
@@ -24,35 +88,155 @@ namespace Base
 		using Self		= AsyncMessage;
 		using Func_t	= std::function< void (GlobalSystemsRef) >;
 
+	private:
+		using _Interface_t	= _BaseAsyncMsgHidden_::AsyncFuncInterface;
+
+		template <typename FN>
+		using _Inline_t		= _BaseAsyncMsgHidden_::InlineAsyncFunc< FN >;
+		
+		template <typename FN>
+		using _Heap_t		= _BaseAsyncMsgHidden_::HeapAsyncFunc< FN >;
+
+		template <typename FN>
+		using _EnableForFunc_t	= CompileTime::DisableIf< CompileTime::IsSameTypes< std::decay_t<FN>, Self > >;
+
+		// size of queue slot, captures of typical message are: ModulePtr + message data
+		static constexpr usize	_BufSize	= 64;
+
+		union _Storage_t {
+			usize	maxAlign;
+			ubyte	buf[ _BufSize ];
+		};
+
 
 	// variables
 	private:
-		Func_t		_func;
+		_Storage_t		_storage;
+		bool			_created	= false;	// function object is constructed in '_storage'
 
 
 	// methods
 	public:
-		AsyncMessage (GX_DEFCTOR) : _func{}
-		{}
+		AsyncMessage (GX_DEFCTOR)
+		{
+			_Clear();
+		}
 
-		explicit AsyncMessage (Func_t &&func) : _func{ RVREF(func) }
-		{}
+		AsyncMessage (const Self &other)
+		{
+			_Copy( other );
+		}
+
+		AsyncMessage (Self &&other)
+		{
+			_Move( RVREF(other) );
+		}
 		
-		template <typename FN>
-		explicit AsyncMessage (FN value) : _func{value}
-		{}
+		template <typename FN, typename = _EnableForFunc_t<FN>>
+		explicit AsyncMessage (FN &&func)
+		{
+			_Create< std::decay_t<FN> >( FW<FN>(func) );
+		}
 
 		template <typename FN, typename ...Args>
-		explicit AsyncMessage (FN func, Args&& ...args) :
-			_func{std::bind( func, FW<Args>(args)..., std::placeholders::_1 )}
-		{}
-		
-		GX_DEFCOPYCTOR_ASSIGN( AsyncMessage );
+		explicit AsyncMessage (FN func, Args&& ...args)
+		{
+			_Create< decltype(std::bind( func, FW<Args>(args)..., std::placeholders::_1 )) >(
+						std::bind( func, FW<Args>(args)..., std::placeholders::_1 ) );
+		}
+
+		~AsyncMessage ()
+		{
+			_Delete();
+		}
+
+		Self& operator = (const Self &right)
+		{
+			if ( this != &right )
+			{
+				_Delete();
+				_Copy( right );
+			}
+			return *this;
+		}
+
+		Self& operator = (Self &&right)
+		{
+			if ( this != &right )
+			{
+				_Delete();
+				_Move( RVREF(right) );
+			}
+			return *this;
+		}
 
 		void Process (GlobalSystemsRef gs) const noexcept
 		{
-			ASSERT( bool(_func) );
-			return _func( gs );
+			ASSERT( _IsCreated() );
+			return _Internal()->Process( gs );
+		}
+
+		ND_ bool  IsValid ()	const	{ return _IsCreated(); }
+		ND_ bool  IsInline ()	const	{ return _IsCreated() and _Internal()->IsInline(); }
+		
+		template <typename FN>
+		ND_ static constexpr bool  IsInlineCapable ()
+		{
+			using F = std::decay_t<FN>;
+			return sizeof(_Inline_t<F>) <= _BufSize and alignof(_Inline_t<F>) <= alignof(_Storage_t);
+		}
+
+
+	private:
+		_Interface_t const *	_Internal ()	const	{ return Cast<_Interface_t const *>( _storage.buf ); }
+		_Interface_t *			_Internal ()			{ return Cast<_Interface_t *>( _storage.buf ); }
+		BinArrayRef				_Data ()				{ return BinArrayRef( _storage.buf ); }
+		bool					_IsCreated ()	const	{ return _created; }
+		void					_Clear ()				{ _created = false; }
+
+		template <typename FN, typename Arg>
+		void _Create (Arg &&func)
+		{
+			STATIC_ASSERT( sizeof(_Heap_t<FN>) <= _BufSize );
+
+			if_constexpr( IsInlineCapable<FN>() )
+				PlacementNew< _Inline_t<FN> >( _Data(), FN{ FW<Arg>(func) } );
+			else
+				PlacementNew< _Heap_t<FN> >( _Data(), new FN{ FW<Arg>(func) } );
+
+			_created = true;
+		}
+
+		void _Delete () noexcept
+		{
+			if ( _IsCreated() )
+			{
+				_Internal()->~_Interface_t();
+				_Clear();
+			}
+		}
+
+		void _Move (Self &&other) noexcept
+		{
+			_Clear();
+
+			if ( other._IsCreated() )
+			{
+				other._Internal()->MoveTo( _Data() );
+				other._Delete();
+				_created = true;
+			}
+		}
+
+		void _Copy (const Self &other) noexcept
+		{
+			_Clear();
+
+			if ( other._IsCreated() )
+			{
+				other._Internal()->CopyTo( _Data() );
+				_created = true;
+			}
 		}
 	};
 
@@ -73,24 +257,24 @@ namespace ModuleMsg
 		Base::ThreadID						altTarget;
 
 	// methods
-		PushAsyncMessage (Base::ThreadID target, Base::AsyncMessage::Func_t &&func) :
-			asyncMsg{Base::AsyncMessage{ RVREF(func) }}, target{ target }, altTarget{ target }
+		PushAsyncMessage (Base::ThreadID target, Base::AsyncMessage &&msg) :
+			asyncMsg{ RVREF(msg) }, target{ target }, altTarget{ target }
 		{}
-		
+
 		template <typename FN>
-		PushAsyncMessage (Base::ThreadID target, FN value) :
-			asyncMsg{Base::AsyncMessage{ value }}, target{ target }, altTarget{ target }
+		PushAsyncMessage (Base::ThreadID target, FN &&value) :
+			asyncMsg{Base::AsyncMessage{ FW<FN>(value) }}, target{ target }, altTarget{ target }
 		{}
 
 		template <typename FN, typename ...Args>
 		PushAsyncMessage (Base::ThreadID target, FN func, Args&& ...args) :
-			asyncMsg{Base::AsyncMessage{ std::bind( func, FW<Args>(args)..., std::placeholders::_1 ) }},
+			asyncMsg{Base::AsyncMessage{ func, FW<Args>(args)... }},
 			target{ target }, altTarget{ target }
 		{}
 
 		template <typename T>
 		PushAsyncMessage (const ModulePtr &target, T &&msg) :
-			asyncMsg{LAMBDA( targ = target, m = RVREF(msg) ) (GlobalSystemsRef) { _Call<T>( targ, m ); }},
+			asyncMsg{Base::AsyncMessage{ LAMBDA( targ = target, m = RVREF(msg) ) (GlobalSystemsRef) { _Call<T>( targ, m ); }}},
 			target{ target->GetThreadID() },
 			altTarget{ target->GetThreadID() }
 		{}
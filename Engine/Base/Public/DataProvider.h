@@ -255,10 +255,11 @@ namespace DSMsg
 		BytesU						position;
 		Editable< BinArrayRef >		writableBuffer;	// preallocated memory, 'result' may contains all or part of this buffer
 		Out_opt< BinArrayCRef >		result;
+		bool						hasPosition	= false;	// if false then sequential data input continues from current position
 
 	// methods
 		ReadMemRange () {}
-		ReadMemRange (BytesU pos, BinArrayRef buf) : position{pos}, writableBuffer{buf} {}
+		ReadMemRange (BytesU pos, BinArrayRef buf) : position{pos}, writableBuffer{buf}, hasPosition{true} {}
 		explicit ReadMemRange (BinArrayRef buf) : writableBuffer{buf} {}
 	};
 	
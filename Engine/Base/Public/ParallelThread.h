@@ -44,6 +44,7 @@ namespace CreateInfo
 		String								name;
 		ModulePtr							manager;
 		ReadOnce< OnStartThreadFunc_t >		onStarted;		// this function must be as fast as possible
+		OS::CpuMask_t						cpuAffinity;	// empty mask - thread is not pinned
 
 	// methods
 		Thread (StringCRef name, const ModulePtr &mngr) :
@@ -58,6 +59,19 @@ namespace CreateInfo
 			manager{ mngr },
 			onStarted{std::bind( func, FW<Args>(args)..., std::placeholders::_1 )}
 		{}
+
+		// pin thread to all SMT siblings of physical core, index is wrapped by core count
+		Thread&  PinToCore (uint physicalCore)
+		{
+			cpuAffinity = OS::CpuTopology::Get().GetCoreMask( physicalCore );
+			return *this;
+		}
+
+		Thread&  SetAffinity (const OS::CpuMask_t &mask)
+		{
+			cpuAffinity = mask;
+			return *this;
+		}
 	};
 	
 
@@ -3,7 +3,7 @@
 #pragma once
 
 #include "Engine/Base/Public/ModuleMessages.h"
-#include "Engine/Base/Common/BaseObject.h"
+#include "Engine/Base/Profiling/MessageStatistic.h"
 
 namespace Engine
 {
@@ -18,14 +18,14 @@ namespace ProfilingMsg
 	struct OnSendMsg : _MsgBase_
 	{
 	// variables
-		ModulePtr							target;
-		WeakPointerType< Base::BaseObject >	sender;
-		VariantCRef							msg;
+		ModulePtr				target;
+		UntypedID_t				sender;		// module that handles message on current thread, 0 if unknown
+		VariantCRef				msg;
 
 	// methods
 		template <typename T>
 		OnSendMsg (const ModulePtr &target, const T &msg) :
-			target{target}, sender{msg.Sender()}, msg{ VariantCRef::FromConst(msg) }
+			target{target}, sender{ Base::MessageStatistic::CurrentModule() }, msg{ VariantCRef::FromConst(msg) }
 		{}
 	};
 
@@ -0,0 +1,101 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Job graph describes work as a set of jobs with dependencies,
+	job starts when all its dependencies are completed.
+	Job can depend only on previously added jobs, so graph is always acyclic.
+
+	Graph is immutable while executing, see 'JobScheduler'.
+*/
+
+#pragma once
+
+#include "Engine/Base/Common/Common.h"
+
+namespace Engine
+{
+namespace Base
+{
+
+	//
+	// Job Graph
+	//
+
+	class JobGraph final
+	{
+	// types
+	public:
+		using JobFunc_t		= Function< void () >;
+		using JobID			= uint;
+		using JobIDs_t		= ArrayCRef< JobID >;
+
+		struct Job
+		{
+		// variables
+			JobFunc_t		func;
+			Array< JobID >	successors;					// jobs that are waiting for this job
+			uint			dependencies	= 0;		// number of jobs that must be completed before
+			bool			mainThread		= false;	// job must be executed in thread that runs graph
+
+		// methods
+			Job () {}
+			Job (JobFunc_t &&func, bool mainThread) : func{RVREF(func)}, mainThread{mainThread} {}
+		};
+
+		using Jobs_t		= Array< Job >;
+
+
+	// variables
+	private:
+		Jobs_t		_jobs;
+
+
+	// methods
+	public:
+		JobGraph () {}
+
+		JobID  Add (JobFunc_t &&func, JobIDs_t dependsOn = Uninitialized)
+		{
+			return _Add( RVREF(func), dependsOn, false );
+		}
+
+		JobID  AddMainThread (JobFunc_t &&func, JobIDs_t dependsOn = Uninitialized)
+		{
+			return _Add( RVREF(func), dependsOn, true );
+		}
+
+		bool AddDependency (JobID job, JobID dependsOn)
+		{
+			CHECK_ERR( job < _jobs.Count() and dependsOn < job );
+
+			_jobs[dependsOn].successors.PushBack( job );
+			++_jobs[job].dependencies;
+			return true;
+		}
+
+		void Clear ()
+		{
+			_jobs.Clear();
+		}
+
+		ND_ usize			Count ()	const	{ return _jobs.Count(); }
+		ND_ bool			Empty ()	const	{ return _jobs.Empty(); }
+		ND_ Jobs_t const&	GetJobs ()	const	{ return _jobs; }
+
+
+	private:
+		JobID  _Add (JobFunc_t &&func, JobIDs_t dependsOn, bool mainThread)
+		{
+			const JobID	id = JobID(_jobs.Count());
+
+			_jobs.PushBack( Job{ RVREF(func), mainThread } );
+
+			for (auto& dep : dependsOn) {
+				AddDependency( id, dep );
+			}
+			return id;
+		}
+	};
+
+
+}	// Base
+}	// Engine
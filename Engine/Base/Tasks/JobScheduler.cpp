@@ -0,0 +1,308 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Base/Tasks/JobScheduler.h"
+
+namespace Engine
+{
+namespace Base
+{
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	JobScheduler::JobScheduler (uint threadCount, bool pinThreads) :
+		_looping{ true }, _running{ false }, _pinThreads{ pinThreads }
+	{
+		if ( threadCount == 0 )
+			threadCount = GXMath::Max( OS::CpuTopology::Get().PhysicalCoreCount(), 2u ) - 1;
+
+		_queues.Reserve( threadCount + 1 );
+		_workers.Reserve( threadCount );
+
+		for (uint i = 0; i <= threadCount; ++i) {
+			_queues.PushBack( UniquePtr<WorkQueue>{ new WorkQueue() } );
+		}
+
+		for (uint i = 0; i < threadCount; ++i)
+		{
+			_workers.PushBack( UniquePtr<Worker>{ new Worker() } );
+
+			auto&	w = *_workers.Back();
+			w.scheduler	= this;
+			w.index		= i;
+
+			CHECK( w.thread.Create( &_WorkerProc, &w ) );
+		}
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	JobScheduler::~JobScheduler ()
+	{
+		ASSERT( not _running );
+
+		_lock.Lock();
+		_looping = false;
+		_wakeUp.Broadcast();
+		_lock.Unlock();
+
+		for (auto& w : _workers) {
+			w->thread.Wait();
+		}
+	}
+
+/*
+=================================================
+	Run
+----
+	blocks current thread until all jobs are completed.
+=================================================
+*/
+	bool JobScheduler::Run (const JobGraph &graph)
+	{
+		CHECK_ERR( not _running );
+
+		if ( graph.Empty() )
+			return true;
+
+		SCOPE_SETTER( _running = true, false );
+
+		const uint	main_idx	= uint(_queues.Count()-1);
+		uint		next_queue	= 0;
+
+		_jobs = graph.GetJobs();
+		_counters.Resize( _jobs.Count() );
+		_remaining.Set( uint(_jobs.Count()) );
+
+		FOR( i, _jobs ) {
+			_counters[i].Set( _jobs[i].dependencies );
+		}
+
+		// distribute independent jobs between workers
+		FOR( i, _jobs )
+		{
+			if ( _jobs[i].dependencies == 0 )
+			{
+				_Push( next_queue, JobID(i) );
+				next_queue = (next_queue + 1) % uint(_queues.Count());
+			}
+		}
+
+		// execute jobs in current thread
+		JobID	id;
+
+		while ( _remaining.Get() > 0 )
+		{
+			if ( _TryPopMain( OUT id ) or _TryPop( main_idx, OUT id ) )
+			{
+				_Execute( main_idx, id );
+				continue;
+			}
+			_Wait( true );
+		}
+
+		_jobs = Uninitialized;
+		return true;
+	}
+
+/*
+=================================================
+	_WorkerProc
+=================================================
+*/
+	void JobScheduler::_WorkerProc (void *param)
+	{
+		Worker *		w		= Cast<Worker *>(param);
+		JobScheduler&	self	= *w->scheduler;
+		JobID			id;
+
+		// main thread uses first core
+		if ( self._pinThreads )
+		{
+			const auto	mask = OS::CpuTopology::Get().GetCoreMask( w->index + 1 );
+
+			if ( mask.IsNotZero() )
+				OS::CpuTopology::SetCurrentThreadAffinity( mask );
+		}
+
+		for (;;)
+		{
+			if ( self._TryPop( w->index, OUT id ) )
+			{
+				self._Execute( w->index, id );
+				continue;
+			}
+
+			if ( not self._Wait( false ) )
+				break;
+		}
+	}
+
+/*
+=================================================
+	_Execute
+=================================================
+*/
+	void JobScheduler::_Execute (uint queueIndex, JobID id)
+	{
+		auto const&	job = _jobs[id];
+
+		if ( job.func )
+			job.func();
+
+		// push continuations to the same queue to use data that is still in cache
+		for (auto& next : job.successors)
+		{
+			if ( _counters[next].Dec() == 0 )
+				_Push( queueIndex, next );
+		}
+
+		if ( _remaining.Dec() == 0 )
+		{
+			SCOPELOCK( _lock );
+			_wakeUp.Broadcast();
+		}
+	}
+
+/*
+=================================================
+	_Push
+=================================================
+*/
+	void JobScheduler::_Push (uint queueIndex, JobID id)
+	{
+		if ( _jobs[id].mainThread )
+		{
+			{
+				SCOPELOCK( _mainQueue.lock );
+				_mainQueue.jobs.PushBack( id );
+			}
+			_mainPending.Inc();
+			_WakeUp( true );	// main thread must be woken up
+			return;
+		}
+
+		auto&	q = *_queues[ queueIndex ];
+		{
+			SCOPELOCK( q.lock );
+			q.jobs.PushBack( id );
+		}
+		_pending.Inc();
+		_WakeUp( false );
+	}
+
+/*
+=================================================
+	_TryPop
+----
+	own queue is processed in LIFO order,
+	jobs are stolen from other queues in FIFO order.
+=================================================
+*/
+	bool JobScheduler::_TryPop (uint queueIndex, OUT JobID &id)
+	{
+		if ( _pending.Get() == 0 )
+			return false;
+
+		const uint	count = uint(_queues.Count());
+
+		for (uint i = 0; i < count; ++i)
+		{
+			auto&	q = *_queues[ (queueIndex + i) % count ];
+			SCOPELOCK( q.lock );
+
+			if ( q.jobs.Empty() )
+				continue;
+
+			if ( i == 0 ) {
+				id = q.jobs.Back();
+				q.jobs.PopBack();
+			} else {
+				id = q.jobs.Front();
+				q.jobs.PopFront();
+			}
+
+			_pending.Dec();
+			return true;
+		}
+		return false;
+	}
+
+/*
+=================================================
+	_TryPopMain
+=================================================
+*/
+	bool JobScheduler::_TryPopMain (OUT JobID &id)
+	{
+		if ( _mainPending.Get() == 0 )
+			return false;
+
+		SCOPELOCK( _mainQueue.lock );
+
+		if ( _mainQueue.jobs.Empty() )
+			return false;
+
+		id = _mainQueue.jobs.Front();
+		_mainQueue.jobs.PopFront();
+
+		_mainPending.Dec();
+		return true;
+	}
+
+/*
+=================================================
+	_Wait
+----
+	returns false if scheduler is stopped.
+	'_sleeping' is increased before checking counters,
+	so '_WakeUp' will see sleeping thread or thread will see new job.
+=================================================
+*/
+	bool JobScheduler::_Wait (bool mainThread)
+	{
+		_lock.Lock();
+		_sleeping.Inc();
+
+		while ( _looping and _pending.Get() == 0 )
+		{
+			if ( mainThread and (_mainPending.Get() > 0 or _remaining.Get() == 0) )
+				break;
+
+			_wakeUp.Wait( _lock );
+		}
+
+		_sleeping.Dec();
+
+		const bool	looping = _looping;
+		_lock.Unlock();
+
+		return looping;
+	}
+
+/*
+=================================================
+	_WakeUp
+=================================================
+*/
+	void JobScheduler::_WakeUp (bool all)
+	{
+		if ( _sleeping.Get() == 0 )
+			return;
+
+		SCOPELOCK( _lock );
+
+		if ( all )
+			_wakeUp.Broadcast();
+		else
+			_wakeUp.Signal();
+	}
+
+
+}	// Base
+}	// Engine
@@ -0,0 +1,96 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Executes job graph on worker pool.
+
+	Each worker has its own queue, completed job pushes ready successors (continuations)
+	to the queue of current worker, idle worker steals jobs from other queues.
+	Thread that calls 'Run' participates in execution and it is the only thread
+	that executes main thread jobs.
+*/
+
+#pragma once
+
+#include "Engine/Base/Tasks/JobGraph.h"
+#include "Core/STL/ThreadSafe/Atomic.h"
+
+namespace Engine
+{
+namespace Base
+{
+
+	//
+	// Job Scheduler
+	//
+
+	class JobScheduler final : public Noncopyable
+	{
+	// types
+	private:
+		using JobID			= JobGraph::JobID;
+		using Job			= JobGraph::Job;
+
+		struct WorkQueue
+		{
+			Mutex				lock;
+			Queue< JobID >		jobs;
+		};
+
+		struct Worker
+		{
+			JobScheduler *		scheduler	= null;
+			uint				index		= 0;
+			OS::Thread			thread;
+		};
+
+		using WorkQueues_t		= Array< UniquePtr< WorkQueue > >;
+		using Workers_t			= Array< UniquePtr< Worker > >;
+		using Counters_t		= Array< Atomic< uint > >;
+
+
+	// variables
+	private:
+		WorkQueues_t		_queues;		// last queue is used by thread that runs graph
+		WorkQueue			_mainQueue;
+		Workers_t			_workers;
+
+		// current graph
+		ArrayCRef< Job >	_jobs;
+		Counters_t			_counters;		// number of uncompleted dependencies
+		Atomic< uint >		_remaining;		// number of uncompleted jobs
+
+		Atomic< uint >		_pending;		// number of jobs in '_queues'
+		Atomic< uint >		_mainPending;	// number of jobs in '_mainQueue'
+		Atomic< uint >		_sleeping;
+
+		Mutex				_lock;
+		OS::ConditionVariable	_wakeUp;
+		bool				_looping;
+		bool				_running;
+		const bool			_pinThreads;	// pin workers to physical cores
+
+
+	// methods
+	public:
+		// threadCount: 0 - physical core count minus one
+		explicit JobScheduler (uint threadCount = 0, bool pinThreads = false);
+		~JobScheduler ();
+
+		bool Run (const JobGraph &graph);
+
+		ND_ uint  ThreadCount ()	const	{ return uint(_workers.Count()) + 1; }
+
+
+	private:
+		static void _WorkerProc (void *param);
+
+		void _Execute (uint queueIndex, JobID id);
+		void _Push (uint queueIndex, JobID id);
+		bool _TryPop (uint queueIndex, OUT JobID &id);
+		bool _TryPopMain (OUT JobID &id);
+		bool _Wait (bool mainThread);
+		void _WakeUp (bool all);
+	};
+
+
+}	// Base
+}	// Engine
@@ -17,6 +17,7 @@ namespace Base
 	ParallelThreadImpl::ParallelThreadImpl (UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::Thread &info) :
 		Module( gs, ModuleConfig{ id, 1 }, &_eventTypes ),
 		_onStarted( RVREF( info.onStarted.Get() ) ),
+		_cpuAffinity( info.cpuAffinity ),
 		_isLooping( false )
 	{
 		GlobalSystems()->parallelThread._Set( this );
@@ -119,6 +120,13 @@ namespace Base
 
 		_isLooping	= true;
 		
+		CpuProfiler::SetThreadModule( GetModuleID() );
+
+		if ( _cpuAffinity.IsNotZero() and not OS::CpuTopology::SetCurrentThreadAffinity( _cpuAffinity ) )
+		{
+			LOG( "failed to set affinity for thread '"_str << GetDebugName() << "'", ELog::Warning );
+		}
+
 		_timer.Start();
 		
 		if ( _onStarted )
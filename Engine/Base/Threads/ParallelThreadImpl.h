@@ -34,6 +34,7 @@ namespace Base
 	private:
 		OS::Thread				_thread;
 		OnStartThreadFunc_t		_onStarted;
+		OS::CpuMask_t			_cpuAffinity;
 		TimeProfilerL			_timer;
 		bool					_isLooping;
 
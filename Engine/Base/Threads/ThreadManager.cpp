@@ -287,7 +287,10 @@ namespace Base
 		CHECK_ERR( mngr );
 
 
-		CreateParallelThreadData	data{ id, gs, CreateInfo::Thread{ ci.name, mngr, RVREF( ci.onStarted.Get() ) } };
+		CreateInfo::Thread			thread_ci{ ci.name, mngr, RVREF( ci.onStarted.Get() ) };
+		thread_ci.cpuAffinity = ci.cpuAffinity;
+
+		CreateParallelThreadData	data{ id, gs, RVREF( thread_ci ) };
 
 		// start thread and set 'data' to new thread
 		data.thread.Create( &_RunAsync, &data );
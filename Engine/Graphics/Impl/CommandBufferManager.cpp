@@ -98,6 +98,7 @@ namespace Graphics
 		
 		bool				_isVRCompatible;
 		bool				_isVRFrame;
+		bool				_isOffscreenFrame;
 
 
 	// methods
@@ -150,7 +151,8 @@ namespace Graphics
 		GraphicsBaseModule( gs, ModuleConfig{ id, UMax }, &_eventTypes ),
 		_bufferChainLength{ Max( 2u, ci.bufferChainLength ) },		_bufferIndex{ 0 },
 		_scope{ EScope::None },										_frameIndex{ 0 },
-		_isVRCompatible{ false },									_isVRFrame{ false }
+		_isVRCompatible{ false },									_isVRFrame{ false },
+		_isOffscreenFrame{ false }
 	{
 		SetDebugName( "CommandBufferManager" );
 
@@ -378,6 +380,20 @@ namespace Graphics
 		
 		CHECK_ERR( _BeginFrame() );
 
+		// begin offscreen frame
+		if ( msg.offscreen )
+		{
+			msg.result.Set({ null, _bufferIndex, _bufferIndex });
+
+			_framebuffer		= null;
+			_frameIndex			= _bufferIndex;
+			_scope				= EScope::Frame;
+			_isOffscreenFrame	= true;
+
+			_SendEvent( GraphicsMsg::OnCmdBeginFrame{ _bufferIndex });
+			return true;
+		}
+
 		// begin frame
 		{
 			GpuMsg::ThreadBeginFrame	begin;
@@ -420,14 +436,19 @@ namespace Graphics
 		end.waitSemaphores.Append( per_frame.waitSemaphores );
 		end.signalSemaphores.Append( per_frame.signalSemaphores );
 
-		CHECK( _GetManager()->Send( end ) );
+		if ( _isOffscreenFrame ) {
+			CHECK( _GetManager()->Send( Cast<GpuMsg::SubmitCommands const &>( end ) ) );
+		} else {
+			CHECK( _GetManager()->Send( end ) );
+		}
 
 		per_frame.waitSemaphores.Clear();
 		_tempBuffers.Clear();
 
-		_framebuffer = null;
-		_frameIndex	 = UMax;
-		_scope		 = EScope::None;
+		_framebuffer		= null;
+		_frameIndex			= UMax;
+		_scope				= EScope::None;
+		_isOffscreenFrame	= false;
 		
 		_SendEvent( GraphicsMsg::OnCmdEndFrame{ _bufferIndex });
 		return true;
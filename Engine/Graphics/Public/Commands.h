@@ -41,13 +41,21 @@ namespace GraphicsMsg
 	//
 	struct CmdBeginFrame : _MsgBase_
 	{
+	// types
 		struct Data {
-			ModulePtr	framebuffer;		// returns current framebuffer, same as in 'ThreadBeginFrame'
+			ModulePtr	framebuffer;		// returns current framebuffer, same as in 'ThreadBeginFrame', null for offscreen frame
 			uint		frameIndex;			// index of image in swapchain, same as in 'ThreadBeginFrame'
 			uint		cmdIndex;			// index of buffer sequence, max value is 'CommandBufferManager::bufferChainLength'-1
 		};
 
+	// variables
+		bool			offscreen	= false;	// swapchain image will not be acquired and presented,
+												// commands will be submitted to the queue with frame fence.
 		Out< Data >		result;
+
+	// methods
+		CmdBeginFrame () {}
+		explicit CmdBeginFrame (bool offscreen) : offscreen{offscreen} {}
 	};
 
 	struct CmdEndFrame : _MsgBase_
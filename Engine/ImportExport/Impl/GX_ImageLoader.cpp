@@ -53,6 +53,11 @@ namespace ImportExport
 		Array<Level_t>		_levels;
 		EPixelFormat::type	_format;
 		EImageLayout::type	_imageLayout;
+		const BytesU		_memoryBudget;
+		uint				_baseLevel;			// first resident mipmap level in file
+		uint				_lastLevel;			// smallest mipmap level in file
+		uint				_nextLevel;			// next mipmap level to stream, levels are uploaded from smallest to largest
+		const bool			_progressive;
 
 
 	// methods
@@ -74,9 +79,14 @@ namespace ImportExport
 
 	private:
 		bool _PreLoadImage ();
-		bool _LoadImage ();
 		bool _UnloadImage ();
 		bool _UpdateTexture ();
+		void _StreamNextLevel ();
+		bool _UploadLevels (uint firstLevel, uint lastLevel, bool streaming);
+		
+		ND_ uint  _ChooseBaseLevel (const GXImageFormat::Header &header) const;
+		ND_ static BytesU  _HeaderSize ()	{ return SizeOf<GXImageFormat::Header>; }
+		ND_ static BytesU  _SlicePitch (const Level_t &level);
 	};
 //-----------------------------------------------------------------------------
 
@@ -92,7 +102,9 @@ namespace ImportExport
 	GX_ImageLoader::GX_ImageLoader (UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::ImageLoader &ci) :
 		Module( gs, ModuleConfig{ id, 1 }, &_eventTypes ),
 		_dataInput{ ci.dataInput },		_format{ Uninitialized },
-		_imageLayout{ ci.imageLayout }
+		_imageLayout{ ci.imageLayout },	_memoryBudget{ ci.memoryBudget },
+		_baseLevel{ 0 },				_lastLevel{ 0 },
+		_nextLevel{ 0 },				_progressive{ ci.progressive }
 	{
 		SetDebugName( "GX_ImageLoader" );
 
@@ -198,9 +210,16 @@ namespace ImportExport
 */
 	bool GX_ImageLoader::_OnImageComposed (const ModuleMsg::AfterCompose &)
 	{
-		CHECK_ERR( _UpdateTexture() );
-
 		_GetParents().Front()->UnsubscribeAll( this );
+
+		if ( _progressive )
+		{
+			_nextLevel = _lastLevel + 1;
+			_StreamNextLevel();
+			return true;
+		}
+
+		CHECK_ERR( _UpdateTexture() );
 		return true;
 	}
 
@@ -216,17 +235,34 @@ namespace ImportExport
 		// read header
 		GXImageFormat::Header	header = {};
 		{
-			_dataInput->Send( DSMsg::ReadMemRange{ BinArrayRef::FromValue( header ) });
+			_dataInput->Send( DSMsg::ReadMemRange{ 0_b, BinArrayRef::FromValue( header ) });
+
+			CHECK_ERR( header.version == GXImageFormat::VERSION );
+			CHECK_ERR( header.maxLevel > 0 and header.layers > 0 );
 
 			const usize		num_levels	= header.layers * header.maxLevel;
 			_levels.Resize( num_levels, false );
 
-			_dataInput->Send( DSMsg::ReadMemRange{ BinArrayRef::From( _levels ) });
+			_dataInput->Send( DSMsg::ReadMemRange{ _HeaderSize(), BinArrayRef::From( _levels ) });
 			_dataInput->Send( DSMsg::ReleaseData{} );
 
-			_format = header.pixelFormat;
+			_format		= header.pixelFormat;
+			_lastLevel	= header.maxLevel - 1;
 		}
 
+		// skip largest levels that doesn't fit into memory budget
+		_baseLevel = _ChooseBaseLevel( header );
+
+		for (usize i = 0; i < _levels.Count();)
+		{
+			if ( _levels[i].level < _baseLevel or _levels[i].level > _lastLevel )
+				_levels.Erase( i );
+			else
+				++i;
+		}
+
+		const uint3		base_dim = Max( uint3( header.width, header.height, header.depth ) >> _baseLevel, 1u );
+
 		// update image descriptor
 		ImageDescription	descr;
 		ModulePtr			image = _GetParents().Front();
@@ -235,9 +271,9 @@ namespace ImportExport
 		CHECK( image->Send( req_descr ) );
 
 		descr			= *req_descr.result;
-		descr.dimension	= Max( uint4( header.width, header.height, header.depth, header.layers ), 1u );
+		descr.dimension	= Max( uint4( base_dim, header.layers ), 1u );
 		descr.format	= header.pixelFormat;
-		descr.maxLevel	= MipmapLevel( header.maxLevel );
+		descr.maxLevel	= MipmapLevel( header.maxLevel - _baseLevel );
 		descr.samples	= MultiSamples( header.samples );
 		descr.usage		|= EImageUsage::TransferDst;	// to copy from buffer
 
@@ -277,6 +313,62 @@ namespace ImportExport
 		return true;
 	}
 	
+/*
+=================================================
+	_ChooseBaseLevel
+----
+	returns first level such that total size of
+	this and all smaller levels fits into budget.
+=================================================
+*/
+	uint GX_ImageLoader::_ChooseBaseLevel (const GXImageFormat::Header &header) const
+	{
+		if ( _memoryBudget == 0_b )
+			return 0;
+
+		Array< BytesU >		level_sizes;
+		level_sizes.Resize( header.maxLevel );
+
+		for (auto& level : _levels)
+		{
+			if ( level.level < level_sizes.Count() )
+				level_sizes[ level.level ] += _SlicePitch( level ) * Max( level.dimension.z, 1u );
+		}
+
+		BytesU	total;
+		uint	base = header.maxLevel - 1;		// smallest level is always resident
+
+		for (uint i = header.maxLevel; i > 0; --i)
+		{
+			total += level_sizes[i-1];
+
+			if ( total > _memoryBudget )
+				break;
+
+			base = i-1;
+		}
+
+		if ( base > 0 ) {
+			LOG( "skipped "_str << base << " mipmap levels to fit into memory budget " << ToString( _memoryBudget ), ELog::Debug );
+		}
+		return base;
+	}
+	
+/*
+=================================================
+	_SlicePitch
+----
+	slice pitch may be zero for 1D and 2D images
+=================================================
+*/
+	BytesU GX_ImageLoader::_SlicePitch (const Level_t &level)
+	{
+		if ( level.slicePitch > 0 )
+			return BytesU(level.slicePitch);
+
+		return BytesU(level.rowPitch) * Max( level.dimension.y, 1u );
+	}
+
 /*
 =================================================
 	_UnloadImage
@@ -297,33 +389,102 @@ namespace ImportExport
 /*
 =================================================
 	_UpdateTexture
+----
+	upload all levels in single command buffer
 =================================================
 */
 	bool GX_ImageLoader::_UpdateTexture ()
+	{
+		CHECK_ERR( not _levels.Empty() );
+
+		const bool	res = _UploadLevels( _baseLevel, _lastLevel, false );
+		
+		_UnloadImage();
+		return res;
+	}
+	
+/*
+=================================================
+	_StreamNextLevel
+----
+	upload next level and schedule uploading of next
+	level when current commands will be completed,
+	so image will be updated progressively (one level per frame)
+	and only one staging level exists at a time.
+=================================================
+*/
+	void GX_ImageLoader::_StreamNextLevel ()
+	{
+		if ( _levels.Empty() or _GetParents().Empty() or not _dataInput )
+			return;	// image was unloaded
+
+		if ( _nextLevel <= _baseLevel )
+		{
+			_UnloadImage();
+			return;
+		}
+
+		--_nextLevel;
+
+		if ( not _UploadLevels( _nextLevel, _nextLevel, true ) )
+		{
+			_UnloadImage();
+		}
+	}
+
+/*
+=================================================
+	_UploadLevels
+=================================================
+*/
+	bool GX_ImageLoader::_UploadLevels (uint firstLevel, uint lastLevel, bool streaming)
 	{
 		ModulePtr	cmd			= GetModuleByMsg< AsyncCmdBufMsgList_t >();
-		ModulePtr	perframe	= cmd->GetModuleByMsg< CmdBufferMngrMsgList_t >();
 		ModulePtr	image		= _GetParents().Front();
 		BitsU		bpp			= EPixelFormat::BitPerPixel( _format );
 
+		CHECK_ERR( cmd and image );
+		CHECK_ERR( firstLevel <= lastLevel and firstLevel >= _baseLevel );
+
+		const MipmapLevel	base_mip	{ firstLevel - _baseLevel };
+		const uint			level_count	= lastLevel - firstLevel + 1;
+
+		// when streaming starts, levels that are not uploaded yet must not contain garbage
+		const bool			clear_pending	= streaming and firstLevel == _lastLevel and firstLevel > _baseLevel;
+		const MipmapLevel	barrier_mip		= clear_pending ? MipmapLevel(0) : base_mip;
+		const uint			barrier_count	= clear_pending ? _lastLevel - _baseLevel + 1 : level_count;
+
 		// prepare
 		GpuMsg::GetDeviceInfo			req_dev;
 		CHECK( image->Send( req_dev ) );
 
 		GpuMsg::GetGraphicsModules		req_ids;
 		CHECK( req_dev.result->gpuThread->Send( req_ids ) );
-
+		
 		GpuMsg::GetImageDescription		req_descr;
 		CHECK( image->Send( req_descr ) );
 
-		GpuMsg::GetImageMemoryLayout	req_layout;
-		CHECK( image->Send( req_layout ) );
+		const uint		layer_count	= req_descr.result->dimension.w;
 
 
 		// copy buffer to image
 		GraphicsMsg::CmdBeginAsync		begin;
 		begin.syncMode = GraphicsMsg::CmdBeginAsync::EMode::BeforeFrame;
 
+		if ( streaming )
+		{
+			// continue streaming in next update, can't record commands inside callback
+			begin.onCompleted = LAMBDA( self = ModulePtr(this) ) (uint)
+								{
+									CHECK( self->GlobalSystems()->taskModule->SendAsync( ModuleMsg::PushAsyncMessage{
+												self->GetThreadID(),
+												LAMBDA( self ) (GlobalSystemsRef) {
+													self.ToPtr< GX_ImageLoader >()->_StreamNextLevel();
+												}}
+									));
+								};
+		}
+
 		CHECK( cmd->Send( begin ) );
 		
 		cmd->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::TopOfPipe, EPipelineStage::Transfer }
@@ -332,17 +493,29 @@ namespace ImportExport
 									EPipelineAccess::TransferWrite,
 									EImageLayout::Undefined,
 									EImageLayout::TransferDstOptimal,
-									EImageAspect::Color }) );
+									EImageAspect::Color,
+									barrier_mip, barrier_count,
+									ImageLayer(0), layer_count }) );
+
+		if ( clear_pending )
+		{
+			cmd->Send( GpuMsg::CmdClearColorImage{ image, EImageLayout::TransferDstOptimal }
+							.Clear( float4(0.0f) )
+							.AddRange({ EImageAspect::Color, MipmapLevel(0), firstLevel - _baseLevel, ImageLayer(0), layer_count }) );
+		}
 
 		// load levels
 		for (const auto& level : _levels)
 		{
+			if ( level.level < firstLevel or level.level > lastLevel )
+				continue;
+
 			ModulePtr	buffer;
 			CHECK_ERR( GlobalSystems()->modulesFactory->Create(
 										req_ids.result->graphics.buffer,
 										GlobalSystems(),
 										CreateInfo::GpuBuffer{
-											BufferDescription{ BytesU(level.slicePitch) * level.dimension.z, EBufferUsage::TransferSrc },
+											BufferDescription{ _SlicePitch( level ) * Max( level.dimension.z, 1u ), EBufferUsage::TransferSrc },
 											EGpuMemory::CoherentWithCPU,
 											EMemoryAccess::CpuWrite | EMemoryAccess::GpuRead },
 										OUT buffer ) );
@@ -351,7 +524,7 @@ namespace ImportExport
 			GpuMsg::MapMemoryToCpu	map_cmd{ GpuMsg::EMappingFlags::WriteDiscard };
 			buffer->Send( map_cmd );
 
-			_dataInput->Send( DSMsg::ReadMemRange{ *map_cmd.result });
+			_dataInput->Send( DSMsg::ReadMemRange{ _HeaderSize() + BytesU(level.memOffset), *map_cmd.result });
 
 			buffer->Send( GpuMsg::UnmapMemory{} );
 			
@@ -367,9 +540,11 @@ namespace ImportExport
 			copy.dstLayout		= EImageLayout::TransferDstOptimal;
 			copy.regions.PushBack({});
 			copy.regions.Back().bufferRowLength			= uint(level.rowPitch.ToBits()) / uint(bpp);
-			copy.regions.Back().bufferImageHeight		= uint(level.slicePitch / level.rowPitch);
+			copy.regions.Back().bufferImageHeight		= uint(_SlicePitch( level ) / BytesU(level.rowPitch));
 			copy.regions.Back().imageSize				= level.dimension;
 			copy.regions.Back().imageLayers.aspectMask	|= EImageAspect::Color;
+			copy.regions.Back().imageLayers.mipLevel	= MipmapLevel( level.level - _baseLevel );
+			copy.regions.Back().imageLayers.baseLayer	= ImageLayer( level.layer );
 
 			CHECK( cmd->Send( copy ) );
 		}
@@ -395,11 +570,11 @@ namespace ImportExport
 									dst_access,
 									EImageLayout::TransferDstOptimal,
 									_imageLayout,
-									EImageAspect::Color }) );
+									EImageAspect::Color,
+									barrier_mip, barrier_count,
+									ImageLayer(0), layer_count }) );
 
 		CHECK( cmd->Send( GraphicsMsg::CmdEndAsync{} ) );
-		
-		_UnloadImage();
 		return true;
 	}
 //-----------------------------------------------------------------------------
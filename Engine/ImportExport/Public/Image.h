@@ -20,9 +20,13 @@ namespace CreateInfo
 	// variables
 		ModulePtr			dataInput;		// random access data input module
 		EImageLayout::type	imageLayout;	// image layout after loading
+		BytesU				memoryBudget;	// max size of resident mipmap levels, largest levels that doesn't fit will be skipped, 0 - unlimited
+		bool				progressive;	// upload one mipmap level per frame, starting from smallest level
 
 	// methods
-		explicit ImageLoader (const ModulePtr &dataInput, EImageLayout::type layout = EImageLayout::ShaderReadOnlyOptimal) : dataInput{dataInput}, imageLayout{layout} {}
+		explicit ImageLoader (const ModulePtr &dataInput, EImageLayout::type layout = EImageLayout::ShaderReadOnlyOptimal,
+							  BytesU memoryBudget = 0_b, bool progressive = false) :
+			dataInput{dataInput}, imageLayout{layout}, memoryBudget{memoryBudget}, progressive{progressive} {}
 	};
 
 
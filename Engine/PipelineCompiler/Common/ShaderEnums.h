@@ -52,7 +52,7 @@ namespace PipelineCompiler
 		static constexpr type	HLSL_11_BC		= DirectX_11 | DXBC;
 		static constexpr type	HLSL_12_IL		= DirectX_12 | DXIL;
 
-		//static constexpr type	Soft_100_Src	= Software_100 | HighLevel;			// intermediate C++ source
+		static constexpr type	Soft_100_Src	= Software_100 | HighLevel;			// intermediate C++ source, used for runtime compilation
 		static constexpr type	Soft_100_Exe	= Software_100 | CPP_Invocable;		// builtin program in EXE/DLL
 
 		static constexpr type	IntermediateSrc	= VKSL_110;
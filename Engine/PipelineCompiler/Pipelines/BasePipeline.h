@@ -307,6 +307,14 @@ namespace PipelineCompiler
 
 			// allow minimal rebuild based on file modification time.
 			bool							minimalRebuild			= true;
+
+			// number of compute invocations processed per call in C++ shaders,
+			// used only for shaders without barriers and shared memory.
+			uint							softwareBatchSize		= 0;
+
+			// add C++ shader source to pipeline description,
+			// it is used to compile shaders at runtime with host specific flags.
+			bool							softwareShaderSource	= false;
 		};
 
 
@@ -703,6 +703,7 @@ namespace PipelineCompiler
 			cfg.source			= EShaderFormat::IntermediateSrc;
 			cfg.target			= fmt;
 			cfg.skipExternals	= false;
+			cfg.invocationBatch	= convCfg.softwareBatchSize;
 
 			if ( EShaderFormat::GetFormat( fmt ) == EShaderFormat::HighLevel or
 				 EShaderFormat::GetFormat( fmt ) == EShaderFormat::CPP_Invocable )
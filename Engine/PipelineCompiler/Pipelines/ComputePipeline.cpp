@@ -144,6 +144,9 @@ namespace PipelineCompiler
 				src.Insert( ser->ShaderSrcCPP_Impl( name, compiled( EShaderFormat::Soft_100_Exe ), func_name ), pos );
 
 				src << ser->ShaderSrcCPP( name, func_name );
+
+				if ( cfg.softwareShaderSource )
+					src << ser->ShaderToString( EShaderFormat::Soft_100_Src, name, compiled( EShaderFormat::Soft_100_Exe ) );
 			}
 		}
 
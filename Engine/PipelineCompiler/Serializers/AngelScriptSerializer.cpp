@@ -1103,11 +1103,11 @@ namespace PipelineCompiler
 		if ( not shaderSrc.Empty() )
 		{
 			const usize	start	= str.Length();
-			usize		pos		= 0;
 
 			str << StringCRef::From( shaderSrc );
 
-			str.FindAndChange( "##main##", funcName, OUT pos, start );
+			// entry point name may be used several times (batched shader registration)
+			str.ReplaceStrings( "##main##", funcName, start );
 		}
 		return str;
 	}
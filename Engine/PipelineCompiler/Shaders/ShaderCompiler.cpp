@@ -668,6 +668,8 @@ namespace PipelineCompiler
 		CHECK_ERR( EShaderFormat::IsValid( cfg.source ) );
 		CHECK_ERR( EShaderFormat::IsValid( cfg.target ) );
 
+		GX_MEMORY_SCOPE( EMemorySubsystem::ShaderCompiler );
+
 		log.Clear();
 		result.Clear();
 
@@ -752,10 +754,11 @@ namespace PipelineCompiler
 					case EShaderFormat::GLSL :
 					case EShaderFormat::VKSL :
 					{
-						ASSERT( not cfg.optimize and "not supported" );
-
 						if ( cfg.skipExternals or cfg.typeReplacer )
 							;	// go to 'case GXSL'
+						else
+						if ( cfg.optimize )
+							return _OptimizeGLSL( data, baseFolder, cfg, OUT log, OUT result );
 						else
 							return _CopySource( data, OUT result );
 					}
@@ -765,6 +768,7 @@ namespace PipelineCompiler
 
 						CHECK_COMP( _GLSLangParse( cfg, data, baseFolder, OUT log, OUT glslang_data ) );
 						CHECK_COMP( _ReplaceTypes( glslang_data, cfg ) );
+						CHECK_COMP( _OptimizeAST( glslang_data, cfg, INOUT log ) );
 						CHECK_COMP( _TranslateGXSLtoGLSL( cfg, glslang_data, OUT log, OUT result ) );
 						return true;
 					}
@@ -848,6 +852,7 @@ namespace PipelineCompiler
 				_GLSLangResult	glslang_data;
 				CHECK_COMP( _GLSLangParse( cfg2, data2, baseFolder, OUT log, OUT glslang_data ) );
 				CHECK_COMP( _ReplaceTypes( glslang_data, cfg2 ) );
+				CHECK_COMP( _OptimizeAST( glslang_data, cfg2, INOUT log ) );
 				CHECK_COMP( _TranslateGXSLtoHLSL( cfg2, glslang_data, OUT log, OUT result ) );
 				return true;
 			}
@@ -1056,6 +1061,7 @@ namespace PipelineCompiler
 				_GLSLangResult	glslang_data;
 				CHECK_COMP( _GLSLangParse( cfg2, data2, baseFolder, OUT log, OUT glslang_data ) );
 				CHECK_COMP( _ReplaceTypes( glslang_data, cfg2 ) );
+				CHECK_COMP( _OptimizeAST( glslang_data, cfg2, INOUT log ) );
 				CHECK_COMP( _TranslateGXSLtoCL( cfg2, glslang_data, OUT log, OUT result ) );
 				return true;
 			}
@@ -1130,10 +1136,37 @@ namespace PipelineCompiler
 		_GLSLangResult	glslang_data;
 		CHECK_COMP( _GLSLangParse( cfg2, data2, baseFolder, OUT log, OUT glslang_data ) );
 		CHECK_COMP( _ReplaceTypes( glslang_data, cfg2 ) );
+		CHECK_COMP( _OptimizeAST( glslang_data, cfg2, INOUT log ) );
 		CHECK_COMP( _TranslateGXSLtoCPP( cfg2, glslang_data, OUT log, OUT result ) );
 		return true;
 	}
 
+/*
+=================================================
+	_OptimizeGLSL
+----
+	GLSL to GLSL translation is not required,
+	so source is translated only if optimizer changed AST,
+	otherwise original source is used.
+=================================================
+*/
+	bool ShaderCompiler::_OptimizeGLSL (const _ShaderData &data, StringCRef baseFolder, const Config &cfg, OUT String &log, OUT BinaryArray &result)
+	{
+		ASSERT( cfg.optimize and not cfg.skipExternals and not cfg.typeReplacer );
+
+		_GLSLangResult	glslang_data;
+		bool			modified	= false;
+
+		CHECK_COMP( _GLSLangParse( cfg, data, baseFolder, OUT log, OUT glslang_data ) );
+		CHECK_COMP( _OptimizeAST( glslang_data, cfg, INOUT log, OUT &modified ) );
+
+		if ( not modified )
+			return _CopySource( data, OUT result );
+
+		CHECK_COMP( _TranslateGXSLtoGLSL( cfg, glslang_data, OUT log, OUT result ) );
+		return true;
+	}
+
 /*
 =================================================
 	_CopySource
@@ -1161,6 +1194,8 @@ namespace PipelineCompiler
 */
 	bool ShaderCompiler::Validate (EShaderFormat::type shaderFmt, EShader::type shaderType, BinArrayCRef data)
 	{
+		GX_MEMORY_SCOPE( EMemorySubsystem::ShaderCompiler );
+
 		switch ( EShaderFormat::GetApiFormat( shaderFmt ) )
 		{
 			case EShaderFormat::GLSL :			return _ValidateGLSLSource( shaderType, StringCRef::From( data ) );
@@ -54,8 +54,9 @@ namespace PipelineCompiler
 			EShaderFormat::type			source				= Uninitialized;
 			EShaderFormat::type			target				= Uninitialized;
 			bool						skipExternals		= false;		// uniforms, buffers, in/out
-			bool						optimize			= false;		// SPIRV, HLSL bytecode/IL
+			bool						optimize			= false;		// SPIRV, HLSL bytecode/IL, AST before translation
 			bool						inlineAll			= false;
+			uint						invocationBatch		= 0;			// software renderer: invocations per shader call, 0 or 1 - scalar code
 		};
 
 
@@ -120,6 +121,7 @@ namespace PipelineCompiler
 		bool _Compile (const glslang::TIntermediate* intermediate, const Config &cfg, OUT String &log, OUT BinaryArray &result) const;
 
 		bool _CopySource (const _ShaderData &data, OUT BinaryArray &result) const;
+		bool _OptimizeGLSL (const _ShaderData &data, StringCRef baseFolder, const Config &cfg, OUT String &log, OUT BinaryArray &result);
 
 		bool _CheckGLAErrors (OUT String *log = null) const;
 		
@@ -140,6 +142,11 @@ namespace PipelineCompiler
 		bool _ReplaceTypes (const _GLSLangResult &data, const Config &cfg) const;
 
 
+	// AST optimizer
+	private:
+		bool _OptimizeAST (const _GLSLangResult &data, const Config &cfg, INOUT String &log, OUT bool *modified = null) const;
+
+
 	// GLSL deserializer
 	private:
 		static bool _ProcessExternalObjects (TIntermNode* root, TIntermNode* node, INOUT DeserializedShader &result);
@@ -133,7 +133,6 @@ namespace PipelineCompiler
 		CHECK_ERR(	cfg.target == EShaderFormat::CL_120 );*/
 	
 		// not supported here
-		ASSERT( not cfg.optimize );
 		ASSERT( not cfg.skipExternals );
 
 		const glslang::TIntermediate* intermediate = glslangData.prog.getIntermediate( glslangData.shader->getStage() );
@@ -34,14 +34,16 @@ namespace PipelineCompiler
 		ShaderVarNameValidator	_nameValidator;
 		const EShader::type		_shaderType;
 
+		const uint				_invocationBatch;
+
 		uint					_sharedCounter = 0;
 		uint					_barrierCounter = 0;
 
 
 	// methods
 	public:
-		explicit CPP_DstLanguage (EShader::type shaderType) :
-			_nameValidator{EShaderFormat::Soft_100_Exe}, _shaderType{shaderType}
+		CPP_DstLanguage (EShader::type shaderType, uint invocationBatch) :
+			_nameValidator{EShaderFormat::Soft_100_Exe}, _shaderType{shaderType}, _invocationBatch{invocationBatch}
 		{}
 
 		~CPP_DstLanguage ()
@@ -119,9 +121,6 @@ namespace PipelineCompiler
 					EShaderFormat::GetApiFormat( cfg.source ) == EShaderFormat::VKSL );
 		CHECK_ERR(	cfg.target == EShaderFormat::Soft_100_Exe );
 	
-		// not supported here
-		ASSERT( not cfg.optimize );
-
 		const glslang::TIntermediate* intermediate = glslangData.prog.getIntermediate( glslangData.shader->getStage() );
 		CHECK_ERR( intermediate );
 
@@ -131,7 +130,7 @@ namespace PipelineCompiler
 		translator.states.useGXrules	= intermediate->getSource() == glslang::EShSourceGxsl;
 		translator.states.inlineAll		= cfg.inlineAll or (not translator.states.useGXrules);
 		translator.entryPoint			= intermediate->getEntryPointName().c_str();
-		translator.language				= new CPP_DstLanguage( ConvertShaderType( glslangData.shader->getStage() ) );
+		translator.language				= new CPP_DstLanguage( ConvertShaderType( glslangData.shader->getStage() ), cfg.invocationBatch );
 
 		CHECK_ERR( TranslateShaderInfo( intermediate, cfg.skipExternals, translator ) );
 		
@@ -1155,6 +1154,36 @@ namespace PipelineCompiler
 			CHECK_ERR( _TranslateBuiltin( _builtinList[i], INOUT src ) );
 		}
 
+		// batched shader processes several local invocations per call,
+		// invocations are executed in scalar loop and 'return' finishes only current invocation.
+		// This is not SIMD code, batching only reduces per-call overhead (thread dispatch, resource setup).
+		// Barriers and shared memory requires concurrent invocations, so these shaders are always scalar.
+		const bool	batched = (_invocationBatch > 1 and _shaderType == EShader::Compute and
+							_barrierCounter == 0 and _sharedCounter == 0);
+
+		if ( batched )
+		{
+			String	globals_src;
+			FOR( i, _globalVars )
+			{
+				CHECK_ERR( _TranslateGlobal( _globalVars[i].first, _globalVars[i].second, INOUT globals_src ) );
+			}
+			StringParser::IncreaceIndent( INOUT globals_src );
+
+			String	body_src = body;
+			StringParser::IncreaceIndent( INOUT body_src, "\t\t\t" );
+
+			src << "\n	// shader\n"
+				<< "\tconst auto  _invocation_ = [&] ()\n\t{\n"
+				<< globals_src
+				<< "\t\t{\n" << body_src << "\t\t}\n\t};\n\n"
+				<< "\tfor (UInt _inv_ = 0; _helper_.SelectInvocation( _inv_ ); ++_inv_) {\n"
+				<< "\t\t_invocation_();\n"
+				<< "\t}\n}\n\n"
+				<< "static const bool  " << entryPoint << "_batch = Impl::BatchedShaderRegistry::Register( &" << entryPoint << ", " << _invocationBatch << " );\n";
+			return true;
+		}
+
 		// global variables
 		FOR( i, _globalVars )
 		{
@@ -17,6 +17,8 @@ namespace PipelineCompiler
 	{
 		CHECK_ERR( EShaderFormat::IsValid( shaderFmt ) );
 
+		GX_MEMORY_SCOPE( EMemorySubsystem::ShaderCompiler );
+
 		result = DeserializedShader();
 		
 		Config			cfg;
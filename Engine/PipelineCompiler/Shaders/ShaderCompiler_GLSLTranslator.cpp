@@ -100,9 +100,6 @@ namespace PipelineCompiler
 					EShaderFormat::GetApiFormat( cfg.target ) == EShaderFormat::GLSL or
 					EShaderFormat::GetApiFormat( cfg.target ) == EShaderFormat::VKSL );
 	
-		// not supported here
-		ASSERT( not cfg.optimize );
-
 		const glslang::TIntermediate* intermediate = glslangData.prog.getIntermediate( glslangData.shader->getStage() );
 		CHECK_ERR( intermediate );
 
@@ -121,9 +121,6 @@ namespace PipelineCompiler
 
 		CHECK_ERR(	cfg.target == EShaderFormat::HLSL_11 );
 	
-		// not supported here
-		ASSERT( not cfg.optimize );
-
 		const glslang::TIntermediate* intermediate = glslangData.prog.getIntermediate( glslangData.shader->getStage() );
 		CHECK_ERR( intermediate );
 
@@ -6,6 +6,28 @@
 namespace PipelineCompiler
 {
 
+	//
+	// Built-in File Cache
+	//
+	struct BuiltinFileCache
+	{
+	// types
+		using Files_t	= HashMap< String, UniquePtr<String> >;	// null if file is not exists
+
+	// variables
+		ReadWriteSync	lock;
+		Files_t			files;
+
+	// methods
+		static BuiltinFileCache&  Instance ()
+		{
+			static BuiltinFileCache		inst;
+			return inst;
+		}
+	};
+//-----------------------------------------------------------------------------
+
+
 /*
 =================================================
 	constructor
@@ -15,6 +37,11 @@ namespace PipelineCompiler
 		IncludeResult{ headerName, data.cstr(), data.Length(), userData },
 		_data{ RVREF(data) }
 	{}
+	
+    ShaderCompiler::ShaderIncluder::IncludeResultImpl::IncludeResultImpl (StringCRef shared, const std::string& headerName, void* userData) :
+		IncludeResult{ headerName, shared.cstr(), shared.Length(), userData },
+		_shared{ shared }
+	{}
 //-----------------------------------------------------------------------------
 
 
@@ -102,6 +129,52 @@ namespace PipelineCompiler
 		return false;
 	}
 
+/*
+=================================================
+	LoadBuiltinFile
+----
+	sources are generated at runtime by 'glsl_vfs',
+	so they are built once and shared between all shaders.
+	Cached strings are never removed, so returned reference is valid until program exit.
+=================================================
+*/
+	bool ShaderCompiler::ShaderIncluder::LoadBuiltinFile (StringCRef filename, OUT StringCRef &source)
+	{
+		auto&	cache = BuiltinFileCache::Instance();
+		
+		BuiltinFileCache::Files_t::iterator		iter;
+		{
+			SCOPELOCK( cache.lock.GetScopeReadLock() );
+
+			if ( cache.files.Find( filename, OUT iter ) )
+			{
+				if ( not iter->second )
+					return false;
+
+				source = *iter->second;
+				return true;
+			}
+		}
+
+		// build source without lock, another thread may build the same file
+		String				src;
+		UniquePtr<String>	fdata;
+
+		if ( glsl_vfs::LoadFile( filename, OUT src ) )
+			fdata = new String( RVREF(src) );
+
+		SCOPELOCK( cache.lock.GetScopeWriteLock() );
+		
+		if ( not cache.files.Find( filename, OUT iter ) )
+			iter = cache.files.Add( String(filename), RVREF(fdata) );
+
+		if ( not iter->second )
+			return false;
+
+		source = *iter->second;
+		return true;
+	}
+
 /*
 =================================================
 	includeSystem
@@ -123,11 +196,11 @@ namespace PipelineCompiler
 
 
 		// search in built-in virtual file system
-		String	fdata;
+		StringCRef	fdata;
 
-		if ( glsl_vfs::LoadFile( fname, OUT fdata ) )
+		if ( LoadBuiltinFile( fname, OUT fdata ) )
 		{
-			auto	iter = _results.Add( IncludeResultPtr_t{new IncludeResultImpl( RVREF(fdata), headerName )} );
+			auto	iter = _results.Add( IncludeResultPtr_t{new IncludeResultImpl( fdata, headerName )} );
 			
 			_includedFiles.Add( sysfile_name, iter->ptr());
 			return iter->ptr();
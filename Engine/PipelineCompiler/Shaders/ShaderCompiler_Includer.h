@@ -19,12 +19,14 @@ namespace PipelineCompiler
 		struct IncludeResultImpl final : IncludeResult
 		{
 		// variables
-			const String	_data;
+			const String		_data;
+			const StringCRef	_shared;	// source from process-wide cache
 
 		// methods
             IncludeResultImpl (String &&data, const std::string& headerName, void* userData = null);
+            IncludeResultImpl (StringCRef shared, const std::string& headerName, void* userData = null);
 
-			StringCRef GetSource () const	{ return _data; }
+			StringCRef GetSource () const	{ return _data.Empty() ? _shared : StringCRef(_data); }
 		};
 
 		using IncludeResultPtr_t	= UniquePtr< IncludeResultImpl >;
@@ -47,6 +49,9 @@ namespace PipelineCompiler
 		~ShaderIncluder ();
 
 		void AddDirectory (StringCRef path);
+		
+		// returns source of built-in file, cache is shared between all includers
+		static bool LoadBuiltinFile (StringCRef filename, OUT StringCRef &source);
 		bool GetHeaderSource (StringCRef header, OUT StringCRef &source) const;
 
 		// TShader::Includer //
@@ -0,0 +1,1410 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Target independent optimizations for glslang AST,
+	runs once before translation to GLSL, HLSL, OpenCL and C++.
+
+	Passes:
+		- dead function elimination (functions that are unreachable from entry point).
+		- constant propagation for local variables that are initialized once by constant.
+		- constant folding (the same glslang folding that is used for constant expressions).
+		- dead branch elimination for constant conditions.
+		- dead code elimination: unused local variables, code after 'return', 'break', 'continue', 'discard'.
+*/
+
+#include "Engine/PipelineCompiler/Shaders/ShaderCompiler_Utils.h"
+
+namespace PipelineCompiler
+{
+
+	//
+	// AST Optimizer
+	//
+	struct ASTOptimizer
+	{
+	// types
+		using SymbolID	= uint;
+
+		struct Statement
+		{
+			glslang::TIntermAggregate*	seq		= null;		// parent sequence
+			TIntermNode*				node	= null;
+		};
+
+		struct LocalVar
+		{
+			uint						reads	= 0;
+			uint						writes	= 0;
+			glslang::TIntermBinary*		init	= null;		// 'var = constant' in function scope
+			Array< Statement >			stores;				// statements that only write to this variable
+		};
+
+		using LocalVars_t	= HashMap< SymbolID, LocalVar >;
+		using Constants_t	= HashMap< SymbolID, glslang::TIntermConstantUnion* >;
+		using Functions_t	= HashMap< String, glslang::TIntermAggregate* >;
+
+
+	// constants
+		static constexpr uint	MaxIterations	= 8;
+
+
+	// variables
+		glslang::TIntermediate*		intermediate	= null;
+		String						entryPoint;
+		Functions_t					functions;		// signature, definition
+
+		// current function
+		glslang::TIntermAggregate*	funcBody		= null;
+		LocalVars_t					locals;
+		Constants_t					constants;
+		bool						changed			= false;
+
+		// statistic
+		uint						removedFunctions	= 0;
+		uint						removedStatements	= 0;
+		uint						removedBranches		= 0;
+		uint						foldedExpressions	= 0;
+		uint						propagatedConsts	= 0;
+	};
+
+	static bool RegisterFunctions (glslang::TIntermAggregate* root, INOUT ASTOptimizer &opt);
+	static bool RemoveDeadFunctions (glslang::TIntermAggregate* root, INOUT ASTOptimizer &opt);
+	static bool OptimizeFunction (glslang::TIntermAggregate* func, INOUT ASTOptimizer &opt);
+	static void CollectFunctionCalls (TIntermNode* node, INOUT Array<String> &calls);
+	static uint CountNodes (TIntermNode* node);
+
+	static void AnalyzeNode (TIntermNode* node, bool recordStores, INOUT ASTOptimizer &opt);
+	static void AnalyzeLValue (TIntermNode* node, INOUT ASTOptimizer &opt);
+	static void AnalyzeFunctionCall (glslang::TIntermAggregate* call, INOUT ASTOptimizer &opt);
+	static void FindConstants (INOUT ASTOptimizer &opt);
+	static void RemoveDeadStores (INOUT ASTOptimizer &opt);
+
+	static TIntermNode*  RewriteNode (TIntermNode* node, INOUT ASTOptimizer &opt);
+	static glslang::TIntermTyped*  RewriteTyped (glslang::TIntermTyped* node, INOUT ASTOptimizer &opt);
+	static glslang::TIntermTyped*  RewriteSymbol (glslang::TIntermSymbol* symbol, INOUT ASTOptimizer &opt);
+	static glslang::TIntermTyped*  RewriteBinary (glslang::TIntermBinary* binary, INOUT ASTOptimizer &opt);
+	static glslang::TIntermTyped*  RewriteUnary (glslang::TIntermUnary* unary, INOUT ASTOptimizer &opt);
+	static glslang::TIntermTyped*  RewriteAggregate (glslang::TIntermAggregate* aggr, INOUT ASTOptimizer &opt);
+	static TIntermNode*  RewriteSelection (glslang::TIntermSelection* selection, INOUT ASTOptimizer &opt);
+	static TIntermNode*  RewriteBranch (glslang::TIntermBranch* branch, INOUT ASTOptimizer &opt);
+
+	static void OptimizeStatements (TIntermNode* node, INOUT ASTOptimizer &opt);
+	static void OptimizeSequence (glslang::TIntermAggregate* seq, INOUT ASTOptimizer &opt);
+
+	static bool IsPure (TIntermNode* node);
+	static bool IsForLoopHeader (glslang::TIntermAggregate* seq);
+	static bool CanEraseStatements (glslang::TIntermAggregate* seq, ArrayCRef<TIntermNode*> nodes);
+	static void EraseStatement (glslang::TIntermAggregate* seq, TIntermNode* node);
+
+/*
+=================================================
+	_OptimizeAST
+----
+	'modified' is false if AST is not changed,
+	so source may be used without translation.
+=================================================
+*/
+	bool ShaderCompiler::_OptimizeAST (const _GLSLangResult &glslangData, const Config &cfg, INOUT String &log, OUT bool *modified) const
+	{
+		if ( modified )
+			*modified = false;
+
+		if ( not cfg.optimize )
+			return true;
+
+		glslang::TIntermediate*	intermediate = glslangData.prog.getIntermediate( glslangData.shader->getStage() );
+		CHECK_ERR( intermediate );
+
+		glslang::TIntermAggregate*	root = intermediate->getTreeRoot()->getAsAggregate();
+		CHECK_ERR( root and root->getOp() == glslang::TOperator::EOpSequence );
+
+		const uint		size_before	= CountNodes( root );
+
+		ASTOptimizer	opt;
+		opt.intermediate	= intermediate;
+		opt.entryPoint		= intermediate->getEntryPointName().c_str();
+
+		CHECK_ERR( RegisterFunctions( root, INOUT opt ) );
+		CHECK_ERR( RemoveDeadFunctions( root, INOUT opt ) );
+
+		FOR( i, root->getSequence() )
+		{
+			glslang::TIntermAggregate*	aggr = root->getSequence()[i]->getAsAggregate();
+
+			if ( aggr and aggr->getOp() == glslang::TOperator::EOpFunction ) {
+				CHECK_ERR( OptimizeFunction( aggr, INOUT opt ) );
+			}
+		}
+
+		// some function calls may be removed with dead code
+		CHECK_ERR( RemoveDeadFunctions( root, INOUT opt ) );
+
+		log << "AST optimizer: removed " << opt.removedFunctions << " functions, "
+			<< opt.removedStatements << " statements, " << opt.removedBranches << " branches; folded "
+			<< opt.foldedExpressions << " expressions, propagated " << opt.propagatedConsts << " constants; "
+			<< "AST size: " << size_before << " -> " << CountNodes( root ) << " nodes\n";
+
+		if ( modified )
+			*modified = (opt.removedFunctions + opt.removedStatements + opt.removedBranches +
+						 opt.foldedExpressions + opt.propagatedConsts) > 0;
+		return true;
+	}
+
+/*
+=================================================
+	ForEachChild
+=================================================
+*/
+	template <typename Fn>
+	static void ForEachChild (TIntermNode* node, Fn &&fn)
+	{
+		if ( glslang::TIntermAggregate* aggr = node->getAsAggregate() )
+		{
+			FOR( i, aggr->getSequence() ) {
+				if ( aggr->getSequence()[i] )	fn( aggr->getSequence()[i] );
+			}
+		}
+		else
+		if ( glslang::TIntermBinary* binary = node->getAsBinaryNode() )
+		{
+			if ( binary->getLeft() )	fn( binary->getLeft() );
+			if ( binary->getRight() )	fn( binary->getRight() );
+		}
+		else
+		if ( glslang::TIntermUnary* unary = node->getAsUnaryNode() )
+		{
+			if ( unary->getOperand() )	fn( unary->getOperand() );
+		}
+		else
+		if ( glslang::TIntermSelection* selection = node->getAsSelectionNode() )
+		{
+			if ( selection->getCondition() )	fn( selection->getCondition() );
+			if ( selection->getTrueBlock() )	fn( selection->getTrueBlock() );
+			if ( selection->getFalseBlock() )	fn( selection->getFalseBlock() );
+		}
+		else
+		if ( glslang::TIntermLoop* loop = node->getAsLoopNode() )
+		{
+			if ( loop->getBody() )		fn( loop->getBody() );
+			if ( loop->getTest() )		fn( loop->getTest() );
+			if ( loop->getTerminal() )	fn( loop->getTerminal() );
+		}
+		else
+		if ( glslang::TIntermBranch* branch = node->getAsBranchNode() )
+		{
+			if ( branch->getExpression() )	fn( branch->getExpression() );
+		}
+		else
+		if ( glslang::TIntermSwitch* sw = node->getAsSwitchNode() )
+		{
+			if ( sw->getCondition() )	fn( sw->getCondition() );
+			if ( sw->getBody() )		fn( sw->getBody() );
+		}
+		else
+		if ( glslang::TIntermMethod* method = node->getAsMethodNode() )
+		{
+			if ( method->getObject() )	fn( method->getObject() );
+		}
+	}
+
+/*
+=================================================
+	IsAccessOp
+=================================================
+*/
+	static bool IsAccessOp (glslang::TOperator op)
+	{
+		return	op == glslang::TOperator::EOpIndexDirect		or
+				op == glslang::TOperator::EOpIndexIndirect		or
+				op == glslang::TOperator::EOpIndexDirectStruct	or
+				op == glslang::TOperator::EOpVectorSwizzle;
+	}
+
+/*
+=================================================
+	HasOutArguments
+----
+	builtin functions with 'out' arguments
+=================================================
+*/
+	static bool HasOutArguments (glslang::TOperator op)
+	{
+		switch ( op )
+		{
+			case glslang::TOperator::EOpModf :
+			case glslang::TOperator::EOpFrexp :
+			case glslang::TOperator::EOpAddCarry :
+			case glslang::TOperator::EOpSubBorrow :
+			case glslang::TOperator::EOpUMulExtended :
+			case glslang::TOperator::EOpIMulExtended :
+			case glslang::TOperator::EOpSparseTexture :
+			case glslang::TOperator::EOpSparseTextureLod :
+			case glslang::TOperator::EOpSparseTextureOffset :
+			case glslang::TOperator::EOpSparseTextureFetch :
+			case glslang::TOperator::EOpSparseTextureFetchOffset :
+			case glslang::TOperator::EOpSparseTextureLodOffset :
+			case glslang::TOperator::EOpSparseTextureGrad :
+			case glslang::TOperator::EOpSparseTextureGradOffset :
+			case glslang::TOperator::EOpSparseTextureGather :
+			case glslang::TOperator::EOpSparseTextureGatherOffset :
+			case glslang::TOperator::EOpSparseTextureGatherOffsets :
+			case glslang::TOperator::EOpSparseTextureClamp :
+			case glslang::TOperator::EOpSparseTextureOffsetClamp :
+			case glslang::TOperator::EOpSparseTextureGradClamp :
+			case glslang::TOperator::EOpSparseTextureGradOffsetClamp :
+			case glslang::TOperator::EOpSparseTextureGatherLod :
+			case glslang::TOperator::EOpSparseTextureGatherLodOffset :
+			case glslang::TOperator::EOpSparseTextureGatherLodOffsets :
+			case glslang::TOperator::EOpSparseImageLoad :
+			case glslang::TOperator::EOpSparseImageLoadLod :
+				return true;
+
+			default :
+				break;
+		}
+		return false;
+	}
+
+/*
+=================================================
+	HasSideEffects
+----
+	builtin functions that changes memory or pipeline state
+=================================================
+*/
+	static bool HasSideEffects (glslang::TOperator op)
+	{
+		switch ( op )
+		{
+			case glslang::TOperator::EOpAtomicAdd :
+			case glslang::TOperator::EOpAtomicMin :
+			case glslang::TOperator::EOpAtomicMax :
+			case glslang::TOperator::EOpAtomicAnd :
+			case glslang::TOperator::EOpAtomicOr :
+			case glslang::TOperator::EOpAtomicXor :
+			case glslang::TOperator::EOpAtomicExchange :
+			case glslang::TOperator::EOpAtomicCompSwap :
+			case glslang::TOperator::EOpAtomicCounterIncrement :
+			case glslang::TOperator::EOpAtomicCounterDecrement :
+			case glslang::TOperator::EOpAtomicCounter :
+			case glslang::TOperator::EOpAtomicCounterAdd :
+			case glslang::TOperator::EOpAtomicCounterSubtract :
+			case glslang::TOperator::EOpAtomicCounterMin :
+			case glslang::TOperator::EOpAtomicCounterMax :
+			case glslang::TOperator::EOpAtomicCounterAnd :
+			case glslang::TOperator::EOpAtomicCounterOr :
+			case glslang::TOperator::EOpAtomicCounterXor :
+			case glslang::TOperator::EOpAtomicCounterExchange :
+			case glslang::TOperator::EOpAtomicCounterCompSwap :
+			case glslang::TOperator::EOpImageStore :
+			case glslang::TOperator::EOpImageStoreLod :
+			case glslang::TOperator::EOpImageAtomicAdd :
+			case glslang::TOperator::EOpImageAtomicMin :
+			case glslang::TOperator::EOpImageAtomicMax :
+			case glslang::TOperator::EOpImageAtomicAnd :
+			case glslang::TOperator::EOpImageAtomicOr :
+			case glslang::TOperator::EOpImageAtomicXor :
+			case glslang::TOperator::EOpImageAtomicExchange :
+			case glslang::TOperator::EOpImageAtomicCompSwap :
+			case glslang::TOperator::EOpEmitVertex :
+			case glslang::TOperator::EOpEndPrimitive :
+			case glslang::TOperator::EOpEmitStreamVertex :
+			case glslang::TOperator::EOpEndStreamPrimitive :
+			case glslang::TOperator::EOpBarrier :
+			case glslang::TOperator::EOpMemoryBarrier :
+			case glslang::TOperator::EOpMemoryBarrierAtomicCounter :
+			case glslang::TOperator::EOpMemoryBarrierBuffer :
+			case glslang::TOperator::EOpMemoryBarrierImage :
+			case glslang::TOperator::EOpMemoryBarrierShared :
+			case glslang::TOperator::EOpGroupMemoryBarrier :
+				return true;
+
+			default :
+				break;
+		}
+		return false;
+	}
+
+/*
+=================================================
+	IsPure
+----
+	returns true if expression can be removed without changing program behavior
+=================================================
+*/
+	static bool IsPure (TIntermNode* node)
+	{
+		if ( node == null )
+			return true;
+
+		if ( node->getAsSymbolNode() or node->getAsConstantUnion() )
+			return true;
+
+		if ( glslang::TIntermBinary* binary = node->getAsBinaryNode() )
+		{
+			return	not binary->modifiesState()		and
+					IsPure( binary->getLeft() )		and
+					IsPure( binary->getRight() );
+		}
+
+		if ( glslang::TIntermUnary* unary = node->getAsUnaryNode() )
+		{
+			return	not unary->modifiesState()				and
+					not HasSideEffects( unary->getOp() )	and
+					IsPure( unary->getOperand() );
+		}
+
+		if ( glslang::TIntermAggregate* aggr = node->getAsAggregate() )
+		{
+			// user defined function may change global state
+			if ( aggr->getOp() == glslang::TOperator::EOpFunctionCall	or
+				 HasOutArguments( aggr->getOp() )						or
+				 HasSideEffects( aggr->getOp() ) )
+				return false;
+
+			FOR( i, aggr->getSequence() ) {
+				if ( not IsPure( aggr->getSequence()[i] ) )
+					return false;
+			}
+			return true;
+		}
+
+		if ( glslang::TIntermSelection* selection = node->getAsSelectionNode() )
+		{
+			return	IsPure( selection->getCondition() )		and
+					IsPure( selection->getTrueBlock() )		and
+					IsPure( selection->getFalseBlock() );
+		}
+
+		if ( glslang::TIntermMethod* method = node->getAsMethodNode() )
+		{
+			return IsPure( method->getObject() );
+		}
+
+		return false;
+	}
+
+/*
+=================================================
+	GetLocalVar
+=================================================
+*/
+	static ASTOptimizer::LocalVar*  GetLocalVar (glslang::TIntermSymbol* symbol, INOUT ASTOptimizer &opt)
+	{
+		if ( symbol == null or symbol->getQualifier().storage != glslang::TStorageQualifier::EvqTemporary )
+			return null;
+
+		return &opt.locals.AddOrSkip( ASTOptimizer::SymbolID( symbol->getId() ), {} )->second;
+	}
+
+/*
+=================================================
+	GetStoreTarget
+----
+	returns local variable if statement only writes to it
+=================================================
+*/
+	static glslang::TIntermSymbol*  GetStoreTarget (TIntermNode* node)
+	{
+		glslang::TIntermTyped*	lvalue = null;
+
+		if ( glslang::TIntermBinary* binary = node->getAsBinaryNode() )
+		{
+			if ( not binary->modifiesState() or not IsPure( binary->getRight() ) )
+				return null;
+
+			lvalue = binary->getLeft();
+		}
+		else
+		if ( glslang::TIntermUnary* unary = node->getAsUnaryNode() )
+		{
+			if ( not unary->modifiesState() )
+				return null;
+
+			lvalue = unary->getOperand();
+		}
+		else
+			return null;
+
+		for (; lvalue->getAsBinaryNode() and IsAccessOp( lvalue->getAsBinaryNode()->getOp() );)
+		{
+			glslang::TIntermBinary*	access = lvalue->getAsBinaryNode();
+
+			if ( not IsPure( access->getRight() ) )
+				return null;
+
+			lvalue = access->getLeft();
+		}
+
+		glslang::TIntermSymbol*	symbol = lvalue->getAsSymbolNode();
+
+		return symbol and symbol->getQualifier().storage == glslang::TStorageQualifier::EvqTemporary ? symbol : null;
+	}
+
+/*
+=================================================
+	IsConstInitializer
+----
+	'var = constant'
+=================================================
+*/
+	static bool IsConstInitializer (TIntermNode* node)
+	{
+		glslang::TIntermBinary*		binary = node->getAsBinaryNode();
+
+		if ( not binary or binary->getOp() != glslang::TOperator::EOpAssign )
+			return false;
+
+		if ( not binary->getLeft()->getAsSymbolNode() or not binary->getRight()->getAsConstantUnion() )
+			return false;
+
+		const glslang::TType&	type = binary->getLeft()->getType();
+
+		if ( type.isArray() or type.isStruct() )
+			return false;
+
+		switch ( type.getBasicType() )
+		{
+			case glslang::TBasicType::EbtFloat :
+			case glslang::TBasicType::EbtDouble :
+			case glslang::TBasicType::EbtInt :
+			case glslang::TBasicType::EbtUint :
+			case glslang::TBasicType::EbtInt64 :
+			case glslang::TBasicType::EbtUint64 :
+			case glslang::TBasicType::EbtBool :
+				return true;
+
+			default :
+				break;
+		}
+		return false;
+	}
+
+/*
+=================================================
+	GetConstCondition
+=================================================
+*/
+	static bool GetConstCondition (glslang::TIntermTyped* cond, OUT bool &value)
+	{
+		glslang::TIntermConstantUnion*	cu = cond ? cond->getAsConstantUnion() : null;
+
+		if ( not cu or cu->getConstArray().size() != 1 or cu->getConstArray()[0].getType() != glslang::TBasicType::EbtBool )
+			return false;
+
+		value = cu->getConstArray()[0].getBConst();
+		return true;
+	}
+
+/*
+=================================================
+	IsForLoopHeader
+----
+	translator expects that 'for' loop is a sequence of initializer and loop node
+=================================================
+*/
+	static bool IsForLoopHeader (glslang::TIntermAggregate* seq)
+	{
+		if ( seq->getSequence().empty() )
+			return false;
+
+		glslang::TIntermLoop*	loop = seq->getSequence().back()->getAsLoopNode();
+
+		return loop and loop->testFirst() and loop->getTerminal();
+	}
+
+/*
+=================================================
+	HasCaseLabels
+=================================================
+*/
+	static bool HasCaseLabels (glslang::TIntermAggregate* seq)
+	{
+		FOR( i, seq->getSequence() )
+		{
+			glslang::TIntermBranch*	branch = seq->getSequence()[i]->getAsBranchNode();
+
+			if ( branch and (branch->getFlowOp() == glslang::TOperator::EOpCase or
+							 branch->getFlowOp() == glslang::TOperator::EOpDefault) )
+				return true;
+		}
+		return false;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	RegisterFunctions
+=================================================
+*/
+	static bool RegisterFunctions (glslang::TIntermAggregate* root, INOUT ASTOptimizer &opt)
+	{
+		FOR( i, root->getSequence() )
+		{
+			glslang::TIntermAggregate*	aggr = root->getSequence()[i]->getAsAggregate();
+
+			if ( aggr and aggr->getOp() == glslang::TOperator::EOpFunction ) {
+				opt.functions.Add( aggr->getName().c_str(), aggr );
+			}
+		}
+		return true;
+	}
+
+/*
+=================================================
+	CountNodes
+----
+	used as code size metric
+=================================================
+*/
+	static uint CountNodes (TIntermNode* node)
+	{
+		uint	count = 1;
+
+		ForEachChild( node, [&count] (TIntermNode* n) { count += CountNodes( n ); });
+		return count;
+	}
+
+/*
+=================================================
+	CollectFunctionCalls
+=================================================
+*/
+	static void CollectFunctionCalls (TIntermNode* node, INOUT Array<String> &calls)
+	{
+		glslang::TIntermAggregate*	aggr = node->getAsAggregate();
+
+		if ( aggr and aggr->getOp() == glslang::TOperator::EOpFunctionCall )
+			calls.PushBack( aggr->getName().c_str() );
+
+		ForEachChild( node, [&calls] (TIntermNode* n) { CollectFunctionCalls( n, INOUT calls ); });
+	}
+
+/*
+=================================================
+	RemoveDeadFunctions
+----
+	removes functions that are unreachable from entry point,
+	most of them included from 'glsl_vfs' libraries
+=================================================
+*/
+	static bool RemoveDeadFunctions (glslang::TIntermAggregate* root, INOUT ASTOptimizer &opt)
+	{
+		HashSet< String >	used;
+		Array< String >		pending;
+		bool				has_entry	= false;
+		const String		entry		= String( opt.entryPoint ) << '(';
+
+		FOR( i, root->getSequence() )
+		{
+			TIntermNode*				node = root->getSequence()[i];
+			glslang::TIntermAggregate*	aggr = node->getAsAggregate();
+
+			if ( aggr and aggr->getOp() == glslang::TOperator::EOpFunction )
+			{
+				if ( StringCRef( aggr->getName().c_str() ).StartsWith( entry ) ) {
+					pending.PushBack( aggr->getName().c_str() );
+					has_entry = true;
+				}
+			}
+			else
+			if ( not aggr or aggr->getOp() != glslang::TOperator::EOpLinkerObjects )
+			{
+				// global variable initializers may call functions
+				CollectFunctionCalls( node, INOUT pending );
+			}
+		}
+
+		// keep all functions if entry point is not found
+		if ( not has_entry )
+			return true;
+
+		for (; not pending.Empty();)
+		{
+			const String	sign = pending.Back();
+			pending.PopBack();
+
+			if ( used.IsExist( sign ) )
+				continue;
+
+			used.Add( sign );
+
+			ASTOptimizer::Functions_t::iterator	iter;
+			if ( opt.functions.Find( sign, OUT iter ) ) {
+				CollectFunctionCalls( iter->second, INOUT pending );
+			}
+		}
+
+		auto&	seq = root->getSequence();
+
+		for (usize i = 0; i < seq.size();)
+		{
+			glslang::TIntermAggregate*	aggr = seq[i]->getAsAggregate();
+
+			if ( aggr and aggr->getOp() == glslang::TOperator::EOpFunction and not used.IsExist( aggr->getName().c_str() ) )
+			{
+				opt.functions.Erase( aggr->getName().c_str() );
+				seq.erase( seq.begin() + i );
+				++opt.removedFunctions;
+			}
+			else
+				++i;
+		}
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	OptimizeFunction
+=================================================
+*/
+	static bool OptimizeFunction (glslang::TIntermAggregate* func, INOUT ASTOptimizer &opt)
+	{
+		opt.funcBody = null;
+
+		FOR( i, func->getSequence() )
+		{
+			glslang::TIntermAggregate*	aggr = func->getSequence()[i]->getAsAggregate();
+
+			if ( aggr and aggr->getOp() == glslang::TOperator::EOpSequence )
+				opt.funcBody = aggr;
+		}
+
+		// function without body
+		if ( not opt.funcBody )
+			return true;
+
+		for (uint i = 0; i < ASTOptimizer::MaxIterations; ++i)
+		{
+			opt.changed = false;
+			opt.locals.Clear();
+			opt.constants.Clear();
+
+			AnalyzeNode( opt.funcBody, true, INOUT opt );
+			FindConstants( INOUT opt );
+
+			CHECK_ERR( RewriteNode( opt.funcBody, INOUT opt ) == opt.funcBody );
+
+			RemoveDeadStores( INOUT opt );
+			OptimizeStatements( opt.funcBody, INOUT opt );
+
+			if ( not opt.changed )
+				break;
+		}
+
+		opt.funcBody = null;
+		opt.locals.Clear();
+		opt.constants.Clear();
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	AnalyzeNode
+----
+	counts reads and writes of local variables
+=================================================
+*/
+	static void AnalyzeNode (TIntermNode* node, bool recordStores, INOUT ASTOptimizer &opt)
+	{
+		if ( glslang::TIntermSymbol* symbol = node->getAsSymbolNode() )
+		{
+			if ( auto* var = GetLocalVar( symbol, INOUT opt ) )
+				++var->reads;
+			return;
+		}
+
+		if ( glslang::TIntermBinary* binary = node->getAsBinaryNode() )
+		{
+			if ( binary->modifiesState() )
+			{
+				AnalyzeLValue( binary->getLeft(), INOUT opt );
+				AnalyzeNode( binary->getRight(), recordStores, INOUT opt );
+				return;
+			}
+		}
+
+		if ( glslang::TIntermUnary* unary = node->getAsUnaryNode() )
+		{
+			if ( unary->modifiesState() )
+			{
+				AnalyzeLValue( unary->getOperand(), INOUT opt );
+				return;
+			}
+		}
+
+		if ( glslang::TIntermAggregate* aggr = node->getAsAggregate() )
+		{
+			if ( aggr->getOp() == glslang::TOperator::EOpFunctionCall )
+			{
+				AnalyzeFunctionCall( aggr, INOUT opt );
+				return;
+			}
+
+			if ( HasOutArguments( aggr->getOp() ) )
+			{
+				FOR( i, aggr->getSequence() ) {
+					AnalyzeLValue( aggr->getSequence()[i], INOUT opt );
+				}
+				return;
+			}
+
+			if ( aggr->getOp() == glslang::TOperator::EOpSequence )
+			{
+				// don't change 'for' loop initializer
+				const bool	is_header	= IsForLoopHeader( aggr );
+				const bool	record		= recordStores and not is_header;
+
+				FOR( i, aggr->getSequence() )
+				{
+					TIntermNode*	stmt = aggr->getSequence()[i];
+
+					if ( record )
+					{
+						if ( auto* var = GetLocalVar( GetStoreTarget( stmt ), INOUT opt ) )
+						{
+							var->stores.PushBack({ aggr, stmt });
+
+							if ( aggr == opt.funcBody and IsConstInitializer( stmt ) )
+								var->init = stmt->getAsBinaryNode();
+						}
+					}
+
+					AnalyzeNode( stmt, not is_header, INOUT opt );
+				}
+				return;
+			}
+		}
+
+		ForEachChild( node, [&opt] (TIntermNode* n) { AnalyzeNode( n, true, INOUT opt ); });
+	}
+
+/*
+=================================================
+	AnalyzeLValue
+=================================================
+*/
+	static void AnalyzeLValue (TIntermNode* node, INOUT ASTOptimizer &opt)
+	{
+		if ( glslang::TIntermSymbol* symbol = node->getAsSymbolNode() )
+		{
+			if ( auto* var = GetLocalVar( symbol, INOUT opt ) )
+				++var->writes;
+			return;
+		}
+
+		glslang::TIntermBinary*	binary = node->getAsBinaryNode();
+
+		if ( binary and IsAccessOp( binary->getOp() ) )
+		{
+			AnalyzeLValue( binary->getLeft(), INOUT opt );
+			AnalyzeNode( binary->getRight(), true, INOUT opt );
+			return;
+		}
+
+		// argument is an expression
+		AnalyzeNode( node, true, INOUT opt );
+	}
+
+/*
+=================================================
+	AnalyzeFunctionCall
+=================================================
+*/
+	static void AnalyzeFunctionCall (glslang::TIntermAggregate* call, INOUT ASTOptimizer &opt)
+	{
+		glslang::TIntermAggregate*				params	= null;
+		ASTOptimizer::Functions_t::iterator		iter;
+
+		if ( opt.functions.Find( call->getName().c_str(), OUT iter ) )
+		{
+			FOR( i, iter->second->getSequence() )
+			{
+				glslang::TIntermAggregate*	aggr = iter->second->getSequence()[i]->getAsAggregate();
+
+				if ( aggr and aggr->getOp() == glslang::TOperator::EOpParameters )
+					params = aggr;
+			}
+		}
+
+		FOR( i, call->getSequence() )
+		{
+			TIntermNode*	arg		= call->getSequence()[i];
+			bool			is_out	= true;		// if function is unknown
+
+			if ( params and i < params->getSequence().size() )
+			{
+				const auto	storage = params->getSequence()[i]->getAsTyped()->getQualifier().storage;
+
+				is_out = (storage == glslang::TStorageQualifier::EvqOut or storage == glslang::TStorageQualifier::EvqInOut);
+			}
+
+			if ( is_out )
+				AnalyzeLValue( arg, INOUT opt );
+			else
+				AnalyzeNode( arg, true, INOUT opt );
+		}
+	}
+
+/*
+=================================================
+	FindConstants
+----
+	local variable that has single write in function scope
+	and this write is a constant, can be replaced by constant
+=================================================
+*/
+	static void FindConstants (INOUT ASTOptimizer &opt)
+	{
+		for (auto& item : opt.locals)
+		{
+			auto const&		var = item.second;
+
+			if ( var.init and var.writes == 1 and var.reads > 0 )
+			{
+				opt.constants.Add( item.first, var.init->getRight()->getAsConstantUnion() );
+			}
+		}
+	}
+
+/*
+=================================================
+	RemoveDeadStores
+----
+	removes variables that are written but never readed
+=================================================
+*/
+	static void RemoveDeadStores (INOUT ASTOptimizer &opt)
+	{
+		Array< TIntermNode* >	nodes;
+
+		for (auto& item : opt.locals)
+		{
+			auto const&		var = item.second;
+
+			if ( var.reads > 0 or var.writes == 0 or var.writes != var.stores.Count() )
+				continue;
+
+			// check all sequences before changing
+			bool	can_erase = true;
+
+			FOR( i, var.stores )
+			{
+				nodes.Clear();
+
+				FOR( j, var.stores ) {
+					if ( var.stores[j].seq == var.stores[i].seq )
+						nodes.PushBack( var.stores[j].node );
+				}
+
+				can_erase &= CanEraseStatements( var.stores[i].seq, nodes );
+			}
+
+			if ( not can_erase )
+				continue;
+
+			FOR( i, var.stores ) {
+				EraseStatement( var.stores[i].seq, var.stores[i].node );
+			}
+
+			opt.removedStatements += uint(var.stores.Count());
+			opt.changed = true;
+		}
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	RewriteNode
+----
+	propagates constants and folds expressions,
+	returns new node if it was replaced
+=================================================
+*/
+	static TIntermNode*  RewriteNode (TIntermNode* node, INOUT ASTOptimizer &opt)
+	{
+		if ( node == null )
+			return null;
+
+		if ( glslang::TIntermSymbol* symbol = node->getAsSymbolNode() )
+			return RewriteSymbol( symbol, INOUT opt );
+
+		if ( glslang::TIntermBinary* binary = node->getAsBinaryNode() )
+			return RewriteBinary( binary, INOUT opt );
+
+		if ( glslang::TIntermUnary* unary = node->getAsUnaryNode() )
+			return RewriteUnary( unary, INOUT opt );
+
+		if ( glslang::TIntermAggregate* aggr = node->getAsAggregate() )
+			return RewriteAggregate( aggr, INOUT opt );
+
+		if ( glslang::TIntermSelection* selection = node->getAsSelectionNode() )
+			return RewriteSelection( selection, INOUT opt );
+
+		if ( glslang::TIntermBranch* branch = node->getAsBranchNode() )
+			return RewriteBranch( branch, INOUT opt );
+
+		// loop has no setters for test and terminal nodes, so only body is processed
+		if ( glslang::TIntermLoop* loop = node->getAsLoopNode() )
+		{
+			if ( loop->getBody() and loop->getBody()->getAsAggregate() )
+				RewriteNode( loop->getBody(), INOUT opt );
+			return loop;
+		}
+
+		if ( glslang::TIntermSwitch* sw = node->getAsSwitchNode() )
+		{
+			if ( sw->getBody() )
+				RewriteNode( sw->getBody(), INOUT opt );
+			return sw;
+		}
+
+		// constant union, method
+		return node;
+	}
+
+/*
+=================================================
+	RewriteTyped
+=================================================
+*/
+	static glslang::TIntermTyped*  RewriteTyped (glslang::TIntermTyped* node, INOUT ASTOptimizer &opt)
+	{
+		TIntermNode*	result = RewriteNode( node, INOUT opt );
+
+		return result ? result->getAsTyped() : null;
+	}
+
+/*
+=================================================
+	ReplaceByConstant
+=================================================
+*/
+	static glslang::TIntermTyped*  ReplaceByConstant (glslang::TIntermTyped* node, glslang::TIntermTyped* folded, INOUT ASTOptimizer &opt)
+	{
+		if ( folded == null or not folded->getAsConstantUnion() or not (folded->getType() == node->getType()) )
+			return node;
+
+		folded->setLoc( node->getLoc() );
+
+		++opt.foldedExpressions;
+		opt.changed = true;
+		return folded;
+	}
+
+/*
+=================================================
+	RewriteSymbol
+=================================================
+*/
+	static glslang::TIntermTyped*  RewriteSymbol (glslang::TIntermSymbol* symbol, INOUT ASTOptimizer &opt)
+	{
+		ASTOptimizer::Constants_t::iterator		iter;
+
+		if ( not opt.constants.Find( ASTOptimizer::SymbolID( symbol->getId() ), OUT iter ) )
+			return symbol;
+
+		// all glslang objects use GC
+		glslang::TType*					type	= symbol->getType().clone();
+		type->getQualifier().storage	= glslang::TStorageQualifier::EvqConst;
+
+		glslang::TIntermConstantUnion*	cu		= new glslang::TIntermConstantUnion( iter->second->getConstArray(), *type );
+		cu->setLoc( symbol->getLoc() );
+
+		++opt.propagatedConsts;
+		opt.changed = true;
+		return cu;
+	}
+
+/*
+=================================================
+	RewriteBinary
+=================================================
+*/
+	static glslang::TIntermTyped*  RewriteBinary (glslang::TIntermBinary* binary, INOUT ASTOptimizer &opt)
+	{
+		const glslang::TOperator	op = binary->getOp();
+
+		// left side is not changed
+		if ( binary->modifiesState() )
+		{
+			binary->setRight( RewriteTyped( binary->getRight(), INOUT opt ) );
+			return binary;
+		}
+
+		// indexed object must not be replaced by constant, translators doesn't support it for all types
+		if ( IsAccessOp( op ) )
+		{
+			glslang::TIntermTyped*	left = binary->getLeft();
+
+			if ( not left->getAsSymbolNode() )
+			{
+				glslang::TIntermTyped*	new_left = RewriteTyped( left, INOUT opt );
+
+				if ( not new_left->getAsConstantUnion() or left->getAsConstantUnion() )
+					binary->setLeft( new_left );
+			}
+
+			if ( op == glslang::TOperator::EOpIndexIndirect )
+				binary->setRight( RewriteTyped( binary->getRight(), INOUT opt ) );
+
+			return binary;
+		}
+
+		binary->setLeft( RewriteTyped( binary->getLeft(), INOUT opt ) );
+		binary->setRight( RewriteTyped( binary->getRight(), INOUT opt ) );
+
+		glslang::TIntermConstantUnion*	left	= binary->getLeft()->getAsConstantUnion();
+		glslang::TIntermConstantUnion*	right	= binary->getRight()->getAsConstantUnion();
+		bool							cond	= false;
+
+		// short circuit
+		if ( left and GetConstCondition( left, OUT cond ) )
+		{
+			if ( op == glslang::TOperator::EOpLogicalAnd or op == glslang::TOperator::EOpLogicalOr )
+			{
+				const bool	use_left = (op == glslang::TOperator::EOpLogicalAnd ? not cond : cond);
+
+				++opt.foldedExpressions;
+				opt.changed = true;
+				return use_left ? binary->getLeft() : binary->getRight();
+			}
+		}
+
+		if ( left and right )
+			return ReplaceByConstant( binary, left->fold( op, right ), INOUT opt );
+
+		return binary;
+	}
+
+/*
+=================================================
+	RewriteUnary
+=================================================
+*/
+	static glslang::TIntermTyped*  RewriteUnary (glslang::TIntermUnary* unary, INOUT ASTOptimizer &opt)
+	{
+		if ( unary->modifiesState() )
+			return unary;
+
+		unary->setOperand( RewriteTyped( unary->getOperand(), INOUT opt ) );
+
+		if ( glslang::TIntermConstantUnion* cu = unary->getOperand()->getAsConstantUnion() )
+			return ReplaceByConstant( unary, cu->fold( unary->getOp(), unary->getType() ), INOUT opt );
+
+		return unary;
+	}
+
+/*
+=================================================
+	RewriteAggregate
+=================================================
+*/
+	static glslang::TIntermTyped*  RewriteAggregate (glslang::TIntermAggregate* aggr, INOUT ASTOptimizer &opt)
+	{
+		auto&	seq = aggr->getSequence();
+
+		switch ( aggr->getOp() )
+		{
+			case glslang::TOperator::EOpSequence :
+			{
+				FOR( i, seq ) {
+					seq[i] = RewriteNode( seq[i], INOUT opt );
+				}
+				return aggr;
+			}
+
+			case glslang::TOperator::EOpFunctionCall :
+			{
+				// only 'in' arguments of known function can be changed
+				ASTOptimizer::Functions_t::iterator		iter;
+
+				if ( not opt.functions.Find( aggr->getName().c_str(), OUT iter ) )
+					return aggr;
+
+				FOR( i, iter->second->getSequence() )
+				{
+					glslang::TIntermAggregate*	params = iter->second->getSequence()[i]->getAsAggregate();
+
+					if ( not params or params->getOp() != glslang::TOperator::EOpParameters )
+						continue;
+
+					for (usize j = 0; j < seq.size() and j < params->getSequence().size(); ++j)
+					{
+						const auto	storage = params->getSequence()[j]->getAsTyped()->getQualifier().storage;
+
+						if ( storage == glslang::TStorageQualifier::EvqIn or storage == glslang::TStorageQualifier::EvqConstReadOnly )
+							seq[j] = RewriteNode( seq[j], INOUT opt );
+					}
+				}
+				return aggr;
+			}
+
+			case glslang::TOperator::EOpFunction :
+			case glslang::TOperator::EOpParameters :
+			case glslang::TOperator::EOpLinkerObjects :
+				return aggr;
+
+			default :
+				break;
+		}
+
+		if ( HasOutArguments( aggr->getOp() ) )
+			return aggr;
+
+		bool	all_const = true;
+
+		FOR( i, seq )
+		{
+			seq[i]		= RewriteNode( seq[i], INOUT opt );
+			all_const	&= (seq[i]->getAsConstantUnion() != null);
+		}
+
+		// builtin function or constructor
+		if ( all_const and not seq.empty() and not aggr->getType().isArray() and not aggr->getType().isStruct() and
+			 not HasSideEffects( aggr->getOp() ) )
+		{
+			return ReplaceByConstant( aggr, opt.intermediate->fold( aggr ), INOUT opt );
+		}
+		return aggr;
+	}
+
+/*
+=================================================
+	RewriteSelection
+----
+	glslang has no setters for selection, so new node will be created
+=================================================
+*/
+	static TIntermNode*  RewriteSelection (glslang::TIntermSelection* selection, INOUT ASTOptimizer &opt)
+	{
+		glslang::TIntermTyped*	cond		= RewriteTyped( selection->getCondition(), INOUT opt );
+		TIntermNode*			true_block	= RewriteNode( selection->getTrueBlock(), INOUT opt );
+		TIntermNode*			false_block	= RewriteNode( selection->getFalseBlock(), INOUT opt );
+		bool					value		= false;
+
+		// conditional operator
+		if ( selection->getBasicType() != glslang::TBasicType::EbtVoid )
+		{
+			TIntermNode*	chosen = null;
+
+			if ( GetConstCondition( cond, OUT value ) and
+				 (chosen = (value ? true_block : false_block)) != null and
+				 chosen->getAsTyped() and chosen->getAsTyped()->getType() == selection->getType() )
+			{
+				++opt.foldedExpressions;
+				opt.changed = true;
+				return chosen;
+			}
+
+			if ( cond			!= selection->getCondition()	or
+				 true_block		!= selection->getTrueBlock()	or
+				 false_block	!= selection->getFalseBlock() )
+			{
+				glslang::TIntermSelection*	result = new glslang::TIntermSelection( cond, true_block, false_block, selection->getType() );
+				result->setLoc( selection->getLoc() );
+				return result;
+			}
+			return selection;
+		}
+
+		// 'if' statement, constant condition is processed in 'OptimizeSequence'
+		if ( cond			!= selection->getCondition()	or
+			 true_block		!= selection->getTrueBlock()	or
+			 false_block	!= selection->getFalseBlock() )
+		{
+			glslang::TIntermSelection*	result = new glslang::TIntermSelection( cond, true_block, false_block );
+			result->setLoc( selection->getLoc() );
+			return result;
+		}
+		return selection;
+	}
+
+/*
+=================================================
+	RewriteBranch
+=================================================
+*/
+	static TIntermNode*  RewriteBranch (glslang::TIntermBranch* branch, INOUT ASTOptimizer &opt)
+	{
+		if ( not branch->getExpression() )
+			return branch;
+
+		glslang::TIntermTyped*	expr = RewriteTyped( branch->getExpression(), INOUT opt );
+
+		if ( expr == branch->getExpression() )
+			return branch;
+
+		glslang::TIntermBranch*	result = new glslang::TIntermBranch( branch->getFlowOp(), expr );
+		result->setLoc( branch->getLoc() );
+		return result;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	OptimizeStatements
+=================================================
+*/
+	static void OptimizeStatements (TIntermNode* node, INOUT ASTOptimizer &opt)
+	{
+		if ( node == null )
+			return;
+
+		if ( glslang::TIntermAggregate* aggr = node->getAsAggregate() )
+		{
+			if ( aggr->getOp() == glslang::TOperator::EOpSequence )
+				OptimizeSequence( aggr, INOUT opt );
+		}
+		else
+		if ( glslang::TIntermSelection* selection = node->getAsSelectionNode() )
+		{
+			if ( selection->getBasicType() == glslang::TBasicType::EbtVoid )
+			{
+				OptimizeStatements( selection->getTrueBlock(), INOUT opt );
+				OptimizeStatements( selection->getFalseBlock(), INOUT opt );
+			}
+		}
+		else
+		if ( glslang::TIntermLoop* loop = node->getAsLoopNode() )
+		{
+			OptimizeStatements( loop->getBody(), INOUT opt );
+		}
+		else
+		if ( glslang::TIntermSwitch* sw = node->getAsSwitchNode() )
+		{
+			OptimizeStatements( sw->getBody(), INOUT opt );
+		}
+	}
+
+/*
+=================================================
+	OptimizeSequence
+----
+	removes dead branches and unreachable code
+=================================================
+*/
+	static void OptimizeSequence (glslang::TIntermAggregate* aggr, INOUT ASTOptimizer &opt)
+	{
+		auto&		seq			= aggr->getSequence();
+		const bool	is_special	= IsForLoopHeader( aggr ) or HasCaseLabels( aggr );
+
+		for (usize i = 0; i < seq.size(); ++i)
+		{
+			glslang::TIntermSelection*	selection	= seq[i]->getAsSelectionNode();
+			bool						value		= false;
+
+			// 'if' with constant condition
+			if ( not is_special and selection and
+				 selection->getBasicType() == glslang::TBasicType::EbtVoid and
+				 GetConstCondition( selection->getCondition(), OUT value ) )
+			{
+				TIntermNode*	chosen = value ? selection->getTrueBlock() : selection->getFalseBlock();
+
+				if ( chosen == null )
+				{
+					if ( CanEraseStatements( aggr, { seq[i] } ) )
+					{
+						seq.erase( seq.begin() + i );
+						--i;
+
+						++opt.removedBranches;
+						opt.changed = true;
+						continue;
+					}
+				}
+				else
+				if ( not value or selection->getFalseBlock() )
+				{
+					// keep block to keep scope of local variables
+					glslang::TConstUnionArray		arr(1);		arr[0].setBConst( true );
+					glslang::TIntermConstantUnion*	cond		= new glslang::TIntermConstantUnion( arr, glslang::TType( glslang::TBasicType::EbtBool, glslang::TStorageQualifier::EvqConst ));
+					glslang::TIntermSelection*		result		= new glslang::TIntermSelection( cond, chosen, null );
+
+					cond->setLoc( selection->getCondition()->getLoc() );
+					result->setLoc( selection->getLoc() );
+					seq[i] = result;
+
+					++opt.removedBranches;
+					opt.changed = true;
+				}
+			}
+
+			OptimizeStatements( seq[i], INOUT opt );
+
+			// unreachable code
+			glslang::TIntermBranch*	branch = seq[i]->getAsBranchNode();
+
+			if ( not is_special and branch and i+1 < seq.size() and
+				 (branch->getFlowOp() == glslang::TOperator::EOpReturn	or
+				  branch->getFlowOp() == glslang::TOperator::EOpKill	or
+				  branch->getFlowOp() == glslang::TOperator::EOpBreak	or
+				  branch->getFlowOp() == glslang::TOperator::EOpContinue) )
+			{
+				opt.removedStatements += uint(seq.size() - i - 1);
+				opt.changed = true;
+
+				seq.erase( seq.begin() + i + 1, seq.end() );
+				break;
+			}
+		}
+	}
+
+/*
+=================================================
+	CanEraseStatements
+----
+	sequence must not be empty, translator doesn't support empty blocks,
+	and new last node must not be a 'for' loop, otherwise it will be translated as loop header
+=================================================
+*/
+	static bool CanEraseStatements (glslang::TIntermAggregate* aggr, ArrayCRef<TIntermNode*> nodes)
+	{
+		const auto&		seq		= aggr->getSequence();
+		usize			found	= 0;
+		TIntermNode*	last	= null;
+
+		FOR( i, seq )
+		{
+			if ( nodes.IsExist( seq[i] ) )
+				++found;
+			else
+				last = seq[i];
+		}
+
+		if ( found != nodes.Count() or last == null )
+			return false;
+
+		if ( last == seq.back() )
+			return true;
+
+		glslang::TIntermLoop*	loop = last->getAsLoopNode();
+
+		return not (loop and loop->testFirst() and loop->getTerminal());
+	}
+
+/*
+=================================================
+	EraseStatement
+=================================================
+*/
+	static void EraseStatement (glslang::TIntermAggregate* aggr, TIntermNode* node)
+	{
+		auto&	seq = aggr->getSequence();
+
+		FOR( i, seq )
+		{
+			if ( seq[i] == node ) {
+				seq.erase( seq.begin() + i );
+				return;
+			}
+		}
+	}
+
+}	// PipelineCompiler
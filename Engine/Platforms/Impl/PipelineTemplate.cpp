@@ -33,6 +33,7 @@
 #ifdef GRAPHICS_API_SOFT
 #include "Engine/Platforms/Soft/Impl/SWMessages.h"
 #include "Engine/Platforms/Soft/SoftRendererObjectsConstructor.h"
+#include "Engine/Platforms/Soft/Impl/SWNativeShaderCache.h"
 #endif
 
 
@@ -990,7 +991,22 @@ namespace Platforms
 		
 		CHECK_ERR( _descr.supportedShaders[EShader::Compute] );
 		
-		SWInvoke_t	func = _descr.shaders[EShader::Compute].GetInvocable( EShaderLangFormat::Software_100 | EShaderLangFormat::CPP_Invocable );
+		auto const&	shader	= _descr.shaders[EShader::Compute];
+		SWInvoke_t	func	= null;
+
+		// try to use shader that is compiled with host specific flags
+		auto&		native_cache	= PlatformSW::SWNativeShaderCache::Instance();
+		StringCRef	native_src		= shader.GetString( EShaderLangFormat::Software_100 | EShaderLangFormat::HighLevel );
+
+		if ( native_cache.IsEnabled() and not native_src.Empty() and
+			 not native_cache.GetShader( native_src, OUT func ) )
+		{
+			LOG( "failed to compile native software shader, builtin shader will be used", ELog::Warning );
+		}
+
+		if ( not func )
+			func = shader.GetInvocable( EShaderLangFormat::Software_100 | EShaderLangFormat::CPP_Invocable );
+
 		CHECK_ERR( func );
 		
 		_swData.shaders[EShader::Compute] = func;
@@ -2244,6 +2244,10 @@ namespace PlatformGL
 
 		ASSERT( buf_res.Get<1>().usage[ EBufferUsage::TransferDst ] );
 		ASSERT( msg.stride >= SizeOf<GLuint64> );
+		CHECK_ERR( not msg.flags[ EQueryResult::Value32 ] and not msg.flags[ EQueryResult::WithAvailability ] );
+
+		// non-blocking by default
+		const GLenum	pname	= msg.flags[ EQueryResult::Wait ] ? GL_QUERY_RESULT : GL_QUERY_RESULT_NO_WAIT;
 
 		GL_CALL( glBindBuffer( GL_QUERY_BUFFER, buf_res.Get<0>() ) );
 
@@ -2258,7 +2262,7 @@ namespace PlatformGL
 
 				ASSERT( msg.dstOffset + offset + SizeOf<GLuint64> < buf_res.Get<1>().size );
 
-				GL_CALL( glGetQueryObjectui64v( q.id, GL_QUERY_RESULT_NO_WAIT, ptr + offset ) );
+				GL_CALL( glGetQueryObjectui64v( q.id, pname, ptr + offset ) );
 
 				offset += msg.stride;
 			}
@@ -2274,7 +2278,7 @@ namespace PlatformGL
 				{
 					ASSERT( msg.dstOffset + offset + SizeOf<GLuint64> < buf_res.Get<1>().size );
 
-					GL_CALL( glGetQueryObjectui64v( q.id, GL_QUERY_RESULT_NO_WAIT, ptr + offset ) );
+					GL_CALL( glGetQueryObjectui64v( q.id, pname, ptr + offset ) );
 
 					offset += msg.stride;
 				}
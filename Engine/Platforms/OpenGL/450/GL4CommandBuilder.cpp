@@ -1036,6 +1036,7 @@ namespace PlatformGL
 		CHECK_ERR( _cmdBuffer );
 		CHECK_ERR( _scope == EScope::Command );
 		CHECK_ERR( msg.queryPool and msg.dstBuffer );
+		CHECK_ERR( not msg.flags[ EQueryResult::Value32 ] and not msg.flags[ EQueryResult::WithAvailability ] );	// not supported
 		
 		_commands.PushBack({ msg, __FILE__, __LINE__ });
 		return true;
@@ -356,6 +356,8 @@ namespace PlatformGL
 		GL_CALL( glGetIntegeri_v( GL_MAX_COMPUTE_WORK_GROUP_SIZE, 2, OUT &idata[2] ) );
 		_properties.maxComputeWorkGroupSize = uint3( idata[0], idata[1], idata[2] );
 
+		_properties.timestampPeriod = 1.0f;		// GL_TIMESTAMP is in nanoseconds
+
 		_properties.explicitMemoryObjects = false; //IsExtensionSupported( "GL_EXT_memory_object" );
 	}
 	
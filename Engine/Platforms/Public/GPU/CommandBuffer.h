@@ -7,6 +7,7 @@
 #include "Engine/Platforms/Public/GPU/VertexEnums.h"
 #include "Engine/Platforms/Public/GPU/ImageEnums.h"
 #include "Engine/Platforms/Public/GPU/ShaderEnums.h"
+#include "Engine/Platforms/Public/GPU/QueryEnums.h"
 
 namespace Engine
 {
@@ -65,6 +66,7 @@ namespace GpuMsg
 {
 	using EImageLayout		= Platforms::EImageLayout;
 	using GpuEventId		= Platforms::GpuEventId;
+	using EQueryResult		= Platforms::EQueryResult;
 	
 	//
 	// Image Subresource Range
@@ -1319,9 +1321,11 @@ namespace GpuMsg
 		ModulePtr	queryPool;
 		uint		firstQueryIndex	= 0;
 		uint		queryCount		= 1;
-		ModulePtr	dstBuffer;
-		BytesU		dstOffset;
-		BytesU		stride;
+		ModulePtr			dstBuffer;
+		BytesU				dstOffset;
+		BytesU				stride;
+		EQueryResult::bits	flags;		// 64 bit values without waiting by default,
+										// set 'Wait' if results are required in the same command buffer
 		
 	// methods
 		CmdCopyQueryPoolResults () {}
@@ -1339,6 +1343,11 @@ namespace GpuMsg
 			this->stride	= valStride;
 			return *this;
 		}
+
+		CmdCopyQueryPoolResults&  SetFlags (EQueryResult::bits value) {
+			this->flags = value;
+			return *this;
+		}
 	};
 
 
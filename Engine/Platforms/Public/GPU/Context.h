@@ -52,6 +52,7 @@ namespace Platforms
 				NoErrorContext,	// OpenGL only
 				VSync,			// enable vertical synchronization
 				NoSurface,		// create context without surface
+				PinThreads,		// software renderer only: pin compute threads to physical cores
 				_Count
 			};
 
@@ -41,11 +41,29 @@ namespace Platforms
 			TessellationEvaluationShaderInvocations,
 			ComputeShaderInvocations,
 
+			// software renderer only
+			ComputeShaderWorkGroups,
+
 			_Count
 		};
 
 		GX_ENUM_BITFIELD( EPipelineStatistic );
 	};
 
+
+	struct EQueryResult
+	{
+		enum type : uint
+		{
+			Value32,			// write 32 bit values instead of 64 bit
+			Wait,				// wait until results are available
+			WithAvailability,	// write availability value after each query result
+
+			_Count
+		};
+
+		GX_ENUM_BITFIELD( EQueryResult );
+	};
+
 }	// Platforms
 }	// Engine
@@ -167,6 +167,9 @@ namespace GpuMsg
 			uint3	maxComputeWorkGroupSize;		// local size
 			uint3	maxComputeWorkGroupCount;
 
+			// queries
+			float	timestampPeriod			= 0.0f;		// nanoseconds per timestamp tick, 0 if timestamps are not supported
+
 			// features
 			bool	explicitMemoryObjects	= false;
 		};
@@ -0,0 +1,808 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Platforms/Public/Tools/GpuMemoryAllocator.h"
+
+namespace Engine
+{
+namespace PlatformTools
+{
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	TLSFBlockAllocator::TLSFBlockAllocator (BytesU size, BytesU granularity) :
+		_size{ usize(size) },
+		_granularity{ GXMath::Max( usize(granularity), usize(16) ) }
+	{
+		ASSERT( IsPowerOfTwo( _granularity ) );
+
+		_size &= ~(_granularity - 1);
+
+		Clear();
+	}
+
+/*
+=================================================
+	Clear
+----
+	release all allocations
+=================================================
+*/
+	void TLSFBlockAllocator::Clear ()
+	{
+		_blocks.Clear();
+		_unusedBlocks.Clear();
+
+		_flBitmap	= 0;
+		_usedSize	= 0;
+		_allocCount	= 0;
+
+		ZeroMem( _slBitmap );
+
+		for (uint i = 0; i < _FLCount; ++i)
+		for (uint j = 0; j < _SLCount; ++j) {
+			_freeHeads[i][j] = _InvalidIdx;
+		}
+
+		_firstBlock = _NewBlock();
+
+		Block&	block = _blocks[_firstBlock];
+		block.offset	= 0;
+		block.size		= _size;
+		block.isFree	= true;
+
+		_InsertFree( _firstBlock );
+	}
+
+/*
+=================================================
+	_MappingInsert
+----
+	small blocks are linearly distributed between second level lists,
+	other blocks are distributed by power of two (first level)
+	and linearly inside first level.
+=================================================
+*/
+	void TLSFBlockAllocator::_MappingInsert (usize size, OUT uint &fl, OUT uint &sl)
+	{
+		if ( size < _SmallSize )
+		{
+			fl = 0;
+			sl = uint(size / (_SmallSize / _SLCount));
+			return;
+		}
+
+		const uint	log2 = uint(IntLog2( size ));
+
+		fl = log2 - _SmallLog2 + 1;
+		sl = uint(size >> (log2 - _SLLog2)) ^ _SLCount;
+	}
+
+/*
+=================================================
+	_MappingSearch
+----
+	rounds size up to the next list,
+	so any block in found list is large enough.
+=================================================
+*/
+	void TLSFBlockAllocator::_MappingSearch (usize size, OUT uint &fl, OUT uint &sl)
+	{
+		if ( size < _SmallSize )
+			size = AlignToLarge( size, _SmallSize / _SLCount );
+		else
+			size += (usize(1) << (uint(IntLog2( size )) - _SLLog2)) - 1;
+
+		_MappingInsert( size, OUT fl, OUT sl );
+	}
+
+/*
+=================================================
+	_FindFree
+=================================================
+*/
+	TLSFBlockAllocator::Index_t  TLSFBlockAllocator::_FindFree (INOUT uint &fl, INOUT uint &sl) const
+	{
+		if ( fl >= _FLCount )
+			return _InvalidIdx;
+
+		uint	sl_map = _slBitmap[fl] & (~0u << sl);
+
+		if ( sl_map == 0 )
+		{
+			const ulong	fl_map = (fl + 1 < CompileTime::SizeOf<ulong>::bits ? _flBitmap & (~0ull << (fl + 1)) : 0);
+
+			if ( fl_map == 0 )
+				return _InvalidIdx;
+
+			fl		= uint(usize(BitScanForward( fl_map )));
+			sl_map	= _slBitmap[fl];
+			ASSERT( sl_map != 0 );
+		}
+
+		sl = uint(usize(BitScanForward( sl_map )));
+
+		return _freeHeads[fl][sl];
+	}
+
+/*
+=================================================
+	_FindExact
+----
+	slow path, checks all blocks in lists between
+	requested size and size with alignment padding.
+=================================================
+*/
+	TLSFBlockAllocator::Index_t  TLSFBlockAllocator::_FindExact (usize size, usize align) const
+	{
+		uint	fl, sl, last_fl, last_sl;
+		_MappingInsert( size, OUT fl, OUT sl );
+		_MappingSearch( size + (align - _granularity), OUT last_fl, OUT last_sl );
+
+		for (; fl < _FLCount and (fl < last_fl or (fl == last_fl and sl <= last_sl)); sl = (sl + 1) % _SLCount, fl += uint(sl == 0))
+		{
+			if ( (_slBitmap[fl] & (1u << sl)) == 0 )
+				continue;
+
+			for (Index_t idx = _freeHeads[fl][sl]; idx != _InvalidIdx; idx = _blocks[idx].nextFree)
+			{
+				auto const&	block = _blocks[idx];
+
+				if ( AlignToLarge( block.offset, align ) + size <= block.offset + block.size )
+					return idx;
+			}
+		}
+		return _InvalidIdx;
+	}
+
+/*
+=================================================
+	_InsertFree
+=================================================
+*/
+	void TLSFBlockAllocator::_InsertFree (Index_t idx)
+	{
+		Block&	block = _blocks[idx];
+		uint	fl, sl;
+
+		_MappingInsert( block.size, OUT fl, OUT sl );
+
+		const Index_t	head = _freeHeads[fl][sl];
+
+		block.isFree	= true;
+		block.prevFree	= _InvalidIdx;
+		block.nextFree	= head;
+
+		if ( head != _InvalidIdx )
+			_blocks[head].prevFree = idx;
+
+		_freeHeads[fl][sl]	 = idx;
+		_flBitmap			|= (1ull << fl);
+		_slBitmap[fl]		|= (1u << sl);
+	}
+
+/*
+=================================================
+	_RemoveFree
+=================================================
+*/
+	void TLSFBlockAllocator::_RemoveFree (Index_t idx)
+	{
+		Block&	block = _blocks[idx];
+		uint	fl, sl;
+
+		ASSERT( block.isFree );
+		_MappingInsert( block.size, OUT fl, OUT sl );
+
+		if ( block.prevFree != _InvalidIdx )
+			_blocks[block.prevFree].nextFree = block.nextFree;
+
+		if ( block.nextFree != _InvalidIdx )
+			_blocks[block.nextFree].prevFree = block.prevFree;
+
+		if ( _freeHeads[fl][sl] == idx )
+		{
+			_freeHeads[fl][sl] = block.nextFree;
+
+			if ( block.nextFree == _InvalidIdx )
+			{
+				_slBitmap[fl] &= ~(1u << sl);
+
+				if ( _slBitmap[fl] == 0 )
+					_flBitmap &= ~(1ull << fl);
+			}
+		}
+
+		block.isFree	= false;
+		block.prevFree	= _InvalidIdx;
+		block.nextFree	= _InvalidIdx;
+	}
+
+/*
+=================================================
+	_NewBlock
+=================================================
+*/
+	TLSFBlockAllocator::Index_t  TLSFBlockAllocator::_NewBlock ()
+	{
+		if ( not _unusedBlocks.Empty() )
+		{
+			const Index_t	idx = _unusedBlocks.Back();
+			_unusedBlocks.PopBack();
+
+			_blocks[idx] = Block();
+			return idx;
+		}
+
+		_blocks.PushBack( Block() );
+		return Index_t(_blocks.LastIndex());
+	}
+
+/*
+=================================================
+	_ReleaseBlock
+=================================================
+*/
+	void TLSFBlockAllocator::_ReleaseBlock (Index_t idx)
+	{
+		_blocks[idx] = Block();
+		_unusedBlocks.PushBack( idx );
+	}
+
+/*
+=================================================
+	_Split
+----
+	splits block to [offset, offset + size) and the rest,
+	returns index of the rest block.
+=================================================
+*/
+	TLSFBlockAllocator::Index_t  TLSFBlockAllocator::_Split (Index_t idx, usize size)
+	{
+		ASSERT( _blocks[idx].size > size );
+
+		const Index_t	rest_idx	= _NewBlock();		// may invalidate references
+		Block&			block		= _blocks[idx];
+		Block&			rest		= _blocks[rest_idx];
+
+		rest.offset		= block.offset + size;
+		rest.size		= block.size - size;
+		rest.prevPhys	= idx;
+		rest.nextPhys	= block.nextPhys;
+
+		if ( block.nextPhys != _InvalidIdx )
+			_blocks[block.nextPhys].prevPhys = rest_idx;
+
+		block.size		= size;
+		block.nextPhys	= rest_idx;
+
+		return rest_idx;
+	}
+
+/*
+=================================================
+	_MergeWithNext
+----
+	both blocks must be removed from free lists
+=================================================
+*/
+	void TLSFBlockAllocator::_MergeWithNext (Index_t idx)
+	{
+		Block&			block		= _blocks[idx];
+		const Index_t	next_idx	= block.nextPhys;
+		Block&			next		= _blocks[next_idx];
+
+		ASSERT( block.offset + block.size == next.offset );
+
+		block.size		+= next.size;
+		block.nextPhys	 = next.nextPhys;
+
+		if ( next.nextPhys != _InvalidIdx )
+			_blocks[next.nextPhys].prevPhys = idx;
+
+		_ReleaseBlock( next_idx );
+	}
+
+/*
+=================================================
+	Allocate
+=================================================
+*/
+	bool TLSFBlockAllocator::Allocate (BytesU inSize, BytesU inAlign, OUT Index_t &outBlock, OUT BytesU &outOffset)
+	{
+		const usize	align	= GXMath::Max( usize(inAlign), _granularity );
+		const usize	size	= AlignToLarge( GXMath::Max( usize(inSize), usize(1) ), _granularity );
+		const usize	search	= size + (align - _granularity);
+
+		CHECK_ERR( IsPowerOfTwo( align ) );
+
+		if ( size > _size - _usedSize )
+			return false;
+
+		uint	fl, sl;
+		_MappingSearch( search, OUT fl, OUT sl );
+
+		Index_t		idx = _FindFree( INOUT fl, INOUT sl );
+
+		// search in lists that may contain suitable block,
+		// required when free block has exactly requested size
+		if ( idx == _InvalidIdx )
+			idx = _FindExact( size, align );
+
+		if ( idx == _InvalidIdx )
+			return false;
+
+		_RemoveFree( idx );
+
+		// split padding for alignment
+		const usize	aligned	= AlignToLarge( _blocks[idx].offset, align );
+
+		if ( aligned != _blocks[idx].offset )
+		{
+			const Index_t	pad_idx = idx;
+
+			idx = _Split( pad_idx, aligned - _blocks[pad_idx].offset );
+			_InsertFree( pad_idx );
+		}
+
+		// return unused memory
+		if ( _blocks[idx].size - size >= _granularity )
+		{
+			_InsertFree( _Split( idx, size ) );
+		}
+
+		Block&	block = _blocks[idx];
+		block.align	= align;
+
+		_usedSize	+= block.size;
+		_allocCount	+= 1;
+
+		outBlock	= idx;
+		outOffset	= BytesU(block.offset);
+		return true;
+	}
+
+/*
+=================================================
+	Deallocate
+=================================================
+*/
+	bool TLSFBlockAllocator::Deallocate (Index_t idx)
+	{
+		CHECK_ERR( idx < _blocks.Count() );
+		CHECK_ERR( not _blocks[idx].isFree and _blocks[idx].size > 0 );
+
+		_usedSize	-= _blocks[idx].size;
+		_allocCount	-= 1;
+		_blocks[idx].align = 0;
+
+		// merge with neighbours
+		const Index_t	next = _blocks[idx].nextPhys;
+
+		if ( next != _InvalidIdx and _blocks[next].isFree )
+		{
+			_RemoveFree( next );
+			_MergeWithNext( idx );
+		}
+
+		const Index_t	prev = _blocks[idx].prevPhys;
+
+		if ( prev != _InvalidIdx and _blocks[prev].isFree )
+		{
+			_RemoveFree( prev );
+			_MergeWithNext( prev );
+			idx = prev;
+		}
+
+		_InsertFree( idx );
+		return true;
+	}
+
+/*
+=================================================
+	GetAllocations
+=================================================
+*/
+	void TLSFBlockAllocator::GetAllocations (OUT Array<AllocationInfo> &result) const
+	{
+		result.Clear();
+		result.Reserve( _allocCount );
+
+		for (Index_t idx = _firstBlock; idx != _InvalidIdx; idx = _blocks[idx].nextPhys)
+		{
+			auto const&	block = _blocks[idx];
+
+			if ( not block.isFree )
+				result.PushBack({ idx, BytesU(block.offset), BytesU(block.size), BytesU(block.align) });
+		}
+	}
+
+/*
+=================================================
+	LargestFreeBlock
+=================================================
+*/
+	BytesU  TLSFBlockAllocator::LargestFreeBlock () const
+	{
+		if ( _flBitmap == 0 )
+			return 0_b;
+
+		const uint	fl		= uint(usize(BitScanReverse( _flBitmap )));
+		const uint	sl		= uint(usize(BitScanReverse( _slBitmap[fl] )));
+		usize		size	= 0;
+
+		for (Index_t idx = _freeHeads[fl][sl]; idx != _InvalidIdx; idx = _blocks[idx].nextFree) {
+			size = GXMath::Max( size, _blocks[idx].size );
+		}
+		return BytesU(size);
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	LinearBlockAllocator::LinearBlockAllocator (BytesU size, BytesU granularity) :
+		_size{ usize(size) },
+		_granularity{ GXMath::Max( usize(granularity), usize(1) ) }
+	{
+		ASSERT( IsPowerOfTwo( _granularity ) );
+	}
+
+/*
+=================================================
+	Allocate
+=================================================
+*/
+	bool LinearBlockAllocator::Allocate (BytesU inSize, BytesU inAlign, OUT BytesU &outOffset)
+	{
+		const usize	align	= GXMath::Max( usize(inAlign), _granularity );
+		const usize	size	= AlignToLarge( GXMath::Max( usize(inSize), usize(1) ), _granularity );
+		const usize	offset	= AlignToLarge( _offset, align );
+
+		CHECK_ERR( IsPowerOfTwo( align ) );
+
+		if ( offset + size > _size )
+			return false;
+
+		_offset		= offset + size;
+		_allocCount	+= 1;
+
+		outOffset	= BytesU(offset);
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	GpuMemoryAllocator::GpuMemoryAllocator (BytesU pageSize, BytesU granularity) :
+		_pageSize{ pageSize },
+		_granularity{ GXMath::Max( granularity, 1_b ) }
+	{
+		ASSERT( IsPowerOfTwo( _granularity ) );
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	GpuMemoryAllocator::~GpuMemoryAllocator ()
+	{
+		ASSERT( PageCount() == 0 );		// call 'Clear' and release pages
+	}
+
+/*
+=================================================
+	AddPage
+----
+	returns page index
+=================================================
+*/
+	uint GpuMemoryAllocator::AddPage (BytesU size, ulong userData, bool transient)
+	{
+		Page	page;
+		page.userData = userData;
+
+		if ( transient )
+			page.transient	= UniquePtr<LinearBlockAllocator>{ new LinearBlockAllocator( size, _granularity ) };
+		else
+			page.generic	= UniquePtr<TLSFBlockAllocator>{ new TLSFBlockAllocator( size, _granularity ) };
+
+		// reuse released slot
+		FOR( i, _pages )
+		{
+			if ( not _pages[i].IsValid() )
+			{
+				_pages[i] = RVREF(page);
+				return uint(i);
+			}
+		}
+
+		_pages.PushBack( RVREF(page) );
+		return uint(_pages.LastIndex());
+	}
+
+/*
+=================================================
+	PageUserData
+=================================================
+*/
+	ulong GpuMemoryAllocator::PageUserData (uint page) const
+	{
+		CHECK_ERR( page < _pages.Count() and _pages[page].IsValid() );
+
+		return _pages[page].userData;
+	}
+
+/*
+=================================================
+	PageCount
+=================================================
+*/
+	usize GpuMemoryAllocator::PageCount () const
+	{
+		usize	count = 0;
+
+		for (auto& page : _pages) {
+			count += usize(page.IsValid());
+		}
+		return count;
+	}
+
+/*
+=================================================
+	_AllocateInPages
+=================================================
+*/
+	bool GpuMemoryAllocator::_AllocateInPages (BytesU size, BytesU align, uint skipPage, OUT Allocation &result)
+	{
+		FOR( i, _pages )
+		{
+			auto&	page = _pages[i];
+
+			if ( not page.generic or i == skipPage )
+				continue;
+
+			if ( page.generic->Allocate( size, align, OUT result.block, OUT result.offset ) )
+			{
+				result.page	= uint(i);
+				result.size	= size;
+				return true;
+			}
+		}
+		return false;
+	}
+
+/*
+=================================================
+	Allocate
+----
+	returns false if there is no free space,
+	in this case new page must be added.
+=================================================
+*/
+	bool GpuMemoryAllocator::Allocate (BytesU size, BytesU align, OUT Allocation &result)
+	{
+		result = Allocation();
+
+		return _AllocateInPages( size, align, UMax, OUT result );
+	}
+
+/*
+=================================================
+	AllocateTransient
+=================================================
+*/
+	bool GpuMemoryAllocator::AllocateTransient (BytesU size, BytesU align, OUT Allocation &result)
+	{
+		result = Allocation();
+
+		FOR( i, _pages )
+		{
+			auto&	page = _pages[i];
+
+			if ( page.transient and page.transient->Allocate( size, align, OUT result.offset ) )
+			{
+				result.page	= uint(i);
+				result.size	= size;
+				return true;
+			}
+		}
+		return false;
+	}
+
+/*
+=================================================
+	Deallocate
+----
+	transient allocations are released by 'ResetTransient'
+=================================================
+*/
+	bool GpuMemoryAllocator::Deallocate (INOUT Allocation &alloc)
+	{
+		CHECK_ERR( alloc.IsValid() and alloc.page < _pages.Count() );
+
+		auto&	page = _pages[alloc.page];
+
+		if ( alloc.IsTransient() )
+		{
+			CHECK_ERR( page.transient );
+		}
+		else
+		{
+			CHECK_ERR( page.generic and page.generic->Deallocate( alloc.block ) );
+		}
+
+		alloc = Allocation();
+		return true;
+	}
+
+/*
+=================================================
+	ResetTransient
+=================================================
+*/
+	void GpuMemoryAllocator::ResetTransient ()
+	{
+		for (auto& page : _pages)
+		{
+			if ( page.transient )
+				page.transient->Reset();
+		}
+	}
+
+/*
+=================================================
+	ReleaseEmptyPages
+----
+	returns user data of removed pages,
+	caller must release memory.
+=================================================
+*/
+	void GpuMemoryAllocator::ReleaseEmptyPages (usize keepPages, OUT PageUserData_t &released)
+	{
+		released.Clear();
+
+		usize	empty_pages = 0;
+
+		for (auto& page : _pages)
+		{
+			if ( not page.generic or not page.generic->Empty() )
+				continue;
+
+			if ( ++empty_pages <= keepPages )
+				continue;
+
+			released.PushBack( page.userData );
+			page = Page();
+		}
+	}
+
+/*
+=================================================
+	Clear
+=================================================
+*/
+	void GpuMemoryAllocator::Clear (OUT PageUserData_t &released)
+	{
+		released.Clear();
+
+		for (auto& page : _pages)
+		{
+			if ( page.IsValid() )
+			{
+				if ( page.generic ) {
+					ASSERT( page.generic->Empty() );
+				}
+				released.PushBack( page.userData );
+			}
+		}
+		_pages.Clear();
+	}
+
+/*
+=================================================
+	PlanDefragmentation
+----
+	moves allocations from the least used page to other pages,
+	so the page may be released after all moves are applied.
+=================================================
+*/
+	void GpuMemoryAllocator::PlanDefragmentation (usize maxMoves, OUT DefragMoves_t &moves)
+	{
+		moves.Clear();
+
+		// find the least used page
+		uint	src_page	= UMax;
+		float	min_usage	= 1.0f;
+
+		FOR( i, _pages )
+		{
+			auto&	page = _pages[i];
+
+			if ( not page.generic or page.generic->Empty() )
+				continue;
+
+			const float	usage = float(usize(page.generic->UsedSize())) / float(usize(page.generic->Size()));
+
+			if ( usage < min_usage )
+			{
+				min_usage	= usage;
+				src_page	= uint(i);
+			}
+		}
+
+		if ( src_page == UMax )
+			return;
+
+		Array< TLSFBlockAllocator::AllocationInfo >		allocations;
+		_pages[src_page].generic->GetAllocations( OUT allocations );
+
+		for (auto& info : allocations)
+		{
+			if ( moves.Count() >= maxMoves )
+				break;
+
+			DefragMove	move;
+			move.src.page	= src_page;
+			move.src.block	= info.block;
+			move.src.offset	= info.offset;
+			move.src.size	= info.size;
+
+			if ( not _AllocateInPages( info.size, info.align, src_page, OUT move.dst ) )
+				break;
+
+			moves.PushBack( move );
+		}
+	}
+
+/*
+=================================================
+	GetStatistics
+=================================================
+*/
+	void GpuMemoryAllocator::GetStatistics (OUT Statistics &result) const
+	{
+		result = Statistics();
+
+		BytesU	free_size;
+
+		for (auto& page : _pages)
+		{
+			if ( page.generic )
+			{
+				result.pages			+= 1;
+				result.allocations		+= page.generic->AllocationCount();
+				result.totalSize		+= page.generic->Size();
+				result.usedSize			+= page.generic->UsedSize();
+				result.largestFreeBlock	 = GXMath::Max( result.largestFreeBlock, page.generic->LargestFreeBlock() );
+				free_size				+= page.generic->Size() - page.generic->UsedSize();
+			}
+			else
+			if ( page.transient )
+			{
+				result.transientPages	+= 1;
+				result.allocations		+= page.transient->AllocationCount();
+				result.totalSize		+= page.transient->Size();
+				result.usedSize			+= page.transient->UsedSize();
+			}
+		}
+
+		if ( free_size > 0 )
+			result.fragmentation = 1.0f - float(usize(result.largestFreeBlock)) / float(usize(free_size));
+	}
+
+
+}	// PlatformTools
+}	// Engine
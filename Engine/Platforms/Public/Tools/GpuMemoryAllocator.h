@@ -0,0 +1,239 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#pragma once
+
+#include "Engine/Platforms/Public/Common.h"
+
+namespace Engine
+{
+namespace PlatformTools
+{
+	using namespace Engine::Platforms;
+
+
+	//
+	// TLSF Block Allocator
+	//
+	//	Two-level segregated fit allocator for single memory page.
+	//	Allocator doesn't access memory, it works only with offsets,
+	//	so it can be used for device memory and host memory.
+	//	Allocation and deallocation have constant complexity.
+	//
+
+	class TLSFBlockAllocator final : public Noncopyable
+	{
+	// types
+	public:
+		using Index_t	= uint;
+
+		struct AllocationInfo
+		{
+			Index_t		block;
+			BytesU		offset;
+			BytesU		size;
+			BytesU		align;
+		};
+
+	private:
+		struct Block
+		{
+			usize		offset		= 0;
+			usize		size		= 0;
+			usize		align		= 0;
+			Index_t		prevPhys	= UMax;
+			Index_t		nextPhys	= UMax;
+			Index_t		prevFree	= UMax;
+			Index_t		nextFree	= UMax;
+			bool		isFree		= false;
+		};
+
+
+	// constants
+	private:
+		static constexpr uint	_SLLog2			= 4;
+		static constexpr uint	_SLCount		= 1u << _SLLog2;
+		static constexpr uint	_SmallLog2		= 8;
+		static constexpr usize	_SmallSize		= usize(1) << _SmallLog2;
+		static constexpr uint	_FLCount		= CompileTime::SizeOf<usize>::bits - _SmallLog2 + 1;
+		static constexpr Index_t _InvalidIdx	= UMax;
+
+
+	// variables
+	private:
+		Array< Block >		_blocks;
+		Array< Index_t >	_unusedBlocks;
+		Index_t				_firstBlock		= _InvalidIdx;
+
+		ulong				_flBitmap		= 0;
+		uint				_slBitmap[ _FLCount ];
+		Index_t				_freeHeads[ _FLCount ][ _SLCount ];
+
+		usize				_size			= 0;
+		usize				_granularity	= 0;
+		usize				_usedSize		= 0;
+		usize				_allocCount		= 0;
+
+
+	// methods
+	public:
+		explicit TLSFBlockAllocator (BytesU size, BytesU granularity = 16_b);
+
+		bool Allocate (BytesU size, BytesU align, OUT Index_t &block, OUT BytesU &offset);
+		bool Deallocate (Index_t block);
+		void Clear ();
+
+		void GetAllocations (OUT Array<AllocationInfo> &result) const;
+
+		ND_ BytesU	Size ()				const	{ return BytesU(_size); }
+		ND_ BytesU	UsedSize ()			const	{ return BytesU(_usedSize); }
+		ND_ BytesU	Granularity ()		const	{ return BytesU(_granularity); }
+		ND_ usize	AllocationCount ()	const	{ return _allocCount; }
+		ND_ bool	Empty ()			const	{ return _allocCount == 0; }
+		ND_ BytesU	LargestFreeBlock ()	const;
+
+	private:
+		static void _MappingInsert (usize size, OUT uint &fl, OUT uint &sl);
+		static void _MappingSearch (usize size, OUT uint &fl, OUT uint &sl);
+
+		ND_ Index_t	_FindFree (INOUT uint &fl, INOUT uint &sl) const;
+		ND_ Index_t	_FindExact (usize size, usize align) const;
+		void		_InsertFree (Index_t idx);
+		void		_RemoveFree (Index_t idx);
+
+		ND_ Index_t	_NewBlock ();
+		void		_ReleaseBlock (Index_t idx);
+
+		ND_ Index_t	_Split (Index_t idx, usize size);
+		void		_MergeWithNext (Index_t idx);
+	};
+
+
+
+	//
+	// Linear Block Allocator
+	//
+	//	Memory is released for all allocations at once,
+	//	used for transient per-frame resources.
+	//
+
+	class LinearBlockAllocator final : public Noncopyable
+	{
+	// variables
+	private:
+		usize		_size			= 0;
+		usize		_offset			= 0;
+		usize		_granularity	= 0;
+		usize		_allocCount		= 0;
+
+
+	// methods
+	public:
+		explicit LinearBlockAllocator (BytesU size, BytesU granularity = 1_b);
+
+		bool Allocate (BytesU size, BytesU align, OUT BytesU &offset);
+		void Reset ()							{ _offset = 0;  _allocCount = 0; }
+
+		ND_ BytesU	Size ()				const	{ return BytesU(_size); }
+		ND_ BytesU	UsedSize ()			const	{ return BytesU(_offset); }
+		ND_ usize	AllocationCount ()	const	{ return _allocCount; }
+	};
+
+
+
+	//
+	// GPU Memory Allocator
+	//
+	//	Sub-allocates resources from large pages.
+	//	Allocator doesn't allocate pages itself, backend allocates device or host memory
+	//	and registers it with 'AddPage', page is identified by user data.
+	//	Generic pages use TLSF allocator, transient pages use linear allocator
+	//	and are released all at once by 'ResetTransient'.
+	//
+
+	class GpuMemoryAllocator final : public Noncopyable
+	{
+	// types
+	public:
+		struct Allocation
+		{
+			uint		page	= UMax;
+			uint		block	= UMax;		// UMax for transient allocation
+			BytesU		offset;
+			BytesU		size;
+
+			ND_ bool	IsValid ()		const	{ return page != UMax; }
+			ND_ bool	IsTransient ()	const	{ return IsValid() and block == UMax; }
+		};
+
+		struct DefragMove
+		{
+			Allocation	src;
+			Allocation	dst;
+		};
+
+		struct Statistics
+		{
+			usize		pages				= 0;
+			usize		transientPages		= 0;
+			usize		allocations			= 0;
+			BytesU		totalSize;
+			BytesU		usedSize;
+			BytesU		largestFreeBlock;
+			float		fragmentation		= 0.0f;		// 0 - free memory is continuous, 1 - maximum fragmentation
+		};
+
+		using DefragMoves_t		= Array< DefragMove >;
+		using PageUserData_t	= Array< ulong >;
+
+	private:
+		struct Page
+		{
+			UniquePtr< TLSFBlockAllocator >		generic;
+			UniquePtr< LinearBlockAllocator >	transient;
+			ulong								userData	= 0;
+
+			ND_ bool	IsValid ()	const	{ return generic or transient; }
+		};
+
+
+	// variables
+	private:
+		Array< Page >	_pages;
+		BytesU			_pageSize;
+		BytesU			_granularity;
+
+
+	// methods
+	public:
+		GpuMemoryAllocator (BytesU pageSize, BytesU granularity);
+		~GpuMemoryAllocator ();
+
+		bool Allocate (BytesU size, BytesU align, OUT Allocation &result);
+		bool AllocateTransient (BytesU size, BytesU align, OUT Allocation &result);
+		bool Deallocate (INOUT Allocation &alloc);
+
+		void ResetTransient ();
+
+		ND_ uint	AddPage (BytesU size, ulong userData, bool transient = false);
+		ND_ ulong	PageUserData (uint page) const;
+			void	ReleaseEmptyPages (usize keepPages, OUT PageUserData_t &released);
+			void	Clear (OUT PageUserData_t &released);
+
+		// defragmentation hook:
+		// allocates new memory for allocations from the least used pages,
+		// caller must copy data, rebind resources and deallocate source allocations.
+		void PlanDefragmentation (usize maxMoves, OUT DefragMoves_t &moves);
+
+		void GetStatistics (OUT Statistics &result) const;
+
+		ND_ BytesU	PageSize ()		const	{ return _pageSize; }
+		ND_ BytesU	Granularity ()	const	{ return _granularity; }
+		ND_ usize	PageCount ()	const;
+
+	private:
+		bool _AllocateInPages (BytesU size, BytesU align, uint skipPage, OUT Allocation &result);
+	};
+
+
+}	// PlatformTools
+}	// Engine
@@ -8,9 +8,12 @@
 #include "Engine/Platforms/Public/GPU/Image.h"
 #include "Engine/Platforms/Public/GPU/Buffer.h"
 #include "Engine/Platforms/Public/GPU/Pipeline.h"
+#include "Engine/Platforms/Public/GPU/Query.h"
 #include "Engine/Platforms/Soft/Impl/SWBaseModule.h"
+#include "Engine/Platforms/Soft/Impl/SWImageBlitter.h"
 #include "Engine/Platforms/Soft/SoftRendererObjectsConstructor.h"
 #include "Core/STL/Math/Image/ImageUtils.h"
+#include "Core/STL/ThreadSafe/ParallelFor.h"
 
 namespace Engine
 {
@@ -44,17 +47,63 @@ namespace PlatformSW
 		using CmdDataTypes_t		= GpuMsg::SetSWCommandBufferQueue::Data_t::TypeList_t;
 
 		using ERecordingState		= GpuMsg::SetCommandBufferState::EState;
+		using CommandStats_t		= SWDevice::CommandStats;
+
+		struct ExecNode
+		{
+			usize		cmdIndex	= 0;
+			ModulePtr	pipeline;			// compute states at the moment of recording,
+			ModulePtr	resourceTable;		// because commands may be reordered
+		};
+		using Batch_t				= Array< ExecNode >;	// independent commands
+		using Batches_t				= Array< Batch_t >;
+
+		struct MemRange
+		{
+			usize	begin	= 0;
+			usize	end		= 0;
+
+			ND_ bool  operator == (const MemRange &right) const	{ return begin == right.begin and end == right.end; }
+			ND_ bool  Intersects (const MemRange &right) const	{ return begin < right.end and right.begin < end; }
+		};
+
+		struct TransferJob
+		{
+			BinArrayRef		dst;
+			BinArrayCRef	src;			// if empty then 'dst' is filled with 'pattern'
+			uint			pattern	= 0;
+		};
+		using TransferJobs_t		= Array< TransferJob >;
+
+		using ImageMemLayout_t		= GpuMsg::GetSWImageMemoryLayout::ImgLayers3D;
+		using BlitImageData_t		= SWImageBlitter::ImageData;
+
+		using PipelineCounters_t	= SWDevice::PipelineCounters_t;
+		using QueryData_t			= GpuMsg::GetSWQueryPoolData::Data;
+
+		struct ActiveQuery
+		{
+			ModulePtr			queryPool;
+			uint				queryIndex	= 0;
+			PipelineCounters_t	counters;		// at the moment of 'CmdBeginQuery'
+		};
+		using ActiveQueries_t		= Array< ActiveQuery >;
+
+		struct _AnalyzeCommands_Func;
 
 
 	// constants
 	private:
 		static const TypeIdList		_eventTypes;
+		static constexpr BytesU		_MinParallelTransferSize	= 1_Mb;
 
 
 	// variables
 	private:
 		CommandBufferDescription	_descr;
 		CommandArray_t				_commands;
+		Batches_t					_batches;		// execution order
+		CommandStats_t				_planStats;
 		UsedResources_t				_resources;
 		BinaryArray					_bufferData;
 		BinaryArray					_pushConstData;
@@ -63,6 +112,7 @@ namespace PlatformSW
 		// states
 		ModulePtr					_computeShader;
 		ModulePtr					_computeResTable;
+		ActiveQueries_t				_activeQueries;
 
 
 	// methods
@@ -96,6 +146,21 @@ namespace PlatformSW
 		
 		bool _PrepareForCompute ();
 
+		bool _BuildExecutionPlan ();
+		static MemRange _GetMemoryRange (const ModulePtr &resource);
+
+		bool _ResolveCopyBuffer (const GpuMsg::CmdCopyBuffer &, INOUT TransferJobs_t &);
+		bool _ResolveUpdateBuffer (const GpuMsg::CmdUpdateBuffer &, INOUT TransferJobs_t &);
+		bool _ResolveFillBuffer (const GpuMsg::CmdFillBuffer &, INOUT TransferJobs_t &);
+		usize _RunTransferJobs (ArrayCRef<TransferJob> jobs);
+
+		static void _ExecuteTransferJob (const TransferJob &job);
+
+		bool _GetImageLevel (ImageMemLayout_t &mem, uint layer, MipmapLevel level, bool isDst, OUT BlitImageData_t &result) const;
+		static usize _FindMipmapChain (const GpuMsg::CmdBlitImage &msg, usize first, const ImageMemLayout_t &mem);
+
+		static bool _GetQueryData (const ModulePtr &queryPool, uint firstIndex, uint count, OUT QueryData_t &result);
+
 	public:
 		bool operator () (const GpuMsg::CmdBindComputePipeline &);
 		bool operator () (const GpuMsg::CmdDispatch &);
@@ -106,6 +171,8 @@ namespace PlatformSW
 		bool operator () (const GpuMsg::CmdCopyImage &);
 		bool operator () (const GpuMsg::CmdCopyBufferToImage &);
 		bool operator () (const GpuMsg::CmdCopyImageToBuffer &);
+		bool operator () (const GpuMsg::CmdBlitImage &);
+		bool operator () (const GpuMsg::CmdResolveImage &);
 		bool operator () (const GpuMsg::CmdUpdateBuffer &);
 		bool operator () (const GpuMsg::CmdFillBuffer &);
 		bool operator () (const GpuMsg::CmdClearColorImage &);
@@ -115,6 +182,11 @@ namespace PlatformSW
 		bool operator () (const GpuMsg::CmdDebugMarker &);
 		bool operator () (const GpuMsg::CmdPushDebugGroup &);
 		bool operator () (const GpuMsg::CmdPopDebugGroup &);
+		bool operator () (const GpuMsg::CmdBeginQuery &);
+		bool operator () (const GpuMsg::CmdEndQuery &);
+		bool operator () (const GpuMsg::CmdCopyQueryPoolResults &);
+		bool operator () (const GpuMsg::CmdWriteTimestamp &);
+		bool operator () (const GpuMsg::CmdResetQueryPool &);
 	};
 //-----------------------------------------------------------------------------
 
@@ -219,6 +291,7 @@ namespace PlatformSW
 
 		_resources.Clear();
 		_commands.Clear();
+		_batches.Clear();
 		_bufferData.Clear();
 		_pushConstData.Clear();
 
@@ -235,6 +308,413 @@ namespace PlatformSW
 		_commands		= RVREF(msg.commands.Get());
 		_bufferData		= msg.bufferData;
 		_pushConstData	= msg.pushConstData;
+
+		CHECK_ERR( _BuildExecutionPlan() );
+		return true;
+	}
+
+/*
+=================================================
+	_AnalyzeCommands_Func
+----
+	collects resources that are read or written by command,
+	all accesses to the resource are treated as accesses to the whole resource.
+=================================================
+*/
+	struct SWCommandBuffer::_AnalyzeCommands_Func
+	{
+	// types
+		enum class EKind
+		{
+			Skip,			// command has no effect or changes recording state only
+			Node,			// command can be reordered with independent commands
+			Debug,			// debug command, keeps place after previous commands
+			FullBarrier,	// all previous commands must be completed and all next commands must wait for this command
+		};
+
+		using Resources_t		= GpuMsg::GetSWPipelineResources::Resources_t;
+		using ResTableMap_t		= HashMap< UntypedKey<ModulePtr>, Resources_t >;
+		using ResourceList_t	= Array< ModulePtr >;
+
+
+	// variables
+		ResTableMap_t		resTables;
+		ResourceList_t		reads;
+		ResourceList_t		writes;
+		ModulePtr			pipeline;
+		ModulePtr			resourceTable;
+		EKind				kind		= EKind::Skip;
+		usize				barriers	= 0;
+		usize				dropped		= 0;
+
+
+	// methods
+		void Reset ()
+		{
+			reads.Clear();
+			writes.Clear();
+			kind = EKind::Skip;
+		}
+
+		void operator () (const GpuMsg::CmdBindComputePipeline &msg)
+		{
+			pipeline = msg.pipeline;
+		}
+
+		void operator () (const GpuMsg::CmdBindComputeResourceTable &msg)
+		{
+			resourceTable = msg.resourceTable;
+		}
+
+		void operator () (const GpuMsg::CmdDispatch &)
+		{
+			_AddPipelineResources();
+		}
+
+		void operator () (const GpuMsg::CmdDispatchIndirect &msg)
+		{
+			_AddPipelineResources();
+			reads.PushBack( msg.indirectBuffer );
+		}
+
+		void operator () (const GpuMsg::CmdExecute &)
+		{
+			// secondary command buffers may use any resource
+			kind = EKind::FullBarrier;
+		}
+
+		void operator () (const GpuMsg::CmdCopyBuffer &msg)
+		{
+			_Add( msg.srcBuffer, msg.dstBuffer );
+		}
+
+		void operator () (const GpuMsg::CmdCopyImage &msg)
+		{
+			_Add( msg.srcImage, msg.dstImage );
+		}
+
+		void operator () (const GpuMsg::CmdCopyBufferToImage &msg)
+		{
+			_Add( msg.srcBuffer, msg.dstImage );
+		}
+
+		void operator () (const GpuMsg::CmdCopyImageToBuffer &msg)
+		{
+			_Add( msg.srcImage, msg.dstBuffer );
+		}
+
+		void operator () (const GpuMsg::CmdBlitImage &msg)
+		{
+			_Add( msg.srcImage, msg.dstImage );
+		}
+
+		void operator () (const GpuMsg::CmdResolveImage &msg)
+		{
+			_Add( msg.srcImage, msg.dstImage );
+		}
+
+		void operator () (const GpuMsg::CmdUpdateBuffer &msg)
+		{
+			_Add( null, msg.dstBuffer );
+		}
+
+		void operator () (const GpuMsg::CmdFillBuffer &msg)
+		{
+			_Add( null, msg.dstBuffer );
+		}
+
+		void operator () (const GpuMsg::CmdClearColorImage &msg)
+		{
+			_Add( null, msg.image );
+		}
+
+		void operator () (const GpuMsg::CmdPipelineBarrier &msg)
+		{
+			// execution and memory dependencies are built from resource accesses,
+			// only image layout transitions must be executed.
+			++barriers;
+
+			for (auto& br : msg.imageBarriers)
+			{
+				if ( br.oldLayout != br.newLayout )
+					writes.PushBack( br.image );
+			}
+
+			if ( writes.Empty() )
+				++dropped;
+			else
+				kind = EKind::Node;
+		}
+
+		void operator () (const GpuMsg::CmdPushConstants &)		{}
+		void operator () (const GpuMsg::CmdPushNamedConstants &)	{}
+
+		void operator () (const GpuMsg::CmdDebugMarker &)			{ kind = EKind::Debug; }
+		void operator () (const GpuMsg::CmdPushDebugGroup &)		{ kind = EKind::Debug; }
+		void operator () (const GpuMsg::CmdPopDebugGroup &)		{ kind = EKind::Debug; }
+
+		// queries measure all commands between begin and end, so they must not be reordered
+		void operator () (const GpuMsg::CmdBeginQuery &)			{ kind = EKind::FullBarrier; }
+		void operator () (const GpuMsg::CmdEndQuery &)				{ kind = EKind::FullBarrier; }
+		void operator () (const GpuMsg::CmdWriteTimestamp &)		{ kind = EKind::FullBarrier; }
+
+		void operator () (const GpuMsg::CmdCopyQueryPoolResults &msg)
+		{
+			_Add( msg.queryPool, msg.dstBuffer );
+		}
+
+		void operator () (const GpuMsg::CmdResetQueryPool &msg)
+		{
+			_Add( null, msg.queryPool );
+		}
+
+	private:
+		void _Add (const ModulePtr &src, const ModulePtr &dst)
+		{
+			if ( src )	reads.PushBack( src );
+			if ( dst )	writes.PushBack( dst );
+			kind = EKind::Node;
+		}
+
+		void _AddPipelineResources ()
+		{
+			kind = EKind::FullBarrier;
+
+			if ( not resourceTable )
+				return;
+
+			ResTableMap_t::iterator	iter;
+
+			if ( not resTables.Find( resourceTable.RawPtr(), OUT iter ) )
+			{
+				GpuMsg::GetSWPipelineResources	req_res;
+				resourceTable->Send( req_res );
+
+				if ( not req_res.result )
+					return;
+
+				iter = resTables.Add( resourceTable.RawPtr(), RVREF(*req_res.result) );
+			}
+
+			for (auto& res : iter->second)
+			{
+				if ( res.write )
+					writes.PushBack( res.module );
+				else
+					reads.PushBack( res.module );
+			}
+			kind = EKind::Node;
+		}
+	};
+	
+/*
+=================================================
+	_GetMemoryRange
+----
+	returns address range of memory that is bound to resource,
+	so different resources that share the same memory are not treated as independent.
+=================================================
+*/
+	SWCommandBuffer::MemRange  SWCommandBuffer::_GetMemoryRange (const ModulePtr &resource)
+	{
+		using BufferMsg_t	= MessageListFrom< GpuMsg::GetSWBufferMemoryLayout >;
+		using ImageMsg_t	= MessageListFrom< GpuMsg::GetSWImageMemoryLayout >;
+		using QueryMsg_t	= MessageListFrom< GpuMsg::GetSWQueryPoolData >;
+
+		MemRange	range;
+
+		const auto	AddRange = LAMBDA( &range ) (const void *ptr, BytesU size)
+		{
+			if ( ptr == null or size == 0 )
+				return;
+
+			const usize	begin	= ReferenceCast<usize>( ptr );
+			const usize	end		= begin + usize(size);
+
+			if ( range.begin == range.end ) {
+				range.begin	= begin;
+				range.end	= end;
+			} else {
+				range.begin	= Min( range.begin, begin );
+				range.end	= Max( range.end, end );
+			}
+		};
+
+		if ( resource->SupportsAllMessages< BufferMsg_t >() )
+		{
+			GpuMsg::GetSWBufferMemoryLayout		req_mem{ EPipelineAccess::bits(), EPipelineStage::Unknown };
+			resource->Send( req_mem );
+
+			if ( req_mem.result )
+				AddRange( req_mem.result->memory.RawPtr(), req_mem.result->memory.Size() );
+		}
+		else
+		if ( resource->SupportsAllMessages< ImageMsg_t >() )
+		{
+			GpuMsg::GetSWImageMemoryLayout		req_mem{ EPipelineAccess::bits(), EPipelineStage::Unknown };
+			resource->Send( req_mem );
+
+			if ( req_mem.result )
+			{
+				for (auto& layer : req_mem.result->layers)
+				for (auto& level : layer.mipmaps) {
+					AddRange( level.memory, level.size );
+				}
+			}
+		}
+		else
+		if ( resource->SupportsAllMessages< QueryMsg_t >() )
+		{
+			GpuMsg::GetSWQueryPoolData	req_data;
+			resource->Send( req_data );
+
+			if ( req_data.result )
+				AddRange( req_data.result->values.RawPtr(), req_data.result->values.Size() );
+		}
+
+		// memory is not bound, resource itself is used as unique range
+		if ( range.begin == range.end )
+		{
+			range.begin	= ReferenceCast<usize>( resource.RawPtr() );
+			range.end	= range.begin + 1;
+		}
+		return range;
+	}
+
+/*
+=================================================
+	_BuildExecutionPlan
+----
+	commands are distributed between batches,
+	command is placed in first batch after all commands that access
+	intersecting memory (read after write, write after read, write after write).
+	Commands in batch are independent and may be executed in any order.
+=================================================
+*/
+	bool SWCommandBuffer::_BuildExecutionPlan ()
+	{
+		using EKind			= _AnalyzeCommands_Func::EKind;
+		using RangeMap_t	= HashMap< UntypedKey<ModulePtr>, MemRange >;
+
+		struct MemAccess
+		{
+			MemRange	range;
+			usize		batch	= 0;	// last batch index + 1
+		};
+		using MemAccesses_t	= Array< MemAccess >;
+
+		// accesses to the same range are merged, so search time depends on number of resources
+		const auto	GetBatch = LAMBDA() (const MemAccesses_t &accesses, const MemRange &range) -> usize
+		{
+			usize	batch = 0;
+
+			for (auto& acc : accesses)
+			{
+				if ( acc.range.Intersects( range ) )
+					batch = Max( batch, acc.batch );
+			}
+			return batch;
+		};
+
+		const auto	AddAccess = LAMBDA() (INOUT MemAccesses_t &accesses, const MemRange &range, usize batch)
+		{
+			for (auto& acc : accesses)
+			{
+				if ( acc.range == range ) {
+					acc.batch = Max( acc.batch, batch );
+					return;
+				}
+			}
+			accesses.PushBack({ range, batch });
+		};
+
+		RangeMap_t	ranges;
+
+		const auto	GetRange = LAMBDA( &ranges ) (const ModulePtr &res) -> MemRange
+		{
+			RangeMap_t::iterator	iter;
+
+			if ( not ranges.Find( res.RawPtr(), OUT iter ) )
+				iter = ranges.Add( res.RawPtr(), _GetMemoryRange( res ) );
+
+			return iter->second;
+		};
+
+		_AnalyzeCommands_Func	func;
+		MemAccesses_t			last_read;
+		MemAccesses_t			last_write;
+		Array< MemRange >		read_ranges;
+		Array< MemRange >		write_ranges;
+		usize					min_batch	= 0;	// commands can not be moved before this batch
+		usize					node_count	= 0;
+
+		_batches.Clear();
+		_planStats = CommandStats_t();
+
+		FOR( i, _commands )
+		{
+			func.Reset();
+			_commands[i].data.Accept( func );
+
+			usize	batch = min_batch;
+
+			switch ( func.kind )
+			{
+				case EKind::Skip :
+					continue;
+
+				case EKind::Debug :
+					batch = Max( batch, _batches.Empty() ? 0 : _batches.Count()-1 );
+					break;
+
+				case EKind::FullBarrier :
+					batch		= _batches.Count();
+					min_batch	= batch + 1;
+					break;
+
+				case EKind::Node :
+					read_ranges.Clear();
+					write_ranges.Clear();
+
+					for (auto& res : func.reads) {
+						read_ranges.PushBack( GetRange( res ) );
+					}
+					for (auto& res : func.writes) {
+						write_ranges.PushBack( GetRange( res ) );
+					}
+
+					for (auto& range : read_ranges) {
+						batch = Max( batch, GetBatch( last_write, range ) );
+					}
+					for (auto& range : write_ranges) {
+						batch = Max( batch, GetBatch( last_write, range ), GetBatch( last_read, range ) );
+					}
+					for (auto& range : read_ranges) {
+						AddAccess( INOUT last_read, range, batch+1 );
+					}
+					for (auto& range : write_ranges) {
+						AddAccess( INOUT last_write, range, batch+1 );
+					}
+					break;
+			}
+
+			ASSERT( batch <= _batches.Count() );
+
+			if ( batch == _batches.Count() )
+				_batches.PushBack( Batch_t() );
+
+			_batches[batch].PushBack({ i, func.pipeline, func.resourceTable });
+			++node_count;
+		}
+
+		_planStats.commands			= node_count;
+		_planStats.barriers			= func.barriers;
+		_planStats.droppedBarriers	= func.dropped;
+		_planStats.batches			= _batches.Count();
+
+		for (auto& batch : _batches) {
+			_planStats.maxBatchSize = Max( _planStats.maxBatchSize, batch.Count() );
+		}
 		return true;
 	}
 
@@ -305,6 +785,7 @@ namespace PlatformSW
 		_ChangeState( ERecordingState::Initial );
 		_resources.Clear();
 		_commands.Clear();
+		_batches.Clear();
 		_bufferData.Clear();
 		_pushConstData.Clear();
 
@@ -336,10 +817,32 @@ namespace PlatformSW
 
 		msg.completed = false;
 		
-		FOR( i, _commands ) {
-			_commands[i].data.Accept( *this );
+		CommandStats_t	stats = _planStats;
+		TransferJobs_t	jobs;
+
+		for (auto& batch : _batches)
+		{
+			for (auto& node : batch)
+			{
+				auto const&	data = _commands[ node.cmdIndex ].data;
+
+				// buffer transfers are deferred until the end of batch to run them concurrently
+				if ( data.Is< GpuMsg::CmdCopyBuffer >() )	{ _ResolveCopyBuffer( data.Get< GpuMsg::CmdCopyBuffer >(), INOUT jobs );		continue; }
+				if ( data.Is< GpuMsg::CmdUpdateBuffer >() )	{ _ResolveUpdateBuffer( data.Get< GpuMsg::CmdUpdateBuffer >(), INOUT jobs );	continue; }
+				if ( data.Is< GpuMsg::CmdFillBuffer >() )	{ _ResolveFillBuffer( data.Get< GpuMsg::CmdFillBuffer >(), INOUT jobs );		continue; }
+
+				_computeShader		= node.pipeline;
+				_computeResTable	= node.resourceTable;
+
+				data.Accept( *this );
+			}
+
+			stats.parallelJobs += _RunTransferJobs( jobs );
+			jobs.Clear();
 		}
 
+		GetDevice()->AddCommandStats( stats );
+
 		msg.completed = true;
 
 		_ClearStates();
@@ -362,6 +865,7 @@ namespace PlatformSW
 		{
 			_resources.Clear();
 			_commands.Clear();
+			_batches.Clear();
 			_bufferData.Clear();
 			_pushConstData.Clear();
 		}
@@ -394,6 +898,7 @@ namespace PlatformSW
 
 		_resources.Clear();
 		_commands.Clear();
+		_batches.Clear();
 		_bufferData.Clear();
 		_pushConstData.Clear();
 
@@ -424,6 +929,9 @@ namespace PlatformSW
 	{
 		_computeShader		= null;
 		_computeResTable	= null;
+
+		// query that was not ended has undefined result
+		_activeQueries.Clear();
 	}
 	
 /*
@@ -467,12 +975,28 @@ namespace PlatformSW
 	operator (CmdDispatchIndirect)
 =================================================
 */
-	bool SWCommandBuffer::operator () (const GpuMsg::CmdDispatchIndirect &)
+	bool SWCommandBuffer::operator () (const GpuMsg::CmdDispatchIndirect &msg)
 	{
-		TODO( "" );
-		//_PrepareForCompute();
+		GpuMsg::GetBufferDescription	req_descr;
+		msg.indirectBuffer->Send( req_descr );
+
+		CHECK_ERR( req_descr.result and req_descr.result->usage[ EBufferUsage::Indirect ] );
+
+		// read group count, layout is same as in VkDispatchIndirectCommand
+		auto	mem = msg.indirectBuffer->Request( GpuMsg::GetSWBufferMemoryLayout{ msg.offset, SizeOf<uint3>, EPipelineAccess::IndirectCommandRead, EPipelineStage::DrawIndirect });
+		
+		CHECK_ERR( mem.memAccess[ EMemoryAccess::GpuRead ] );
+		CHECK_ERR( mem.memory.Size() == SizeOf<uint3> );
+
+		uint3	group_count;
+		MemCopy( OUT BinArrayRef::FromValue( group_count ), BinArrayCRef(mem.memory) );
+
+		if ( group_count.x == 0 or group_count.y == 0 or group_count.z == 0 )
+			return true;
+
+		_PrepareForCompute();
 
-		//CHECK_ERR( GetDevice()->DispatchComputeIndirect( msg.groupCount, _computeShader, _computeResTable ) );
+		CHECK_ERR( GetDevice()->DispatchCompute( group_count, _computeShader, _computeResTable ) );
 		return true;
 	}
 
@@ -509,6 +1033,20 @@ namespace PlatformSW
 =================================================
 */
 	bool SWCommandBuffer::operator () (const GpuMsg::CmdCopyBuffer &msg)
+	{
+		TransferJobs_t	jobs;
+		CHECK_ERR( _ResolveCopyBuffer( msg, INOUT jobs ) );
+
+		_RunTransferJobs( jobs );
+		return true;
+	}
+	
+/*
+=================================================
+	_ResolveCopyBuffer
+=================================================
+*/
+	bool SWCommandBuffer::_ResolveCopyBuffer (const GpuMsg::CmdCopyBuffer &msg, INOUT TransferJobs_t &jobs)
 	{
 		for (auto& reg : msg.regions)
 		{
@@ -520,7 +1058,7 @@ namespace PlatformSW
 			
 			CHECK_ERR( src_mem.memory.Size() == dst_mem.memory.Size() );
 
-			MemCopy( OUT BinArrayRef(dst_mem.memory), BinArrayCRef(src_mem.memory) );
+			jobs.PushBack({ BinArrayRef(dst_mem.memory), BinArrayCRef(src_mem.memory) });
 		}
 		return true;
 	}
@@ -743,12 +1281,225 @@ namespace PlatformSW
 		return true;
 	}
 	
+/*
+=================================================
+	_GetImageLevel
+=================================================
+*/
+	bool SWCommandBuffer::_GetImageLevel (ImageMemLayout_t &mem, uint layer, MipmapLevel level, bool isDst, OUT BlitImageData_t &result) const
+	{
+		CHECK_ERR( layer < mem.layers.Count() );
+		CHECK_ERR( level.Get() < mem.layers[layer].mipmaps.Count() );
+
+		auto&	mipmap = mem.layers[layer].mipmaps[ level.Get() ];
+
+		CHECK_ERR( mipmap.memory != null );
+
+		if ( isDst ) {
+			SW_DEBUG_REPORT2( mipmap.layout == EImageLayout::TransferDstOptimal or mipmap.layout == EImageLayout::General, EDbgReport::Error );
+		} else {
+			SW_DEBUG_REPORT2( mipmap.layout == EImageLayout::TransferSrcOptimal or mipmap.layout == EImageLayout::General, EDbgReport::Error );
+		}
+
+		result.memory		= mipmap.Data();
+		result.dimension	= mipmap.dimension;
+		result.format		= mipmap.format;
+		result.rowPitch		= GXImageUtils::AlignedRowSize( mipmap.dimension.x, BytesU(EPixelFormat::BitPerPixel( mipmap.format )), mem.align );
+		return true;
+	}
+
+/*
+=================================================
+	_FindMipmapChain
+----
+	returns number of regions that downsample whole mipmap levels
+	one by one, starting from 'first' region.
+	Regions are executed sequentially, so in software renderer
+	mipmap chain can be recorded as single blit command.
+=================================================
+*/
+	usize SWCommandBuffer::_FindMipmapChain (const GpuMsg::CmdBlitImage &msg, usize first, const ImageMemLayout_t &mem)
+	{
+		// 3D images are not supported
+		if ( msg.srcImage != msg.dstImage or not msg.linearFilter or mem.layers.Empty() or mem.dimension.z > 1 )
+			return 0;
+
+		const auto&	mipmaps	= mem.layers.Front().mipmaps;
+		usize		count	= 0;
+
+		for (usize i = first; i < msg.regions.Count(); ++i, ++count)
+		{
+			const auto&	reg		= msg.regions[i];
+			const uint	src_lvl	= reg.srcLayers.mipLevel.Get();
+			const uint	dst_lvl	= reg.dstLayers.mipLevel.Get();
+
+			if ( dst_lvl != src_lvl + 1 or dst_lvl >= mipmaps.Count() )
+				break;
+
+			if ( reg.srcLayers.baseLayer != reg.dstLayers.baseLayer or reg.srcLayers.layerCount != reg.dstLayers.layerCount )
+				break;
+
+			if ( i > first and (src_lvl != msg.regions[i-1].dstLayers.mipLevel.Get() or
+								reg.srcLayers.baseLayer != msg.regions[i-1].srcLayers.baseLayer or
+								reg.srcLayers.layerCount != msg.regions[i-1].srcLayers.layerCount) )
+				break;
+
+			const uint2	src_dim	= mipmaps[src_lvl].dimension;
+			const uint2	dst_dim	= mipmaps[dst_lvl].dimension;
+
+			if ( Any( reg.srcOffset0.xy() != 0u ) or Any( reg.srcOffset1.xy() != src_dim ) or
+				 Any( reg.dstOffset0.xy() != 0u ) or Any( reg.dstOffset1.xy() != dst_dim ) or
+				 Any( dst_dim != Max( src_dim / 2u, 1u ) ) )
+				break;
+		}
+		return count;
+	}
+
+/*
+=================================================
+	operator (CmdBlitImage)
+----
+	only 2D images and arrays are supported,
+	3D image slices are blitted without scaling in depth.
+=================================================
+*/
+	bool SWCommandBuffer::operator () (const GpuMsg::CmdBlitImage &msg)
+	{
+		GpuMsg::GetSWImageMemoryLayout	req_src_mem { EPipelineAccess::TransferRead, EPipelineStage::Transfer };
+		GpuMsg::GetSWImageMemoryLayout	req_dst_mem { EPipelineAccess::TransferWrite, EPipelineStage::Transfer };
+		GpuMsg::GetImageDescription		req_src_descr;
+		GpuMsg::GetImageDescription		req_dst_descr;
+
+		msg.srcImage->Send( req_src_mem );
+		msg.dstImage->Send( req_dst_mem );
+		msg.srcImage->Send( req_src_descr );
+		msg.dstImage->Send( req_dst_descr );
+
+		CHECK_ERR( req_src_mem.result and req_src_mem.result->memAccess[ EMemoryAccess::GpuRead ] );
+		CHECK_ERR( req_dst_mem.result and req_dst_mem.result->memAccess[ EMemoryAccess::GpuWrite ] );
+		CHECK_ERR( req_src_descr.result and req_src_descr.result->usage[ EImageUsage::TransferSrc ] );
+		CHECK_ERR( req_dst_descr.result and req_dst_descr.result->usage[ EImageUsage::TransferDst ] );
+		CHECK_ERR( not msg.linearFilter or SWImageBlitter::IsFilterable( req_src_descr.result->format ) );
+
+		for (usize i = 0; i < msg.regions.Count();)
+		{
+			// mipmap generation
+			const usize	chain = _FindMipmapChain( msg, i, *req_src_mem.result );
+
+			if ( chain > 1 )
+			{
+				const auto&		reg		= msg.regions[i];
+				const uint		base	= reg.srcLayers.mipLevel.Get();
+
+				for (uint layer = 0; layer < reg.srcLayers.layerCount; ++layer)
+				{
+					FixedSizeArray< BlitImageData_t, 16 >	levels;
+					levels.Resize( chain + 1 );
+
+					FOR( j, levels ) {
+						CHECK_ERR( _GetImageLevel( *req_src_mem.result, reg.srcLayers.baseLayer.Get() + layer, MipmapLevel(base + uint(j)), j > 0, OUT levels[j] ));
+					}
+					CHECK_ERR( SWImageBlitter::GenerateMipmaps( levels ));
+				}
+
+				i += chain;
+				continue;
+			}
+
+			// blit
+			const auto&		reg			= msg.regions[i];
+			const uint3		src_min		= Min( reg.srcOffset0, reg.srcOffset1 );
+			const uint3		dst_min		= Min( reg.dstOffset0, reg.dstOffset1 );
+			const uint		src_off_z	= Max( reg.srcLayers.baseLayer.Get(), src_min.z );
+			const uint		dst_off_z	= Max( reg.dstLayers.baseLayer.Get(), dst_min.z );
+			const uint		src_dim_z	= Max( reg.srcLayers.layerCount, Max( reg.srcOffset0.z, reg.srcOffset1.z ) - src_min.z );
+			const uint		dst_dim_z	= Max( reg.dstLayers.layerCount, Max( reg.dstOffset0.z, reg.dstOffset1.z ) - dst_min.z );
+
+			CHECK_ERR( src_dim_z == dst_dim_z );
+
+			SWImageBlitter::Region	blit_reg;
+			blit_reg.srcOffset0	= int2(reg.srcOffset0.xy());
+			blit_reg.srcOffset1	= int2(reg.srcOffset1.xy());
+			blit_reg.dstOffset0	= int2(reg.dstOffset0.xy());
+			blit_reg.dstOffset1	= int2(reg.dstOffset1.xy());
+
+			for (uint z = 0; z < src_dim_z; ++z)
+			{
+				BlitImageData_t		src_level;
+				BlitImageData_t		dst_level;
+
+				CHECK_ERR( _GetImageLevel( *req_src_mem.result, src_off_z + z, reg.srcLayers.mipLevel, false, OUT src_level ));
+				CHECK_ERR( _GetImageLevel( *req_dst_mem.result, dst_off_z + z, reg.dstLayers.mipLevel, true, OUT dst_level ));
+				CHECK_ERR( SWImageBlitter::Blit( src_level, dst_level, blit_reg, msg.linearFilter ));
+			}
+			++i;
+		}
+		return true;
+	}
+
+/*
+=================================================
+	operator (CmdResolveImage)
+----
+	software renderer doesn't support multisampling,
+	so resolve is same as copy.
+=================================================
+*/
+	bool SWCommandBuffer::operator () (const GpuMsg::CmdResolveImage &msg)
+	{
+		GpuMsg::GetSWImageMemoryLayout	req_src_mem { EPipelineAccess::TransferRead, EPipelineStage::Transfer };
+		GpuMsg::GetSWImageMemoryLayout	req_dst_mem { EPipelineAccess::TransferWrite, EPipelineStage::Transfer };
+		GpuMsg::GetImageDescription		req_src_descr;
+		GpuMsg::GetImageDescription		req_dst_descr;
+
+		msg.srcImage->Send( req_src_mem );
+		msg.dstImage->Send( req_dst_mem );
+		msg.srcImage->Send( req_src_descr );
+		msg.dstImage->Send( req_dst_descr );
+
+		CHECK_ERR( req_src_mem.result and req_src_mem.result->memAccess[ EMemoryAccess::GpuRead ] );
+		CHECK_ERR( req_dst_mem.result and req_dst_mem.result->memAccess[ EMemoryAccess::GpuWrite ] );
+		CHECK_ERR( req_src_descr.result and req_src_descr.result->usage[ EImageUsage::TransferSrc ] );
+		CHECK_ERR( req_dst_descr.result and req_dst_descr.result->usage[ EImageUsage::TransferDst ] );
+		CHECK_ERR( req_src_descr.result->format == req_dst_descr.result->format );
+
+		for (auto& reg : msg.regions)
+		{
+			CHECK_ERR( reg.srcLayers.layerCount == reg.dstLayers.layerCount );
+
+			for (uint layer = 0; layer < reg.srcLayers.layerCount; ++layer)
+			{
+				BlitImageData_t		src_level;
+				BlitImageData_t		dst_level;
+
+				CHECK_ERR( _GetImageLevel( *req_src_mem.result, reg.srcLayers.baseLayer.Get() + layer, reg.srcLayers.mipLevel, false, OUT src_level ));
+				CHECK_ERR( _GetImageLevel( *req_dst_mem.result, reg.dstLayers.baseLayer.Get() + layer, reg.dstLayers.mipLevel, true, OUT dst_level ));
+				CHECK_ERR( SWImageBlitter::Copy( src_level, dst_level, int2(reg.srcOffset.xy()), int2(reg.dstOffset.xy()), reg.extent.xy() ));
+			}
+		}
+		return true;
+	}
+
 /*
 =================================================
 	operator (CmdUpdateBuffer)
 =================================================
 */
 	bool SWCommandBuffer::operator () (const GpuMsg::CmdUpdateBuffer &msg)
+	{
+		TransferJobs_t	jobs;
+		CHECK_ERR( _ResolveUpdateBuffer( msg, INOUT jobs ) );
+
+		_RunTransferJobs( jobs );
+		return true;
+	}
+	
+/*
+=================================================
+	_ResolveUpdateBuffer
+=================================================
+*/
+	bool SWCommandBuffer::_ResolveUpdateBuffer (const GpuMsg::CmdUpdateBuffer &msg, INOUT TransferJobs_t &jobs)
 	{
 		GpuMsg::GetSWBufferMemoryLayout		req_mem { msg.dstOffset, msg.data.Size(), EPipelineAccess::TransferWrite, EPipelineStage::Transfer };
 		GpuMsg::GetBufferDescription		req_descr;
@@ -762,7 +1513,7 @@ namespace PlatformSW
 		CHECK_ERR( (msg.dstOffset % req_mem.result->align) == 0 );
 		CHECK_ERR( req_mem.result->memory.Size() == msg.data.Size() );
 
-		MemCopy( OUT req_mem.result->memory, BinArrayCRef(msg.data) );
+		jobs.PushBack({ req_mem.result->memory, BinArrayCRef(msg.data) });
 		return true;
 	}
 	
@@ -772,6 +1523,20 @@ namespace PlatformSW
 =================================================
 */
 	bool SWCommandBuffer::operator () (const GpuMsg::CmdFillBuffer &msg)
+	{
+		TransferJobs_t	jobs;
+		CHECK_ERR( _ResolveFillBuffer( msg, INOUT jobs ) );
+
+		_RunTransferJobs( jobs );
+		return true;
+	}
+	
+/*
+=================================================
+	_ResolveFillBuffer
+=================================================
+*/
+	bool SWCommandBuffer::_ResolveFillBuffer (const GpuMsg::CmdFillBuffer &msg, INOUT TransferJobs_t &jobs)
 	{
 		GpuMsg::GetBufferDescription	req_descr;
 		msg.dstBuffer->Send( req_descr );
@@ -788,16 +1553,70 @@ namespace PlatformSW
 		CHECK_ERR( (msg.dstOffset % req_mem.result->align) == 0 );
 		CHECK_ERR( req_mem.result->memory.Size() == size );
 		
-		const ubyte	pattern[4]	= {  msg.pattern & 0xFF,
-									(msg.pattern >> 8) & 0xFF,
-									(msg.pattern >> 16) & 0xFF,
-									(msg.pattern >> 24) & 0xFF };
+		jobs.PushBack({ req_mem.result->memory, BinArrayCRef(), msg.pattern });
+		return true;
+	}
+	
+/*
+=================================================
+	_ExecuteTransferJob
+=================================================
+*/
+	void SWCommandBuffer::_ExecuteTransferJob (const TransferJob &job)
+	{
+		BinArrayRef		dst = job.dst;
 
-		for (usize i = 0; i < usize(size); ++i)
+		if ( not job.src.Empty() )
 		{
-			req_mem.result->memory[i] = pattern[i&3];
+			MemCopy( OUT dst, job.src );
+			return;
+		}
+
+		const ubyte	pattern[4]	= {  job.pattern & 0xFF,
+									(job.pattern >> 8) & 0xFF,
+									(job.pattern >> 16) & 0xFF,
+									(job.pattern >> 24) & 0xFF };
+
+		for (usize i = 0; i < dst.Count(); ++i)
+		{
+			dst[i] = pattern[i&3];
 		}
-		return true;
+	}
+	
+/*
+=================================================
+	_RunTransferJobs
+----
+	returns number of jobs that are executed on worker threads.
+	Jobs in batch are independent and memory is already resolved,
+	so worker threads don't send messages to resources.
+=================================================
+*/
+	usize SWCommandBuffer::_RunTransferJobs (ArrayCRef<TransferJob> jobs)
+	{
+		BytesU	total_size;
+
+		for (auto& job : jobs) {
+			total_size += job.dst.Size();
+		}
+
+		if ( jobs.Count() < 2 or total_size < _MinParallelTransferSize )
+		{
+			for (auto& job : jobs) {
+				_ExecuteTransferJob( job );
+			}
+			return 0;
+		}
+
+		ParallelFor( jobs.Count(), 1, 0,
+			LAMBDA( jobs ) (usize first, usize last)
+			{
+				for (usize i = first; i < last; ++i) {
+					_ExecuteTransferJob( jobs[i] );
+				}
+			});
+
+		return jobs.Count();
 	}
 	
 /*
@@ -823,6 +1642,11 @@ namespace PlatformSW
 		for (auto& src : msg.imageBarriers)
 		{
 			CHECK_ERR( src.image );
+
+			// software renderer tracks only image layouts
+			if ( src.oldLayout == src.newLayout )
+				continue;
+
 			src.image->Send( GpuMsg::SWImageBarrier{ src, msg.srcStageMask, msg.dstStageMask });
 		}
 
@@ -898,6 +1722,203 @@ namespace PlatformSW
 		return true;
 	}
 
+/*
+=================================================
+	_GetQueryData
+=================================================
+*/
+	bool SWCommandBuffer::_GetQueryData (const ModulePtr &queryPool, uint firstIndex, uint count, OUT QueryData_t &result)
+	{
+		GpuMsg::GetSWQueryPoolData	req_data;
+		queryPool->Send( req_data );
+
+		CHECK_ERR( req_data.result and req_data.result->valuesPerQuery > 0 );
+
+		const uint	vpq = req_data.result->valuesPerQuery;
+
+		CHECK_ERR( count > 0 );
+		CHECK_ERR( usize(firstIndex + count) * vpq <= req_data.result->values.Count() );
+
+		result.values			= req_data.result->values.SubArray( firstIndex * vpq, count * vpq );
+		result.valuesPerQuery	= vpq;
+		return true;
+	}
+
+/*
+=================================================
+	operator (CmdBeginQuery)
+=================================================
+*/
+	bool SWCommandBuffer::operator () (const GpuMsg::CmdBeginQuery &msg)
+	{
+		QueryData_t		data;
+		CHECK_ERR( _GetQueryData( msg.queryPool, msg.queryIndex, 1, OUT data ) );
+
+		for (auto& q : _activeQueries) {
+			CHECK_ERR( not (q.queryPool == msg.queryPool and q.queryIndex == msg.queryIndex) );
+		}
+
+		_activeQueries.PushBack({ msg.queryPool, msg.queryIndex, GetDevice()->GetPipelineCounters() });
+		return true;
+	}
+
+/*
+=================================================
+	operator (CmdEndQuery)
+----
+	occlusion query is always zero because there is no rasterization,
+	pipeline statistic is written in the order of statistic flags.
+=================================================
+*/
+	bool SWCommandBuffer::operator () (const GpuMsg::CmdEndQuery &msg)
+	{
+		usize	idx = UMax;
+
+		FOR( i, _activeQueries ) {
+			if ( _activeQueries[i].queryPool == msg.queryPool and _activeQueries[i].queryIndex == msg.queryIndex ) {
+				idx = i;
+				break;
+			}
+		}
+		CHECK_ERR( idx < _activeQueries.Count() );
+
+		const PipelineCounters_t	begin	= _activeQueries[idx].counters;
+		const PipelineCounters_t&	end		= GetDevice()->GetPipelineCounters();
+
+		_activeQueries.Erase( idx );
+
+		QueryData_t		data;
+		CHECK_ERR( _GetQueryData( msg.queryPool, msg.queryIndex, 1, OUT data ) );
+
+		GpuMsg::GetQueryPoolDescription	req_descr;
+		msg.queryPool->Send( req_descr );
+		CHECK_ERR( req_descr.result );
+
+		switch ( req_descr.result->queryType )
+		{
+			case EQuery::Occlusion :
+				data.values[0] = 0;
+				break;
+
+			case EQuery::PipelineStatistic :
+			{
+				const auto&	flags	= req_descr.result->statisticFlags;
+				usize		j		= 0;
+
+				FOR( i, flags )
+				{
+					const auto	t = EPipelineStatistic::type(i);
+
+					if ( not flags[t] )
+						continue;
+
+					switch ( t )
+					{
+						case EPipelineStatistic::ComputeShaderInvocations :	data.values[j] = end.computeInvocations - begin.computeInvocations;	break;
+						case EPipelineStatistic::ComputeShaderWorkGroups :	data.values[j] = end.computeWorkGroups - begin.computeWorkGroups;	break;
+						default :											data.values[j] = 0;													break;
+					}
+					++j;
+				}
+				break;
+			}
+
+			default :
+				RETURN_ERR( "query type is not supported by 'CmdEndQuery'" );
+		}
+		return true;
+	}
+
+/*
+=================================================
+	operator (CmdCopyQueryPoolResults)
+----
+	results are always available because commands are executed sequentially,
+	so 'Wait' flag has no effect and availability value is always 1.
+=================================================
+*/
+	bool SWCommandBuffer::operator () (const GpuMsg::CmdCopyQueryPoolResults &msg)
+	{
+		QueryData_t		data;
+		CHECK_ERR( _GetQueryData( msg.queryPool, msg.firstQueryIndex, msg.queryCount, OUT data ) );
+
+		const bool		is_32bit	= msg.flags[ EQueryResult::Value32 ];
+		const usize		val_count	= data.valuesPerQuery + (msg.flags[ EQueryResult::WithAvailability ] ? 1 : 0);
+		const BytesU	val_size	= is_32bit ? SizeOf<uint> : SizeOf<ulong>;
+		const BytesU	query_size	= val_size * val_count;
+		const BytesU	total_size	= msg.stride * (msg.queryCount - 1) + query_size;
+
+		CHECK_ERR( msg.stride >= query_size or msg.queryCount == 1 );
+
+		GpuMsg::GetSWBufferMemoryLayout		req_mem { msg.dstOffset, total_size, EPipelineAccess::TransferWrite, EPipelineStage::Transfer };
+		GpuMsg::GetBufferDescription		req_descr;
+
+		msg.dstBuffer->Send( req_mem );
+		msg.dstBuffer->Send( req_descr );
+
+		CHECK_ERR( req_mem.result and req_descr.result );
+		CHECK_ERR( msg.dstOffset + total_size <= req_descr.result->size );
+		CHECK_ERR( req_descr.result->usage[ EBufferUsage::TransferDst ] );
+		CHECK_ERR( req_mem.result->memAccess[ EMemoryAccess::GpuWrite ] );
+		CHECK_ERR( req_mem.result->memory.Size() == total_size );
+
+		BinArrayRef		dst = req_mem.result->memory;
+
+		for (uint i = 0; i < msg.queryCount; ++i)
+		{
+			BinArrayRef		dst_query = dst.SubArray( usize(msg.stride * i), usize(query_size) );
+
+			for (usize j = 0; j < val_count; ++j)
+			{
+				const ulong		value	= j < data.valuesPerQuery ? data.values[ i * data.valuesPerQuery + j ] : 1;
+				const uint		value32	= uint(value);
+				BinArrayRef		dst_val	= dst_query.SubArray( usize(val_size * j), usize(val_size) );
+
+				if ( is_32bit )
+					MemCopy( OUT dst_val, BinArrayCRef::FromVoid( &value32, val_size ) );
+				else
+					MemCopy( OUT dst_val, BinArrayCRef::FromVoid( &value, val_size ) );
+			}
+		}
+		return true;
+	}
+
+/*
+=================================================
+	operator (CmdWriteTimestamp)
+----
+	commands are executed sequentially,
+	so timestamp is written when all previous commands are completed for any stage.
+=================================================
+*/
+	bool SWCommandBuffer::operator () (const GpuMsg::CmdWriteTimestamp &msg)
+	{
+		QueryData_t		data;
+		CHECK_ERR( _GetQueryData( msg.queryPool, msg.queryIndex, 1, OUT data ) );
+
+		GpuMsg::GetQueryPoolDescription	req_descr;
+		msg.queryPool->Send( req_descr );
+
+		CHECK_ERR( req_descr.result and req_descr.result->queryType == EQuery::Timestamp );
+
+		data.values[0] = GetDevice()->GetTimestamp();
+		return true;
+	}
+
+/*
+=================================================
+	operator (CmdResetQueryPool)
+=================================================
+*/
+	bool SWCommandBuffer::operator () (const GpuMsg::CmdResetQueryPool &msg)
+	{
+		QueryData_t		data;
+		CHECK_ERR( _GetQueryData( msg.queryPool, msg.firstQueryIndex, msg.queryCount, OUT data ) );
+
+		ZeroMem( data.values );
+		return true;
+	}
+
 }	// PlatformSW
 //-----------------------------------------------------------------------------
 
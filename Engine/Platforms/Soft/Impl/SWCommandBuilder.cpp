@@ -80,6 +80,8 @@ namespace PlatformSW
 		bool _CmdCopyImage (const GpuMsg::CmdCopyImage &);
 		bool _CmdCopyBufferToImage (const GpuMsg::CmdCopyBufferToImage &);
 		bool _CmdCopyImageToBuffer (const GpuMsg::CmdCopyImageToBuffer &);
+		bool _CmdBlitImage (const GpuMsg::CmdBlitImage &);
+		bool _CmdResolveImage (const GpuMsg::CmdResolveImage &);
 		bool _CmdUpdateBuffer (const GpuMsg::CmdUpdateBuffer &);
 		bool _CmdFillBuffer (const GpuMsg::CmdFillBuffer &);
 		bool _CmdClearColorImage (const GpuMsg::CmdClearColorImage &);
@@ -89,6 +91,11 @@ namespace PlatformSW
 		bool _CmdDebugMarker (const GpuMsg::CmdDebugMarker &);
 		bool _CmdPushDebugGroup (const GpuMsg::CmdPushDebugGroup &);
 		bool _CmdPopDebugGroup (const GpuMsg::CmdPopDebugGroup &);
+		bool _CmdBeginQuery (const GpuMsg::CmdBeginQuery &);
+		bool _CmdEndQuery (const GpuMsg::CmdEndQuery &);
+		bool _CmdCopyQueryPoolResults (const GpuMsg::CmdCopyQueryPoolResults &);
+		bool _CmdWriteTimestamp (const GpuMsg::CmdWriteTimestamp &);
+		bool _CmdResetQueryPool (const GpuMsg::CmdResetQueryPool &);
 	};
 //-----------------------------------------------------------------------------
 
@@ -133,6 +140,8 @@ namespace PlatformSW
 		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdCopyImage );
 		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdCopyBufferToImage );
 		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdCopyImageToBuffer );
+		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdBlitImage );
+		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdResolveImage );
 		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdUpdateBuffer );
 		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdFillBuffer );
 		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdClearColorImage );
@@ -142,6 +151,11 @@ namespace PlatformSW
 		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdDebugMarker );
 		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdPushDebugGroup );
 		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdPopDebugGroup );
+		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdBeginQuery );
+		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdEndQuery );
+		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdCopyQueryPoolResults );
+		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdWriteTimestamp );
+		_SubscribeOnMsg( this, &SWCommandBuilder::_CmdResetQueryPool );
 
 		ASSERT( _ValidateMsgSubscriptions< SupportedMessages_t >() );
 
@@ -323,6 +337,7 @@ namespace PlatformSW
 	bool SWCommandBuilder::_CmdDispatchIndirect (const GpuMsg::CmdDispatchIndirect &msg)
 	{
 		CHECK_ERR( _cmdBuffer );
+		CHECK_ERR( msg.indirectBuffer );
 		
 		_commands.PushBack({ msg, __FILE__, __LINE__ });
 		return true;
@@ -405,11 +420,39 @@ namespace PlatformSW
 	{
 		CHECK_ERR( _cmdBuffer );
 		CHECK_ERR( msg.srcImage and msg.dstBuffer );
-		
+
 		_commands.PushBack({ msg, __FILE__, __LINE__ });
 		return true;
 	}
-	
+
+/*
+=================================================
+	_CmdBlitImage
+=================================================
+*/
+	bool SWCommandBuilder::_CmdBlitImage (const GpuMsg::CmdBlitImage &msg)
+	{
+		CHECK_ERR( _cmdBuffer );
+		CHECK_ERR( msg.srcImage and msg.dstImage );
+
+		_commands.PushBack({ msg, __FILE__, __LINE__ });
+		return true;
+	}
+
+/*
+=================================================
+	_CmdResolveImage
+=================================================
+*/
+	bool SWCommandBuilder::_CmdResolveImage (const GpuMsg::CmdResolveImage &msg)
+	{
+		CHECK_ERR( _cmdBuffer );
+		CHECK_ERR( msg.srcImage and msg.dstImage );
+
+		_commands.PushBack({ msg, __FILE__, __LINE__ });
+		return true;
+	}
+
 /*
 =================================================
 	_GpuCmdUpdateBuffer
@@ -529,6 +572,77 @@ namespace PlatformSW
 		_commands.PushBack({ msg, __FILE__, __LINE__ });
 		return true;
 	}
+	
+/*
+=================================================
+	_CmdBeginQuery
+=================================================
+*/
+	bool SWCommandBuilder::_CmdBeginQuery (const GpuMsg::CmdBeginQuery &msg)
+	{
+		CHECK_ERR( _cmdBuffer );
+		CHECK_ERR( msg.queryPool );
+		
+		_commands.PushBack({ msg, __FILE__, __LINE__ });
+		return true;
+	}
+	
+/*
+=================================================
+	_CmdEndQuery
+=================================================
+*/
+	bool SWCommandBuilder::_CmdEndQuery (const GpuMsg::CmdEndQuery &msg)
+	{
+		CHECK_ERR( _cmdBuffer );
+		CHECK_ERR( msg.queryPool );
+		
+		_commands.PushBack({ msg, __FILE__, __LINE__ });
+		return true;
+	}
+	
+/*
+=================================================
+	_CmdCopyQueryPoolResults
+=================================================
+*/
+	bool SWCommandBuilder::_CmdCopyQueryPoolResults (const GpuMsg::CmdCopyQueryPoolResults &msg)
+	{
+		CHECK_ERR( _cmdBuffer );
+		CHECK_ERR( msg.queryPool and msg.dstBuffer );
+		CHECK_ERR( msg.stride >= (msg.flags[EQueryResult::Value32] ? SizeOf<uint> : SizeOf<ulong>) );
+		
+		_commands.PushBack({ msg, __FILE__, __LINE__ });
+		return true;
+	}
+	
+/*
+=================================================
+	_CmdWriteTimestamp
+=================================================
+*/
+	bool SWCommandBuilder::_CmdWriteTimestamp (const GpuMsg::CmdWriteTimestamp &msg)
+	{
+		CHECK_ERR( _cmdBuffer );
+		CHECK_ERR( msg.queryPool );
+		
+		_commands.PushBack({ msg, __FILE__, __LINE__ });
+		return true;
+	}
+	
+/*
+=================================================
+	_CmdResetQueryPool
+=================================================
+*/
+	bool SWCommandBuilder::_CmdResetQueryPool (const GpuMsg::CmdResetQueryPool &msg)
+	{
+		CHECK_ERR( _cmdBuffer );
+		CHECK_ERR( msg.queryPool );
+		
+		_commands.PushBack({ msg, __FILE__, __LINE__ });
+		return true;
+	}
 
 }	// PlatformSW
 //-----------------------------------------------------------------------------
@@ -29,7 +29,8 @@ namespace PlatformSW
 											GpuMsg::GetCommandQueueDescription,
 											GpuMsg::SWPresent,
 											GpuMsg::ClientWaitFence,
-											GpuMsg::ClientWaitDeviceIdle
+											GpuMsg::ClientWaitDeviceIdle,
+											GpuMsg::SWResumeQueue
 										> >;
 
 		using SupportedEvents_t		= SWBaseModule::SupportedEvents_t::Append< MessageListFrom<
@@ -67,7 +68,6 @@ namespace PlatformSW
 		};
 
 		using CmdQueue_t			= Queue< Submitted >;
-		using FencesSet_t			= FixedSizeSet< SWFencePtr, GpuMsg::ClientWaitFence::Fences_t::MemoryContainer_t::SIZE >;
 
 
 	// constants
@@ -101,10 +101,11 @@ namespace PlatformSW
 		bool _SWPresent (const GpuMsg::SWPresent &);
 		bool _ClientWaitFence (const GpuMsg::ClientWaitFence &);
 		bool _ClientWaitDeviceIdle (const GpuMsg::ClientWaitDeviceIdle &);
+		bool _ResumeQueue (const GpuMsg::SWResumeQueue &);
 
 	private:
-		bool _Execute (INOUT FencesSet_t &fences);
 		bool _Execute ();
+		bool _ExecuteSubmission (INOUT Submitted &submitted, OUT bool &completed);
 	};
 //-----------------------------------------------------------------------------
 
@@ -142,6 +143,7 @@ namespace PlatformSW
 		_SubscribeOnMsg( this, &SWCommandQueue::_SWPresent );
 		_SubscribeOnMsg( this, &SWCommandQueue::_ClientWaitFence );
 		_SubscribeOnMsg( this, &SWCommandQueue::_ClientWaitDeviceIdle );
+		_SubscribeOnMsg( this, &SWCommandQueue::_ResumeQueue );
 
 		ASSERT( _ValidateMsgSubscriptions< SupportedMessages_t >() );
 
@@ -167,6 +169,9 @@ namespace PlatformSW
 	{
 		CHECK( _Execute() );
 
+		if ( GetDevice() )
+			GetDevice()->RemoveQueue( this );
+
 		_descr = Uninitialized;
 
 		return Module::_Delete_Impl( msg );
@@ -186,6 +191,8 @@ namespace PlatformSW
 		CHECK_ERR( _GetManager() );
 
 		CHECK_LINKING( _syncManager = _GetManager()->GetModuleByMsg< SyncMngrMsgList_t >() );
+
+		GetDevice()->AddQueue( this );
 		
 		return Module::_Link_Impl( msg );
 	}
@@ -252,6 +259,9 @@ namespace PlatformSW
 		}
 
 		_queue.PushBack( RVREF(submit) );
+
+		// execute immediately, submission may wait for semaphore that will be signaled later
+		CHECK( _Execute() );
 		return true;
 	}
 	
@@ -284,107 +294,106 @@ namespace PlatformSW
 /*
 =================================================
 	_Execute
+----
+	submissions are executed in submission order,
+	so execution stops on first submission that waits for semaphore.
+	All queues are executed on gpu thread, compute dispatches
+	inside command buffers are executed on thread pool.
 =================================================
 */
 	bool SWCommandQueue::_Execute ()
 	{
-		FencesSet_t		empty;
-		return _Execute( empty );
-	}
+		if ( _lockQueue )
+			return true;	// already executing, new submissions will be processed in current loop
 
-	bool SWCommandQueue::_Execute (INOUT FencesSet_t &fences)
-	{
 		SCOPE_SETTER( _lockQueue = true, false );
 
-		const bool	run_to_fence = not fences.Empty();
-		bool		changed		 = true;
-
-		for (uint k = 0; k < 10; ++k)
+		for (; not _queue.Empty();)
 		{
-			changed = false;
+			bool	completed = false;
 
-			FOR( i, _queue )
-			{
-				auto&	submited = _queue[i];
-
-				// wait semaphores
-				FOR( j, submited.waitSemaphores )
-				{
-					auto&	sem = submited.waitSemaphores[j];
-
-					if ( sem.first->TryLock( sem.second ) )
-					{
-						submited.waitSemaphores.Erase( j );
-						--j;
-					}
-				}
+			CHECK_ERR( _ExecuteSubmission( INOUT _queue.Front(), OUT completed ) );
 
-				// execute command buffers
-				FOR( j, submited.commands )
-				{
-					auto&	cmd = submited.commands[j];
+			if ( not completed )
+				break;
 
-					cmd.first->Send( cmd.second );
+			Submitted	submitted = RVREF( _queue.Front() );
+			_queue.PopFront();
 
-					// TODO: compare lastIndex and set 'changed' to true
+			// signal immediately
+			if ( submitted.signalFence )
+				submitted.signalFence->Signal();
 
-					// remove command buffer if completed
-					if ( *cmd.second.completed )
-					{
-						cmd.first->Send( GpuMsg::SetCommandBufferState{ GpuMsg::SetCommandBufferState::EState::Completed });
+			if ( not submitted.signalSemaphores.Empty() )
+			{
+				for (auto& sem : submitted.signalSemaphores) {
+					sem->Unlock();
+				}
 
-						submited.commands.Erase( j );
-						--j;
+				// other queues may wait for this semaphores
+				GetDevice()->ResumeQueues();
+			}
+		}
+		return true;
+	}
+	
+/*
+=================================================
+	_ExecuteSubmission
+=================================================
+*/
+	bool SWCommandQueue::_ExecuteSubmission (INOUT Submitted &submitted, OUT bool &completed)
+	{
+		completed = false;
 
-						changed = true;
-					}
-				}
+		// wait semaphores
+		FOR( j, submitted.waitSemaphores )
+		{
+			auto&	sem = submitted.waitSemaphores[j];
 
-				// finish
-				if ( submited.commands.Empty() )
-				{
-					for (auto& sem : submited.signalSemaphores) {
-						sem->Unlock();
-					}
+			if ( sem.first->TryLock( sem.second ) )
+			{
+				submitted.waitSemaphores.Erase( j );
+				--j;
+			}
+		}
 
-					if ( submited.signalFence )
-					{
-						submited.signalFence->Signal();
+		if ( not submitted.waitSemaphores.Empty() )
+			return true;
 
-						fences.Erase( submited.signalFence );
-					}
+		// execute command buffers
+		FOR( j, submitted.commands )
+		{
+			auto&	cmd = submitted.commands[j];
 
-					_queue.Erase( i );
-					--i;
+			cmd.first->Send( cmd.second );
 
-					changed = true;
-				}
+			if ( not *cmd.second.completed )
+				return true;
 
-				// exit if all fences was signaled
-				if ( run_to_fence and fences.Empty() )
-					return true;
-			}
+			cmd.first->Send( GpuMsg::SetCommandBufferState{ GpuMsg::SetCommandBufferState::EState::Completed });
 
-			// reset counter if something changed
-			if ( changed )
-			{
-				k = 0;
-			}
-		}
-		
-		// check for deadlock on semaphore or event
-		if ( not changed and not _queue.Empty() )
-		{
-			_SendEvent( GpuMsg::DeviceLost{} );
-			return false;
+			submitted.commands.Erase( j );
+			--j;
 		}
 
-		// check for deadlock on fence
-		if ( run_to_fence )
+		completed = true;
+		return true;
+	}
+
+/*
+=================================================
+	_ResumeQueue
+=================================================
+*/
+	bool SWCommandQueue::_ResumeQueue (const GpuMsg::SWResumeQueue &msg)
+	{
+		if ( _IsComposedState( GetState() ) )
 		{
-			_SendEvent( GpuMsg::DeviceLost{} );
-			return false;
+			CHECK( _Execute() );
 		}
+
+		msg.hasPending.Set( not _queue.Empty() );
 		return true;
 	}
 
@@ -402,6 +411,10 @@ namespace PlatformSW
 /*
 =================================================
 	_ClientWaitFence
+----
+	queues are resumed until fences are signaled or timeout expired.
+	If all queues are idle then fence will never be signaled,
+	this is handled as device lost.
 =================================================
 */
 	bool SWCommandQueue::_ClientWaitFence (const GpuMsg::ClientWaitFence &msg)
@@ -409,21 +422,56 @@ namespace PlatformSW
 		CHECK_ERR( _IsComposedState( GetState() ) );
 		CHECK_ERR( not msg.fences.Empty() );
 
-		FencesSet_t		fences;
+		const auto	AllSignaled = LAMBDA( this, &msg ) ()
+		{
+			for (auto& wfence : msg.fences)
+			{
+				const auto	fence = _syncManager->Request( GpuMsg::GetSWFence{ wfence } );
+
+				if ( not fence->Wait() )
+					return false;
+			}
+			return true;
+		};
 
 		for (auto& wfence : msg.fences)
 		{
 			const auto	fence = _syncManager->Request( GpuMsg::GetSWFence{ wfence } );
 
 			CHECK_ERR( fence->IsEnqueued() );
-			fences.Add( fence );
 		}
 
-		if ( fences.Empty() )
+		// submissions are executed immediately, so fence may be already signaled
+		if ( AllSignaled() )
 			return true;
 
-		CHECK( _Execute( fences ) );
-		return true;
+		// fence may be signaled by submission in any queue,
+		// submission may wait for semaphore that is signaled in another thread
+		const ulong		timeout	= ulong(msg.timeout.NanoSeconds());
+		TimeProfilerL	timer{ true };
+
+		for (;;)
+		{
+			const bool	pending = GetDevice()->ResumeQueues();
+
+			if ( AllSignaled() )
+				return true;
+
+			if ( not pending )
+			{
+				LOG( "all queues are idle, but fence is not signaled", ELog::Warning );
+				_SendEvent( GpuMsg::DeviceLost{} );
+				return false;
+			}
+
+			if ( ulong(timer.GetTimeDelta().NanoSeconds()) >= timeout )
+				break;
+
+			OS::CurrentThread::Yield();
+		}
+
+		LOG( "timeout on waiting for fence", ELog::Warning );
+		return false;
 	}
 	
 /*
@@ -435,7 +483,14 @@ namespace PlatformSW
 	{
 		CHECK_ERR( _IsComposedState( GetState() ) );
 
-		CHECK( _Execute() );
+		GetDevice()->ResumeQueues();
+
+		// deadlock on semaphore
+		if ( not _queue.Empty() )
+		{
+			_SendEvent( GpuMsg::DeviceLost{} );
+			return false;
+		}
 		return true;
 	}
 
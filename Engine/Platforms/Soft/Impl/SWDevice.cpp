@@ -19,8 +19,8 @@ namespace PlatformSW
 */
 	SWDevice::SWDevice (GlobalSystemsRef gs) :
 		BaseObject( gs ),
-		_debugReportCounter{ 0 },	_debugReportEnabled{ false },
-		_initialized{ false }
+		_debugReportCounter{ 0 },	_memAllocator{ _MemPageSize, 1_b },
+		_debugReportEnabled{ false },	_initialized{ false }
 	{
 	}
 	
@@ -33,6 +33,15 @@ namespace PlatformSW
 	{
 		CHECK( not _initialized );
 
+		// memory objects refer to page memory, they must be released before device
+		MemAllocator_t::Statistics	mem_stat;
+		_memAllocator.GetStatistics( OUT mem_stat );
+		CHECK( mem_stat.allocations == 0 );
+
+		MemAllocator_t::PageUserData_t	released;
+		_memAllocator.Clear( OUT released );
+		_memPages.Clear();
+
 		if ( _debugReportCounter > 0 )
 		{
 			WARNING( "There are a few warnings, check debug output!" );
@@ -44,10 +53,12 @@ namespace PlatformSW
 	Initialize
 =================================================
 */
-	bool SWDevice::Initialize ()
+	bool SWDevice::Initialize (const bool pinThreads)
 	{
 		_initialized = true;
 
+		_shaderModel.SetThreadPinning( pinThreads );
+
 		_UpdateProperties();
 		return true;
 	}
@@ -59,7 +70,79 @@ namespace PlatformSW
 */
 	void SWDevice::Deinitialize ()
 	{
+		_PrintCommandStats();
+
 		_initialized = false;
+		_queues.Clear();
+		_cmdStats = CommandStats();
+
+		_ReleaseMemPages( 0 );
+	}
+
+/*
+=================================================
+	AllocMemory
+----
+	sub-allocates memory for buffer or image from large pages,
+	returns false if resource must use dedicated allocation.
+=================================================
+*/
+	bool SWDevice::AllocMemory (BytesU size, BytesU align, OUT MemAllocation_t &alloc, OUT BinArrayRef &mem)
+	{
+		if ( size > _MemPageSize / 2 or align > _MemPageAlign )
+			return false;
+
+		GX_MEMORY_SCOPE( EMemorySubsystem::GpuHostMemory );
+
+		if ( not _memAllocator.Allocate( size, align, OUT alloc ) )
+		{
+			// find unused page slot
+			usize	index = 0;
+			for (; index < _memPages.Count() and not _memPages[index].Empty(); ++index) {}
+
+			if ( index == _memPages.Count() )
+				_memPages.PushBack( BinaryArray() );
+
+			_memPages[index].Resize( usize(_MemPageSize + _MemPageAlign), false );
+
+			const uint	page = _memAllocator.AddPage( _MemPageSize, index );
+
+			CHECK_ERR( _memAllocator.Allocate( size, align, OUT alloc ) and alloc.page == page );
+		}
+
+		// page memory is aligned to '_MemPageAlign'
+		BinaryArray&	page_mem	= _memPages[ usize(_memAllocator.PageUserData( alloc.page )) ];
+		const usize		base		= usize(AlignToLarge( ReferenceCast<usize>(page_mem.ptr()), usize(_MemPageAlign) ) - ReferenceCast<usize>(page_mem.ptr()));
+
+		mem = BinArrayRef(page_mem).SubArray( base + usize(alloc.offset), usize(size) );
+		return true;
+	}
+	
+/*
+=================================================
+	FreeMemory
+=================================================
+*/
+	void SWDevice::FreeMemory (INOUT MemAllocation_t &alloc)
+	{
+		CHECK( _memAllocator.Deallocate( INOUT alloc ) );
+
+		_ReleaseMemPages( _MaxEmptyMemPages );
+	}
+	
+/*
+=================================================
+	_ReleaseMemPages
+=================================================
+*/
+	void SWDevice::_ReleaseMemPages (usize keepPages)
+	{
+		MemAllocator_t::PageUserData_t	released;
+		_memAllocator.ReleaseEmptyPages( keepPages, OUT released );
+
+		for (auto& index : released) {
+			_memPages[ usize(index) ].Free();
+		}
 	}
 	
 /*
@@ -81,6 +164,99 @@ namespace PlatformSW
 	{
 		return _shaderModel.DispatchCompute( workGroups, pipeline, resourceTable );
 	}
+	
+/*
+=================================================
+	GetTimestamp
+=================================================
+*/
+	ulong SWDevice::GetTimestamp () const
+	{
+		return ulong( OS::PerformanceTimer().GetTime().NanoSeconds() );
+	}
+	
+/*
+=================================================
+	AddQueue
+=================================================
+*/
+	void SWDevice::AddQueue (const ModulePtr &queue)
+	{
+		ASSERT( not _queues.IsExist( queue ) );
+
+		_queues.PushBack( queue );
+	}
+	
+/*
+=================================================
+	RemoveQueue
+=================================================
+*/
+	void SWDevice::RemoveQueue (const ModulePtr &queue)
+	{
+		_queues.FindAndErase( queue );
+	}
+	
+/*
+=================================================
+	ResumeQueues
+----
+	all queues are executed on gpu thread,
+	queue that is currently executing will ignore this message.
+	Returns true if any queue has not completed submissions.
+=================================================
+*/
+	bool SWDevice::ResumeQueues ()
+	{
+		const Queues_t	queues	= _queues;	// queue may be removed while executing
+		bool			pending	= false;
+
+		for (auto& queue : queues)
+		{
+			GpuMsg::SWResumeQueue	msg;
+			queue->Send( msg );
+
+			pending |= msg.hasPending.Get( false );
+		}
+		return pending;
+	}
+	
+/*
+=================================================
+	AddCommandStats
+=================================================
+*/
+	void SWDevice::AddCommandStats (const CommandStats &stats)
+	{
+		_cmdStats.commands			+= stats.commands;
+		_cmdStats.barriers			+= stats.barriers;
+		_cmdStats.droppedBarriers	+= stats.droppedBarriers;
+		_cmdStats.batches			+= stats.batches;
+		_cmdStats.maxBatchSize		 = Max( _cmdStats.maxBatchSize, stats.maxBatchSize );
+		_cmdStats.parallelJobs		+= stats.parallelJobs;
+	}
+	
+/*
+=================================================
+	_PrintCommandStats
+=================================================
+*/
+	void SWDevice::_PrintCommandStats () const
+	{
+		if ( _cmdStats.commands == 0 )
+			return;
+
+		String	str;
+		str << "Software command buffer statistics:"
+			<< "\n  commands:         " << _cmdStats.commands
+			<< "\n  batches:          " << _cmdStats.batches
+			<< "\n  avg batch size:   " << String().FormatF( double(_cmdStats.commands) / Max( _cmdStats.batches, usize(1) ), StringFormatF().Fmt(0,2) )
+			<< "\n  max batch size:   " << _cmdStats.maxBatchSize
+			<< "\n  dropped barriers: " << _cmdStats.droppedBarriers << " of " << _cmdStats.barriers
+			<< "\n  parallel jobs:    " << _cmdStats.parallelJobs;
+
+		LOG( str, ELog::Debug );
+	}
 		
 /*
 =================================================
@@ -141,6 +317,7 @@ namespace PlatformSW
 		_properties.maxComputeWorkGroupCount		= SWDeviceProperties.limits.maxComputeWorkGroupCount;
 
 		_properties.explicitMemoryObjects	= false;	// TODO
+		_properties.timestampPeriod			= 1.0f;		// timestamps are in nanoseconds
 	}
 
 }	// PlatformSW
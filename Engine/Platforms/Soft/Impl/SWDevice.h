@@ -9,6 +9,7 @@
 #include "Engine/Platforms/Soft/Impl/SWEnums.h"
 #include "Engine/Platforms/Soft/Impl/SWShaderModel.h"
 #include "Engine/Platforms/Public/GPU/Thread.h"
+#include "Engine/Platforms/Public/Tools/GpuMemoryAllocator.h"
 
 namespace Engine
 {
@@ -37,7 +38,29 @@ namespace PlatformSW
 			GX_ENUM_BITFIELD( EDbgReport );
 		};
 
+		struct CommandStats
+		{
+			usize	commands		= 0;	// executed commands
+			usize	barriers		= 0;	// recorded pipeline barriers
+			usize	droppedBarriers	= 0;	// barriers that have no effect in software renderer
+			usize	batches			= 0;	// groups of independent commands
+			usize	maxBatchSize	= 0;
+			usize	parallelJobs	= 0;	// transfer operations that are executed on worker threads
+		};
+
 		using DeviceProperties_t	= GpuMsg::GetDeviceProperties::Properties;
+		using PipelineCounters_t	= SWShaderModel::PipelineCounters;
+		using Queues_t				= Array< ModulePtr >;
+		using MemAllocator_t		= PlatformTools::GpuMemoryAllocator;
+		using MemAllocation_t		= MemAllocator_t::Allocation;
+		using MemPages_t			= Array< BinaryArray >;
+
+
+	// constants
+	private:
+		static constexpr BytesU		_MemPageSize		= 16_Mb;
+		static constexpr BytesU		_MemPageAlign		= 256_b;
+		static constexpr uint		_MaxEmptyMemPages	= 1;
 
 
 	// variables
@@ -45,7 +68,12 @@ namespace PlatformSW
 		uint2				_surfaceSize;
 
 		SWShaderModel		_shaderModel;
+		Queues_t			_queues;
+		CommandStats		_cmdStats;
 		mutable uint		_debugReportCounter;
+
+		MemAllocator_t		_memAllocator;
+		MemPages_t			_memPages;
 		
 		DeviceProperties_t	_properties;
 
@@ -58,12 +86,21 @@ namespace PlatformSW
 		explicit SWDevice (GlobalSystemsRef gs);
 		~SWDevice ();
 		
-		bool Initialize ();
+		bool Initialize (bool pinThreads = false);
 		void Deinitialize ();
 
 		void Resize (const uint2 &size);
 
 		bool DispatchCompute (const uint3 &workGroups, const ModulePtr &pipeline, const ModulePtr &resourceTable);
+
+		void AddQueue (const ModulePtr &queue);
+		void RemoveQueue (const ModulePtr &queue);
+		bool ResumeQueues ();
+
+		void AddCommandStats (const CommandStats &stats);
+
+		bool AllocMemory (BytesU size, BytesU align, OUT MemAllocation_t &alloc, OUT BinArrayRef &mem);
+		void FreeMemory (INOUT MemAllocation_t &alloc);
 		
 		void InitDebugReport ();
 		void DebugReport (StringCRef log, EDbgReport::bits flags, StringCRef file, int line) const;
@@ -74,9 +111,17 @@ namespace PlatformSW
 		
 		ND_ DeviceProperties_t const&	GetProperties ()	const	{ return _properties; }
 
+		ND_ CommandStats const&			GetCommandStats ()	const	{ return _cmdStats; }
+
+		ND_ PipelineCounters_t const&	GetPipelineCounters () const	{ return _shaderModel.GetCounters(); }
+
+		ND_ ulong						GetTimestamp ()		const;		// in nanoseconds
+
 
 	private:
 		void _UpdateProperties ();
+		void _ReleaseMemPages (usize keepPages);
+		void _PrintCommandStats () const;
 	};
 
 
@@ -0,0 +1,634 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Core/Config/Engine.Config.h"
+
+#ifdef GRAPHICS_API_SOFT
+
+#include "Engine/Platforms/Soft/Impl/SWImageBlitter.h"
+#include "Core/STL/Math/Color/ColorFormats.h"
+#include "Core/STL/Math/Color/ColorBatchConverter.h"
+#include "Core/STL/Math/Interpolations.h"
+#include "Core/STL/ThreadSafe/ParallelFor.h"
+
+namespace Engine
+{
+namespace PlatformSW
+{
+	using namespace GX_STL::GXMath::ColorFormat;
+
+	using Converter = ColorFormatUtils::ColorFormatConverter;
+
+
+/*
+=================================================
+	LoadRow
+=================================================
+*/
+	template <typename ColorType>
+	static void LoadRow (const void *src, usize count, OUT float4 *dst)
+	{
+		ColorType const*	in = Cast<ColorType const *>(src);
+
+		for (usize i = 0; i < count; ++i)
+		{
+			RGBA32f	col;
+			Converter::Convert( OUT col, in[i] );
+			dst[i] = float4(col);
+		}
+	}
+
+/*
+=================================================
+	StoreRow
+=================================================
+*/
+	template <typename ColorType>
+	static void StoreRow (const float4 *src, usize count, OUT void *dst)
+	{
+		ColorType *		out = Cast<ColorType *>(dst);
+
+		for (usize i = 0; i < count; ++i)
+		{
+			ColorType	col;
+			Converter::Convert( OUT col, RGBA32f{ src[i] } );
+			out[i] = col;
+		}
+	}
+
+/*
+=================================================
+	LoadRow_RGBA8
+=================================================
+*/
+	static void LoadRow_RGBA8 (const void *src, usize count, OUT float4 *dst)
+	{
+		ColorBatchConverter::RGBA8UNormToRGBA32f( Cast<RGBA8_UNorm const *>(src), count, OUT dst );
+	}
+
+/*
+=================================================
+	StoreRow_RGBA8
+=================================================
+*/
+	static void StoreRow_RGBA8 (const float4 *src, usize count, OUT void *dst)
+	{
+		ColorBatchConverter::RGBA32fToRGBA8UNorm( src, count, OUT Cast<RGBA8_UNorm *>(dst) );
+	}
+
+/*
+=================================================
+	LoadRow_RGBA16F
+----
+	pixel is read as 4 packed halfs,
+	size of RGBA16f may be padded by compiler.
+=================================================
+*/
+	static void LoadRow_RGBA16F (const void *src, usize count, OUT float4 *dst)
+	{
+		STATIC_ASSERT( sizeof(half) == 2 );
+		STATIC_ASSERT( sizeof(float4) == sizeof(float) * 4 );
+
+		ColorBatchConverter::HalfToFloat( Cast<half const *>(src), count * 4, OUT &dst[0].x );
+	}
+
+/*
+=================================================
+	StoreRow_RGBA16F
+=================================================
+*/
+	static void StoreRow_RGBA16F (const float4 *src, usize count, OUT void *dst)
+	{
+		ColorBatchConverter::FloatToHalf( &src[0].x, count * 4, OUT Cast<half *>(dst) );
+	}
+
+/*
+=================================================
+	DownsampleRow
+----
+	2x2 box filter for any float or normalized format
+=================================================
+*/
+	template <typename ColorType>
+	static void DownsampleRow (const void *row0, const void *row1, uint first, uint last, uint stepX, OUT void *dst)
+	{
+		ColorType const*	r0	= Cast<ColorType const *>(row0);
+		ColorType const*	r1	= Cast<ColorType const *>(row1);
+		ColorType *			out	= Cast<ColorType *>(dst);
+
+		for (uint x = first; x < last; ++x)
+		{
+			const uint	i = x * 2;
+			const uint	j = i + stepX;
+
+			RGBA32f		c0, c1, c2, c3;
+			Converter::Convert( OUT c0, r0[i] );
+			Converter::Convert( OUT c1, r0[j] );
+			Converter::Convert( OUT c2, r1[i] );
+			Converter::Convert( OUT c3, r1[j] );
+
+			const float4	sum = float4(c0) + float4(c1) + float4(c2) + float4(c3);
+
+			Converter::Convert( OUT out[x], RGBA32f{ sum * 0.25f } );
+		}
+	}
+
+/*
+=================================================
+	DownsampleRow_RGBA8
+----
+	integer version, loop over components
+	is vectorized by compiler.
+=================================================
+*/
+	static void DownsampleRow_RGBA8 (const void *row0, const void *row1, uint first, uint last, uint stepX, OUT void *dst)
+	{
+		ubyte const*	r0	= Cast<ubyte const *>(row0);
+		ubyte const*	r1	= Cast<ubyte const *>(row1);
+		ubyte *			out	= Cast<ubyte *>(dst);
+		const uint		dx	= stepX * 4;
+
+		for (uint x = first * 4, end = last * 4; x < end; ++x)
+		{
+			const uint	i = (x & ~3u) * 2 + (x & 3u);
+			const uint	j = i + dx;
+
+			out[x] = ubyte( (uint(r0[i]) + uint(r0[j]) + uint(r1[i]) + uint(r1[j]) + 2) >> 2 );
+		}
+	}
+
+/*
+=================================================
+	DownsampleRow_RGBA32F
+=================================================
+*/
+	static void DownsampleRow_RGBA32F (const void *row0, const void *row1, uint first, uint last, uint stepX, OUT void *dst)
+	{
+		float const*	r0	= Cast<float const *>(row0);
+		float const*	r1	= Cast<float const *>(row1);
+		float *			out	= Cast<float *>(dst);
+		const uint		dx	= stepX * 4;
+
+		for (uint x = first * 4, end = last * 4; x < end; ++x)
+		{
+			const uint	i = (x & ~3u) * 2 + (x & 3u);
+			const uint	j = i + dx;
+
+			out[x] = (r0[i] + r0[j] + r1[i] + r1[j]) * 0.25f;
+		}
+	}
+
+/*
+=================================================
+	DownsampleRow_RGBA16F
+----
+	rows are converted to float by small chunks
+	on the stack, so each pixel is converted once.
+=================================================
+*/
+	static void DownsampleRow_RGBA16F (const void *row0, const void *row1, uint first, uint last, uint stepX, OUT void *dst)
+	{
+		static constexpr uint	chunk_size	= 64;
+
+		half const*	r0	= Cast<half const *>(row0);
+		half const*	r1	= Cast<half const *>(row1);
+		half *		out	= Cast<half *>(dst);
+		float		f0[ chunk_size * 2 * 4 ];
+		float		f1[ chunk_size * 2 * 4 ];
+		float		res[ chunk_size * 4 ];
+		const uint	dx	= stepX * 4;
+
+		for (uint x = first; x < last; x += chunk_size)
+		{
+			const uint	count		= Min( chunk_size, last - x );
+			const uint	src_count	= (count * 2 - 1 + stepX) * 4;	// if stepX is zero then there is no odd pixel
+
+			ColorBatchConverter::HalfToFloat( r0 + x * 2 * 4, src_count, OUT f0 );
+			ColorBatchConverter::HalfToFloat( r1 + x * 2 * 4, src_count, OUT f1 );
+
+			for (uint c = 0; c < count * 4; ++c)
+			{
+				const uint	i = (c & ~3u) * 2 + (c & 3u);
+				const uint	j = i + dx;
+
+				res[c] = (f0[i] + f0[j] + f1[i] + f1[j]) * 0.25f;
+			}
+
+			ColorBatchConverter::FloatToHalf( res, count * 4, OUT out + x * 4 );
+		}
+	}
+
+/*
+=================================================
+	RowPtr
+=================================================
+*/
+	ND_ static ubyte*  RowPtr (const SWImageBlitter::ImageData &img, usize y)
+	{
+		return BinArrayRef(img.memory).ptr() + usize(img.rowPitch) * y;
+	}
+
+/*
+=================================================
+	CheckImage
+=================================================
+*/
+	static bool CheckImage (const SWImageBlitter::ImageData &img)
+	{
+		const BytesU	bpp = BytesU(EPixelFormat::BitPerPixel( img.format ));
+
+		CHECK_ERR( img.memory.ptr() != null );
+		CHECK_ERR( All( img.dimension > 0u ) );
+		CHECK_ERR( img.rowPitch >= bpp * img.dimension.x );
+		CHECK_ERR( img.memory.Size() >= img.rowPitch * (img.dimension.y - 1) + bpp * img.dimension.x );
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	_GetPixelFuncs
+=================================================
+*/
+	bool SWImageBlitter::_GetPixelFuncs (EPixelFormat::type format, OUT PixelFuncs &funcs)
+	{
+		#define CASE_FMT( _fmt_, _color_ ) \
+			case EPixelFormat::_fmt_ :	funcs = PixelFuncs{ &LoadRow< _color_ >, &StoreRow< _color_ >, &DownsampleRow< _color_ > };	break;
+
+		switch ( format )
+		{
+			// signed normalized
+			CASE_FMT( RGBA16_SNorm,		RGBA16_SNorm );
+			CASE_FMT( RGBA8_SNorm,		RGBA8_SNorm );
+			CASE_FMT( RGB16_SNorm,		RGB16_SNorm );
+			CASE_FMT( RGB8_SNorm,		RGB8_SNorm );
+			CASE_FMT( RG16_SNorm,		RG16_SNorm );
+			CASE_FMT( RG8_SNorm,		RG8_SNorm );
+			CASE_FMT( R16_SNorm,		R16_SNorm );
+			CASE_FMT( R8_SNorm,			R8_SNorm );
+
+			// unsigned normalized
+			CASE_FMT( RGBA16_UNorm,		RGBA16_UNorm );
+			CASE_FMT( RGBA8_UNorm,		RGBA8_UNorm );
+			CASE_FMT( RGB16_UNorm,		RGB16_UNorm );
+			CASE_FMT( RGB8_UNorm,		RGB8_UNorm );
+			CASE_FMT( RG16_UNorm,		RG16_UNorm );
+			CASE_FMT( RG8_UNorm,		RG8_UNorm );
+			CASE_FMT( R16_UNorm,		R16_UNorm );
+			CASE_FMT( R8_UNorm,			R8_UNorm );
+			CASE_FMT( RGB10_A2_UNorm,	RGB10_A2_UNorm );
+			CASE_FMT( RGBA4_UNorm,		RGBA4_UNorm );
+			CASE_FMT( RGB5_A1_UNorm,	RGB5_A1_UNorm );
+			CASE_FMT( RGB_5_6_5_UNorm,	R5_G6_B5_UNorm );
+
+			// float
+			CASE_FMT( R16F,				R16f );
+			CASE_FMT( RG16F,			RG16f );
+			CASE_FMT( RGB16F,			RGB16f );
+			CASE_FMT( RGBA16F,			RGBA16f );
+			CASE_FMT( R32F,				R32f );
+			CASE_FMT( RG32F,			RG32f );
+			CASE_FMT( RGB32F,			RGB32f );
+			CASE_FMT( RGBA32F,			RGBA32f );
+			CASE_FMT( RGB_11_11_10F,	R11_G11_B10f );
+
+			default :	return false;
+		}
+		#undef CASE_FMT
+
+		// optimized versions
+		switch ( format )
+		{
+			case EPixelFormat::RGBA8_UNorm :
+				funcs.load			= &LoadRow_RGBA8;
+				funcs.store			= &StoreRow_RGBA8;
+				funcs.downsample	= &DownsampleRow_RGBA8;
+				break;
+
+			case EPixelFormat::RGBA16F :
+				funcs.load			= &LoadRow_RGBA16F;
+				funcs.store			= &StoreRow_RGBA16F;
+				funcs.downsample	= &DownsampleRow_RGBA16F;
+				break;
+
+			case EPixelFormat::RGBA32F :		funcs.downsample = &DownsampleRow_RGBA32F;	break;
+			default :							break;
+		}
+		return true;
+	}
+
+/*
+=================================================
+	IsFilterable
+=================================================
+*/
+	bool SWImageBlitter::IsFilterable (EPixelFormat::type format)
+	{
+		PixelFuncs	funcs;
+		return _GetPixelFuncs( format, OUT funcs );
+	}
+
+/*
+=================================================
+	_IsHalfSize
+=================================================
+*/
+	bool SWImageBlitter::_IsHalfSize (const ImageData &src, const ImageData &dst)
+	{
+		return	dst.dimension.x == Max( src.dimension.x / 2, 1u ) and
+				dst.dimension.y == Max( src.dimension.y / 2, 1u );
+	}
+
+/*
+=================================================
+	Blit
+=================================================
+*/
+	bool SWImageBlitter::Blit (const ImageData &src, const ImageData &dst, const Region &region, bool linearFilter)
+	{
+		CHECK_ERR( CheckImage( src ) and CheckImage( dst ) );
+		CHECK_ERR( All( region.srcOffset0 >= 0 ) and All( region.srcOffset1 >= 0 ) );
+		CHECK_ERR( All( region.dstOffset0 >= 0 ) and All( region.dstOffset1 >= 0 ) );
+		CHECK_ERR( All( Max( region.srcOffset0, region.srcOffset1 ) <= int2(src.dimension) ) );
+		CHECK_ERR( All( Max( region.dstOffset0, region.dstOffset1 ) <= int2(dst.dimension) ) );
+
+		const int2	src_size = region.srcOffset1 - region.srcOffset0;
+		const int2	dst_size = region.dstOffset1 - region.dstOffset0;
+
+		if ( Any( src_size == 0 ) or Any( dst_size == 0 ) )
+			return true;
+
+		// use box filter for whole image downsampling, it gives the same result as bilinear filter
+		if ( linearFilter and src.format == dst.format and
+			 All( region.srcOffset0 == 0 ) and All( region.dstOffset0 == 0 ) and
+			 All( src_size == int2(src.dimension) ) and All( dst_size == int2(dst.dimension) ) and
+			 All( src.dimension == dst.dimension * 2 ) and IsFilterable( src.format ) )
+		{
+			return GenerateMipmaps({ src, dst });
+		}
+
+		if ( not linearFilter and src.format == dst.format )
+			return _BlitNearest( src, dst, region );
+
+		return _BlitConvert( src, dst, region, linearFilter );
+	}
+
+/*
+=================================================
+	_BlitNearest
+----
+	copy pixels without conversion,
+	supports all formats.
+=================================================
+*/
+	bool SWImageBlitter::_BlitNearest (const ImageData &src, const ImageData &dst, const Region &region)
+	{
+		const int2		dst_min		= Min( region.dstOffset0, region.dstOffset1 );
+		const int2		dst_size	= Abs( region.dstOffset1 - region.dstOffset0 );
+		const float2	scale		= float2(region.srcOffset1 - region.srcOffset0) / float2(region.dstOffset1 - region.dstOffset0);
+		const usize		bpp			= usize(BytesU(EPixelFormat::BitPerPixel( src.format )));
+
+		Array< usize >	columns;	columns.Resize( dst_size.x );
+
+		for (int x = 0; x < dst_size.x; ++x)
+		{
+			const float	u = float(region.srcOffset0.x) + (float(dst_min.x + x - region.dstOffset0.x) + 0.5f) * scale.x;
+
+			columns[x] = Clamp( int(Floor( u )), 0, int(src.dimension.x)-1 ) * bpp;
+		}
+
+		const bool	is_copy		= All( scale == 1.0f );
+		const usize	min_rows	= _MinParallelPixels / usize(Max( dst_size.x, 1 ));
+
+		ParallelFor( usize(dst_size.y), _BlitRowsPerJob, min_rows,
+			[&] (usize first, usize last)
+			{
+				for (int y = int(first); y < int(last); ++y)
+				{
+					const float		v		= float(region.srcOffset0.y) + (float(dst_min.y + y - region.dstOffset0.y) + 0.5f) * scale.y;
+					const int		src_y	= Clamp( int(Floor( v )), 0, int(src.dimension.y)-1 );
+					ubyte const*	src_row	= RowPtr( src, src_y );
+					ubyte *			dst_row	= RowPtr( dst, dst_min.y + y ) + bpp * dst_min.x;
+
+					if ( is_copy )
+					{
+						UnsafeMem::MemCopy( OUT dst_row, src_row + columns[0], BytesU(bpp * dst_size.x) );
+						continue;
+					}
+
+					for (int x = 0; x < dst_size.x; ++x) {
+						UnsafeMem::MemCopy( OUT dst_row + bpp * x, src_row + columns[x], BytesU(bpp) );
+					}
+				}
+			});
+		return true;
+	}
+
+/*
+=================================================
+	_BlitConvert
+----
+	load source rows to float4, filter and store with
+	destination format.
+=================================================
+*/
+	bool SWImageBlitter::_BlitConvert (const ImageData &src, const ImageData &dst, const Region &region, bool linearFilter)
+	{
+		PixelFuncs	src_funcs;
+		PixelFuncs	dst_funcs;
+
+		CHECK_ERR( _GetPixelFuncs( src.format, OUT src_funcs ) );
+		CHECK_ERR( _GetPixelFuncs( dst.format, OUT dst_funcs ) );
+
+		const int2		dst_min		= Min( region.dstOffset0, region.dstOffset1 );
+		const int2		dst_size	= Abs( region.dstOffset1 - region.dstOffset0 );
+		const float2	scale		= float2(region.srcOffset1 - region.srcOffset0) / float2(region.dstOffset1 - region.dstOffset0);
+		const usize		src_bpp		= usize(BytesU(EPixelFormat::BitPerPixel( src.format )));
+		const usize		dst_bpp		= usize(BytesU(EPixelFormat::BitPerPixel( dst.format )));
+		const int		max_x		= int(src.dimension.x)-1;
+		const int		max_y		= int(src.dimension.y)-1;
+
+		// calculate source columns and weights
+		Array< int2 >	columns;	columns.Resize( dst_size.x );
+		Array< float >	weights;	weights.Resize( dst_size.x );
+		int				col_min		= max_x;
+		int				col_max		= 0;
+
+		for (int x = 0; x < dst_size.x; ++x)
+		{
+			const float	u = float(region.srcOffset0.x) + (float(dst_min.x + x - region.dstOffset0.x) + 0.5f) * scale.x;
+
+			if ( linearFilter )
+			{
+				const float	fu = u - 0.5f;
+				const float	fl = Floor( fu );
+
+				columns[x]	= int2( Clamp( int(fl), 0, max_x ), Clamp( int(fl)+1, 0, max_x ) );
+				weights[x]	= fu - fl;
+			}
+			else
+			{
+				columns[x]	= int2( Clamp( int(Floor( u )), 0, max_x ) );
+				weights[x]	= 0.0f;
+			}
+
+			col_min = Min( col_min, columns[x].x );
+			col_max = Max( col_max, columns[x].y );
+		}
+
+		for (auto& col : columns) {
+			col -= col_min;
+		}
+
+		const usize		row_length	= usize(col_max - col_min + 1);
+		const usize		min_rows	= _MinParallelPixels / usize(Max( dst_size.x, 1 ));
+
+		ParallelFor( usize(dst_size.y), _BlitRowsPerJob, min_rows,
+			[&] (usize first, usize last)
+			{
+				Array< float4 >		temp;
+				temp.Resize( row_length * 2 + dst_size.x );
+
+				float4 *	row0	= temp.ptr();
+				float4 *	row1	= row0 + row_length;
+				float4 *	out		= row1 + row_length;
+				int			last_y0	= -1;
+				int			last_y1	= -1;
+
+				for (int y = int(first); y < int(last); ++y)
+				{
+					const float	v	= float(region.srcOffset0.y) + (float(dst_min.y + y - region.dstOffset0.y) + 0.5f) * scale.y;
+					const float	fv	= linearFilter ? v - 0.5f : v;
+					const float	fl	= Floor( fv );
+					const float	wy	= linearFilter ? fv - fl : 0.0f;
+					const int	y0	= Clamp( int(fl), 0, max_y );
+					const int	y1	= linearFilter ? Clamp( int(fl)+1, 0, max_y ) : y0;
+
+					// rows are reused when source is magnified
+					if ( y0 != last_y0 ) {
+						src_funcs.load( RowPtr( src, y0 ) + src_bpp * col_min, row_length, OUT row0 );
+						last_y0 = y0;
+					}
+					if ( y1 != last_y1 ) {
+						src_funcs.load( RowPtr( src, y1 ) + src_bpp * col_min, row_length, OUT row1 );
+						last_y1 = y1;
+					}
+
+					if ( linearFilter )
+					{
+						for (int x = 0; x < dst_size.x; ++x)
+						{
+							const int2	c = columns[x];
+							out[x] = Lerp( Lerp( row0[c.x], row0[c.y], weights[x] ), Lerp( row1[c.x], row1[c.y], weights[x] ), wy );
+						}
+					}
+					else
+					{
+						for (int x = 0; x < dst_size.x; ++x) {
+							out[x] = row0[ columns[x].x ];
+						}
+					}
+
+					dst_funcs.store( out, dst_size.x, OUT RowPtr( dst, dst_min.y + y ) + dst_bpp * dst_min.x );
+				}
+			});
+		return true;
+	}
+
+/*
+=================================================
+	Copy
+=================================================
+*/
+	bool SWImageBlitter::Copy (const ImageData &src, const ImageData &dst, const int2 &srcOffset, const int2 &dstOffset, const uint2 &size)
+	{
+		CHECK_ERR( CheckImage( src ) and CheckImage( dst ) );
+		CHECK_ERR( src.format == dst.format );
+		CHECK_ERR( All( srcOffset >= 0 ) and All( uint2(srcOffset) + size <= src.dimension ) );
+		CHECK_ERR( All( dstOffset >= 0 ) and All( uint2(dstOffset) + size <= dst.dimension ) );
+
+		Region	reg;
+		reg.srcOffset0	= srcOffset;
+		reg.srcOffset1	= srcOffset + int2(size);
+		reg.dstOffset0	= dstOffset;
+		reg.dstOffset1	= dstOffset + int2(size);
+
+		return _BlitNearest( src, dst, reg );
+	}
+
+/*
+=================================================
+	GenerateMipmaps
+----
+	'levels[base]' is split into tiles of 2^_TileLevels pixels,
+	each thread downsamples its tiles through next _TileLevels levels,
+	then next group of levels is processed in the same way.
+	Tile of next level never reads pixels outside of tile on previous level,
+	because destination size is rounded down.
+=================================================
+*/
+	bool SWImageBlitter::GenerateMipmaps (ArrayCRef<ImageData> levels)
+	{
+		CHECK_ERR( levels.Count() > 1 );
+
+		PixelFuncs	funcs;
+		CHECK_ERR( _GetPixelFuncs( levels.Front().format, OUT funcs ) );
+		CHECK_ERR( CheckImage( levels.Front() ) );
+
+		for (usize i = 1; i < levels.Count(); ++i)
+		{
+			CHECK_ERR( levels[i].format == levels.Front().format );
+			CHECK_ERR( CheckImage( levels[i] ) );
+			CHECK_ERR( _IsHalfSize( levels[i-1], levels[i] ) );
+		}
+
+		const uint	tile_size	= 1u << _TileLevels;
+		const usize	min_tiles	= _MinParallelPixels / (tile_size * tile_size);
+
+		for (usize base = 0; base+1 < levels.Count();)
+		{
+			const uint	num_levels	= uint(Min( usize(_TileLevels), levels.Count()-1 - base ));
+			const uint2	base_dim	= levels[base].dimension;
+			const uint2	num_tiles	= (base_dim + (tile_size-1)) / tile_size;
+
+			ParallelFor( usize(num_tiles.x) * num_tiles.y, 1, min_tiles,
+				[&] (usize firstTile, usize lastTile)
+				{
+					for (uint index = uint(firstTile); index < uint(lastTile); ++index)
+					{
+						const uint2	tile = uint2( index % num_tiles.x, index / num_tiles.x ) * tile_size;
+
+						for (uint l = 0; l < num_levels; ++l)
+						{
+							ImageData const&	src		= levels[base + l];
+							ImageData const&	dst		= levels[base + l + 1];
+							const uint			shift	= l + 1;
+							const uint2			first	= uint2( tile.x >> shift, tile.y >> shift );
+							const uint2			last	= Min( uint2( (tile.x + tile_size) >> shift, (tile.y + tile_size) >> shift ), dst.dimension );
+							const uint			step_x	= src.dimension.x > 1 ? 1 : 0;
+
+							if ( Any( first >= last ) )
+								break;
+
+							for (uint y = first.y; y < last.y; ++y)
+							{
+								const uint	y0 = Min( y*2,   src.dimension.y-1 );
+								const uint	y1 = Min( y*2+1, src.dimension.y-1 );
+
+								funcs.downsample( RowPtr( src, y0 ), RowPtr( src, y1 ), first.x, last.x, step_x, OUT RowPtr( dst, y ) );
+							}
+						}
+					}
+				});
+
+			base += num_levels;
+		}
+		return true;
+	}
+
+
+}	// PlatformSW
+}	// Engine
+
+#endif	// GRAPHICS_API_SOFT
@@ -0,0 +1,95 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Image blit and mipmap generation for software renderer.
+
+	Blit converts pixels to float4 row by row, so any pair of float and
+	normalized formats is supported, other formats can only be copied
+	with nearest filter and without conversion.
+
+	Mipmaps are generated with 2x2 box filter. Level is split into tiles,
+	each tile is downsampled through several levels by the same thread
+	while it is still in cache, so there is no synchronization between levels.
+*/
+
+#pragma once
+
+#include "Core/Config/Engine.Config.h"
+
+#ifdef GRAPHICS_API_SOFT
+
+#include "Engine/Platforms/Public/GPU/Image.h"
+
+namespace Engine
+{
+namespace PlatformSW
+{
+	using namespace Engine::Platforms;
+
+
+	//
+	// Image Blitter
+	//
+
+	class SWImageBlitter final : public Noncopyable
+	{
+	// types
+	public:
+		struct ImageData : CompileTime::FastCopyable
+		{
+			BinArrayRef				memory;
+			uint2					dimension;
+			BytesU					rowPitch;
+			EPixelFormat::type		format	= EPixelFormat::Unknown;
+		};
+
+		struct Region
+		{
+			int2		srcOffset0;		// if 'offset1 < offset0' then image is flipped
+			int2		srcOffset1;
+			int2		dstOffset0;
+			int2		dstOffset1;
+		};
+
+		using LoadRow_t			= void (*) (const void *src, usize count, OUT float4 *dst);
+		using StoreRow_t		= void (*) (const float4 *src, usize count, OUT void *dst);
+		using DownsampleRow_t	= void (*) (const void *row0, const void *row1, uint first, uint last, uint stepX, OUT void *dst);
+
+	private:
+		struct PixelFuncs
+		{
+			LoadRow_t			load		= null;
+			StoreRow_t			store		= null;
+			DownsampleRow_t		downsample	= null;
+		};
+
+
+	// constants
+	private:
+		static constexpr uint	_TileLevels			= 6;		// tile size is 64x64 pixels
+		static constexpr uint	_BlitRowsPerJob		= 32;
+		static constexpr usize	_MinParallelPixels	= 1 << 16;
+
+
+	// methods
+	public:
+		static bool Blit (const ImageData &src, const ImageData &dst, const Region &region, bool linearFilter);
+		static bool Copy (const ImageData &src, const ImageData &dst, const int2 &srcOffset, const int2 &dstOffset, const uint2 &size);
+
+		// 'levels[0]' is source, 'levels[i+1]' must be half size of 'levels[i]'
+		static bool GenerateMipmaps (ArrayCRef<ImageData> levels);
+
+		ND_ static bool IsFilterable (EPixelFormat::type format);
+
+	private:
+		static bool _GetPixelFuncs (EPixelFormat::type format, OUT PixelFuncs &funcs);
+
+		static bool _BlitNearest (const ImageData &src, const ImageData &dst, const Region &region);
+		static bool _BlitConvert (const ImageData &src, const ImageData &dst, const Region &region, bool linearFilter);
+		static bool _IsHalfSize (const ImageData &src, const ImageData &dst);
+	};
+
+
+}	// PlatformSW
+}	// Engine
+
+#endif	// GRAPHICS_API_SOFT
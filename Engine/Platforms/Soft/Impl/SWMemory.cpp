@@ -56,6 +56,7 @@ namespace PlatformSW
 
 		using EBindingTarget		= GpuMsg::OnMemoryBindingChanged::EBindingTarget;
 		using MemMapper_t			= PlatformTools::MemoryMapperHelper;
+		using MemAllocation_t		= SWDevice::MemAllocation_t;
 
 
 	// constants
@@ -65,9 +66,10 @@ namespace PlatformSW
 
 	// variables
 	private:
-		BinaryArray			_memory;
+		BinaryArray			_memory;			// dedicated allocation
 		BinArrayRef			_usedMemory;
 		BytesU				_align;
+		MemAllocation_t		_allocation;		// allocation in device memory pages
 
 		MemMapper_t			_memMapper;
 		EGpuMemory::bits	_flags;
@@ -105,6 +107,7 @@ namespace PlatformSW
 
 		bool _AllocForImage ();
 		bool _AllocForBuffer ();
+		bool _AllocMemory (BytesU size);
 		void _FreeMemory ();
 
 		static usize _GetAlignedOffset (ubyte *ptr, BytesU align);
@@ -177,7 +180,7 @@ namespace PlatformSW
 */
 	bool SWMemory::_IsCreated () const
 	{
-		return not _memory.Empty();
+		return not _usedMemory.Empty();
 	}
 	
 /*
@@ -220,8 +223,7 @@ namespace PlatformSW
 		_align = req_mem.result->align;
 		CHECK_ERR( IsPowerOfTwo( _align ) );
 
-		_memory.Resize( usize(AlignToLarge( req_mem.result->size + _align, _align )), false );
-		_usedMemory = _memory.SubArray( _GetAlignedOffset( _memory.ptr(), _align ), usize(req_mem.result->size) );
+		CHECK_ERR( _AllocMemory( req_mem.result->size ) );
 
 		_binding = EBindingTarget::Image;
 		return true;
@@ -242,13 +244,35 @@ namespace PlatformSW
 		_align = req_mem.result->align;
 		CHECK_ERR( IsPowerOfTwo( _align ) );
 
-		_memory.Resize( usize(AlignToLarge( req_mem.result->size + _align, _align )), false );
-		_usedMemory = _memory.SubArray( _GetAlignedOffset( _memory.ptr(), _align ), usize(req_mem.result->size) );
+		CHECK_ERR( _AllocMemory( req_mem.result->size ) );
 
 		_binding = EBindingTarget::Buffer;
 		return true;
 	}
 
+/*
+=================================================
+	_AllocMemory
+=================================================
+*/
+	bool SWMemory::_AllocMemory (BytesU size)
+	{
+		// sub-allocate from device memory pages,
+		// memory with aliasing may be bound to other resources, so it always has dedicated allocation
+		if ( not _flags[ EGpuMemory::Dedicated ] and not _flags[ EGpuMemory::SupportAliasing ] and
+			 GetDevice()->AllocMemory( size, _align, OUT _allocation, OUT _usedMemory ) )
+		{
+			return true;
+		}
+
+		// dedicated allocation
+		GX_MEMORY_SCOPE( EMemorySubsystem::GpuHostMemory );
+
+		_memory.Resize( usize(AlignToLarge( size + _align, _align )), false );
+		_usedMemory = _memory.SubArray( _GetAlignedOffset( _memory.ptr(), _align ), usize(size) );
+		return true;
+	}
+
 /*
 =================================================
 	_FreeMemory
@@ -256,6 +280,9 @@ namespace PlatformSW
 */
 	void SWMemory::_FreeMemory ()
 	{
+		if ( _allocation.IsValid() and GetDevice() )
+			GetDevice()->FreeMemory( INOUT _allocation );
+
 		_align		= 0_b;
 		_flags		= Uninitialized;
 		_binding	= EBindingTarget::Unbinded;
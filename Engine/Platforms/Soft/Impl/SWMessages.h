@@ -326,6 +326,7 @@ namespace GpuMsg
 
 		struct Stage {
 			SWInvoke_t		func;
+			uint			batchSize	= 1;	// local invocations per call for compute shader
 		};
 
 	// variables
@@ -357,6 +358,41 @@ namespace GpuMsg
 	};
 
 
+	//
+	// Get Resources from Resource Table
+	//
+	struct GetSWPipelineResources : _MsgBase_
+	{
+	// types
+		struct Resource
+		{
+			ModulePtr	module;
+			bool		write	= false;	// storage buffer or image without 'readonly' qualifier
+		};
+		using Resources_t	= Array< Resource >;
+
+	// variables
+		Out< Resources_t >		result;
+	};
+
+
+	//
+	// Get Query Pool Data
+	//
+	struct GetSWQueryPoolData : _MsgBase_
+	{
+	// types
+		struct Data
+		{
+			ArrayRef< ulong >	values;				// 'valuesPerQuery' values for each query
+			uint				valuesPerQuery	= 0;
+		};
+
+	// variables
+		Out< Data >		result;
+	};
+
+
 	//
 	// Sync Client With Device
 	//
@@ -385,6 +421,8 @@ namespace GpuMsg
 								 CmdCopyImage,
 								 CmdCopyBufferToImage,
 								 CmdCopyImageToBuffer,
+								 CmdBlitImage,
+								 CmdResolveImage,
 								 CmdUpdateBuffer,
 								 CmdFillBuffer,
 								 CmdClearColorImage,
@@ -393,7 +431,12 @@ namespace GpuMsg
 								 CmdPushNamedConstants,
 								 CmdDebugMarker,
 								 CmdPushDebugGroup,
-								 CmdPopDebugGroup >;
+								 CmdPopDebugGroup,
+								 CmdBeginQuery,
+								 CmdEndQuery,
+								 CmdCopyQueryPoolResults,
+								 CmdWriteTimestamp,
+								 CmdResetQueryPool >;
 
 		using Func_t	= Delegate< void (VariantCRef data, StringCRef file, uint line) >;
 
@@ -446,6 +489,19 @@ namespace GpuMsg
 	};
 
 
+	//
+	// Resume Queue
+	//
+	struct SWResumeQueue : _MsgBase_
+	{
+		// queue executes all submissions that are ready to execute,
+		// sent when semaphore has been signaled by another queue.
+
+	// variables
+		Out_opt< bool >		hasPending;		// true if queue has submissions that are not completed
+	};
+
+
 	//
 	// Present Frame
 	//
@@ -0,0 +1,431 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Platforms/Soft/Impl/SWNativeShaderCache.h"
+
+#ifdef GRAPHICS_API_SOFT
+
+#include "Engine/Platforms/Soft/ShaderLang/SWShaderHelper.h"
+
+#ifdef GX_SW_NATIVE_SHADERS
+#	include <stdlib.h>
+#	include <unistd.h>
+#endif
+
+namespace Engine
+{
+namespace PlatformSW
+{
+
+	static constexpr char	_NativeEntryName[]	= "gx_sw_native_main";
+	static constexpr char	_NativeBatchName[]	= "gx_sw_native_batch";
+
+	// must be increased when generated wrapper or shader calling convention is changed
+	static constexpr uint	_NativeABIVersion	= 1;
+
+	// shader language headers that are compiled into each shader
+	static constexpr char	_ShaderLangPath[]	= "Engine/Platforms/Soft/ShaderLang/";
+	static const char *		_ShaderLangHeaders[] = {
+		"SWShaderHelper.h", "SWLang.h", "SWLangArray.h", "SWLangBarrier.h", "SWLangBuffer.h",
+		"SWLangCommon.h", "SWLangGLM.h", "SWLangImage.h", "SWLangShared.h", "SWLangTexture.h",
+		"SWLangTexture2D.h", "gen_Image.h", "gen_Texture.h"
+	};
+
+/*
+=================================================
+	HashAppend
+----
+	FNV-1a, must be same between launches
+=================================================
+*/
+	static void HashAppend (INOUT ulong &hash, StringCRef str)
+	{
+		for (usize i = 0; i < str.Length(); ++i) {
+			hash = (hash ^ ubyte(str[i])) * 1099511628211ull;
+		}
+		hash = (hash ^ 0xFF) * 1099511628211ull;	// separator
+	}
+
+/*
+=================================================
+	Instance
+=================================================
+*/
+	SWNativeShaderCache&  SWNativeShaderCache::Instance ()
+	{
+		static SWNativeShaderCache	inst;
+		return inst;
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	SWNativeShaderCache::~SWNativeShaderCache ()
+	{
+		Disable();
+	}
+
+/*
+=================================================
+	Setup
+=================================================
+*/
+	bool SWNativeShaderCache::Setup (const Settings &settings)
+	{
+	#ifdef GX_SW_NATIVE_SHADERS
+		SCOPELOCK( _lock );
+
+		CHECK_ERR( not settings.folder.Empty() and not settings.compiler.Empty() );
+
+		if ( not OS::FileSystem::IsDirectoryExist( settings.folder ) )
+			CHECK_ERR( OS::FileSystem::CreateDirectories( settings.folder ) );
+
+		ulong	headers_hash = 0;
+		CHECK_ERR( _HashHeaders( settings, OUT headers_hash ) );
+
+		// shaders compiled with previous settings are still valid,
+		// new shaders will use new settings and will have different hash
+		_settings		= settings;
+		_headersHash	= headers_hash;
+		_enabled		= true;
+		return true;
+
+	#else
+		GX_UNUSED( settings );
+		RETURN_ERR( "runtime shader compilation is not supported on this platform" );
+	#endif
+	}
+
+/*
+=================================================
+	Disable
+----
+	new shaders will not be compiled or loaded.
+	Function pointers that are returned by 'GetShader' are used
+	by live pipelines and by 'BatchedShaderRegistry', so libraries
+	are kept loaded until shutdown.
+=================================================
+*/
+	void SWNativeShaderCache::Disable ()
+	{
+		SCOPELOCK( _lock );
+
+		_enabled = false;
+	}
+
+/*
+=================================================
+	GetShader
+----
+	compiler is executed synchronously in current thread,
+	so first use of shader may block for a few seconds.
+	Shader is compiled and loaded without lock, so other threads
+	are not blocked, the same shader may be compiled by several threads,
+	first loaded library will be used.
+=================================================
+*/
+	bool SWNativeShaderCache::GetShader (StringCRef source, OUT SWInvoke_t &result)
+	{
+		result = null;
+
+	#ifdef GX_SW_NATIVE_SHADERS
+		CHECK_ERR( not source.Empty() );
+
+		Settings	settings;
+		ulong		hash	= 0;
+
+		// search in loaded shaders
+		{
+			SCOPELOCK( _lock );
+
+			CHECK_ERR( _enabled );
+
+			settings	= _settings;
+			hash		= _CalcHash( source, settings, _headersHash );
+
+			Shaders_t::iterator	iter;
+
+			if ( _shaders.Find( hash, OUT iter ) )
+			{
+				result = iter->second;
+				return true;
+			}
+		}
+
+		const String	name		= String().FormatAlignedI( hash, 16, '0', 16 );
+		const String	src_file	= FileAddress::BuildPath( settings.folder, name, "cpp" );
+		const String	lib_file	= FileAddress::BuildPath( settings.folder, name, "so" );
+		const String	full_src	= _BuildSource( source );
+
+		LibraryPtr		lib;
+		SWInvoke_t		func		= null;
+		uint			batch_size	= 0;
+
+		// search in cache, source is compared to prevent hash collisions
+		if ( OS::FileSystem::IsFileExist( lib_file ) and OS::FileSystem::IsFileExist( src_file ) )
+		{
+			GXFile::RFilePtr	file = GXFile::HddRFile::New( src_file );
+			String				cached;
+
+			if ( file )
+			{
+				cached.Resize( usize(file->RemainingSize()) );
+
+				if ( file->Read( cached.ptr(), cached.LengthInBytes() ) and
+					 StringCRef(cached) == StringCRef(full_src) and
+					 _Load( lib_file, OUT lib, OUT func, OUT batch_size ) )
+				{
+					return _AddShader( hash, RVREF(lib), func, batch_size, OUT result );
+				}
+			}
+		}
+
+		// compile to files that are unique for this thread,
+		// then publish them with atomic rename, so other processes never see incomplete files.
+		// library is published first, so source is never found without library.
+		const String	tmp_ext		= String(".") << uint(::getpid()) << '.' << OS::CurrentThread::GetCurrentThreadId() << ".tmp";
+		const String	tmp_src		= String(src_file) << tmp_ext;
+		const String	tmp_lib		= String(lib_file) << tmp_ext;
+		{
+			GXFile::WFilePtr	file = GXFile::HddWFile::New( tmp_src );
+			CHECK_ERR( file );
+			CHECK_ERR( file->Write( StringCRef(full_src) ) );
+		}
+
+		if ( not _Compile( settings, tmp_src, tmp_lib ) )
+		{
+			OS::FileSystem::DeleteFile( tmp_src );
+			OS::FileSystem::DeleteFile( tmp_lib );
+			return false;
+		}
+
+		CHECK_ERR( OS::FileSystem::MoveFile( tmp_lib, lib_file ) );
+		CHECK_ERR( OS::FileSystem::MoveFile( tmp_src, src_file ) );
+		CHECK_ERR( _Load( lib_file, OUT lib, OUT func, OUT batch_size ) );
+
+		return _AddShader( hash, RVREF(lib), func, batch_size, OUT result );
+
+	#else
+		GX_UNUSED( source );
+		return false;
+	#endif
+	}
+
+/*
+=================================================
+	_CalcHash
+----
+	compiler settings, shader language headers and
+	ABI version are part of the key.
+=================================================
+*/
+	ulong SWNativeShaderCache::_CalcHash (StringCRef source, const Settings &settings, ulong headersHash)
+	{
+		ulong	hash = 14695981039346656037ull;
+
+		HashAppend( INOUT hash, source );
+		HashAppend( INOUT hash, String().FormatI( _NativeABIVersion, 10 ) );
+		HashAppend( INOUT hash, String().FormatI( headersHash, 16 ) );
+		HashAppend( INOUT hash, settings.compiler );
+		HashAppend( INOUT hash, settings.flags );
+
+		for (auto& dir : settings.includeDirs) {
+			HashAppend( INOUT hash, dir );
+		}
+		for (auto& def : settings.defines) {
+			HashAppend( INOUT hash, def );
+		}
+		return hash;
+	}
+
+/*
+=================================================
+	_HashHeaders
+----
+	shaders must be recompiled when shader language headers
+	are changed, headers are searched in include directories.
+=================================================
+*/
+	bool SWNativeShaderCache::_HashHeaders (const Settings &settings, OUT ulong &result)
+	{
+		result = 14695981039346656037ull;
+
+		for (auto& header : _ShaderLangHeaders)
+		{
+			bool	found = false;
+
+			for (auto& dir : settings.includeDirs)
+			{
+				const String		path = FileAddress::BuildPath( dir, String(_ShaderLangPath) << header );
+				GXFile::RFilePtr	file;
+
+				if ( not OS::FileSystem::IsFileExist( path ) or not (file = GXFile::HddRFile::New( path )) )
+					continue;
+
+				String	data;
+				data.Resize( usize(file->RemainingSize()) );
+
+				CHECK_ERR( file->Read( data.ptr(), data.LengthInBytes() ) );
+
+				HashAppend( INOUT result, header );
+				HashAppend( INOUT result, data );
+				found = true;
+				break;
+			}
+
+			if ( not found )
+				RETURN_ERR( "shader language header '"_str << header << "' is not found in include directories" );
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_BuildSource
+----
+	translator output contains entry point '##main##'
+	declared in anonymous namespace, so add exported wrappers.
+=================================================
+*/
+	String SWNativeShaderCache::_BuildSource (StringCRef source)
+	{
+		String	src;
+		src << "// This is generated file\n"
+			<< "#include \"Engine/Platforms/Soft/ShaderLang/SWLang.h\"\n\n";
+
+		src << source << "\n";
+		src.ReplaceStrings( "##main##", "sw_native_main" );
+
+		src << "\nextern \"C\" __attribute__((visibility(\"default\")))\n"
+			<< "void " << _NativeEntryName << " (const SWShaderLang::Impl::SWShaderHelper &helper)\n"
+			<< "{\n"
+			<< "	SWShaderLang::sw_native_main( helper );\n"
+			<< "}\n\n"
+			<< "extern \"C\" __attribute__((visibility(\"default\")))\n"
+			<< "unsigned " << _NativeBatchName << " ()\n"
+			<< "{\n"
+			<< "	return SWShaderLang::Impl::BatchedShaderRegistry::GetBatchSize( &SWShaderLang::sw_native_main );\n"
+			<< "}\n";
+		return src;
+	}
+
+/*
+=================================================
+	_Compile
+=================================================
+*/
+	bool SWNativeShaderCache::_Compile (const Settings &settings, StringCRef srcFile, StringCRef libFile)
+	{
+	#ifdef GX_SW_NATIVE_SHADERS
+		const String	log_file	= String(libFile) << ".log";
+		String			cmd;
+
+		cmd << settings.compiler << ' ' << settings.flags;
+
+		for (auto& def : settings.defines) {
+			cmd << " -D" << def;
+		}
+		for (auto& dir : settings.includeDirs) {
+			cmd << " -I\"" << dir << '"';
+		}
+
+		cmd << " -o \"" << libFile << "\" \"" << srcFile << "\" > \"" << log_file << "\" 2>&1";
+
+		LOG( "compile software shader: "_str << srcFile, ELog::Debug );
+
+		if ( ::system( cmd.cstr() ) != 0 )
+		{
+			String				log;
+			GXFile::RFilePtr	file = GXFile::HddRFile::New( log_file );
+
+			if ( file )
+			{
+				log.Resize( usize(file->RemainingSize()) );
+				file->Read( log.ptr(), log.LengthInBytes() );
+			}
+			RETURN_ERR( "failed to compile software shader '"_str << srcFile << "':\n" << log );
+		}
+
+		OS::FileSystem::DeleteFile( log_file );
+		return true;
+
+	#else
+		GX_UNUSED( settings, srcFile, libFile );
+		return false;
+	#endif
+	}
+
+/*
+=================================================
+	_Load
+=================================================
+*/
+	bool SWNativeShaderCache::_Load (StringCRef libFile, OUT LibraryPtr &lib, OUT SWInvoke_t &func, OUT uint &batchSize)
+	{
+	#ifdef GX_SW_NATIVE_SHADERS
+		using BatchFunc_t = unsigned (*) ();
+
+		lib = new OS::Library();
+
+		if ( not lib->Load( libFile ) )
+		{
+			LOG( "failed to load software shader '"_str << libFile << "'", ELog::Warning );
+			return false;
+		}
+
+		BatchFunc_t		batch	= null;
+
+		CHECK_ERR( lib->GetProc( OUT func, _NativeEntryName ) );
+		CHECK_ERR( lib->GetProc( OUT batch, _NativeBatchName ) );
+
+		// shared library has its own registry
+		batchSize = batch();
+		return true;
+
+	#else
+		GX_UNUSED( libFile, lib, func, batchSize );
+		return false;
+	#endif
+	}
+
+/*
+=================================================
+	_AddShader
+----
+	if the same shader was loaded by another thread
+	then new library will be unloaded.
+=================================================
+*/
+	bool SWNativeShaderCache::_AddShader (ulong hash, LibraryPtr &&lib, SWInvoke_t func, uint batchSize, OUT SWInvoke_t &result)
+	{
+	#ifdef GX_SW_NATIVE_SHADERS
+		SCOPELOCK( _lock );
+
+		Shaders_t::iterator	iter;
+
+		if ( _shaders.Find( hash, OUT iter ) )
+		{
+			result = iter->second;
+			return true;
+		}
+
+		if ( batchSize > 1 )
+			SWShaderLang::Impl::BatchedShaderRegistry::Register( func, batchSize );
+
+		_libraries.Add({ hash, RVREF(lib) });
+		_shaders.Add( hash, func );
+
+		result = func;
+		return true;
+
+	#else
+		GX_UNUSED( hash, lib, func, batchSize, result );
+		return false;
+	#endif
+	}
+
+}	// PlatformSW
+}	// Engine
+
+#endif	// GRAPHICS_API_SOFT
@@ -0,0 +1,107 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Compiles C++ shaders at runtime with host specific flags
+	and caches them as shared libraries.
+
+	Shader source is the C++ translator output that is stored in
+	pipeline description as 'Software_100 | HighLevel' source.
+	Executable must export engine symbols ('-rdynamic') because
+	compiled shaders are linked against it when loaded.
+	Compiler is executed synchronously in the thread that requests
+	the shader (usually GPU thread) without holding the cache lock,
+	cached shaders are only loaded.
+	Cache key contains shader source, compiler settings, hash of
+	shader language headers and ABI version.
+*/
+
+#pragma once
+
+#include "Core/Config/Engine.Config.h"
+
+#ifdef GRAPHICS_API_SOFT
+
+#include "Engine/Platforms/Public/GPU/Pipeline.h"
+
+#if defined( PLATFORM_BASE_POSIX ) and defined( GX_USE_NATIVE_API )
+#	define GX_SW_NATIVE_SHADERS
+#endif
+
+namespace Engine
+{
+namespace PlatformSW
+{
+
+	//
+	// Native Shader Cache
+	//
+
+	class SWNativeShaderCache final : public Noncopyable
+	{
+	// types
+	public:
+		using SWInvoke_t	= Platforms::PipelineTemplateDescription::ShaderSource::SWInvoke_t;
+
+		struct Settings
+		{
+			String			folder		= "sw_shader_cache";		// compiled shaders and sources
+			String			compiler	= "c++";
+			String			flags		= "-std=c++17 -O3 -march=native -fPIC -shared";
+			Array<String>	includeDirs;							// must contain engine root directory
+			Array<String>	defines;								// must be same as in engine build
+		};
+
+	private:
+		#ifdef GX_SW_NATIVE_SHADERS
+		using LibraryPtr	= UniquePtr< OS::Library >;
+		using Libraries_t	= HashMap< ulong, LibraryPtr >;		// source hash -> library
+		using Shaders_t		= HashMap< ulong, SWInvoke_t >;		// source hash -> entry point
+		#else
+		using LibraryPtr	= UniquePtr< int >;					// unused
+		#endif
+
+
+	// variables
+	private:
+		Settings		_settings;
+		ulong			_headersHash	= 0;	// hash of shader language headers
+		bool			_enabled		= false;
+
+		#ifdef GX_SW_NATIVE_SHADERS
+		Libraries_t		_libraries;
+		Shaders_t		_shaders;
+		#endif
+
+		Mutex			_lock;
+
+
+	// methods
+	private:
+		SWNativeShaderCache () {}
+		~SWNativeShaderCache ();
+
+	public:
+		ND_ static SWNativeShaderCache&  Instance ();
+
+		bool Setup (const Settings &settings);
+		void Disable ();
+
+		ND_ bool IsEnabled ()	const	{ return _enabled; }
+
+		// returns cached shader or compiles new one
+		bool GetShader (StringCRef source, OUT SWInvoke_t &result);
+
+	private:
+		bool _AddShader (ulong hash, LibraryPtr &&lib, SWInvoke_t func, uint batchSize, OUT SWInvoke_t &result);
+
+		ND_ static ulong	_CalcHash (StringCRef source, const Settings &settings, ulong headersHash);
+		ND_ static String	_BuildSource (StringCRef source);
+		static bool			_HashHeaders (const Settings &settings, OUT ulong &result);
+		static bool			_Compile (const Settings &settings, StringCRef srcFile, StringCRef libFile);
+		static bool			_Load (StringCRef libFile, OUT LibraryPtr &lib, OUT SWInvoke_t &func, OUT uint &batchSize);
+	};
+
+
+}	// PlatformSW
+}	// Engine
+
+#endif	// GRAPHICS_API_SOFT
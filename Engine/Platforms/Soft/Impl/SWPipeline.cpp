@@ -247,6 +247,7 @@ namespace PlatformSW
 		Description_t		_descr;
 		LayoutDesc_t		_layoutDesc;
 		ShaderFunc_t		_func;
+		uint				_batchSize;		// cached from registry, so dispatch doesn't lock
 
 
 	// methods
@@ -287,7 +288,7 @@ namespace PlatformSW
 	SWComputePipeline::SWComputePipeline (UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::ComputePipeline &ci) :
 		SWBaseModule( gs, ModuleConfig{ id, UMax }, &_eventTypes ),
 		_descr{ ci.descr },		_layoutDesc{ ci.layout },
-		_func{ null }
+		_func{ null },			_batchSize{ 1 }
 	{
 		SetDebugName( "SWComputePipeline" );
 
@@ -481,6 +482,8 @@ namespace PlatformSW
 		_func = (*req_shader_ids.result)[cs_index].func;
 		CHECK_ERR( _func );
 
+		// shaders with barriers and shared memory are always scalar
+		_batchSize = SWShaderLang::Impl::BatchedShaderRegistry::GetBatchSize( _func );
 		return true;
 	}
 	
@@ -491,7 +494,8 @@ namespace PlatformSW
 */
 	void SWComputePipeline::_DestroyPipeline ()
 	{
-		_func	= null;
+		_func		= null;
+		_batchSize	= 1;
 	}
 	
 /*
@@ -501,7 +505,7 @@ namespace PlatformSW
 */
 	bool SWComputePipeline::_GetSWPipelineStage (const GpuMsg::GetSWPipelineStage &msg)
 	{
-		msg.result.Set({ _func });
+		msg.result.Set({ _func, _batchSize });
 		return true;
 	}
 	
@@ -35,6 +35,7 @@ namespace PlatformSW
 											Fwd_GetSWBufferMemoryLayout,
 											Fwd_GetSWImageViewMemoryLayout,
 											Fwd_GetSWTextureMemoryLayout,
+											GpuMsg::GetSWPipelineResources,
 											GpuMsg::PipelineAttachBuffer,
 											GpuMsg::PipelineAttachImage,
 											GpuMsg::PipelineAttachTexture
@@ -50,6 +51,7 @@ namespace PlatformSW
 		{
 			ModulePtr	resource;	// 
 			ModulePtr	sampler;	// only for texture	
+			bool		write	= false;
 		};
 
 		using CachedResources_t		= Array< ResCache >;	// sorted by binding index
@@ -104,6 +106,7 @@ namespace PlatformSW
 		bool _GetSWBufferMemoryLayout (const Fwd_GetSWBufferMemoryLayout &);
 		bool _GetSWTextureMemoryLayout (const Fwd_GetSWTextureMemoryLayout &);
 		bool _GetSWImageViewMemoryLayout (const Fwd_GetSWImageViewMemoryLayout &);
+		bool _GetSWPipelineResources (const GpuMsg::GetSWPipelineResources &);
 
 	private:
 		bool _CreateResourceTable ();
@@ -141,6 +144,7 @@ namespace PlatformSW
 		_SubscribeOnMsg( this, &SWPipelineResourceTable::_GetSWBufferMemoryLayout );
 		_SubscribeOnMsg( this, &SWPipelineResourceTable::_GetSWTextureMemoryLayout );
 		_SubscribeOnMsg( this, &SWPipelineResourceTable::_GetSWImageViewMemoryLayout );
+		_SubscribeOnMsg( this, &SWPipelineResourceTable::_GetSWPipelineResources );
 		_SubscribeOnMsg( this, &SWPipelineResourceTable::_PipelineAttachImage );
 		_SubscribeOnMsg( this, &SWPipelineResourceTable::_PipelineAttachBuffer );
 		_SubscribeOnMsg( this, &SWPipelineResourceTable::_PipelineAttachTexture );
@@ -459,6 +463,7 @@ namespace PlatformSW
 			auto&	cached = self._cached[ img.uniqueIndex ];
 
 			CHECK_ERR( FindModule< ImageMsgList >( img.name, OUT cached.resource ) );
+			cached.write = EShaderMemoryModel::HasWriteAccess( img.access );
 			
 			GpuMsg::GetImageDescription	req_img_descr;
 			cached.resource->Send( req_img_descr );
@@ -519,6 +524,7 @@ namespace PlatformSW
 			auto&	cached = self._cached[ buf.uniqueIndex ];
 
 			CHECK_ERR( FindModule< BufferMsgList >( buf.name, OUT cached.resource ) );
+			cached.write = EShaderMemoryModel::HasWriteAccess( buf.access );
 			
 			GpuMsg::GetBufferDescription		req_descr;
 			cached.resource->Send( req_descr );
@@ -651,6 +657,28 @@ namespace PlatformSW
 		return true;
 	}
 
+/*
+=================================================
+	_GetSWPipelineResources
+=================================================
+*/
+	bool SWPipelineResourceTable::_GetSWPipelineResources (const GpuMsg::GetSWPipelineResources &msg)
+	{
+		CHECK_ERR( _IsComposedState( GetState() ) );
+
+		GpuMsg::GetSWPipelineResources::Resources_t	result;
+		result.Reserve( _cached.Count() );
+
+		for (auto& cached : _cached)
+		{
+			if ( cached.resource )
+				result.PushBack({ cached.resource, cached.write });
+		}
+
+		msg.result.Set( RVREF(result) );
+		return true;
+	}
+
 }	// PlatformSW
 //-----------------------------------------------------------------------------
 
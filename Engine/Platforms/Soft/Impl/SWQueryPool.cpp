@@ -0,0 +1,223 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Core/Config/Engine.Config.h"
+
+#ifdef GRAPHICS_API_SOFT
+
+#include "Engine/Platforms/Public/GPU/Query.h"
+#include "Engine/Platforms/Soft/Impl/SWBaseModule.h"
+#include "Engine/Platforms/Soft/SoftRendererObjectsConstructor.h"
+
+namespace Engine
+{
+namespace PlatformSW
+{
+
+	//
+	// Software Query Pool
+	//
+
+	class SWQueryPool final : public SWBaseModule
+	{
+	// types
+	private:
+		using SupportedMessages_t	= SWBaseModule::SupportedMessages_t::Append< MessageListFrom<
+											GpuMsg::GetQueryPoolDescription,
+											GpuMsg::GetSWQueryPoolData
+										> >;
+
+		using SupportedEvents_t		= SWBaseModule::SupportedEvents_t;
+
+
+	// constants
+	private:
+		static const TypeIdList		_eventTypes;
+
+
+	// variables
+	private:
+		QueryPoolDescription	_descr;
+		Array< ulong >			_values;
+		uint					_valuesPerQuery;
+
+
+	// methods
+	public:
+		SWQueryPool (UntypedID_t, GlobalSystemsRef gs, const CreateInfo::GpuQueryPool &ci);
+		~SWQueryPool ();
+
+
+	// message handlers
+	private:
+		bool _Compose (const ModuleMsg::Compose &);
+		bool _Delete (const ModuleMsg::Delete &);
+		bool _GetQueryPoolDescription (const GpuMsg::GetQueryPoolDescription &);
+		bool _GetSWQueryPoolData (const GpuMsg::GetSWQueryPoolData &);
+
+	private:
+		bool _CreateQueryPool ();
+	};
+//-----------------------------------------------------------------------------
+
+
+
+	const TypeIdList	SWQueryPool::_eventTypes{ UninitializedT< SupportedEvents_t >() };
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	SWQueryPool::SWQueryPool (UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::GpuQueryPool &ci) :
+		SWBaseModule( gs, ModuleConfig{ id, UMax }, &_eventTypes ),
+		_descr( ci.descr ),		_valuesPerQuery{ 0 }
+	{
+		SetDebugName( "SWQueryPool" );
+
+		_SubscribeOnMsg( this, &SWQueryPool::_OnModuleAttached_Impl );
+		_SubscribeOnMsg( this, &SWQueryPool::_OnModuleDetached_Impl );
+		_SubscribeOnMsg( this, &SWQueryPool::_AttachModule_Impl );
+		_SubscribeOnMsg( this, &SWQueryPool::_DetachModule_Impl );
+		_SubscribeOnMsg( this, &SWQueryPool::_FindModule_Impl );
+		_SubscribeOnMsg( this, &SWQueryPool::_ModulesDeepSearch_Impl );
+		_SubscribeOnMsg( this, &SWQueryPool::_Link_Impl );
+		_SubscribeOnMsg( this, &SWQueryPool::_Compose );
+		_SubscribeOnMsg( this, &SWQueryPool::_Delete );
+		_SubscribeOnMsg( this, &SWQueryPool::_OnManagerChanged );
+		_SubscribeOnMsg( this, &SWQueryPool::_GetQueryPoolDescription );
+		_SubscribeOnMsg( this, &SWQueryPool::_GetSWQueryPoolData );
+		_SubscribeOnMsg( this, &SWQueryPool::_GetDeviceInfo );
+		_SubscribeOnMsg( this, &SWQueryPool::_GetSWDeviceInfo );
+		_SubscribeOnMsg( this, &SWQueryPool::_GetSWPrivateClasses );
+
+		ASSERT( _ValidateMsgSubscriptions< SupportedMessages_t >() );
+
+		_AttachSelfToManager( _GetGPUThread( ci.gpuThread ), UntypedID_t(0), true );
+
+		ASSERT( _descr.count > 0 );
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	SWQueryPool::~SWQueryPool ()
+	{
+	}
+
+/*
+=================================================
+	_Compose
+=================================================
+*/
+	bool SWQueryPool::_Compose (const ModuleMsg::Compose &msg)
+	{
+		if ( _IsComposedState( GetState() ) )
+			return true;	// already composed
+
+		CHECK_ERR( GetState() == EState::Linked );
+
+		CHECK_COMPOSING( _CreateQueryPool() );
+
+		_SendForEachAttachments( msg );
+
+		// very paranoic check
+		CHECK( _ValidateAllSubscriptions() );
+
+		CHECK( _SetState( EState::ComposedImmutable ) );
+
+		_SendUncheckedEvent( ModuleMsg::AfterCompose{} );
+		return true;
+	}
+
+/*
+=================================================
+	_Delete
+=================================================
+*/
+	bool SWQueryPool::_Delete (const ModuleMsg::Delete &msg)
+	{
+		_descr			= Uninitialized;
+		_valuesPerQuery	= 0;
+		_values.Clear();
+
+		return Module::_Delete_Impl( msg );
+	}
+
+/*
+=================================================
+	_GetQueryPoolDescription
+=================================================
+*/
+	bool SWQueryPool::_GetQueryPoolDescription (const GpuMsg::GetQueryPoolDescription &msg)
+	{
+		msg.result.Set( _descr );
+		return true;
+	}
+
+/*
+=================================================
+	_GetSWQueryPoolData
+=================================================
+*/
+	bool SWQueryPool::_GetSWQueryPoolData (const GpuMsg::GetSWQueryPoolData &msg)
+	{
+		CHECK_ERR( _IsComposedState( GetState() ) );
+
+		msg.result.Set({ _values, _valuesPerQuery });
+		return true;
+	}
+
+/*
+=================================================
+	_CreateQueryPool
+----
+	timestamp and occlusion queries have single value,
+	pipeline statistic query has value for each statistic flag.
+	Only compute shader statistic is counted,
+	other statistics are always zero because there is no graphics pipeline.
+=================================================
+*/
+	bool SWQueryPool::_CreateQueryPool ()
+	{
+		CHECK_ERR( _descr.count > 0 );
+
+		switch ( _descr.queryType )
+		{
+			case EQuery::Occlusion :
+			case EQuery::Timestamp :
+				_valuesPerQuery = 1;
+				break;
+
+			case EQuery::PipelineStatistic :
+				CHECK_ERR( _descr.statisticFlags.IsNotZero() );
+				_valuesPerQuery = 0;
+
+				FOR( i, _descr.statisticFlags ) {
+					_valuesPerQuery += uint(_descr.statisticFlags[ EPipelineStatistic::type(i) ]);
+				}
+				break;
+
+			default :
+				RETURN_ERR( "unsupported query type" );
+		}
+
+		_values.Resize( _descr.count * _valuesPerQuery, false );
+		ZeroMem( ArrayRef<ulong>( _values ) );
+		return true;
+	}
+
+}	// PlatformSW
+//-----------------------------------------------------------------------------
+
+namespace Platforms
+{
+	ModulePtr SoftRendererObjectsConstructor::CreateSWQueryPool (ModuleMsg::UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::GpuQueryPool &ci)
+	{
+		return New< PlatformSW::SWQueryPool >( id, gs, ci );
+	}
+}	// Platforms
+}	// Engine
+
+#endif	// GRAPHICS_API_SOFT
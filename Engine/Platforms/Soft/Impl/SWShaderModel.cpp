@@ -26,6 +26,7 @@ namespace PlatformSW
 		// variables
 			ShaderFunc_t		_shaderFunc;
 			OS::Thread			_thread;
+			OS::CpuMask_t		_cpuAffinity;
 
 			const uint3			_localID;
 			const uint3			_localSize;
@@ -40,6 +41,8 @@ namespace PlatformSW
 
 			ComputeShader&	Init ()			{ return _shaderState.Create( ComputeShader{} ).Get< ComputeShader >(); }
 			uint&			Invocation ()	{ return _invocationID; }
+
+			void SetBatch (uint base, uint count)	{ _batchBase = base;  _batchSize = count; }
 		};
 
 
@@ -48,7 +51,7 @@ namespace PlatformSW
 		ComputeThreadPool () {}
 
 		void Invoke (Ptr<IShaderModel> shader, ShaderFunc_t func, const uint3 &localSize,
-					 const uint3 &groupOffset, const uint3 &groupSize);
+					 const uint3 &groupOffset, const uint3 &groupSize, uint batchSize, bool pinThreads);
 	};
 
 
@@ -58,18 +61,45 @@ namespace PlatformSW
 =================================================
 */
 	void SWShaderModel::ComputeThreadPool::Invoke (Ptr<IShaderModel> shader, ShaderFunc_t func, const uint3 &localSize,
-													const uint3 &groupOffset, const uint3 &groupSize)
+													const uint3 &groupOffset, const uint3 &groupSize, const uint batchSize, const bool pinThreads)
 	{
 		Array< ShaderHelper >	shaders;
-
-		shaders.Reserve( localSize.Volume() );
 		
 		// initialize
-		for (uint3 local_id; local_id.z < localSize.z; ++local_id.z)
-		for (local_id.y = 0; local_id.y < localSize.y; ++local_id.y)
-		for (local_id.x = 0; local_id.x < localSize.x; ++local_id.x)
+		if ( batchSize > 1 )
+		{
+			// batched shader processes 'batchSize' local invocations per call
+			const uint	count = localSize.Volume();
+
+			shaders.Reserve( (count + batchSize - 1) / batchSize );
+
+			for (uint base = 0; base < count; base += batchSize)
+			{
+				const uint3	local_id{ base % localSize.x, (base / localSize.x) % localSize.y, base / (localSize.x * localSize.y) };
+
+				shaders.PushBack(ShaderHelper{ shader, func, local_id, localSize, groupOffset, groupSize });
+				shaders.Back().SetBatch( base, Min( batchSize, count - base ) );
+			}
+		}
+		else
+		{
+			shaders.Reserve( localSize.Volume() );
+
+			for (uint3 local_id; local_id.z < localSize.z; ++local_id.z)
+			for (local_id.y = 0; local_id.y < localSize.y; ++local_id.y)
+			for (local_id.x = 0; local_id.x < localSize.x; ++local_id.x)
+			{
+				shaders.PushBack(ShaderHelper{ shader, func, local_id, localSize, groupOffset, groupSize });
+			}
+		}
+
+		// distribute invocations between physical cores to prevent migration between cores,
+		// disabled by default because it conflicts with affinity that is set by user
+		if ( pinThreads )
 		{
-			shaders.PushBack(ShaderHelper{ shader, func, local_id, localSize, groupOffset, groupSize });
+			FOR( i, shaders ) {
+				shaders[i]._cpuAffinity = OS::CpuTopology::Get().GetCoreMask( uint(i) );
+			}
 		}
 
 		// run
@@ -81,6 +111,9 @@ namespace PlatformSW
 					auto&			state	= self->Init();
 					const uint3		size	= self->_groupSize + self->_groupOffset;
 
+					if ( self->_cpuAffinity.IsNotZero() )
+						OS::CpuTopology::SetCurrentThreadAffinity( self->_cpuAffinity );
+
 					state.inNumWorkGroups			= glm::uvec3( size.x, size.y, size.z );
 					state.constWorkGroupSize		= glm::uvec3( self->_localSize.x, self->_localSize.y, self->_localSize.z );
 					state.inLocalInvocationID		= glm::uvec3( self->_localID.x, self->_localID.y, self->_localID.z );
@@ -122,8 +155,105 @@ namespace PlatformSW
 	constructor
 =================================================
 */
-	SWShaderModel::SWShaderModel () : _localSize{0}
+	SWShaderModel::SWShaderModel () : _localSize{0}, _pinThreads{false}
 	{}
+//-----------------------------------------------------------------------------
+
+
+
+	//
+	// Resolve Binding Functor
+	//
+	struct SWShaderModel::_ResolveBinding_Func
+	{
+	// types
+		using PipelineLayoutDescription	= Platforms::PipelineLayoutDescription;
+		using TextureUniform			= PipelineLayoutDescription::TextureUniform;
+		using SamplerUniform			= PipelineLayoutDescription::SamplerUniform;
+		using SubpassInput				= PipelineLayoutDescription::SubpassInput;
+		using ImageUniform				= PipelineLayoutDescription::ImageUniform;
+		using UniformBuffer				= PipelineLayoutDescription::UniformBuffer;
+		using StorageBuffer				= PipelineLayoutDescription::StorageBuffer;
+		using PushConstant				= PipelineLayoutDescription::PushConstant;
+		using PushConstantsBuffer		= PipelineLayoutDescription::PushConstantsBuffer;
+
+	// variables
+		BindingTable_t &				bindings;
+		ModulePtr const&				resourceTable;
+		const EPipelineStage::type		stage;
+
+	// methods
+		_ResolveBinding_Func (OUT BindingTable_t &bindings, const ModulePtr &resourceTable, EPipelineStage::type stage) :
+			bindings{bindings}, resourceTable{resourceTable}, stage{stage}
+		{}
+
+		static EPipelineAccess::bits  _ToAccess (EShaderMemoryModel::type model)
+		{
+			return	(EShaderMemoryModel::HasReadAccess( model ) ? EPipelineAccess::ShaderRead : EPipelineAccess::type(0)) |
+					(EShaderMemoryModel::HasWriteAccess( model ) ? EPipelineAccess::ShaderWrite : EPipelineAccess::type(0));
+		}
+
+		Binding_t&  _Slot (uint index) const
+		{
+			if ( index >= bindings.Count() )
+				bindings.Resize( index+1 );
+
+			return bindings[index];
+		}
+
+		bool _Buffer (uint index, EPipelineAccess::bits access) const
+		{
+			Fwd_GetSWBufferMemoryLayout		req{ index, access, stage };
+			CHECK_ERR( resourceTable->SendAsync( req ) and req.message.result );
+
+			_Slot( index ).Create( BufferBinding{ *req.message.result, access } );
+			return true;
+		}
+
+		bool operator () (const TextureUniform &tex) const
+		{
+			const EPipelineAccess::bits		access = EPipelineAccess::ShaderRead;
+
+			Fwd_GetSWTextureMemoryLayout	req{ tex.uniqueIndex, access, stage };
+			CHECK_ERR( resourceTable->SendAsync( req ) and req.message.result and req.message.sampler );
+
+			_Slot( tex.uniqueIndex ).Create( TextureBinding{ *req.message.result, *req.message.sampler, access } );
+			return true;
+		}
+
+		bool operator () (const ImageUniform &img) const
+		{
+			const EPipelineAccess::bits		access = _ToAccess( img.access );
+
+			Fwd_GetSWImageViewMemoryLayout	req{ img.uniqueIndex, access, stage };
+			CHECK_ERR( resourceTable->SendAsync( req ) and req.message.result );
+
+			_Slot( img.uniqueIndex ).Create( ImageBinding{ *req.message.result, access } );
+			return true;
+		}
+
+		bool operator () (const UniformBuffer &buf) const
+		{
+			return _Buffer( buf.uniqueIndex, EPipelineAccess::UniformRead );
+		}
+
+		bool operator () (const PushConstantsBuffer &buf) const
+		{
+			return _Buffer( buf.uniqueIndex, EPipelineAccess::UniformRead );
+		}
+
+		bool operator () (const StorageBuffer &buf) const
+		{
+			return _Buffer( buf.uniqueIndex, _ToAccess( buf.access ) );
+		}
+
+		bool operator () (const SamplerUniform &) const		{ return true; }
+		bool operator () (const SubpassInput &) const		{ return true; }
+		bool operator () (const PushConstant &) const		{ return true; }
+	};
+//-----------------------------------------------------------------------------
+
+
 	
 /*
 =================================================
@@ -135,10 +265,40 @@ namespace PlatformSW
 		_resourceTable	= null;
 		_localSize		= 0;
 
+		_bindings.Clear();
 		_barriers.Clear();
 		_sharedMemory.Clear();
 	}
 
+/*
+=================================================
+	_ResolveBindings
+----
+	requests all resources from resource table before
+	shader threads are started, so shader invocations
+	read resources without locks and messages.
+	Resources that can't be resolved here will be
+	requested from resource table on demand.
+=================================================
+*/
+	bool SWShaderModel::_ResolveBindings (const ModulePtr &pipeline, EPipelineStage::type stage)
+	{
+		_bindings.Clear();
+
+		GpuMsg::GetPipelineLayoutDescription	req_layout;
+		CHECK_ERR( pipeline->Send( req_layout ) and req_layout.result );
+
+		const auto				uniforms = req_layout.result->GetUniforms();
+		_ResolveBinding_Func	func{ OUT _bindings, _resourceTable, stage };
+
+		bool	resolved = true;
+
+		FOR( i, uniforms ) {
+			uniforms[i].Accept( LAMBDA( &func, &resolved ) (const auto &un) { resolved &= func( un ); });
+		}
+		return resolved;
+	}
+
 /*
 =================================================
 	DispatchCompute
@@ -175,8 +335,13 @@ namespace PlatformSW
 		_resourceTable	= resourceTable;
 		_localSize		= local.Volume();
 
+		CHECK_ERR( _ResolveBindings( pipeline, EPipelineStage::ComputeShader ) );
+
 		ComputeThreadPool	thread_pool;
-		thread_pool.Invoke( this, func, local, groupOffset, groups );
+		thread_pool.Invoke( this, func, local, groupOffset, groups, req_shader.result->batchSize, _pinThreads );
+
+		_counters.computeWorkGroups		+= ulong(groups.Volume());
+		_counters.computeInvocations	+= ulong(groups.Volume()) * local.Volume();
 		
 		_Reset();
 		return true;
@@ -234,6 +399,17 @@ namespace PlatformSW
 */
 	void SWShaderModel::GetBufferMemoryLayout (Fwd_GetSWBufferMemoryLayout &msg) const
 	{
+		if ( msg.index < _bindings.Count() )
+		{
+			auto const&	binding = _bindings[ msg.index ];
+
+			if ( binding.Is< BufferBinding >() and binding.Get< BufferBinding >().access == msg.message.access )
+			{
+				msg.message.result.Set( binding.Get< BufferBinding >().data );
+				return;
+			}
+		}
+
 		SCOPELOCK( _lock );
 
 		CHECK( _resourceTable->SendAsync( msg ) );
@@ -246,6 +422,17 @@ namespace PlatformSW
 */
 	void SWShaderModel::GetImageViewMemoryLayout (Fwd_GetSWImageViewMemoryLayout &msg) const
 	{
+		if ( msg.index < _bindings.Count() )
+		{
+			auto const&	binding = _bindings[ msg.index ];
+
+			if ( binding.Is< ImageBinding >() and binding.Get< ImageBinding >().access == msg.message.accessMask )
+			{
+				msg.message.result.Set( binding.Get< ImageBinding >().layers );
+				return;
+			}
+		}
+
 		SCOPELOCK( _lock );
 
 		CHECK( _resourceTable->SendAsync( msg ) );
@@ -258,6 +445,18 @@ namespace PlatformSW
 */
 	void SWShaderModel::GetTextureMemoryLayout (Fwd_GetSWTextureMemoryLayout &msg) const
 	{
+		if ( msg.index < _bindings.Count() )
+		{
+			auto const&	binding = _bindings[ msg.index ];
+
+			if ( binding.Is< TextureBinding >() and binding.Get< TextureBinding >().access == msg.message.accessMask )
+			{
+				msg.message.result.Set( binding.Get< TextureBinding >().layers );
+				msg.message.sampler.Set( binding.Get< TextureBinding >().sampler );
+				return;
+			}
+		}
+
 		SCOPELOCK( _lock );
 
 		CHECK( _resourceTable->SendAsync( msg ) );
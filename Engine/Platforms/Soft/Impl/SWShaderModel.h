@@ -7,6 +7,7 @@
 #ifdef GRAPHICS_API_SOFT
 
 #include "Engine/Platforms/Soft/ShaderLang/SWShaderHelper.h"
+#include "Engine/Platforms/Soft/Impl/SWMessages.h"
 
 namespace Engine
 {
@@ -20,6 +21,13 @@ namespace PlatformSW
 	class SWShaderModel final : protected SWShaderLang::Impl::SWShaderHelper::IShaderModel
 	{
 	// types
+	public:
+		struct PipelineCounters
+		{
+			ulong	computeInvocations	= 0;
+			ulong	computeWorkGroups	= 0;
+		};
+
 	private:
 		using ShaderFunc_t		= PipelineTemplateDescription::ShaderSource::SWInvoke_t;
 
@@ -32,12 +40,40 @@ namespace PlatformSW
 		using BarrierMap_t		= HashMap< Key_t, Barrier_t >;
 
 		class ComputeThreadPool;
+		struct _ResolveBinding_Func;
+
+		// resources resolved once per dispatch, indexed by uniform unique index,
+		// cached result is used only if requested access is the same
+		struct BufferBinding
+		{
+			GpuMsg::GetSWBufferMemoryLayout::Data		data;
+			EPipelineAccess::bits						access;
+		};
+
+		struct ImageBinding
+		{
+			GpuMsg::GetSWImageViewMemoryLayout::ImgLayers3D	layers;
+			EPipelineAccess::bits							access;
+		};
+
+		struct TextureBinding
+		{
+			GpuMsg::GetSWImageViewMemoryLayout::ImgLayers3D	layers;
+			SamplerDescription								sampler;
+			EPipelineAccess::bits							access;
+		};
+
+		using Binding_t			= Union< BufferBinding, ImageBinding, TextureBinding >;
+		using BindingTable_t	= Array< Binding_t >;
 
 
 	// variables
 	private:
 		ModulePtr				_resourceTable;
 		int						_localSize;
+		BindingTable_t			_bindings;		// immutable while shader threads are running
+		PipelineCounters		_counters;		// accumulated for all dispatches, used by pipeline statistic queries
+		bool					_pinThreads;	// pin compute threads to physical cores
 
 		mutable SharedMemMap_t	_sharedMemory;
 		mutable BarrierMap_t	_barriers;
@@ -52,6 +88,10 @@ namespace PlatformSW
 		bool DispatchCompute (const uint3 &workGroups, const ModulePtr &pipeline, const ModulePtr &resourceTable);
 		bool DispatchComputeOffset (const uint3 &groupOffset, const uint3 &workGroups, const ModulePtr &pipeline, const ModulePtr &resourceTable);
 
+		void SetThreadPinning (bool enabled)	{ _pinThreads = enabled; }
+
+		ND_ PipelineCounters const&	GetCounters ()	const	{ return _counters; }
+
 
 	private:
 		// IShaderModel //
@@ -63,6 +103,7 @@ namespace PlatformSW
 
 	private:
 		void _Reset ();
+		bool _ResolveBindings (const ModulePtr &pipeline, EPipelineStage::type stage);
 
 		static void _Invoke (void *param);
 	};
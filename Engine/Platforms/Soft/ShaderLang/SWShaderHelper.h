@@ -94,9 +94,9 @@ namespace Impl
 
 		struct ComputeShader
 		{
-			glm::uvec3			inGlobalInvocationID;			// gl_GlobalInvocationID
-			glm::uvec3			inLocalInvocationID;			// gl_LocalInvocationID
-			glm::uint			inLocalInvocationIndex	= 0;	// gl_LocalInvocationIndex
+			mutable glm::uvec3	inGlobalInvocationID;			// gl_GlobalInvocationID	(changed by 'SelectInvocation')
+			mutable glm::uvec3	inLocalInvocationID;			// gl_LocalInvocationID		(changed by 'SelectInvocation')
+			mutable glm::uint	inLocalInvocationIndex	= 0;	// gl_LocalInvocationIndex	(changed by 'SelectInvocation')
 			glm::uvec3			inNumWorkGroups;				// gl_NumWorkGroups
 			glm::uvec3			inWorkGroupID;					// gl_WorkGroupID
 			glm::uvec3			constWorkGroupSize;				// gl_WorkGroupSize
@@ -130,6 +130,8 @@ namespace Impl
 	protected:
 		Ptr<IShaderModel>	_shader;
 		uint				_invocationID	= 0;
+		uint				_batchBase		= 0;	// local invocation index of the first invocation in batch
+		uint				_batchSize		= 1;	// number of local invocations processed by batched shader per call
 
 		ShaderState_t		_shaderState;
 
@@ -180,12 +182,71 @@ namespace Impl
 		//template <typename T, typename R>
 		//void GetTexture (uint uniqueIndex, OUT Texture3D<T,R> &value) const;
 
+		// for batched compute shaders
+		ND_ bool SelectInvocation (uint index) const;
+
 	private:
 		EShader::type			_GetShader () const;
 		EPipelineStage::type	_GetStage () const;
 	};
 
 
+
+	//
+	// Batched Shader Registry
+	//
+
+	class BatchedShaderRegistry final : public Noncopyable
+	{
+	// types
+	public:
+		using Invoke_t	= void (*) (const SWShaderHelper &);
+
+	private:
+		using Shaders_t	= Array< Pair< Invoke_t, uint > >;
+
+	// variables
+	private:
+		Shaders_t				_shaders;
+		GX_STL::OS::Mutex		_lock;
+
+	// methods
+	private:
+		BatchedShaderRegistry () {}
+
+		ND_ static BatchedShaderRegistry&  _Instance ()
+		{
+			static BatchedShaderRegistry	inst;
+			return inst;
+		}
+
+	public:
+		// called from generated code when shader processes 'batchSize' invocations per call
+		static bool Register (Invoke_t func, uint batchSize)
+		{
+			auto&	self = _Instance();
+			SCOPELOCK( self._lock );
+
+			self._shaders.PushBack({ func, batchSize });
+			return true;
+		}
+
+		// returns 1 for scalar shaders,
+		// called when pipeline is created, result is cached in pipeline
+		ND_ static uint GetBatchSize (Invoke_t func)
+		{
+			auto&	self = _Instance();
+			SCOPELOCK( self._lock );
+
+			for (auto& sh : self._shaders) {
+				if ( sh.first == func )
+					return sh.second;
+			}
+			return 1;
+		}
+	};
+
+
 /*
 =================================================
 	GetShared
@@ -299,6 +360,29 @@ namespace Impl
 		value = RVREF(Texture2D<T>{ RVREF(*req_tex.message.result), *req_tex.message.sampler });
 	}
 	
+/*
+=================================================
+	SelectInvocation
+----
+	updates invocation builtins for specified invocation in batch,
+	returns false if all invocations are processed.
+=================================================
+*/
+	inline bool SWShaderHelper::SelectInvocation (uint index) const
+	{
+		if ( index >= _batchSize )
+			return false;
+
+		auto const&			state	= _shaderState.Get< ComputeShader >();
+		glm::uvec3 const&	size	= state.constWorkGroupSize;
+		const glm::uint		local	= _batchBase + index;
+
+		state.inLocalInvocationIndex	= local;
+		state.inLocalInvocationID		= glm::uvec3( local % size.x, (local / size.x) % size.y, local / (size.x * size.y) );
+		state.inGlobalInvocationID		= state.inWorkGroupID * size + state.inLocalInvocationID;
+		return true;
+	}
+
 /*
 =================================================
 	_GetShader
@@ -13,6 +13,7 @@
 #include "Engine/Platforms/Public/GPU/RenderPass.h"
 #include "Engine/Platforms/Public/GPU/Sampler.h"
 #include "Engine/Platforms/Public/GPU/Memory.h"
+#include "Engine/Platforms/Public/GPU/Query.h"
 #include "Engine/Platforms/Soft/Impl/SWMessages.h"
 #include "Engine/Platforms/Soft/SoftRendererObjectsConstructor.h"
 
@@ -188,6 +189,7 @@ namespace Platforms
 		graphics.sampler		= SWSamplerModuleID;
 		graphics.memory			= SWMemoryModuleID;
 		graphics.resourceTable	= SWPipelineResourceTableModuleID;
+		graphics.queryPool		= SWQueryPoolModuleID;
 		return graphics;
 	}
 	
@@ -209,6 +211,7 @@ namespace Platforms
 		compute.sampler			= SWSamplerModuleID;
 		compute.memory			= SWMemoryModuleID;
 		compute.resourceTable	= SWPipelineResourceTableModuleID;
+		compute.queryPool		= SWQueryPoolModuleID;
 		return compute;
 	}
 
@@ -237,6 +240,7 @@ namespace Platforms
 		CHECK( mf->Register( SWComputePipelineModuleID, &CreateSWComputePipeline ) );
 		//CHECK( mf->Register( SWGraphicsPipelineModuleID, &CreateSWGraphicsPipeline ) );
 		CHECK( mf->Register( SWPipelineResourceTableModuleID, &CreateSWPipelineResourceTable ) );
+		CHECK( mf->Register( SWQueryPoolModuleID, &CreateSWQueryPool ) );
 		
 		if ( not mf->IsRegistered< CreateInfo::PipelineTemplate >( PipelineTemplateModuleID ) )
 			CHECK( mf->Register( PipelineTemplateModuleID, &CreatePipelineTemplate ) );
@@ -266,6 +270,7 @@ namespace Platforms
 		mf->UnregisterAll( SWCommandBuilderModuleID );
 		//mf->UnregisterAll( SWGraphicsPipelineModuleID );
 		mf->UnregisterAll( SWPipelineResourceTableModuleID );
+		mf->UnregisterAll( SWQueryPoolModuleID );
 
 		//mf->UnregisterAll< Platforms::PipelineTemplate >();	// TODO
 	}
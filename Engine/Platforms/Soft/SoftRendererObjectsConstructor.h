@@ -26,6 +26,7 @@ namespace CreateInfo
 	struct ComputePipeline;
 	struct GraphicsPipeline;
 	struct PipelineResourceTable;
+	struct GpuQueryPool;
 
 }	// CreateInfo
 
@@ -46,6 +47,7 @@ namespace Platforms
 	static constexpr OModID::type  SWComputePipelineModuleID		= "sw.c-ppln"_OModID;
 	static constexpr OModID::type  SWPipelineResourceTableModuleID	= "sw.restable"_OModID;
 	static constexpr OModID::type  SWSyncManagerModuleID			= "sw.sync"_OModID;
+	static constexpr OModID::type  SWQueryPoolModuleID				= "sw.query"_OModID;
 
 
 	//
@@ -78,6 +80,7 @@ namespace Platforms
 		static ModulePtr CreateSWComputePipeline (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::ComputePipeline &);
 		static ModulePtr CreateSWGraphicsPipeline (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::GraphicsPipeline &);
 		static ModulePtr CreateSWPipelineResourceTable (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::PipelineResourceTable &);
+		static ModulePtr CreateSWQueryPool (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::GpuQueryPool &);
 	};
 
 
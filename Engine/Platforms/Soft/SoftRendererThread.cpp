@@ -372,7 +372,7 @@ namespace Platforms
 			default :				RETURN_ERR( "unsupported software renderer version" );
 		}
 
-		_device.Initialize();
+		_device.Initialize( _settings.flags[ GraphicsSettings::EFlags::PinThreads ] );
 
 		if ( _settings.flags[ GraphicsSettings::EFlags::DebugContext ] )
 		{
@@ -1958,7 +1958,7 @@ namespace PlatformVK
 	{
 		CHECK_ERR( _scope == EScope::Command );
 		CHECK_ERR( msg.queryPool and msg.dstBuffer );
-		CHECK_ERR( msg.stride >= SizeOf<ulong> );
+		CHECK_ERR( msg.stride >= (msg.flags[EQueryResult::Value32] ? SizeOf<uint> : SizeOf<ulong>) );
 		
 		const auto&		query_res	= GetResourceCache()->GetQueryPoolID( msg.queryPool );
 		const auto&		buf_res		= GetResourceCache()->GetBufferID( msg.dstBuffer );
@@ -1973,7 +1973,7 @@ namespace PlatformVK
 								   buf_res.Get<0>(),
 								   VkDeviceSize( msg.dstOffset ),
 								   VkDeviceSize( msg.stride ),
-								   VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT );
+								   Vk1Enum( msg.flags ) );
 		return true;
 	}
 	
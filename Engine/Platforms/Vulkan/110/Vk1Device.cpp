@@ -462,6 +462,8 @@ namespace PlatformVK
 		_properties.maxComputeWorkGroupSize			= ReferenceCast<uint3>(_deviceProperties.limits.maxComputeWorkGroupSize);
 		_properties.maxComputeWorkGroupCount		= ReferenceCast<uint3>(_deviceProperties.limits.maxComputeWorkGroupCount);
 
+		_properties.timestampPeriod					= _deviceProperties.limits.timestampPeriod;
+
 		_properties.explicitMemoryObjects			= true;
 	}
 	
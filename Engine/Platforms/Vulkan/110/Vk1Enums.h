@@ -916,6 +916,23 @@ namespace PlatformVK
 		return flags;
 	}
 
+/*
+=================================================
+	QueryResult
+=================================================
+*/
+	ND_ inline vk::VkQueryResultFlags  Vk1Enum (EQueryResult::bits values)
+	{
+		using namespace vk;
+
+		VkQueryResultFlags	flags = values[EQueryResult::Value32] ? 0 : VK_QUERY_RESULT_64_BIT;
+
+		if ( values[EQueryResult::Wait] )				flags |= VK_QUERY_RESULT_WAIT_BIT;
+		if ( values[EQueryResult::WithAvailability] )	flags |= VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+
+		return flags;
+	}
+
 /*
 =================================================
 	GpuObject
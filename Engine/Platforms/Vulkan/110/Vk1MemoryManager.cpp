@@ -5,6 +5,7 @@
 #ifdef GRAPHICS_API_VULKAN
 
 #include "Engine/Platforms/Public/GPU/Memory.h"
+#include "Engine/Platforms/Public/Tools/GpuMemoryAllocator.h"
 #include "Engine/Platforms/Vulkan/110/Vk1BaseModule.h"
 #include "Engine/Platforms/Vulkan/VulkanObjectsConstructor.h"
 
@@ -30,25 +31,35 @@ namespace PlatformVK
 
 		using SupportedEvents_t		= Vk1BaseModule::SupportedEvents_t;
 
+		using GpuMemoryAllocator	= PlatformTools::GpuMemoryAllocator;
+		using Allocation_t			= GpuMemoryAllocator::Allocation;
+
 		struct Memory
 		{
-			VkDeviceMemory			mem		= VK_NULL_HANDLE;
+			VkDeviceMemory			mem			= VK_NULL_HANDLE;
 			BytesU					size;
 			BytesU					align;
 			EGpuMemory::bits		flags;
+			Allocation_t			alloc;					// valid if memory is sub-allocated from page
+			uint					memTypeIndex	= UMax;
 		};
 
 		using MemoryMap_t		= Map< ModuleWPtr, Memory >;
+		using Allocators_t		= Array< UniquePtr< GpuMemoryAllocator > >;	// per memory type
 
 
 	// constants
 	private:
 		static const TypeIdList		_eventTypes;
+
+		static constexpr BytesU		_PageSize		= 64_Mb;
+		static constexpr uint		_MaxEmptyPages	= 1;		// per memory type
 		
 
 	// variables
 	private:
 		MemoryMap_t		_memBlocks;
+		Allocators_t	_allocators;
 
 
 	// methods
@@ -63,6 +74,16 @@ namespace PlatformVK
 		
 		bool _VkAllocMemory (const GpuMsg::VkAllocMemory &);
 		bool _VkFreeMemory (const GpuMsg::VkFreeMemory &);
+
+	private:
+		bool _SubAllocate (const GpuMsg::VkAllocMemory &msg, uint memTypeIndex, INOUT Memory &block);
+		void _FreeSubAllocation (Memory &block);
+		void _FreePages ();
+
+		ND_ static bool  _IsSubAllocationSupported (const GpuMsg::VkAllocMemory &msg);
+
+		ND_ static ulong			_ToUserData (VkDeviceMemory mem)	{ return ulong(ReferenceCast<uint64_t>(mem)); }
+		ND_ static VkDeviceMemory	_ToMemory (ulong userData)			{ return ReferenceCast<VkDeviceMemory>(uint64_t(userData)); }
 	};
 //-----------------------------------------------------------------------------
 
@@ -108,6 +129,115 @@ namespace PlatformVK
 */
 	Vk1MemoryManager::~Vk1MemoryManager ()
 	{
+		ASSERT( _allocators.Empty() );
+	}
+
+/*
+=================================================
+	_IsSubAllocationSupported
+----
+	host visible memory is not sub-allocated because
+	memory object can be mapped only once at a time,
+	memory with aliasing may be bound to other resources
+	and must not overlap with neighbour allocations.
+=================================================
+*/
+	bool Vk1MemoryManager::_IsSubAllocationSupported (const GpuMsg::VkAllocMemory &msg)
+	{
+		return	not msg.flags[EGpuMemory::Dedicated]		and
+				not msg.flags[EGpuMemory::SupportAliasing]	and
+				not msg.flags[EGpuMemory::CoherentWithCPU]	and
+				not msg.flags[EGpuMemory::CachedInCPU]		and
+				BytesU(msg.memReqs.size) <= _PageSize / 2;
+	}
+
+/*
+=================================================
+	_SubAllocate
+=================================================
+*/
+	bool Vk1MemoryManager::_SubAllocate (const GpuMsg::VkAllocMemory &msg, uint memTypeIndex, INOUT Memory &block)
+	{
+		if ( memTypeIndex >= _allocators.Count() )
+			_allocators.Resize( memTypeIndex+1 );
+
+		auto&	alloc = _allocators[memTypeIndex];
+
+		if ( not alloc )
+		{
+			const BytesU	granularity = BytesU(GetDevice()->GetDeviceProperties().limits.bufferImageGranularity);
+
+			alloc = UniquePtr<GpuMemoryAllocator>{ new GpuMemoryAllocator( _PageSize, granularity ) };
+		}
+
+		// allocate new page
+		if ( not alloc->Allocate( block.size, block.align, OUT block.alloc ) )
+		{
+			VkMemoryAllocateInfo	info = {};
+			info.sType				= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			info.allocationSize		= VkDeviceSize(_PageSize);
+			info.memoryTypeIndex	= memTypeIndex;
+
+			VkDeviceMemory		mem_id;
+			VK_CHECK( vkAllocateMemory( GetVkDevice(), &info, null, OUT &mem_id ) );
+		
+			GetDevice()->SetObjectName( ReferenceCast<uint64_t>(mem_id), GetDebugName(), EGpuObject::DeviceMemory );
+
+			const uint	page = alloc->AddPage( _PageSize, _ToUserData( mem_id ) );
+
+			CHECK_ERR( alloc->Allocate( block.size, block.align, OUT block.alloc ) and block.alloc.page == page );
+		}
+
+		block.mem			= _ToMemory( alloc->PageUserData( block.alloc.page ) );
+		block.memTypeIndex	= memTypeIndex;
+
+		msg.result.Set({ block.mem, block.alloc.offset, block.size });
+		return true;
+	}
+
+/*
+=================================================
+	_FreeSubAllocation
+=================================================
+*/
+	void Vk1MemoryManager::_FreeSubAllocation (Memory &block)
+	{
+		auto&	alloc = _allocators[block.memTypeIndex];
+
+		CHECK( alloc->Deallocate( INOUT block.alloc ) );
+
+		GpuMemoryAllocator::PageUserData_t	released;
+		alloc->ReleaseEmptyPages( _MaxEmptyPages, OUT released );
+
+		for (auto& page : released) {
+			vkFreeMemory( GetVkDevice(), _ToMemory( page ), null );
+		}
+	}
+
+/*
+=================================================
+	_FreePages
+=================================================
+*/
+	void Vk1MemoryManager::_FreePages ()
+	{
+		auto	dev = GetVkDevice();
+
+		for (auto& alloc : _allocators)
+		{
+			if ( not alloc )
+				continue;
+
+			GpuMemoryAllocator::PageUserData_t	released;
+			alloc->Clear( OUT released );
+
+			for (auto& page : released)
+			{
+				if ( dev != VK_NULL_HANDLE )
+					vkFreeMemory( dev, _ToMemory( page ), null );
+			}
+		}
+		_allocators.Clear();
 	}
 	
 /*
@@ -129,6 +259,21 @@ namespace PlatformVK
 		CHECK_ERR( GetDevice()->GetMemoryTypeIndex( msg.memReqs.memoryTypeBits, Vk1Enum( msg.flags ), OUT info.memoryTypeIndex ) );
 		
 
+		// sub-allocate from page
+		if ( _IsSubAllocationSupported( msg ) )
+		{
+			Memory	block;
+			block.align		= BytesU(msg.memReqs.alignment);
+			block.flags		= msg.flags;
+			block.size		= BytesU(msg.memReqs.size);
+
+			CHECK_ERR( _SubAllocate( msg, info.memoryTypeIndex, INOUT block ) );
+
+			_memBlocks.Add( msg.module, block );
+			return true;
+		}
+
+
 		// dedicated allocation (if supported)
 		VkMemoryDedicatedAllocateInfoKHR	dedicated_info = {};
 		dedicated_info.sType	= VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO_KHR;
@@ -175,7 +320,10 @@ namespace PlatformVK
 		
 		if ( _memBlocks.Find( msg.module, OUT iter ) )
 		{
-			vkFreeMemory( dev, iter->second.mem, null );
+			if ( iter->second.alloc.IsValid() )
+				_FreeSubAllocation( iter->second );
+			else
+				vkFreeMemory( dev, iter->second.mem, null );
 
 			_memBlocks.EraseByIter( iter );
 		}
@@ -195,9 +343,14 @@ namespace PlatformVK
 		{
 			while ( not _memBlocks.Empty() )
 			{
-				ModulePtr	mod = _memBlocks.Front().first.Lock();
+				ModulePtr	mod		= _memBlocks.Front().first.Lock();
+				Memory&		block	= _memBlocks.Front().second;
+
+				if ( block.alloc.IsValid() )
+					CHECK( _allocators[block.memTypeIndex]->Deallocate( INOUT block.alloc ) );
+				else
+					vkFreeMemory( dev, block.mem, null );
 
-				vkFreeMemory( dev, _memBlocks.Front().second.mem, null );
 				_memBlocks.EraseByIndex( 0 );
 
 				if ( mod ) {
@@ -207,6 +360,7 @@ namespace PlatformVK
 		}
 
 		_memBlocks.Clear();
+		_FreePages();
 
 		return Module::_Delete_Impl( msg );
 	}
@@ -0,0 +1,185 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Profilers/Public/CpuStatistic.h"
+#include "Engine/Profilers/Impl/ProfilerObjectsConstructor.h"
+
+namespace Engine
+{
+namespace Profilers
+{
+
+	//
+	// CPU Profiler
+	//
+
+	class CpuProfiler : public Module
+	{
+	// types
+	protected:
+		using SupportedMessages_t	= MessageListFrom<
+											ModuleMsg::AttachModule,
+											ModuleMsg::DetachModule,
+											ModuleMsg::OnModuleAttached,
+											ModuleMsg::OnModuleDetached,
+											ModuleMsg::Link,
+											ModuleMsg::Compose,
+											ModuleMsg::Delete,
+											ProfilerMsg::CpuProfilerStart,
+											ProfilerMsg::CpuProfilerStop,
+											ProfilerMsg::CpuProfilerSaveTrace,
+											ProfilerMsg::GetCpuProfilerCapture
+										>;
+
+		using SupportedEvents_t		= MessageListFrom<
+											ModuleMsg::Delete
+										>;
+
+		using Recorder				= Base::CpuProfiler;
+
+
+	// constants
+	private:
+		static const TypeIdList		_eventTypes;
+
+
+	// variables
+	private:
+		String			_traceOnDelete;
+
+
+	// methods
+	public:
+		CpuProfiler (UntypedID_t, GlobalSystemsRef gs, const CreateInfo::CpuProfiler &);
+		~CpuProfiler ();
+
+
+	// message handlers
+	private:
+		bool _Delete (const ModuleMsg::Delete &);
+		bool _CpuProfilerStart (const ProfilerMsg::CpuProfilerStart &);
+		bool _CpuProfilerStop (const ProfilerMsg::CpuProfilerStop &);
+		bool _CpuProfilerSaveTrace (const ProfilerMsg::CpuProfilerSaveTrace &);
+		bool _GetCpuProfilerCapture (const ProfilerMsg::GetCpuProfilerCapture &);
+	};
+//-----------------------------------------------------------------------------
+
+
+
+	const TypeIdList	CpuProfiler::_eventTypes{ UninitializedT< SupportedEvents_t >() };
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	CpuProfiler::CpuProfiler (UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::CpuProfiler &ci) :
+		Module( gs, ModuleConfig{ id, 1 }, &_eventTypes ),
+		_traceOnDelete{ ci.traceOnDelete }
+	{
+		SetDebugName( "CpuProfiler" );
+
+		_SubscribeOnMsg( this, &CpuProfiler::_AttachModule_Impl );
+		_SubscribeOnMsg( this, &CpuProfiler::_DetachModule_Impl );
+		_SubscribeOnMsg( this, &CpuProfiler::_OnModuleAttached_Impl );
+		_SubscribeOnMsg( this, &CpuProfiler::_OnModuleDetached_Impl );
+		_SubscribeOnMsg( this, &CpuProfiler::_Link_Impl );
+		_SubscribeOnMsg( this, &CpuProfiler::_Compose_Impl );
+		_SubscribeOnMsg( this, &CpuProfiler::_Delete );
+		_SubscribeOnMsg( this, &CpuProfiler::_CpuProfilerStart );
+		_SubscribeOnMsg( this, &CpuProfiler::_CpuProfilerStop );
+		_SubscribeOnMsg( this, &CpuProfiler::_CpuProfilerSaveTrace );
+		_SubscribeOnMsg( this, &CpuProfiler::_GetCpuProfilerCapture );
+
+		ASSERT( _ValidateMsgSubscriptions< SupportedMessages_t >() );
+
+		if ( ci.startImmediately )
+			Recorder::Start( ci.lastFrames );
+	}
+	
+/*
+=================================================
+	destructor
+=================================================
+*/
+	CpuProfiler::~CpuProfiler ()
+	{
+	}
+	
+/*
+=================================================
+	_Delete
+=================================================
+*/
+	bool CpuProfiler::_Delete (const ModuleMsg::Delete &msg)
+	{
+		if ( Recorder::IsEnabled() )
+		{
+			Recorder::Stop();
+
+			if ( not _traceOnDelete.Empty() )
+				Recorder::SaveChromeTrace( _traceOnDelete );
+		}
+		return Module::_Delete_Impl( msg );
+	}
+	
+/*
+=================================================
+	_CpuProfilerStart
+=================================================
+*/
+	bool CpuProfiler::_CpuProfilerStart (const ProfilerMsg::CpuProfilerStart &msg)
+	{
+		Recorder::Start( msg.lastFrames );
+		return true;
+	}
+	
+/*
+=================================================
+	_CpuProfilerStop
+=================================================
+*/
+	bool CpuProfiler::_CpuProfilerStop (const ProfilerMsg::CpuProfilerStop &)
+	{
+		Recorder::Stop();
+		return true;
+	}
+	
+/*
+=================================================
+	_CpuProfilerSaveTrace
+=================================================
+*/
+	bool CpuProfiler::_CpuProfilerSaveTrace (const ProfilerMsg::CpuProfilerSaveTrace &msg)
+	{
+		CHECK_ERR( Recorder::SaveChromeTrace( msg.filename ) );
+		return true;
+	}
+	
+/*
+=================================================
+	_GetCpuProfilerCapture
+=================================================
+*/
+	bool CpuProfiler::_GetCpuProfilerCapture (const ProfilerMsg::GetCpuProfilerCapture &msg)
+	{
+		Recorder::Capture	capture;
+		CHECK_ERR( Recorder::GetCapture( OUT capture ) );
+
+		msg.result.Set( RVREF(capture) );
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+	
+/*
+=================================================
+	CreateCpuProfiler
+=================================================
+*/
+	ModulePtr ProfilerObjectsConstructor::CreateCpuProfiler (ModuleMsg::UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::CpuProfiler &ci)
+	{
+		return New< CpuProfiler >( id, gs, ci );
+	}
+
+}	// Profilers
+}	// Engine
@@ -0,0 +1,419 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Profilers/Public/GpuStatistic.h"
+#include "Engine/Platforms/Public/GPU/Thread.h"
+#include "Engine/Platforms/Public/GPU/Buffer.h"
+#include "Engine/Platforms/Public/GPU/Memory.h"
+#include "Engine/Platforms/Public/GPU/Query.h"
+#include "Engine/Platforms/Public/GPU/CommandBuffer.h"
+#include "Engine/Profilers/Impl/ProfilerObjectsConstructor.h"
+#include "Engine/Platforms/Public/Tools/GPUThreadHelper.h"
+
+namespace Engine
+{
+namespace Profilers
+{
+	using namespace Engine::Platforms;
+
+
+	//
+	// GPU Profiler
+	//
+
+	class GpuProfiler : public Module
+	{
+	// types
+	protected:
+		using SupportedMessages_t	= MessageListFrom<
+											ModuleMsg::AttachModule,
+											ModuleMsg::DetachModule,
+											ModuleMsg::OnModuleAttached,
+											ModuleMsg::OnModuleDetached,
+											ModuleMsg::Link,
+											ModuleMsg::Compose,
+											ModuleMsg::Delete,
+											ProfilerMsg::GpuProfilerBeginFrame,
+											ProfilerMsg::GpuProfilerEndFrame,
+											ProfilerMsg::GpuProfilerBeginScope,
+											ProfilerMsg::GpuProfilerEndScope,
+											ProfilerMsg::GetGpuProfilerResults
+										>;
+
+		using SupportedEvents_t		= MessageListFrom<
+											ModuleMsg::Delete
+										>;
+
+		using Results_t				= Array< ProfilerMsg::GetGpuProfilerResults::Scope >;
+
+		struct ScopeInfo
+		{
+			String		name;
+			uint		depth	= 0;
+		};
+
+		using Scopes_t				= Array< ScopeInfo >;
+		using ScopeStack_t			= Array< uint >;
+
+
+	// constants
+	private:
+		static const TypeIdList		_eventTypes;
+
+
+	// variables
+	private:
+		ModulePtr					_gpuThread;
+		ModulePtr					_timestampPool;		// 2 timestamps per scope
+		ModulePtr					_statisticPool;		// 1 query per scope, can be null
+		ModulePtr					_resultBuffer;
+
+		Scopes_t					_scopes;
+		ScopeStack_t				_stack;
+
+		const uint					_maxScopes;
+		const EPipelineStatistic::bits	_statFlags;
+		uint						_statCount;
+		float						_timestampPeriod;	// nanoseconds per tick
+
+
+	// methods
+	public:
+		GpuProfiler (UntypedID_t, GlobalSystemsRef gs, const CreateInfo::GpuProfiler &);
+		~GpuProfiler ();
+
+
+	// message handlers
+	private:
+		bool _Link (const ModuleMsg::Link &);
+		bool _Compose (const ModuleMsg::Compose &);
+		bool _Delete (const ModuleMsg::Delete &);
+		bool _GpuProfilerBeginFrame (const ProfilerMsg::GpuProfilerBeginFrame &);
+		bool _GpuProfilerEndFrame (const ProfilerMsg::GpuProfilerEndFrame &);
+		bool _GpuProfilerBeginScope (const ProfilerMsg::GpuProfilerBeginScope &);
+		bool _GpuProfilerEndScope (const ProfilerMsg::GpuProfilerEndScope &);
+		bool _GetGpuProfilerResults (const ProfilerMsg::GetGpuProfilerResults &);
+
+	private:
+		bool _CreateResources ();
+
+		ND_ BytesU  _TimestampsSize () const	{ return SizeOf<ulong> * _maxScopes * 2; }
+		ND_ BytesU  _StatisticSize () const		{ return SizeOf<ulong> * _maxScopes * _statCount; }
+	};
+//-----------------------------------------------------------------------------
+
+
+
+	const TypeIdList	GpuProfiler::_eventTypes{ UninitializedT< SupportedEvents_t >() };
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	GpuProfiler::GpuProfiler (UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::GpuProfiler &ci) :
+		Module( gs, ModuleConfig{ id, UMax }, &_eventTypes ),
+		_gpuThread{ ci.gpuThread },		_maxScopes{ ci.maxScopes },
+		_statFlags{ ci.statistic },		_statCount{ 0 },
+		_timestampPeriod{ 0.0f }
+	{
+		SetDebugName( "GpuProfiler" );
+
+		_SubscribeOnMsg( this, &GpuProfiler::_AttachModule_Impl );
+		_SubscribeOnMsg( this, &GpuProfiler::_DetachModule_Impl );
+		_SubscribeOnMsg( this, &GpuProfiler::_OnModuleAttached_Impl );
+		_SubscribeOnMsg( this, &GpuProfiler::_OnModuleDetached_Impl );
+		_SubscribeOnMsg( this, &GpuProfiler::_Link );
+		_SubscribeOnMsg( this, &GpuProfiler::_Compose );
+		_SubscribeOnMsg( this, &GpuProfiler::_Delete );
+		_SubscribeOnMsg( this, &GpuProfiler::_GpuProfilerBeginFrame );
+		_SubscribeOnMsg( this, &GpuProfiler::_GpuProfilerEndFrame );
+		_SubscribeOnMsg( this, &GpuProfiler::_GpuProfilerBeginScope );
+		_SubscribeOnMsg( this, &GpuProfiler::_GpuProfilerEndScope );
+		_SubscribeOnMsg( this, &GpuProfiler::_GetGpuProfilerResults );
+
+		ASSERT( _ValidateMsgSubscriptions< SupportedMessages_t >() );
+
+		FOR( i, _statFlags ) {
+			_statCount += uint(_statFlags[ EPipelineStatistic::type(i) ]);
+		}
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	GpuProfiler::~GpuProfiler ()
+	{
+	}
+
+/*
+=================================================
+	_Link
+=================================================
+*/
+	bool GpuProfiler::_Link (const ModuleMsg::Link &msg)
+	{
+		if ( _IsComposedOrLinkedState( GetState() ) )
+			return true;	// already linked
+
+		CHECK_ERR( _IsInitialState( GetState() ) );
+
+		if ( not _gpuThread ) {
+			CHECK_LINKING(( _gpuThread = PlatformTools::GPUThreadHelper::FindGraphicsThread( GlobalSystems() ) ));
+		}
+		return Module::_Link_Impl( msg );
+	}
+
+/*
+=================================================
+	_Compose
+=================================================
+*/
+	bool GpuProfiler::_Compose (const ModuleMsg::Compose &msg)
+	{
+		if ( _IsComposedState( GetState() ) )
+			return true;	// already composed
+
+		CHECK_ERR( GetState() == EState::Linked );
+
+		CHECK_COMPOSING( _CreateResources() );
+
+		return Module::_DefCompose( false );
+	}
+
+/*
+=================================================
+	_Delete
+=================================================
+*/
+	bool GpuProfiler::_Delete (const ModuleMsg::Delete &msg)
+	{
+		ModuleUtils::Send({ _timestampPool, _statisticPool, _resultBuffer }, msg );
+
+		_gpuThread		= null;
+		_timestampPool	= null;
+		_statisticPool	= null;
+		_resultBuffer	= null;
+
+		_scopes.Clear();
+		_stack.Clear();
+
+		return Module::_Delete_Impl( msg );
+	}
+
+/*
+=================================================
+	_CreateResources
+=================================================
+*/
+	bool GpuProfiler::_CreateResources ()
+	{
+		CHECK_ERR( _maxScopes > 0 );
+
+		GpuMsg::GetDeviceProperties		req_props;
+		_gpuThread->Send( req_props );
+
+		_timestampPeriod = req_props.result->timestampPeriod;
+		CHECK_ERR( _timestampPeriod > 0.0f );	// timestamps are not supported
+
+		GpuMsg::GetGraphicsModules		req_ids;
+		_gpuThread->Send( req_ids );
+
+		auto	factory	= GlobalSystems()->modulesFactory;
+		auto	gs		= _gpuThread->GlobalSystems();
+
+		CHECK_ERR( factory->Create(
+						req_ids.result->graphics.queryPool,
+						gs,
+						CreateInfo::GpuQueryPool{ _gpuThread, QueryPoolDescription{ EQuery::Timestamp, _maxScopes * 2 } },
+						OUT _timestampPool ) );
+
+		if ( _statCount > 0 )
+		{
+			CHECK_ERR( factory->Create(
+							req_ids.result->graphics.queryPool,
+							gs,
+							CreateInfo::GpuQueryPool{ _gpuThread, QueryPoolDescription{ _statFlags, _maxScopes } },
+							OUT _statisticPool ) );
+		}
+
+		CHECK_ERR( factory->Create(
+						req_ids.result->graphics.buffer,
+						gs,
+						CreateInfo::GpuBuffer{
+							BufferDescription{ _TimestampsSize() + _StatisticSize(), EBufferUsage::TransferDst },
+							EGpuMemory::CoherentWithCPU },
+						OUT _resultBuffer ) );
+
+		CHECK_ERR( ModuleUtils::Initialize({ _timestampPool, _statisticPool, _resultBuffer }) );
+		return true;
+	}
+
+/*
+=================================================
+	_GpuProfilerBeginFrame
+=================================================
+*/
+	bool GpuProfiler::_GpuProfilerBeginFrame (const ProfilerMsg::GpuProfilerBeginFrame &msg)
+	{
+		CHECK_ERR( _IsComposedState( GetState() ) );
+		CHECK_ERR( msg.cmdBuilder );
+
+		_scopes.Clear();
+		_stack.Clear();
+
+		msg.cmdBuilder->Send( GpuMsg::CmdResetQueryPool{ _timestampPool, 0, _maxScopes * 2 });
+
+		if ( _statisticPool ) {
+			msg.cmdBuilder->Send( GpuMsg::CmdResetQueryPool{ _statisticPool, 0, _maxScopes });
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_GpuProfilerEndFrame
+=================================================
+*/
+	bool GpuProfiler::_GpuProfilerEndFrame (const ProfilerMsg::GpuProfilerEndFrame &msg)
+	{
+		CHECK_ERR( _IsComposedState( GetState() ) );
+		CHECK_ERR( msg.cmdBuilder );
+		CHECK_ERR( _stack.Empty() );
+
+		if ( _scopes.Empty() )
+			return true;
+
+		const uint	count = uint(_scopes.Count());
+
+		msg.cmdBuilder->Send( GpuMsg::CmdCopyQueryPoolResults{}
+								.SetSource( _timestampPool, 0, count * 2 )
+								.SetDestination( _resultBuffer, 0_b, SizeOf<ulong> )
+								.SetFlags( EQueryResult::bits().Set( EQueryResult::Wait )) );
+
+		if ( _statisticPool )
+		{
+			msg.cmdBuilder->Send( GpuMsg::CmdCopyQueryPoolResults{}
+									.SetSource( _statisticPool, 0, count )
+									.SetDestination( _resultBuffer, _TimestampsSize(), SizeOf<ulong> * _statCount )
+									.SetFlags( EQueryResult::bits().Set( EQueryResult::Wait )) );
+		}
+
+		msg.cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::Transfer, EPipelineStage::Host }
+								.AddBuffer({ _resultBuffer,
+											 EPipelineAccess::TransferWrite,
+											 EPipelineAccess::HostRead,
+											 0_b, _TimestampsSize() + _StatisticSize() }) );
+		return true;
+	}
+
+/*
+=================================================
+	_GpuProfilerBeginScope
+----
+	pipeline statistic queries can not be nested,
+	so statistic is recorded for top level scopes only.
+=================================================
+*/
+	bool GpuProfiler::_GpuProfilerBeginScope (const ProfilerMsg::GpuProfilerBeginScope &msg)
+	{
+		CHECK_ERR( _IsComposedState( GetState() ) );
+		CHECK_ERR( msg.cmdBuilder );
+		CHECK_ERR( _scopes.Count() < _maxScopes );
+
+		const uint	index = uint(_scopes.Count());
+
+		_scopes.PushBack({ msg.name, uint(_stack.Count()) });
+		_stack.PushBack( index );
+
+		msg.cmdBuilder->Send( GpuMsg::CmdWriteTimestamp{ _timestampPool, index * 2, EPipelineStage::TopOfPipe });
+
+		if ( _statisticPool and _scopes.Back().depth == 0 ) {
+			msg.cmdBuilder->Send( GpuMsg::CmdBeginQuery{ _statisticPool, index });
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_GpuProfilerEndScope
+=================================================
+*/
+	bool GpuProfiler::_GpuProfilerEndScope (const ProfilerMsg::GpuProfilerEndScope &msg)
+	{
+		CHECK_ERR( _IsComposedState( GetState() ) );
+		CHECK_ERR( msg.cmdBuilder );
+		CHECK_ERR( not _stack.Empty() );
+
+		const uint	index = _stack.Back();
+		_stack.PopBack();
+
+		if ( _statisticPool and _scopes[index].depth == 0 ) {
+			msg.cmdBuilder->Send( GpuMsg::CmdEndQuery{ _statisticPool, index });
+		}
+
+		msg.cmdBuilder->Send( GpuMsg::CmdWriteTimestamp{ _timestampPool, index * 2 + 1, EPipelineStage::BottomOfPipe });
+		return true;
+	}
+
+/*
+=================================================
+	_GetGpuProfilerResults
+=================================================
+*/
+	bool GpuProfiler::_GetGpuProfilerResults (const ProfilerMsg::GetGpuProfilerResults &msg)
+	{
+		CHECK_ERR( _IsComposedState( GetState() ) );
+
+		Results_t	results;
+
+		if ( _scopes.Empty() ) {
+			msg.result.Set( RVREF(results) );
+			return true;
+		}
+
+		BinaryArray		data;	data.Resize( usize(_TimestampsSize() + _StatisticSize()) );
+
+		GpuMsg::ReadFromGpuMemory	read_cmd{ data };
+		_resultBuffer->Send( read_cmd );
+		CHECK_ERR( read_cmd.result->Size() == data.Size() );
+
+		ArrayCRef<ulong>	timestamps	= ArrayCRef<ulong>::From( data ).SubArray( 0, _maxScopes * 2 );
+		ArrayCRef<ulong>	statistic	= ArrayCRef<ulong>::From( data ).SubArray( _maxScopes * 2 );
+
+		results.Resize( _scopes.Count() );
+
+		FOR( i, _scopes )
+		{
+			auto&		dst		= results[i];
+			const ulong	begin	= timestamps[i*2];
+			const ulong	end		= timestamps[i*2 + 1];
+
+			dst.name	= _scopes[i].name;
+			dst.depth	= _scopes[i].depth;
+			dst.time	= TimeD::FromNanoSeconds( double(end > begin ? end - begin : 0) * _timestampPeriod );
+
+			if ( _statisticPool and dst.depth == 0 ) {
+				dst.statistic = statistic.SubArray( i * _statCount, _statCount );
+			}
+		}
+
+		msg.result.Set( RVREF(results) );
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	CreateGpuProfiler
+=================================================
+*/
+	ModulePtr ProfilerObjectsConstructor::CreateGpuProfiler (ModuleMsg::UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::GpuProfiler &ci)
+	{
+		return New< GpuProfiler >( id, gs, ci );
+	}
+
+}	// Profilers
+}	// Engine
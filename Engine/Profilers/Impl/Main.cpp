@@ -2,6 +2,8 @@
 
 #include "Engine/Profilers/Impl/ProfilerObjectsConstructor.h"
 #include "Engine/Profilers/Public/GpuStatistic.h"
+#include "Engine/Profilers/Public/CpuStatistic.h"
+#include "Engine/Profilers/Public/MemoryStatistic.h"
 
 namespace Engine
 {
@@ -20,6 +22,10 @@ namespace Profilers
 		auto	mf = GetMainSystemInstance()->GlobalSystems()->modulesFactory;
 
 		CHECK( mf->Register( FPSCounterModuleID, &POC::CreateFPSCounter ) );
+		CHECK( mf->Register( GpuProfilerModuleID, &POC::CreateGpuProfiler ) );
+		CHECK( mf->Register( CpuProfilerModuleID, &POC::CreateCpuProfiler ) );
+		CHECK( mf->Register( MessageProfilerModuleID, &POC::CreateMessageProfiler ) );
+		CHECK( mf->Register( MemoryProfilerModuleID, &POC::CreateMemoryProfiler ) );
 	}
 	
 /*
@@ -32,6 +38,10 @@ namespace Profilers
 		auto	mf = GetMainSystemInstance()->GlobalSystems()->modulesFactory;
 
 		mf->UnregisterAll( FPSCounterModuleID );
+		mf->UnregisterAll( GpuProfilerModuleID );
+		mf->UnregisterAll( CpuProfilerModuleID );
+		mf->UnregisterAll( MessageProfilerModuleID );
+		mf->UnregisterAll( MemoryProfilerModuleID );
 	}
 
 }	// Profilers
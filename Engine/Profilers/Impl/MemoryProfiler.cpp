@@ -0,0 +1,176 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Profilers/Public/MemoryStatistic.h"
+#include "Engine/Profilers/Impl/ProfilerObjectsConstructor.h"
+
+namespace Engine
+{
+namespace Profilers
+{
+
+	//
+	// Memory Profiler
+	//
+
+	class MemoryProfiler : public Module
+	{
+	// types
+	protected:
+		using SupportedMessages_t	= MessageListFrom<
+											ModuleMsg::AttachModule,
+											ModuleMsg::DetachModule,
+											ModuleMsg::OnModuleAttached,
+											ModuleMsg::OnModuleDetached,
+											ModuleMsg::Link,
+											ModuleMsg::Compose,
+											ModuleMsg::Delete,
+											ProfilerMsg::SetMemoryBudget,
+											ProfilerMsg::GetMemoryStatistic
+										>;
+
+		using SupportedEvents_t		= MessageListFrom<
+											ModuleMsg::Delete
+										>;
+
+		using Statistic_t			= StaticArray< MemoryTracker::Statistic, EMemorySubsystem::_Count >;
+
+
+	// constants
+	private:
+		static const TypeIdList		_eventTypes;
+
+
+	// variables
+	private:
+		Statistic_t			_prevStat;
+		TimeProfilerD		_timer;
+
+
+	// methods
+	public:
+		MemoryProfiler (UntypedID_t, GlobalSystemsRef gs, const CreateInfo::MemoryProfiler &);
+		~MemoryProfiler ();
+
+
+	// message handlers
+	private:
+		bool _SetMemoryBudget (const ProfilerMsg::SetMemoryBudget &);
+		bool _GetMemoryStatistic (const ProfilerMsg::GetMemoryStatistic &);
+	};
+//-----------------------------------------------------------------------------
+
+
+
+	const TypeIdList	MemoryProfiler::_eventTypes{ UninitializedT< SupportedEvents_t >() };
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	MemoryProfiler::MemoryProfiler (UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::MemoryProfiler &ci) :
+		Module( gs, ModuleConfig{ id, 1 }, &_eventTypes )
+	{
+		SetDebugName( "MemoryProfiler" );
+
+		_SubscribeOnMsg( this, &MemoryProfiler::_AttachModule_Impl );
+		_SubscribeOnMsg( this, &MemoryProfiler::_DetachModule_Impl );
+		_SubscribeOnMsg( this, &MemoryProfiler::_OnModuleAttached_Impl );
+		_SubscribeOnMsg( this, &MemoryProfiler::_OnModuleDetached_Impl );
+		_SubscribeOnMsg( this, &MemoryProfiler::_Link_Impl );
+		_SubscribeOnMsg( this, &MemoryProfiler::_Compose_Impl );
+		_SubscribeOnMsg( this, &MemoryProfiler::_Delete_Impl );
+		_SubscribeOnMsg( this, &MemoryProfiler::_SetMemoryBudget );
+		_SubscribeOnMsg( this, &MemoryProfiler::_GetMemoryStatistic );
+
+		ASSERT( _ValidateMsgSubscriptions< SupportedMessages_t >() );
+
+		if ( not MemoryTracker::IsEnabled() )
+			LOG( "memory statistic requires GX_MEMORY_TRACKING, statistic will be empty", ELog::Warning );
+
+		FOR( i, ci.budgets )
+		{
+			if ( ci.budgets[i] > BytesU() )
+				MemoryTracker::SetBudget( EMemorySubsystem::type(i), ulong(ci.budgets[i]) );
+		}
+
+		FOR( i, _prevStat ) {
+			MemoryTracker::GetStatistic( EMemorySubsystem::type(i), OUT _prevStat[i] );
+		}
+		_timer.Start();
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	MemoryProfiler::~MemoryProfiler ()
+	{
+	}
+
+/*
+=================================================
+	_SetMemoryBudget
+=================================================
+*/
+	bool MemoryProfiler::_SetMemoryBudget (const ProfilerMsg::SetMemoryBudget &msg)
+	{
+		CHECK_ERR( msg.subsystem < EMemorySubsystem::_Count );
+
+		MemoryTracker::SetBudget( msg.subsystem, ulong(msg.budget) );
+		return true;
+	}
+
+/*
+=================================================
+	_GetMemoryStatistic
+----
+	rates are calculated since previous request
+=================================================
+*/
+	bool MemoryProfiler::_GetMemoryStatistic (const ProfilerMsg::GetMemoryStatistic &msg)
+	{
+		const double	dt = GXMath::Max( _timer.GetTimeDelta().Seconds(), 1.0e-6 );
+
+		ProfilerMsg::GetMemoryStatistic::Subsystems_t	result;
+
+		FOR( i, result )
+		{
+			MemoryTracker::Statistic	stat;
+			CHECK_ERR( MemoryTracker::GetStatistic( EMemorySubsystem::type(i), OUT stat ) );
+
+			const auto&		prev	= _prevStat[i];
+			auto&			dst		= result[i];
+
+			dst.type		= EMemorySubsystem::type(i);
+			dst.live		= BytesU( stat.liveBytes );
+			dst.peak		= BytesU( stat.peakBytes );
+			dst.budget		= BytesU( stat.budget );
+			dst.allocCount	= stat.allocCount;
+			dst.allocRate	= float( double(stat.allocCount - prev.allocCount) / dt );
+			dst.byteRate	= float( double(stat.totalBytes - prev.totalBytes) / dt );
+
+			_prevStat[i] = stat;
+		}
+
+		_timer.Start();
+
+		msg.result.Set( result );
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	CreateMemoryProfiler
+=================================================
+*/
+	ModulePtr ProfilerObjectsConstructor::CreateMemoryProfiler (ModuleMsg::UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::MemoryProfiler &ci)
+	{
+		return New< MemoryProfiler >( id, gs, ci );
+	}
+
+}	// Profilers
+}	// Engine
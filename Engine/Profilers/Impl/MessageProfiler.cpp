@@ -0,0 +1,221 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Profilers/Public/CpuStatistic.h"
+#include "Engine/Profilers/Impl/ProfilerObjectsConstructor.h"
+
+namespace Engine
+{
+namespace Profilers
+{
+
+	//
+	// Message Profiler
+	//
+
+	class MessageProfiler : public Module
+	{
+	// types
+	protected:
+		using SupportedMessages_t	= MessageListFrom<
+											ModuleMsg::AttachModule,
+											ModuleMsg::DetachModule,
+											ModuleMsg::OnModuleAttached,
+											ModuleMsg::OnModuleDetached,
+											ModuleMsg::Link,
+											ModuleMsg::Compose,
+											ModuleMsg::Delete,
+											ProfilerMsg::MessageProfilerStart,
+											ProfilerMsg::MessageProfilerStop,
+											ProfilerMsg::MessageProfilerReset,
+											ProfilerMsg::MessageProfilerSaveReport,
+											ProfilerMsg::MessageProfilerSaveGraph,
+											ProfilerMsg::GetMessageStatistic
+										>;
+
+		using SupportedEvents_t		= MessageListFrom<
+											ModuleMsg::Delete
+										>;
+
+		using Recorder				= Base::MessageStatistic;
+
+
+	// constants
+	private:
+		static const TypeIdList		_eventTypes;
+
+
+	// variables
+	private:
+		String			_reportOnDelete;
+		String			_graphOnDelete;
+
+
+	// methods
+	public:
+		MessageProfiler (UntypedID_t, GlobalSystemsRef gs, const CreateInfo::MessageProfiler &);
+		~MessageProfiler ();
+
+
+	// message handlers
+	private:
+		bool _Delete (const ModuleMsg::Delete &);
+		bool _MessageProfilerStart (const ProfilerMsg::MessageProfilerStart &);
+		bool _MessageProfilerStop (const ProfilerMsg::MessageProfilerStop &);
+		bool _MessageProfilerReset (const ProfilerMsg::MessageProfilerReset &);
+		bool _MessageProfilerSaveReport (const ProfilerMsg::MessageProfilerSaveReport &);
+		bool _MessageProfilerSaveGraph (const ProfilerMsg::MessageProfilerSaveGraph &);
+		bool _GetMessageStatistic (const ProfilerMsg::GetMessageStatistic &);
+	};
+//-----------------------------------------------------------------------------
+
+
+
+	const TypeIdList	MessageProfiler::_eventTypes{ UninitializedT< SupportedEvents_t >() };
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	MessageProfiler::MessageProfiler (UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::MessageProfiler &ci) :
+		Module( gs, ModuleConfig{ id, 1 }, &_eventTypes ),
+		_reportOnDelete{ ci.reportOnDelete },	_graphOnDelete{ ci.graphOnDelete }
+	{
+		SetDebugName( "MessageProfiler" );
+
+		_SubscribeOnMsg( this, &MessageProfiler::_AttachModule_Impl );
+		_SubscribeOnMsg( this, &MessageProfiler::_DetachModule_Impl );
+		_SubscribeOnMsg( this, &MessageProfiler::_OnModuleAttached_Impl );
+		_SubscribeOnMsg( this, &MessageProfiler::_OnModuleDetached_Impl );
+		_SubscribeOnMsg( this, &MessageProfiler::_Link_Impl );
+		_SubscribeOnMsg( this, &MessageProfiler::_Compose_Impl );
+		_SubscribeOnMsg( this, &MessageProfiler::_Delete );
+		_SubscribeOnMsg( this, &MessageProfiler::_MessageProfilerStart );
+		_SubscribeOnMsg( this, &MessageProfiler::_MessageProfilerStop );
+		_SubscribeOnMsg( this, &MessageProfiler::_MessageProfilerReset );
+		_SubscribeOnMsg( this, &MessageProfiler::_MessageProfilerSaveReport );
+		_SubscribeOnMsg( this, &MessageProfiler::_MessageProfilerSaveGraph );
+		_SubscribeOnMsg( this, &MessageProfiler::_GetMessageStatistic );
+
+		ASSERT( _ValidateMsgSubscriptions< SupportedMessages_t >() );
+
+		#if not (defined(GX_ENABLE_DEBUGGING) or defined(GX_ENABLE_PROFILING))
+			LOG( "message statistic requires GX_ENABLE_PROFILING or GX_ENABLE_DEBUGGING, statistic will be empty", ELog::Warning );
+		#endif
+
+		if ( ci.startImmediately )
+			Recorder::Start();
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	MessageProfiler::~MessageProfiler ()
+	{
+	}
+
+/*
+=================================================
+	_Delete
+=================================================
+*/
+	bool MessageProfiler::_Delete (const ModuleMsg::Delete &msg)
+	{
+		if ( Recorder::IsEnabled() )
+		{
+			Recorder::Stop();
+
+			if ( not _reportOnDelete.Empty() )
+				Recorder::SaveReport( _reportOnDelete );
+
+			if ( not _graphOnDelete.Empty() )
+				Recorder::SaveGraph( _graphOnDelete );
+		}
+		return Module::_Delete_Impl( msg );
+	}
+
+/*
+=================================================
+	_MessageProfilerStart
+=================================================
+*/
+	bool MessageProfiler::_MessageProfilerStart (const ProfilerMsg::MessageProfilerStart &)
+	{
+		Recorder::Start();
+		return true;
+	}
+
+/*
+=================================================
+	_MessageProfilerStop
+=================================================
+*/
+	bool MessageProfiler::_MessageProfilerStop (const ProfilerMsg::MessageProfilerStop &)
+	{
+		Recorder::Stop();
+		return true;
+	}
+
+/*
+=================================================
+	_MessageProfilerReset
+=================================================
+*/
+	bool MessageProfiler::_MessageProfilerReset (const ProfilerMsg::MessageProfilerReset &)
+	{
+		Recorder::Reset();
+		return true;
+	}
+
+/*
+=================================================
+	_MessageProfilerSaveReport
+=================================================
+*/
+	bool MessageProfiler::_MessageProfilerSaveReport (const ProfilerMsg::MessageProfilerSaveReport &msg)
+	{
+		CHECK_ERR( Recorder::SaveReport( msg.filename ) );
+		return true;
+	}
+
+/*
+=================================================
+	_MessageProfilerSaveGraph
+=================================================
+*/
+	bool MessageProfiler::_MessageProfilerSaveGraph (const ProfilerMsg::MessageProfilerSaveGraph &msg)
+	{
+		CHECK_ERR( Recorder::SaveGraph( msg.filename ) );
+		return true;
+	}
+
+/*
+=================================================
+	_GetMessageStatistic
+=================================================
+*/
+	bool MessageProfiler::_GetMessageStatistic (const ProfilerMsg::GetMessageStatistic &msg)
+	{
+		Recorder::Entries_t		entries;
+		Recorder::GetStatistic( OUT entries );
+
+		msg.result.Set( RVREF(entries) );
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	CreateMessageProfiler
+=================================================
+*/
+	ModulePtr ProfilerObjectsConstructor::CreateMessageProfiler (ModuleMsg::UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::MessageProfiler &ci)
+	{
+		return New< MessageProfiler >( id, gs, ci );
+	}
+
+}	// Profilers
+}	// Engine
@@ -9,6 +9,10 @@ namespace Engine
 namespace CreateInfo
 {
 	struct FPSCounter;
+	struct GpuProfiler;
+	struct CpuProfiler;
+	struct MessageProfiler;
+	struct MemoryProfiler;
 
 }	// CreateInfo
 
@@ -25,6 +29,10 @@ namespace Profilers
 	// methods
 	public:
 		static ModulePtr CreateFPSCounter (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::FPSCounter &);
+		static ModulePtr CreateGpuProfiler (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::GpuProfiler &);
+		static ModulePtr CreateCpuProfiler (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::CpuProfiler &);
+		static ModulePtr CreateMessageProfiler (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::MessageProfiler &);
+		static ModulePtr CreateMemoryProfiler (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::MemoryProfiler &);
 	};
 
 
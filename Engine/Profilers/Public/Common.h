@@ -14,4 +14,10 @@ namespace Profilers
 	void UnregisterProfilers ();
 
 }	// Profilers
+
+namespace ProfilerMsg
+{
+	using namespace Engine::_BaseMessages_;
+
+}	// ProfilerMsg
 }	// Engine
@@ -0,0 +1,114 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#pragma once
+
+#include "Engine/Profilers/Public/IDs.h"
+
+namespace Engine
+{
+namespace CreateInfo
+{
+
+	//
+	// CPU Profiler Create Info
+	//
+	struct CpuProfiler
+	{
+		uint		lastFrames			= 0;		// ring buffer mode, 0 - capture all frames
+		bool		startImmediately	= true;
+		String		traceOnDelete;					// if not empty then trace will be saved when module is deleted
+	};
+
+
+	//
+	// Message Profiler Create Info
+	//
+	struct MessageProfiler
+	{
+		bool		startImmediately	= true;
+		String		reportOnDelete;					// if not empty then report will be saved when module is deleted
+		String		graphOnDelete;					// same as 'reportOnDelete' but for graphviz file
+	};
+
+}	// CreateInfo
+
+
+namespace ProfilerMsg
+{
+
+	//
+	// CPU Profiler Start / Stop
+	//
+	struct CpuProfilerStart : _MsgBase_
+	{
+		uint		lastFrames	= 0;
+
+		CpuProfilerStart () {}
+		explicit CpuProfilerStart (uint lastFrames) : lastFrames{lastFrames} {}
+	};
+
+	struct CpuProfilerStop : _MsgBase_
+	{};
+
+
+	//
+	// Save CPU Profiler Trace
+	//
+	struct CpuProfilerSaveTrace : _MsgBase_
+	{
+		String		filename;	// chrome trace json
+
+		explicit CpuProfilerSaveTrace (StringCRef filename) : filename{filename} {}
+	};
+
+
+	//
+	// Get CPU Profiler Capture
+	//
+	struct GetCpuProfilerCapture : _MsgBase_
+	{
+		Out< Base::CpuProfiler::Capture >	result;
+	};
+
+
+	//
+	// Message Profiler Start / Stop / Reset
+	//
+	struct MessageProfilerStart : _MsgBase_
+	{};
+
+	struct MessageProfilerStop : _MsgBase_
+	{};
+
+	struct MessageProfilerReset : _MsgBase_
+	{};
+
+
+	//
+	// Save Message Profiler Report / Graph
+	//
+	struct MessageProfilerSaveReport : _MsgBase_
+	{
+		String		filename;	// text report, sorted by time
+
+		explicit MessageProfilerSaveReport (StringCRef filename) : filename{filename} {}
+	};
+
+	struct MessageProfilerSaveGraph : _MsgBase_
+	{
+		String		filename;	// graphviz dot file
+
+		explicit MessageProfilerSaveGraph (StringCRef filename) : filename{filename} {}
+	};
+
+
+	//
+	// Get Message Statistic
+	//
+	struct GetMessageStatistic : _MsgBase_
+	{
+		Out< Base::MessageStatistic::Entries_t >	result;
+	};
+
+}	// ProfilerMsg
+}	// Engine
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/Profilers/Public/IDs.h"
+#include "Engine/Platforms/Public/GPU/QueryEnums.h"
 
 namespace Engine
 {
@@ -17,13 +18,79 @@ namespace CreateInfo
 		TimeD		interval	= 1.0_sec;
 	};
 
+
+	//
+	// GPU Profiler Create Info
+	//
+	struct GpuProfiler
+	{
+		using EPipelineStatistic	= Platforms::EPipelineStatistic;
+
+		ModulePtr					gpuThread;		// if null then graphics thread is used
+		uint						maxScopes	= 64;
+		EPipelineStatistic::bits	statistic;		// empty if pipeline statistic is not needed
+	};
+
 }	// CreateInfo
 
 
 namespace ProfilerMsg
 {
 
-	
+	//
+	// GPU Profiler Frame
+	//
+	struct GpuProfilerBeginFrame : _MsgBase_
+	{
+		ModulePtr	cmdBuilder;		// resets queries, must be recorded outside of render pass
+
+		explicit GpuProfilerBeginFrame (const ModulePtr &cmdBuilder) : cmdBuilder{cmdBuilder} {}
+	};
+
+	struct GpuProfilerEndFrame : _MsgBase_
+	{
+		ModulePtr	cmdBuilder;		// copies query results to host visible buffer
+
+		explicit GpuProfilerEndFrame (const ModulePtr &cmdBuilder) : cmdBuilder{cmdBuilder} {}
+	};
+
+
+	//
+	// GPU Profiler Scope
+	//
+	struct GpuProfilerBeginScope : _MsgBase_
+	{
+		ModulePtr	cmdBuilder;
+		String		name;
+
+		GpuProfilerBeginScope (const ModulePtr &cmdBuilder, StringCRef name) : cmdBuilder{cmdBuilder}, name{name} {}
+	};
+
+	struct GpuProfilerEndScope : _MsgBase_
+	{
+		ModulePtr	cmdBuilder;
+
+		explicit GpuProfilerEndScope (const ModulePtr &cmdBuilder) : cmdBuilder{cmdBuilder} {}
+	};
+
+
+	//
+	// Get GPU Profiler Results
+	//
+	struct GetGpuProfilerResults : _MsgBase_
+	{
+	// types
+		struct Scope
+		{
+			String			name;
+			TimeD			time;
+			uint			depth	= 0;
+			Array<ulong>	statistic;		// in order of statistic flags, only for top level scopes
+		};
+
+	// variables
+		Out< Array<Scope> >		result;		// valid only when command buffer with 'GpuProfilerEndFrame' is completed
+	};
 
 }	// ProfilerMsg
 }	// Engine
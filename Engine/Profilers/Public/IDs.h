@@ -10,6 +10,10 @@ namespace Profilers
 {
 
 	static constexpr OModID::type  FPSCounterModuleID		= "fps-count"_OModID;
+	static constexpr OModID::type  GpuProfilerModuleID		= "gpu-prof"_OModID;
+	static constexpr OModID::type  CpuProfilerModuleID		= "cpu-prof"_OModID;
+	static constexpr OModID::type  MessageProfilerModuleID	= "msg-prof"_OModID;
+	static constexpr OModID::type  MemoryProfilerModuleID	= "mem-prof"_OModID;
 	
 
 }	// Profilers
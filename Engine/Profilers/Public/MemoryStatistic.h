@@ -0,0 +1,65 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#pragma once
+
+#include "Engine/Profilers/Public/IDs.h"
+#include "Core/STL/Memory/MemoryTracker.h"
+
+namespace Engine
+{
+namespace CreateInfo
+{
+
+	//
+	// Memory Profiler Create Info
+	//
+	struct MemoryProfiler
+	{
+		using Budgets_t	= StaticArray< BytesU, EMemorySubsystem::_Count >;
+
+		Budgets_t	budgets;		// soft limits per subsystem, 0 - unlimited
+	};
+
+}	// CreateInfo
+
+
+namespace ProfilerMsg
+{
+
+	//
+	// Set Memory Budget
+	//
+	struct SetMemoryBudget : _MsgBase_
+	{
+		EMemorySubsystem::type	subsystem	= EMemorySubsystem::Unknown;
+		BytesU					budget;		// 0 - unlimited
+
+		SetMemoryBudget (EMemorySubsystem::type subsystem, BytesU budget) : subsystem{subsystem}, budget{budget} {}
+	};
+
+
+	//
+	// Get Memory Statistic
+	//
+	struct GetMemoryStatistic : _MsgBase_
+	{
+	// types
+		struct Subsystem
+		{
+			EMemorySubsystem::type	type		= EMemorySubsystem::Unknown;
+			BytesU					live;
+			BytesU					peak;
+			BytesU					budget;
+			ulong					allocCount	= 0;
+			float					allocRate	= 0.0f;		// allocations per second since previous request
+			float					byteRate	= 0.0f;		// allocated bytes per second since previous request
+		};
+
+		using Subsystems_t	= StaticArray< Subsystem, EMemorySubsystem::_Count >;
+
+	// variables
+		Out< Subsystems_t >		result;		// zeros if memory tracking is disabled
+	};
+
+}	// ProfilerMsg
+}	// Engine
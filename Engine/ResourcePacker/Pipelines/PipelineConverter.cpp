@@ -211,7 +211,7 @@ namespace ResPack
 */
 	bool PipelineConverter::ConvertPipelines (StringCRef outFolder)
 	{
-		CHECK_ERR( OS::FileSystem::IsDirectoryExist( outFolder ) );
+		CHECK_ERR( OS::FileSystem::CreateDirectories( outFolder ) );
 
 		// add dependency to resource packer executable
 		{
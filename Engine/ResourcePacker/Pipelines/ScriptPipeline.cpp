@@ -79,6 +79,8 @@ namespace ResPack
 		binder.AddProperty( &ConverterConfig::validation,			"validation" );
 		binder.AddProperty( &ConverterConfig::nameSpace,			"nameSpace" );
 		binder.AddProperty( &ConverterConfig::minimalRebuild,		"minimalRebuild" );
+		binder.AddProperty( &ConverterConfig::softwareBatchSize,		"softwareBatchSize" );
+		binder.AddProperty( &ConverterConfig::softwareShaderSource,	"softwareShaderSource" );
 
 		binder.AddMethodFromGlobal( &ConverterConfigUtils::Include,		"Include" );
 		binder.AddMethodFromGlobal( &ConverterConfigUtils::SetDefaults,	"SetDefaults" );
@@ -27,6 +27,8 @@ namespace Scene
 
 		factory->Register( WindowSurfaceModuleID, &SOC::CreateWindowSurface );
 		factory->Register( VRSurfaceModuleID, &SOC::CreateVRSurface );
+		factory->Register( OffscreenSurfaceModuleID, &SOC::CreateOffscreenSurface );
+		factory->Register( VideoRecordeerSurfaceModuleID, &SOC::CreateVideoRecorderSurface );
 
 		factory->Register( SceneManagerModuleID, &SOC::CreateSceneManager );
 		factory->Register( SceneModuleID, &SOC::CreateSceneMainThread );
@@ -49,6 +51,8 @@ namespace Scene
 
 		factory->UnregisterAll( WindowSurfaceModuleID );
 		factory->UnregisterAll( VRSurfaceModuleID );
+		factory->UnregisterAll( OffscreenSurfaceModuleID );
+		factory->UnregisterAll( VideoRecordeerSurfaceModuleID );
 
 		factory->UnregisterAll( SceneManagerModuleID );
 		factory->UnregisterAll( SceneModuleID );
@@ -11,6 +11,8 @@ namespace CreateInfo
 {
 	struct Camera;
 	struct RenderSurface;
+	struct OffscreenSurface;
+	struct VideoRecorderSurface;
 	struct SceneManager;
 	struct SceneMain;
 	struct SceneRenderer;
@@ -35,6 +37,8 @@ namespace Scene
 
 		static ModulePtr  CreateWindowSurface (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::RenderSurface &);
 		static ModulePtr  CreateVRSurface (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::RenderSurface &);
+		static ModulePtr  CreateOffscreenSurface (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::OffscreenSurface &);
+		static ModulePtr  CreateVideoRecorderSurface (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::VideoRecorderSurface &);
 
 		static ModulePtr  CreateSceneManager (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::SceneManager &);
 		static ModulePtr  CreateSceneMainThread (ModuleMsg::UntypedID_t, GlobalSystemsRef, const CreateInfo::SceneMain &);
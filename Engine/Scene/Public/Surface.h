@@ -25,6 +25,70 @@ namespace CreateInfo
 		ModulePtr	scene;
 	};
 
+
+	//
+	// Offscreen Surface Create Info
+	//
+	struct OffscreenSurface
+	{
+	// types
+		using EPixelFormat	= Platforms::EPixelFormat;
+
+		struct Frame
+		{
+			BinArrayCRef		pixels;			// valid only inside callback
+			GXMath::uint2		size;
+			BytesU				rowPitch;
+			EPixelFormat::type	format;
+			ulong				frameId;		// index of frame since surface was created
+		};
+
+		using Callback_t	= Function< void (const Frame &) >;
+
+	// variables
+		ModulePtr			scene;
+		GXMath::uint2		size;
+		EPixelFormat::type	colorFmt		= EPixelFormat::RGBA8_UNorm;
+		EPixelFormat::type	depthFmt		= EPixelFormat::Depth24;		// 'Unknown' to disable depth buffer
+		Callback_t			onFrameReady;	// called from render thread when frame was copied to host visible memory,
+											// frames are delivered in order with latency of 'CommandBufferManager::bufferChainLength' frames.
+		TimeD				statInterval	= 1.0_sec;
+	};
+
+
+	//
+	// Video Recorder Surface Create Info
+	//
+	struct VideoRecorderSurface
+	{
+	// types
+		using EPixelFormat	= Platforms::EPixelFormat;
+
+		enum class EFormat
+		{
+			Y4M,				// uncompressed YUV 4:4:4 stream
+			RawCompressed,		// RGBA8 frames, each frame compressed with LZ4 (if enabled) or MiniZ
+			PNGSequence,		// one file per frame: '<path>_000000.png', requires MiniZ
+		};
+
+		enum class EQueuePolicy
+		{
+			Block,				// backpressure: render thread waits until encoder frees a slot, frames are never lost
+			DropNewest,			// captured frame is skipped if queue is full
+			DropOldest,			// oldest frame in queue is replaced by captured frame
+		};
+
+	// variables
+		ModulePtr			scene;
+		GXMath::uint2		size;
+		EPixelFormat::type	depthFmt		= EPixelFormat::Depth24;
+		String				path;								// output file for stream formats, file prefix for image sequence
+		EFormat				format			= EFormat::Y4M;
+		EQueuePolicy		policy			= EQueuePolicy::DropOldest;
+		uint				queueLength		= 8;				// max number of frames waiting for encoder
+		uint				frameRate		= 30;				// written to stream header
+	};
+
 }	// CreateInfo
 
 
@@ -84,5 +148,24 @@ namespace SceneMsg
 	};
 
 
+	//
+	// Get Offscreen Surface Readback Statistic
+	//
+	struct OffscreenSurfaceGetStatistic : _MsgBase_
+	{
+	// types
+		struct Data
+		{
+			ulong		framesRead			= 0;	// total
+			BytesU		bytesRead;					// total
+			double		framesPerSecond		= 0.0;	// measured on last interval
+			double		megabytesPerSecond	= 0.0;	// measured on last interval
+		};
+
+	// variables
+		Out< Data >		result;
+	};
+
+
 }	// SceneMsg
 }	// Engine
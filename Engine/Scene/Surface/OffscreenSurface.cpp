@@ -0,0 +1,594 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Scene/Public/Surface.h"
+#include "Engine/Scene/Impl/SceneObjectConstructor.h"
+#include "Engine/Scene/Impl/BaseSceneModule.h"
+#include "Engine/Platforms/Public/Tools/GPUThreadHelper.h"
+
+namespace Engine
+{
+namespace Scene
+{
+	using namespace Engine::Platforms;
+
+
+	//
+	// Offscreen Surface
+	//
+
+	class OffscreenSurface final : public BaseSceneModule
+	{
+	// types
+	protected:
+		using SupportedMessages_t	= BaseSceneModule::SupportedMessages_t::Erase< MessageListFrom<
+											ModuleMsg::Compose
+										> >::Append< MessageListFrom<
+											SceneMsg::SurfaceGetDescription,
+											SceneMsg::OffscreenSurfaceGetStatistic,
+											ModuleMsg::Update
+										> >;
+
+		using SupportedEvents_t		= BaseSceneModule::SupportedEvents_t::Append< MessageListFrom<
+											ModuleMsg::Update,
+											SceneMsg::SurfaceOnResize,
+											SceneMsg::SurfaceRequestUpdate
+										> >;
+
+		using CmdBufferMngrMsgList_t = MessageListFrom<
+											GraphicsMsg::CmdBeginFrame,
+											GraphicsMsg::CmdEndFrame,
+											GraphicsMsg::CmdBegin,
+											GraphicsMsg::CmdEnd >;
+
+		using Frame_t				= CreateInfo::OffscreenSurface::Frame;
+		using Callback_t			= CreateInfo::OffscreenSurface::Callback_t;
+		using Statistic_t			= SceneMsg::OffscreenSurfaceGetStatistic::Data;
+
+		struct FrameSlot
+		{
+			ModulePtr		framebuffer;
+			ModulePtr		colorImage;
+			ModulePtr		depthImage;			// optional
+			ModulePtr		stagingBuffer;		// host visible memory, persistently mapped
+			BinArrayCRef	mapped;
+			BinaryArray		readCache;			// used if memory can not be mapped
+			ulong			frameId		= 0;
+			bool			pending		= false;
+		};
+
+		using FrameSlots_t			= Array< FrameSlot >;
+
+
+	// constants
+	private:
+		static const TypeIdList		_eventTypes;
+
+
+	// variables
+	private:
+		ModulePtr			_thread;
+		ModulePtr			_builder;
+		ModulePtr			_syncManager;
+		GraphicsModuleIDs	_gpuIDs;
+
+		FrameSlots_t		_slots;				// indexed by 'cmdIndex' from command buffer manager
+		Callback_t			_onFrameReady;
+
+		const uint2					_size;
+		const EPixelFormat::type	_colorFmt;
+		const EPixelFormat::type	_depthFmt;
+		BytesU						_rowPitch;
+
+		ulong				_frameCounter;		// number of submitted frames
+
+		// statistic
+		TimeProfilerD		_timer;
+		const TimeD			_statInterval;
+		ulong				_intervalFrames;
+		BytesU				_intervalBytes;
+		Statistic_t			_stat;
+
+
+	// methods
+	public:
+		OffscreenSurface (UntypedID_t, GlobalSystemsRef gs, const CreateInfo::OffscreenSurface &ci);
+		~OffscreenSurface ();
+
+
+	// message handlers
+	private:
+		bool _Link (const ModuleMsg::Link &);
+		bool _Delete (const ModuleMsg::Delete &);
+		bool _Update (const ModuleMsg::Update &);
+		bool _SurfaceGetDescription (const SceneMsg::SurfaceGetDescription &);
+		bool _OffscreenSurfaceGetStatistic (const SceneMsg::OffscreenSurfaceGetStatistic &);
+
+		// event handlers
+		bool _DeviceBeforeDestroy (const GpuMsg::DeviceBeforeDestroy &);
+		bool _AfterCompose (const ModuleMsg::AfterCompose &);
+
+	private:
+		bool _CreateSlot (OUT FrameSlot &slot) const;
+		bool _RecordReadback (const FrameSlot &slot) const;
+		void _ReadFrame (uint index);
+		void _FlushPendingFrames ();
+		void _UpdateStatistic (BytesU size);
+		void _DestroySlots ();
+	};
+//-----------------------------------------------------------------------------
+
+
+
+	const TypeIdList	OffscreenSurface::_eventTypes{ UninitializedT< SupportedEvents_t >() };
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	OffscreenSurface::OffscreenSurface (UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::OffscreenSurface &ci) :
+		BaseSceneModule( gs, ModuleConfig{ id, UMax }, &_eventTypes ),
+		_onFrameReady{ ci.onFrameReady },
+		_size{ Max( ci.size, uint2(1) ) },	_colorFmt{ ci.colorFmt },		_depthFmt{ ci.depthFmt },
+		_frameCounter{ 0 },					_statInterval{ ci.statInterval },
+		_intervalFrames{ 0 }
+	{
+		SetDebugName( "Scene.OffscreenSurface" );
+
+		_SubscribeOnMsg( this, &OffscreenSurface::_OnModuleAttached_Impl );
+		_SubscribeOnMsg( this, &OffscreenSurface::_OnModuleDetached_Impl );
+		_SubscribeOnMsg( this, &OffscreenSurface::_AttachModule_Impl );
+		_SubscribeOnMsg( this, &OffscreenSurface::_DetachModule_Impl );
+		_SubscribeOnMsg( this, &OffscreenSurface::_FindModule_Impl );
+		_SubscribeOnMsg( this, &OffscreenSurface::_ModulesDeepSearch_Impl );
+		_SubscribeOnMsg( this, &OffscreenSurface::_Link );
+		_SubscribeOnMsg( this, &OffscreenSurface::_Delete );
+		_SubscribeOnMsg( this, &OffscreenSurface::_Update );
+		_SubscribeOnMsg( this, &OffscreenSurface::_SurfaceGetDescription );
+		_SubscribeOnMsg( this, &OffscreenSurface::_OffscreenSurfaceGetStatistic );
+		_SubscribeOnMsg( this, &OffscreenSurface::_OnManagerChanged );
+		_SubscribeOnMsg( this, &OffscreenSurface::_GetScenePrivateClasses );
+
+		ASSERT( _ValidateMsgSubscriptions< SupportedMessages_t >() );
+
+		CHECK( not EPixelFormat::IsCompressed( _colorFmt ) );
+
+		_rowPitch = BytesU(_size.x * EPixelFormat::BitPerPixel( _colorFmt ).ToBytes());
+
+		_AttachSelfToManager( ci.scene, SceneRendererModuleID, true );
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	OffscreenSurface::~OffscreenSurface ()
+	{
+		ASSERT( _slots.Empty() );
+	}
+
+/*
+=================================================
+	_Link
+=================================================
+*/
+	bool OffscreenSurface::_Link (const ModuleMsg::Link &msg)
+	{
+		if ( _IsComposedOrLinkedState( GetState() ) )
+			return true;	// already linked
+
+		CHECK_ERR( _IsInitialState( GetState() ) );
+		CHECK_ERR( _GetManager() );
+
+		_SendForEachAttachments( msg );
+
+		CHECK_ATTACHMENT( _thread = PlatformTools::GPUThreadHelper::FindGraphicsThread( GlobalSystems() ) );
+
+		_thread->Subscribe( this, &OffscreenSurface::_DeviceBeforeDestroy );
+		_GetManager()->Subscribe( this, &OffscreenSurface::_AfterCompose );
+
+		_builder = _GetManager()->GetModuleByMsg< CmdBufferMngrMsgList_t >();
+		CHECK_ERR( _builder );
+
+		CHECK( _SetState( EState::Linked ) );
+
+		_SendUncheckedEvent( ModuleMsg::AfterLink{} );
+		return true;
+	}
+
+/*
+=================================================
+	_AfterCompose
+=================================================
+*/
+	bool OffscreenSurface::_AfterCompose (const ModuleMsg::AfterCompose &)
+	{
+		GpuMsg::GetGraphicsModules	req_ids;
+		GpuMsg::GetDeviceInfo		req_dev;
+
+		CHECK( _thread->Send( req_ids ) );
+		CHECK( _thread->Send( req_dev ) );
+
+		_gpuIDs			= req_ids.result->graphics;
+		_syncManager	= req_dev.result->syncManager;
+
+		CHECK_ERR( _DefCompose( false ) );
+
+		_timer.Start();
+
+		_SendEvent( SceneMsg::SurfaceOnResize{ _size });
+		return true;
+	}
+
+/*
+=================================================
+	_Update
+----
+	frame N renders into slot with index 'cmdIndex',
+	this slot will be read back when command buffer manager
+	reuses 'cmdIndex', so the fence is already signaled
+	and the render thread is not blocked by readback.
+=================================================
+*/
+	bool OffscreenSurface::_Update (const ModuleMsg::Update &msg)
+	{
+		if ( not _IsComposedState( GetState() ) )
+			return false;
+
+		// update dependencies
+		Module::_Update_Impl( msg );
+
+		GraphicsMsg::CmdBeginFrame	begin_frame{ true };
+		CHECK_ERR( _builder->Send( begin_frame ) );
+
+		const uint	index = begin_frame.result->cmdIndex;
+
+		if ( index >= _slots.Count() )
+			_slots.Resize( index+1 );
+
+		FrameSlot&	slot = _slots[index];
+
+		ASSERT( not slot.pending );
+
+		if ( not slot.framebuffer )
+			CHECK_ERR( _CreateSlot( OUT slot ) );
+
+		SceneMsg::SurfaceRequestUpdate	req_upd;
+		req_upd.framebuffers.PushBack({ slot.framebuffer, float4x4(), float4x4(), 0 });
+		req_upd.cmdBuilder = _builder;
+
+		CHECK( _SendEvent( req_upd ) );
+
+		CHECK( _RecordReadback( slot ) );
+
+		slot.frameId	= _frameCounter++;
+		slot.pending	= true;
+
+		// keep module alive until frame completed
+		ModulePtr	self	= this;
+		auto		on_completed = LAMBDA( self, index ) (uint)
+								{
+									self.ToPtr< OffscreenSurface >()->_ReadFrame( index );
+								};
+		CHECK( _builder->Send( GraphicsMsg::SubscribeOnFrameCompleted{ RVREF(on_completed) }) );
+
+		CHECK( _builder->Send( GraphicsMsg::CmdEndFrame{} ) );
+		return true;
+	}
+
+/*
+=================================================
+	_RecordReadback
+=================================================
+*/
+	bool OffscreenSurface::_RecordReadback (const FrameSlot &slot) const
+	{
+		const BytesU	buf_size = _rowPitch * _size.y;
+
+		CHECK_ERR( _builder->Send( GraphicsMsg::CmdBegin{} ) );
+
+		_builder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::ColorAttachmentOutput, EPipelineStage::Transfer }
+							.AddImage({	slot.colorImage,
+										EPipelineAccess::ColorAttachmentWrite,
+										EPipelineAccess::TransferRead,
+										EImageLayout::ColorAttachmentOptimal,
+										EImageLayout::TransferSrcOptimal,
+										EImageAspect::Color }) );
+
+		_builder->Send( GpuMsg::CmdCopyImageToBuffer{ slot.colorImage, EImageLayout::TransferSrcOptimal, slot.stagingBuffer }
+							.AddRegion( 0_b, _size.x, _size.y,
+										GpuMsg::ImageRange{ EImageAspect::Color, 0_mipmap, 0_layer, 1 },
+										uint3(0),
+										uint3(_size, 1) ));
+
+		_builder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::Transfer, EPipelineStage::Host }
+							.AddBuffer({ slot.stagingBuffer,
+										 EPipelineAccess::TransferWrite,
+										 EPipelineAccess::HostRead,
+										 0_b, buf_size })
+							.AddImage({	slot.colorImage,
+										EPipelineAccess::TransferRead,
+										EPipelineAccess::ColorAttachmentWrite,
+										EImageLayout::TransferSrcOptimal,
+										EImageLayout::ColorAttachmentOptimal,
+										EImageAspect::Color }) );
+
+		CHECK_ERR( _builder->Send( GraphicsMsg::CmdEnd{} ) );
+		return true;
+	}
+
+/*
+=================================================
+	_ReadFrame
+=================================================
+*/
+	void OffscreenSurface::_ReadFrame (uint index)
+	{
+		if ( index >= _slots.Count() or not _slots[index].pending )
+			return;
+
+		FrameSlot&		slot		= _slots[index];
+		const BytesU	buf_size	= _rowPitch * _size.y;
+		BinArrayCRef	pixels		= slot.mapped;
+
+		slot.pending = false;
+
+		if ( pixels.Empty() )
+		{
+			slot.readCache.Resize( usize(buf_size), false );
+
+			GpuMsg::ReadFromGpuMemory	read_cmd{ slot.readCache };
+			CHECK( slot.stagingBuffer->Send( read_cmd ) );
+
+			pixels = *read_cmd.result;
+		}
+
+		CHECK( pixels.Size() >= buf_size );
+
+		if ( _onFrameReady )
+		{
+			_onFrameReady( Frame_t{ pixels.SubArray( 0, usize(buf_size) ), _size, _rowPitch, _colorFmt, slot.frameId });
+		}
+
+		_UpdateStatistic( buf_size );
+	}
+
+/*
+=================================================
+	_FlushPendingFrames
+----
+	frames in flight are read in submission order
+	after device became idle.
+=================================================
+*/
+	void OffscreenSurface::_FlushPendingFrames ()
+	{
+		bool	has_pending = false;
+
+		for (auto& slot : _slots) {
+			has_pending |= slot.pending;
+		}
+
+		if ( not has_pending or not _syncManager )
+			return;
+
+		CHECK( _syncManager->Send( GpuMsg::ClientWaitDeviceIdle{} ) );
+
+		for (;;)
+		{
+			uint	index	= UMax;
+			ulong	min_id	= UMax;
+
+			FOR( i, _slots )
+			{
+				if ( _slots[i].pending and _slots[i].frameId < min_id ) {
+					min_id	= _slots[i].frameId;
+					index	= uint(i);
+				}
+			}
+
+			if ( index == UMax )
+				break;
+
+			_ReadFrame( index );
+		}
+	}
+
+/*
+=================================================
+	_UpdateStatistic
+=================================================
+*/
+	void OffscreenSurface::_UpdateStatistic (BytesU size)
+	{
+		++_stat.framesRead;
+		_stat.bytesRead += size;
+
+		++_intervalFrames;
+		_intervalBytes += size;
+
+		const double	dt = _timer.GetTimeDelta().Seconds();
+
+		if ( dt > _statInterval.Seconds() )
+		{
+			_stat.framesPerSecond		= double(_intervalFrames) / dt;
+			_stat.megabytesPerSecond	= _intervalBytes.Mb<double>() / dt;
+
+			LOG( "offscreen readback: "_str << _stat.framesPerSecond << " fps, " << _stat.megabytesPerSecond << " Mb/s", ELog::Debug );
+
+			_intervalFrames	= 0;
+			_intervalBytes	= 0_b;
+			_timer.Start();
+		}
+	}
+
+/*
+=================================================
+	_CreateSlot
+=================================================
+*/
+	bool OffscreenSurface::_CreateSlot (OUT FrameSlot &slot) const
+	{
+		auto	factory = GlobalSystems()->modulesFactory;
+
+		CHECK_ERR( factory->Create(
+						_gpuIDs.framebuffer,
+						GlobalSystems(),
+						CreateInfo::GpuFramebuffer{ _size },
+						OUT slot.framebuffer ) );
+
+		// create color target
+		CHECK_ERR( factory->Create(
+						_gpuIDs.image,
+						GlobalSystems(),
+						CreateInfo::GpuImage{
+							ImageDescription{
+								EImage::Tex2D,
+								uint4( _size, 0, 0 ),
+								_colorFmt,
+								EImageUsage::ColorAttachment | EImageUsage::TransferSrc
+							},
+							EGpuMemory::LocalInGPU,
+							EMemoryAccess::GpuReadWrite
+						},
+						OUT slot.colorImage ) );
+
+		slot.framebuffer->Send( GpuMsg::FramebufferAttachImage{ "Color0", slot.colorImage });
+
+		// create depth-stencil target
+		if ( _depthFmt != EPixelFormat::Unknown )
+		{
+			CHECK_ERR( factory->Create(
+							_gpuIDs.image,
+							GlobalSystems(),
+							CreateInfo::GpuImage{
+								ImageDescription{
+									EImage::Tex2D,
+									uint4( _size, 0, 0 ),
+									_depthFmt,
+									EImageUsage::DepthStencilAttachment
+								},
+								EGpuMemory::LocalInGPU,
+								EMemoryAccess::GpuReadWrite
+							},
+							OUT slot.depthImage ) );
+
+			slot.framebuffer->Send( GpuMsg::FramebufferAttachImage{ "Depth", slot.depthImage });
+		}
+
+		// create staging buffer
+		CHECK_ERR( factory->Create(
+						_gpuIDs.buffer,
+						GlobalSystems(),
+						CreateInfo::GpuBuffer{
+							BufferDescription{ _rowPitch * _size.y, EBufferUsage::TransferDst },
+							EGpuMemory::CoherentWithCPU,
+							EMemoryAccess::bits() | EMemoryAccess::CpuRead | EMemoryAccess::GpuWrite
+						},
+						OUT slot.stagingBuffer ) );
+
+		ModuleUtils::Initialize({ slot.framebuffer, slot.stagingBuffer });
+
+		// map memory once, some backends doesn't support persistent mapping
+		GpuMsg::MapMemoryToCpu	map_cmd{ GpuMsg::EMappingFlags::Read };
+
+		if ( slot.stagingBuffer->Send( map_cmd ) and map_cmd.result.IsDefined() )
+			slot.mapped = *map_cmd.result;
+
+		return true;
+	}
+
+/*
+=================================================
+	_DestroySlots
+=================================================
+*/
+	void OffscreenSurface::_DestroySlots ()
+	{
+		for (auto& slot : _slots)
+		{
+			if ( not slot.mapped.Empty() )
+				slot.stagingBuffer->Send( GpuMsg::UnmapMemory{} );
+
+			ModuleUtils::Send({ slot.framebuffer, slot.colorImage, slot.depthImage, slot.stagingBuffer }, ModuleMsg::Delete{} );
+		}
+		_slots.Clear();
+	}
+
+/*
+=================================================
+	_Delete
+=================================================
+*/
+	bool OffscreenSurface::_Delete (const ModuleMsg::Delete &msg)
+	{
+		_FlushPendingFrames();
+		_DestroySlots();
+
+		// release callback resources, for example video encoder
+		_onFrameReady = Callback_t();
+
+		if ( _stat.framesRead > 0 )
+		{
+			LOG( "offscreen surface: read "_str << _stat.framesRead << " frames, " << ToString( _stat.bytesRead ), ELog::Info );
+		}
+
+		if ( _thread ) {
+			_thread->UnsubscribeAll( this );
+		}
+
+		_thread			= null;
+		_builder		= null;
+		_syncManager	= null;
+
+		return Module::_Delete_Impl( msg );
+	}
+
+/*
+=================================================
+	_SurfaceGetDescription
+=================================================
+*/
+	bool OffscreenSurface::_SurfaceGetDescription (const SceneMsg::SurfaceGetDescription &msg)
+	{
+		msg.result.Set({ _size, _colorFmt, _depthFmt });
+		return true;
+	}
+
+/*
+=================================================
+	_OffscreenSurfaceGetStatistic
+=================================================
+*/
+	bool OffscreenSurface::_OffscreenSurfaceGetStatistic (const SceneMsg::OffscreenSurfaceGetStatistic &msg)
+	{
+		msg.result.Set( _stat );
+		return true;
+	}
+
+/*
+=================================================
+	_DeviceBeforeDestroy
+=================================================
+*/
+	bool OffscreenSurface::_DeviceBeforeDestroy (const GpuMsg::DeviceBeforeDestroy &)
+	{
+		Send( ModuleMsg::Delete{} );
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	CreateOffscreenSurface
+=================================================
+*/
+	ModulePtr  SceneObjectConstructor::CreateOffscreenSurface (ModuleMsg::UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::OffscreenSurface &ci)
+	{
+		return New< OffscreenSurface >( id, gs, ci );
+	}
+
+}	// Scene
+}	// Engine
@@ -0,0 +1,515 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "Engine/Scene/Public/Surface.h"
+#include "Engine/Scene/Impl/SceneObjectConstructor.h"
+#include "Core/STL/Compression/LZ4Compression.h"
+#include "Core/STL/Compression/MiniZCompression.h"
+
+namespace Engine
+{
+namespace Scene
+{
+	using namespace Engine::Platforms;
+
+	using EVideoFormat	= CreateInfo::VideoRecorderSurface::EFormat;
+	using EQueuePolicy	= CreateInfo::VideoRecorderSurface::EQueuePolicy;
+
+
+	//
+	// Video Writer interface
+	//
+
+	class IVideoWriter
+	{
+	public:
+		virtual ~IVideoWriter () {}
+
+		virtual bool Begin (const uint2 &size) = 0;
+		virtual bool WriteFrame (BinArrayCRef rgba8, const uint2 &size, ulong frameId) = 0;
+		virtual void End () = 0;
+	};
+
+	using VideoWriterPtr = UniquePtr< IVideoWriter >;
+
+
+
+	//
+	// YUV4MPEG2 Writer
+	//
+
+	class Y4MVideoWriter final : public IVideoWriter
+	{
+	private:
+		GXFile::WFilePtr	_file;
+		BinaryArray			_planes;
+		const String		_path;
+		const uint			_frameRate;
+
+	public:
+		Y4MVideoWriter (StringCRef path, uint frameRate) : _path{path}, _frameRate{frameRate} {}
+
+		bool Begin (const uint2 &size) override
+		{
+			_file = GXFile::HddWFile::New( _path );
+			CHECK_ERR( _file );
+
+			String	header;
+			header << "YUV4MPEG2 W" << size.x << " H" << size.y << " F" << _frameRate << ":1 Ip A1:1 C444 XCOLORRANGE=FULL\n";
+
+			_planes.Resize( size.Area() * 3, false );
+			return _file->Write( StringCRef(header) );
+		}
+
+		bool WriteFrame (BinArrayCRef rgba8, const uint2 &size, ulong) override
+		{
+			CHECK_ERR( _file );
+
+			const usize	count	= size.Area();
+			ubyte *		y_plane	= _planes.ptr();
+			ubyte *		u_plane	= y_plane + count;
+			ubyte *		v_plane	= u_plane + count;
+
+			CHECK_ERR( rgba8.Size() >= BytesU(count * 4) );
+
+			// BT.601 full range, integer approximation
+			for (usize i = 0; i < count; ++i)
+			{
+				const int	r = rgba8[i*4 + 0];
+				const int	g = rgba8[i*4 + 1];
+				const int	b = rgba8[i*4 + 2];
+
+				y_plane[i] = ubyte( ((  77 * r + 150 * g +  29 * b + 128) >> 8) );
+				u_plane[i] = ubyte( (( -43 * r -  85 * g + 128 * b + 128) >> 8) + 128 );
+				v_plane[i] = ubyte( (( 128 * r - 107 * g -  21 * b + 128) >> 8) + 128 );
+			}
+
+			CHECK_ERR( _file->Write( StringCRef("FRAME\n") ) );
+			return _file->Write( _planes.ptr(), BytesU(count * 3) ) == BytesU(count * 3);
+		}
+
+		void End () override
+		{
+			_file = null;
+		}
+	};
+
+
+
+	//
+	// Raw Compressed Writer
+	//
+
+	class RawCompressedWriter final : public IVideoWriter
+	{
+	// types
+	private:
+	#if defined( GX_ENABLE_LZ4 )
+		using Compressor_t	= GXCompression::LZ4Compressor;
+		static constexpr uint	MAGIC	= 'G' | ('X' << 8) | ('L' << 16) | ('4' << 24);
+	#elif defined( GX_ENABLE_MINIZ )
+		using Compressor_t	= GXCompression::MiniZCompressor;
+		static constexpr uint	MAGIC	= 'G' | ('X' << 8) | ('M' << 16) | ('Z' << 24);
+	#endif
+
+		struct FileHeader
+		{
+			uint	magic;
+			uint	width;
+			uint	height;
+			uint	frameRate;
+		};
+
+		struct FrameHeader
+		{
+			ulong	frameId;
+			uint	compressedSize;
+			uint	uncompressedSize;
+		};
+
+	// variables
+	private:
+		GXFile::WFilePtr	_file;
+		BinaryArray			_buffer;
+		const String		_path;
+		const uint			_frameRate;
+
+	// methods
+	public:
+		RawCompressedWriter (StringCRef path, uint frameRate) : _path{path}, _frameRate{frameRate} {}
+
+		bool Begin (const uint2 &size) override
+		{
+		#if defined( GX_ENABLE_LZ4 ) or defined( GX_ENABLE_MINIZ )
+			_file = GXFile::HddWFile::New( _path );
+			CHECK_ERR( _file );
+
+			_buffer.Resize( usize(Compressor_t().GetPrefferedSize( BytesU(size.Area() * 4) )), false );
+
+			FileHeader	header{ MAGIC, size.x, size.y, _frameRate };
+			return _file->Write( header );
+		#else
+			RETURN_ERR( "compression is not supported" );
+		#endif
+		}
+
+		bool WriteFrame (BinArrayCRef rgba8, const uint2 &, ulong frameId) override
+		{
+		#if defined( GX_ENABLE_LZ4 ) or defined( GX_ENABLE_MINIZ )
+			CHECK_ERR( _file );
+
+			BinArrayRef		dst = _buffer;
+			CHECK_ERR( Compressor_t().Compress( rgba8, INOUT dst ) );
+
+			FrameHeader		header{ frameId, uint(dst.Size()), uint(rgba8.Size()) };
+
+			CHECK_ERR( _file->Write( header ) );
+			return _file->Write( dst.RawPtr(), dst.Size() ) == dst.Size();
+		#else
+			return false;
+		#endif
+		}
+
+		void End () override
+		{
+			_file = null;
+		}
+	};
+
+
+
+	//
+	// PNG Sequence Writer
+	//
+
+	class PngSequenceWriter final : public IVideoWriter
+	{
+	private:
+		const String	_path;
+
+	public:
+		explicit PngSequenceWriter (StringCRef path) : _path{path} {}
+
+		bool Begin (const uint2 &) override
+		{
+		#ifdef GX_ENABLE_MINIZ
+			return true;
+		#else
+			RETURN_ERR( "PNG encoding requires MiniZ" );
+		#endif
+		}
+
+		bool WriteFrame (BinArrayCRef rgba8, const uint2 &size, ulong frameId) override
+		{
+		#ifdef GX_ENABLE_MINIZ
+			size_t	png_size	= 0;
+			void *	png_data	= tdefl_write_image_to_png_file_in_memory_ex( rgba8.RawPtr(), int(size.x), int(size.y), 4, OUT &png_size,
+																			  MZ_BEST_SPEED, MZ_FALSE );
+			CHECK_ERR( png_data != null );
+
+			const String		fname	= String(_path) << '_' << String().FormatAlignedI( frameId, 6, '0' ) << ".png";
+			GXFile::WFilePtr	file	= GXFile::HddWFile::New( fname );
+			bool				res		= file and file->Write( png_data, BytesU(png_size) ) == BytesU(png_size);
+
+			mz_free( png_data );
+			CHECK_ERR( res );
+			return true;
+		#else
+			return false;
+		#endif
+		}
+
+		void End () override {}
+	};
+//-----------------------------------------------------------------------------
+
+
+
+	//
+	// Video Encoder
+	//
+
+	class VideoEncoder final : public RefCountedObject<>
+	{
+	// types
+	private:
+		struct FrameData
+		{
+			BinaryArray		pixels;
+			ulong			frameId	= 0;
+		};
+
+		using FrameQueue_t	= CircularQueue< FrameData >;
+		using FreeBuffers_t	= Array< BinaryArray >;
+
+	// variables
+	private:
+		OS::Mutex				_lock;
+		OS::ConditionVariable	_notEmpty;
+		OS::ConditionVariable	_notFull;
+		FrameQueue_t			_queue;			// frames waiting for encoder
+		FreeBuffers_t			_freeBuffers;	// to avoid allocation per frame
+		OS::Thread				_thread;
+		VideoWriterPtr			_writer;
+
+		const uint2				_size;
+		const EQueuePolicy		_policy;
+		const uint				_maxQueueLength;
+		bool					_looping		= false;
+
+		ulong					_captured		= 0;
+		ulong					_dropped		= 0;
+		ulong					_encoded		= 0;
+		ulong					_encodeFailed	= 0;
+
+
+	// methods
+	public:
+		VideoEncoder (const CreateInfo::VideoRecorderSurface &ci);
+		~VideoEncoder ();
+
+		bool Start ();
+		void Enqueue (const CreateInfo::OffscreenSurface::Frame &frame);
+
+	private:
+		void _Loop ();
+		void _Stop ();
+
+		static void _ThreadProc (void *param);
+	};
+
+	SHARED_POINTER( VideoEncoder );
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	VideoEncoder::VideoEncoder (const CreateInfo::VideoRecorderSurface &ci) :
+		_size{ ci.size },				_policy{ ci.policy },
+		_maxQueueLength{ Max( ci.queueLength, 1u ) }
+	{
+		switch ( ci.format )
+		{
+			case EVideoFormat::Y4M :			_writer.Reset( new Y4MVideoWriter( ci.path, ci.frameRate ) );		break;
+			case EVideoFormat::RawCompressed :	_writer.Reset( new RawCompressedWriter( ci.path, ci.frameRate ) );	break;
+			case EVideoFormat::PNGSequence :	_writer.Reset( new PngSequenceWriter( ci.path ) );					break;
+			default :							WARNING( "unknown video format" );
+		}
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VideoEncoder::~VideoEncoder ()
+	{
+		_Stop();
+
+		LOG( "Video recorder: captured "_str << _captured << " frames, encoded " << _encoded
+			 << ", dropped " << _dropped << ", failed " << _encodeFailed, ELog::Info );
+	}
+
+/*
+=================================================
+	Start
+=================================================
+*/
+	bool VideoEncoder::Start ()
+	{
+		CHECK_ERR( _writer );
+		CHECK_ERR( not _looping );
+		CHECK_ERR( _writer->Begin( _size ) );
+
+		_looping = true;
+
+		CHECK_ERR( _thread.Create( &_ThreadProc, this ) );
+		return true;
+	}
+
+/*
+=================================================
+	_Stop
+----
+	encodes all queued frames and waits for thread
+=================================================
+*/
+	void VideoEncoder::_Stop ()
+	{
+		{
+			SCOPELOCK( _lock );
+
+			if ( not _looping )
+				return;
+
+			_looping = false;
+		}
+
+		_notEmpty.Broadcast();
+		_notFull.Broadcast();
+
+		_thread.Wait();
+		_writer->End();
+	}
+
+/*
+=================================================
+	Enqueue
+----
+	called from render thread,
+	pixels are copied outside of lock to minimize contention.
+=================================================
+*/
+	void VideoEncoder::Enqueue (const CreateInfo::OffscreenSurface::Frame &frame)
+	{
+		CHECK_ERR( All( frame.size == _size ), void() );
+		CHECK_ERR( frame.format == EPixelFormat::RGBA8_UNorm, void() );
+
+		FrameData	data;
+		data.frameId = frame.frameId;
+
+		// acquire buffer
+		{
+			SCOPELOCK( _lock );
+
+			if ( not _looping )
+				return;
+
+			++_captured;
+
+			if ( _queue.Count() >= _maxQueueLength )
+			{
+				switch ( _policy )
+				{
+					case EQueuePolicy::Block :
+						while ( _looping and _queue.Count() >= _maxQueueLength ) {
+							_notFull.Wait( _lock );
+						}
+						break;
+
+					case EQueuePolicy::DropNewest :
+						++_dropped;
+						return;
+
+					case EQueuePolicy::DropOldest :
+						_freeBuffers.PushBack( RVREF(_queue.Front().pixels) );
+						_queue.PopFront();
+						++_dropped;
+						break;
+				}
+			}
+
+			if ( not _freeBuffers.Empty() )
+			{
+				data.pixels = RVREF(_freeBuffers.Back());
+				_freeBuffers.PopBack();
+			}
+		}
+
+		// copy pixels with tight packing
+		const BytesU	row_size	= BytesU(_size.x * 4);
+
+		data.pixels.Resize( usize(row_size * _size.y), false );
+
+		for (uint y = 0; y < _size.y; ++y)
+		{
+			MemCopy( data.pixels.SubArray( usize(row_size * y), usize(row_size) ),
+					 frame.pixels.SubArray( usize(frame.rowPitch * y), usize(row_size) ) );
+		}
+
+		// push to queue
+		{
+			SCOPELOCK( _lock );
+
+			if ( not _looping )
+				return;
+
+			_queue.PushBack( RVREF(data) );
+		}
+		_notEmpty.Signal();
+	}
+
+/*
+=================================================
+	_Loop
+=================================================
+*/
+	void VideoEncoder::_Loop ()
+	{
+		FrameData	data;
+
+		for (;;)
+		{
+			// get next frame
+			{
+				SCOPELOCK( _lock );
+
+				if ( not data.pixels.Empty() )
+					_freeBuffers.PushBack( RVREF(data.pixels) );
+
+				while ( _looping and _queue.Empty() ) {
+					_notEmpty.Wait( _lock );
+				}
+
+				// queue is drained on exit
+				if ( _queue.Empty() )
+					break;
+
+				data = RVREF(_queue.Front());
+				_queue.PopFront();
+			}
+			_notFull.Signal();
+
+			// encode without lock
+			const bool	res = _writer->WriteFrame( data.pixels, _size, data.frameId );
+
+			SCOPELOCK( _lock );
+			(res ? _encoded : _encodeFailed)++;
+		}
+	}
+
+/*
+=================================================
+	_ThreadProc
+=================================================
+*/
+	void VideoEncoder::_ThreadProc (void *param)
+	{
+		Cast<VideoEncoder *>(param)->_Loop();
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	CreateVideoRecorderSurface
+----
+	frames are read back by offscreen surface and passed
+	to encoder thread, render thread never waits for encoding
+	except when 'EQueuePolicy::Block' is used.
+=================================================
+*/
+	ModulePtr  SceneObjectConstructor::CreateVideoRecorderSurface (ModuleMsg::UntypedID_t id, GlobalSystemsRef gs, const CreateInfo::VideoRecorderSurface &ci)
+	{
+		CHECK_ERR( not ci.path.Empty() );
+		CHECK_ERR( All( ci.size > uint2(0) ) );
+
+		VideoEncoderPtr		encoder{ new VideoEncoder( ci ) };
+		CHECK_ERR( encoder->Start() );
+
+		CreateInfo::OffscreenSurface	offscreen_ci;
+		offscreen_ci.scene			= ci.scene;
+		offscreen_ci.size			= ci.size;
+		offscreen_ci.colorFmt		= EPixelFormat::RGBA8_UNorm;
+		offscreen_ci.depthFmt		= ci.depthFmt;
+		offscreen_ci.onFrameReady	= LAMBDA( encoder ) (const CreateInfo::OffscreenSurface::Frame &frame)
+									  {
+										  encoder->Enqueue( frame );
+									  };
+
+		return CreateOffscreenSurface( id, gs, offscreen_ci );
+	}
+
+}	// Scene
+}	// Engine
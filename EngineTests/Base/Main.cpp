@@ -5,6 +5,13 @@
 extern void Test_Window ();
 extern void Test_GWindow ();
 extern void Test_CWindow ();
+extern void Test_ModuleGraph ();
+extern void Test_ModuleAllocator ();
+extern void Test_JobGraph ();
+extern void Test_AsyncMessage ();
+extern void Test_GpuMemoryAllocator ();
+extern void Test_CpuProfiler ();
+extern void Test_MessageStatistic ();
 
 
 int main ()
@@ -14,6 +21,13 @@ int main ()
 	//Test_Window();
 	Test_GWindow();
 	//Test_CWindow();
+	Test_ModuleGraph();
+	Test_ModuleAllocator();
+	Test_JobGraph();
+	Test_AsyncMessage();
+	Test_GpuMemoryAllocator();
+	Test_CpuProfiler();
+	Test_MessageStatistic();
 
 	return 0;
 }
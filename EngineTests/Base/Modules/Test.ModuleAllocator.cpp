@@ -0,0 +1,176 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "../Common.h"
+#include "Engine/Base/Modules/ModuleRegistry.h"
+
+
+static constexpr OModID::type	TransientModuleID	= "transient"_OModID;
+
+
+//
+// Transient Module
+//
+
+class TransientModule final : public Module
+{
+// types
+private:
+	using SupportedEvents_t		= Module::SupportedEvents_t;
+
+
+// constants
+private:
+	static const TypeIdList		_eventTypes;
+
+
+// variables
+private:
+	StaticArray< ubyte, 256 >	_data;
+
+
+// methods
+public:
+	TransientModule (UntypedID_t id, GlobalSystemsRef gs) :
+		Module( gs, ModuleConfig{ id, 1 }, &_eventTypes )
+	{
+		_SubscribeOnMsg( this, &TransientModule::_OnModuleAttached_Impl );
+		_SubscribeOnMsg( this, &TransientModule::_OnModuleDetached_Impl );
+		_SubscribeOnMsg( this, &TransientModule::_AttachModule_Empty );
+		_SubscribeOnMsg( this, &TransientModule::_DetachModule_Empty );
+		_SubscribeOnMsg( this, &TransientModule::_OnManagerChanged_Empty );
+		_SubscribeOnMsg( this, &TransientModule::_FindModule_Impl );
+		_SubscribeOnMsg( this, &TransientModule::_ModulesDeepSearch_Impl );
+		_SubscribeOnMsg( this, &TransientModule::_Link_Empty );
+		_SubscribeOnMsg( this, &TransientModule::_Compose_Empty );
+		_SubscribeOnMsg( this, &TransientModule::_Update_Empty );
+		_SubscribeOnMsg( this, &TransientModule::_Delete_Impl );
+	}
+};
+
+const TypeIdList	TransientModule::_eventTypes{ UninitializedT< SupportedEvents_t >() };
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	GetTypeStatistics
+=================================================
+*/
+static ModuleRegistry::TypeStatistics  GetTypeStatistics (ModuleMsg::UntypedID_t id)
+{
+	ModuleRegistry::Statistics_t	stats;
+	ModuleRegistry::Instance().GetStatistics( OUT stats );
+
+	for (auto& st : stats) {
+		if ( st.id == id )
+			return st;
+	}
+	return {};
+}
+
+/*
+=================================================
+	GetSlabCount
+=================================================
+*/
+static usize  GetSlabCount ()
+{
+	ModuleAllocator::Statistics_t	stats;
+	ModuleAllocator::Instance().GetStatistics( OUT stats );
+
+	usize	count = 0;
+	for (auto& st : stats) {
+		count += st.slabs;
+	}
+	return count;
+}
+
+/*
+=================================================
+	TestRecycling
+=================================================
+*/
+static void TestRecycling ()
+{
+	auto&	alloc	= ModuleAllocator::Instance();
+
+	void*	ptr0	= alloc.Allocate( 100 );
+	void*	ptr1	= alloc.Allocate( 120 );	// same size class
+	CHECK( ptr0 != null and ptr1 != null and ptr0 != ptr1 );
+
+	alloc.Deallocate( ptr1, 120 );
+	void*	ptr2	= alloc.Allocate( 128 );
+	CHECK( ptr2 == ptr1 );
+
+	alloc.Deallocate( ptr0, 100 );
+	alloc.Deallocate( ptr2, 128 );
+
+	// large allocation
+	const usize	heap_blocks	= alloc.HeapBlockCount();
+	void*		large		= alloc.Allocate( 1 << 20 );
+
+	CHECK( alloc.HeapBlockCount() == heap_blocks + 1 );
+	alloc.Deallocate( large, 1 << 20 );
+	CHECK( alloc.HeapBlockCount() == heap_blocks );
+}
+
+/*
+=================================================
+	Test_ModuleAllocator
+----
+	creates and destroys a lot of transient modules per frame,
+	after first frame memory must be recycled.
+=================================================
+*/
+extern void Test_ModuleAllocator ()
+{
+	static const uint	num_frames	= 20;
+	static const uint	num_modules	= 1000;
+
+	auto			ms		= GetMainSystemInstance();
+	auto			gs		= ms->GlobalSystems();
+	TimeProfilerD	timer;
+	TimeD			first_frame;
+	usize			slabs	= 0;
+
+	TestRecycling();
+
+	const auto	stat_before	= GetTypeStatistics( TransientModuleID );
+
+	Array< ModulePtr >	modules;
+	modules.Reserve( num_modules );
+
+	timer.Start();
+
+	for (uint frame = 0; frame < num_frames; ++frame)
+	{
+		for (uint i = 0; i < num_modules; ++i) {
+			modules.PushBack( New< TransientModule >( TransientModuleID, gs ) );
+		}
+
+		CHECK( GetTypeStatistics( TransientModuleID ).live == stat_before.live + num_modules );
+
+		modules.Clear();
+
+		if ( frame == 0 )
+		{
+			first_frame	= timer.GetTimeDelta();
+			slabs		= GetSlabCount();
+			timer.Start();
+		}
+	}
+
+	const TimeD	other_frames = timer.GetTimeDelta();
+
+	const auto	stat_after	= GetTypeStatistics( TransientModuleID );
+
+	CHECK( stat_after.live == stat_before.live );
+	CHECK( stat_after.created == stat_before.created + num_frames * num_modules );
+	CHECK( GetSlabCount() == slabs );	// all memory is recycled
+
+	LOG( "Transient modules, "_str << num_modules << " per frame:"
+		 << "\n  first frame:  " << ToString( first_frame )
+		 << "\n  other frames: " << ToString( TimeD::FromSeconds( other_frames.Seconds() / (num_frames-1) ) ) << " per frame", ELog::Info );
+
+	WARNING( "Module allocator test succeeded!" );
+}
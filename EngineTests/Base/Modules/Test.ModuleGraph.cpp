@@ -0,0 +1,163 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "../Common.h"
+
+
+namespace ModMsg = ModuleMsg;
+
+static constexpr OModID::type	BenchGroupModuleID	= "bench.grp"_OModID;
+static constexpr OModID::type	BenchLeafModuleID	= "bench.leaf"_OModID;
+
+
+//
+// Benchmark Module
+//
+
+class BenchModule final : public Module
+{
+// types
+private:
+	using SupportedEvents_t		= Module::SupportedEvents_t;
+
+
+// constants
+private:
+	static const TypeIdList		_eventTypes;
+
+
+// methods
+public:
+	BenchModule (UntypedID_t id, GlobalSystemsRef gs, bool isLeaf) :
+		Module( gs, ModuleConfig{ id, 1 }, &_eventTypes )
+	{
+		_SubscribeOnMsg( this, &BenchModule::_OnModuleAttached_Impl );
+		_SubscribeOnMsg( this, &BenchModule::_OnModuleDetached_Impl );
+		_SubscribeOnMsg( this, &BenchModule::_OnManagerChanged_Empty );
+		_SubscribeOnMsg( this, &BenchModule::_FindModule_Impl );
+		_SubscribeOnMsg( this, &BenchModule::_ModulesDeepSearch_Impl );
+		_SubscribeOnMsg( this, &BenchModule::_Delete_Impl );
+
+		if ( isLeaf )
+		{
+			_SubscribeOnMsg( this, &BenchModule::_AttachModule_Empty );
+			_SubscribeOnMsg( this, &BenchModule::_DetachModule_Empty );
+			_SubscribeOnMsg( this, &BenchModule::_Link_Empty );
+			_SubscribeOnMsg( this, &BenchModule::_Compose_Empty );
+			_SubscribeOnMsg( this, &BenchModule::_Update_Empty );
+		}
+		else
+		{
+			_SubscribeOnMsg( this, &BenchModule::_AttachModule_Impl );
+			_SubscribeOnMsg( this, &BenchModule::_DetachModule_Impl );
+			_SubscribeOnMsg( this, &BenchModule::_Link_Impl );
+			_SubscribeOnMsg( this, &BenchModule::_Compose_Impl );
+			_SubscribeOnMsg( this, &BenchModule::_Update_Impl );
+		}
+	}
+};
+
+const TypeIdList	BenchModule::_eventTypes{ UninitializedT< SupportedEvents_t >() };
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	Test_ModuleGraph
+----
+	builds graph: root -> 100 groups -> 100 leaves,
+	measures time of attachment, composing and lookups.
+=================================================
+*/
+extern void Test_ModuleGraph ()
+{
+	static const uint	num_groups	= 100;
+	static const uint	num_leaves	= 100;
+
+	auto			ms		= GetMainSystemInstance();
+	auto			gs		= ms->GlobalSystems();
+	TimeProfilerD	timer;
+	
+	Array< ModulePtr >	groups;
+	groups.Reserve( num_groups );
+
+	ModulePtr	root = New< BenchModule >( BenchGroupModuleID, gs, false );
+
+	// attach
+	timer.Start();
+
+	for (uint i = 0; i < num_groups; ++i)
+	{
+		ModulePtr	group = New< BenchModule >( BenchGroupModuleID, gs, false );
+
+		for (uint j = 0; j < num_leaves; ++j)
+		{
+			group->Send( ModMsg::AttachModule{ "leaf_"_str << j, New< BenchModule >( BenchLeafModuleID, gs, true ) });
+		}
+
+		root->Send( ModMsg::AttachModule{ "group_"_str << i, group });
+		groups.PushBack( group );
+	}
+
+	const TimeD	attach_time = timer.GetTimeDelta();
+
+	// link and compose
+	timer.Start();
+	CHECK( ModuleUtils::Initialize({ root }) );
+	const TimeD	compose_time = timer.GetTimeDelta();
+
+	// search by name
+	timer.Start();
+	for (uint i = 0; i < num_groups; ++i)
+	{
+		ModulePtr	group = root->GetModuleByName( "group_"_str << i );
+		CHECK( group == groups[i] );
+
+		for (uint j = 0; j < num_leaves; ++j) {
+			CHECK( group->GetModuleByName( "leaf_"_str << j ) );
+		}
+	}
+	const TimeD	by_name_time = timer.GetTimeDelta();
+
+	// search by ID and messages
+	timer.Start();
+	for (auto& group : groups)
+	{
+		for (uint j = 0; j < num_leaves; ++j) {
+			CHECK( group->GetModuleByID( BenchLeafModuleID ) );
+			CHECK( group->GetModuleByMsg< CompileTime::TypeListFrom< ModMsg::FindModule > >() );
+		}
+	}
+	const TimeD	by_id_time = timer.GetTimeDelta();
+
+	// deep search
+	timer.Start();
+
+	Array< ModulePtr >				found;
+	const ModuleMsg::UntypedID_t	leaf_id	= BenchLeafModuleID;
+	ModMsg::ModulesDeepSearch		search{ ArrayCRef<ModuleMsg::UntypedID_t>{ &leaf_id, 1 }, 0, 2 };
+	search.result = &found;
+
+	root->Send( search );
+	CHECK( found.Count() == num_groups * num_leaves );
+
+	const TimeD	deep_search_time = timer.GetTimeDelta();
+
+	// delete
+	timer.Start();
+	root->Send( ModMsg::Delete{} );
+	root = null;
+	groups.Clear();
+	found.Clear();
+	const TimeD	delete_time = timer.GetTimeDelta();
+
+	LOG( "Module graph with "_str << (1 + num_groups * (1 + num_leaves)) << " modules:"
+		 << "\n  attach:      " << ToString( attach_time )
+		 << "\n  compose:     " << ToString( compose_time )
+		 << "\n  by name:     " << ToString( by_name_time )
+		 << "\n  by id/msg:   " << ToString( by_id_time )
+		 << "\n  deep search: " << ToString( deep_search_time )
+		 << "\n  delete:      " << ToString( delete_time ), ELog::Info );
+	
+	WARNING( "Module graph test succeeded!" );
+}
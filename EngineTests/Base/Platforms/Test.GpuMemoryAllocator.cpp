@@ -0,0 +1,299 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "../Common.h"
+#include "Engine/Platforms/Public/Tools/GpuMemoryAllocator.h"
+
+using namespace Engine::PlatformTools;
+
+
+//
+// Test Random
+//
+struct TestRandom
+{
+	ulong	state	= 0x853c49e6748fea9bull;
+
+	uint Next (uint maxValue)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return uint(state % maxValue);
+	}
+};
+
+
+//
+// Occupancy Map
+//
+struct OccupancyMap
+{
+	Array< ubyte >	units;
+	usize			granularity;
+
+	OccupancyMap (BytesU size, BytesU granularity) : granularity{usize(granularity)}
+	{
+		units.Resize( usize(size) / this->granularity );
+		FOR( i, units ) { units[i] = 0; }
+	}
+
+	bool Set (BytesU offset, BytesU size, ubyte value)
+	{
+		const usize	first	= usize(offset) / granularity;
+		const usize	last	= (usize(offset) + usize(size) + granularity - 1) / granularity;
+
+		for (usize i = first; i < last; ++i)
+		{
+			if ( i >= units.Count() or units[i] == value )
+				return false;
+			units[i] = value;
+		}
+		return true;
+	}
+};
+
+/*
+=================================================
+	TestTLSFAllocator
+----
+	random allocations must not overlap,
+	after deallocation of all blocks memory must be continuous.
+=================================================
+*/
+static void TestTLSFAllocator ()
+{
+	const BytesU	page_size	= 1_Mb;
+	const BytesU	granularity	= 16_b;
+
+	TLSFBlockAllocator	alloc{ page_size, granularity };
+	OccupancyMap		map{ page_size, granularity };
+	TestRandom			rnd;
+
+	struct Alloc {
+		TLSFBlockAllocator::Index_t	block;
+		BytesU						offset;
+		BytesU						size;
+	};
+	Array< Alloc >	allocs;
+
+	for (uint i = 0; i < 20000; ++i)
+	{
+		if ( allocs.Empty() or rnd.Next( 3 ) != 0 )
+		{
+			const BytesU	size	= BytesU( 1 + rnd.Next( 8 << 10 ));
+			const BytesU	align	= BytesU( usize(1) << rnd.Next( 9 ));
+			Alloc			a;
+
+			if ( not alloc.Allocate( size, align, OUT a.block, OUT a.offset ) )
+				continue;
+
+			a.size = size;
+			CHECK( usize(a.offset) % usize(align) == 0 );
+			CHECK( map.Set( a.offset, a.size, 1 ) );
+
+			allocs.PushBack( a );
+		}
+		else
+		{
+			const usize		idx	= rnd.Next( uint(allocs.Count()) );
+			const Alloc		a	= allocs[idx];
+
+			allocs[idx] = allocs.Back();
+			allocs.PopBack();
+
+			CHECK( map.Set( a.offset, a.size, 0 ) );
+			CHECK( alloc.Deallocate( a.block ));
+		}
+	}
+
+	CHECK( alloc.AllocationCount() == allocs.Count() );
+
+	for (auto& a : allocs) {
+		CHECK( alloc.Deallocate( a.block ));
+	}
+
+	CHECK( alloc.Empty() );
+	CHECK( alloc.UsedSize() == 0_b );
+	CHECK( alloc.LargestFreeBlock() == page_size );
+
+	// whole page
+	TLSFBlockAllocator::Index_t	block;
+	BytesU						offset;
+
+	CHECK( alloc.Allocate( page_size, 256_b, OUT block, OUT offset ) and offset == 0_b );
+	CHECK( not alloc.Allocate( 1_b, 1_b, OUT block, OUT offset ) );
+}
+
+/*
+=================================================
+	TestLinearAllocator
+=================================================
+*/
+static void TestLinearAllocator ()
+{
+	LinearBlockAllocator	alloc{ 1_Kb, 16_b };
+	BytesU					offset;
+
+	CHECK( alloc.Allocate( 100_b, 1_b, OUT offset ) and offset == 0_b );
+	CHECK( alloc.Allocate( 10_b, 256_b, OUT offset ) and offset == 256_b );
+	CHECK( alloc.UsedSize() == 272_b );
+	CHECK( not alloc.Allocate( 1_Kb, 1_b, OUT offset ) );
+
+	alloc.Reset();
+	CHECK( alloc.Allocate( 1_Kb, 1_b, OUT offset ) and offset == 0_b );
+}
+
+/*
+=================================================
+	TestGpuMemoryAllocator
+=================================================
+*/
+static void TestGpuMemoryAllocator ()
+{
+	using Allocation = GpuMemoryAllocator::Allocation;
+
+	const BytesU		page_size = 64_Kb;
+	GpuMemoryAllocator	alloc{ page_size, 256_b };
+	Array< Allocation >	allocs;
+	Allocation			a;
+
+	// fill two pages
+	CHECK( not alloc.Allocate( 1_b, 1_b, OUT a ) );
+
+	for (uint i = 0; i < 2 * 64; ++i)
+	{
+		if ( not alloc.Allocate( 1_Kb, 1_b, OUT a ) )
+		{
+			const uint	page = alloc.AddPage( page_size, 100 + i );
+			CHECK( alloc.PageUserData( page ) == 100 + i );
+			CHECK( alloc.Allocate( 1_Kb, 1_b, OUT a ) and a.page == page );
+		}
+		allocs.PushBack( a );
+	}
+	CHECK( alloc.PageCount() == 2 );
+
+	// release most of allocations in the second page
+	for (usize i = allocs.Count()-1; i > 64+4; --i) {
+		CHECK( alloc.Deallocate( INOUT allocs[i] ));
+	}
+	for (uint i = 0; i < 16; ++i) {
+		CHECK( alloc.Deallocate( INOUT allocs[i] ));
+	}
+
+	GpuMemoryAllocator::Statistics	stat;
+	alloc.GetStatistics( OUT stat );
+	CHECK( stat.pages == 2 and stat.allocations == 48 + 5 );
+	CHECK( stat.usedSize == BytesU::FromKb( 48 + 5 ) );
+
+	// defragmentation must move allocations from the second page
+	GpuMemoryAllocator::DefragMoves_t	moves;
+	alloc.PlanDefragmentation( 100, OUT moves );
+	CHECK( moves.Count() == 5 );
+
+	for (auto& m : moves)
+	{
+		CHECK( m.src.page == allocs[64].page and m.dst.page == allocs[16].page );
+		CHECK( alloc.Deallocate( INOUT m.src ));
+	}
+
+	GpuMemoryAllocator::PageUserData_t	released;
+	alloc.ReleaseEmptyPages( 0, OUT released );
+	CHECK( released.Count() == 1 and released.Front() == 100 + 64 );
+	CHECK( alloc.PageCount() == 1 );
+
+	// transient
+	const uint	tpage = alloc.AddPage( page_size, 1, true );
+
+	CHECK( alloc.AllocateTransient( 32_Kb, 1_b, OUT a ) and a.IsTransient() and a.page == tpage );
+	CHECK( alloc.AllocateTransient( 32_Kb, 1_b, OUT a ) );
+	CHECK( not alloc.AllocateTransient( 1_b, 1_b, OUT a ) );
+	alloc.ResetTransient();
+	CHECK( alloc.AllocateTransient( 1_b, 1_b, OUT a ) );
+
+	// release all
+	for (uint i = 16; i < 64; ++i) {
+		CHECK( alloc.Deallocate( INOUT allocs[i] ));
+	}
+	for (auto& m : moves) {
+		CHECK( alloc.Deallocate( INOUT m.dst ));
+	}
+
+	alloc.Clear( OUT released );
+	CHECK( released.Count() == 2 );
+}
+
+/*
+=================================================
+	BenchmarkTLSFAllocator
+----
+	measures allocation throughput and fragmentation
+	after many random allocations and deallocations.
+=================================================
+*/
+static void BenchmarkTLSFAllocator ()
+{
+	const BytesU		page_size	= 64_Mb;
+	const uint			num_ops		= 1000000;
+
+	TLSFBlockAllocator	alloc{ page_size, 256_b };
+	TestRandom			rnd;
+	TimeProfilerD		timer;
+
+	Array< TLSFBlockAllocator::Index_t >	blocks;
+	blocks.Reserve( 1 << 14 );
+
+	uint	failed = 0;
+
+	timer.Start();
+
+	for (uint i = 0; i < num_ops; ++i)
+	{
+		if ( blocks.Count() < 4000 or (blocks.Count() < 10000 and rnd.Next( 2 ) == 0) )
+		{
+			TLSFBlockAllocator::Index_t	block;
+			BytesU						offset;
+
+			if ( alloc.Allocate( BytesU( 256 + rnd.Next( 16 << 10 )), 256_b, OUT block, OUT offset ) )
+				blocks.PushBack( block );
+			else
+				++failed;
+		}
+		else
+		{
+			const usize	idx = rnd.Next( uint(blocks.Count()) );
+
+			alloc.Deallocate( blocks[idx] );
+			blocks[idx] = blocks.Back();
+			blocks.PopBack();
+		}
+	}
+
+	const TimeD		dt		= timer.GetTimeDelta();
+	const BytesU	free	= alloc.Size() - alloc.UsedSize();
+	const float		frag	= 1.0f - float(usize(alloc.LargestFreeBlock())) / float(usize(free));
+
+	LOG( "TLSF allocator: "_str << num_ops << " operations in " << ToString( dt )
+		 << ", " << (dt.NanoSeconds() / num_ops) << " ns per operation"
+		 << "\n  allocations: " << blocks.Count() << ", failed: " << failed
+		 << ", used: " << ToString( alloc.UsedSize() ) << ", fragmentation: " << frag, ELog::Info );
+
+	for (auto& b : blocks) {
+		alloc.Deallocate( b );
+	}
+	CHECK( alloc.LargestFreeBlock() == page_size );
+}
+
+/*
+=================================================
+	Test_GpuMemoryAllocator
+=================================================
+*/
+extern void Test_GpuMemoryAllocator ()
+{
+	TestTLSFAllocator();
+	TestLinearAllocator();
+	TestGpuMemoryAllocator();
+	BenchmarkTLSFAllocator();
+
+	WARNING( "GPU memory allocator test succeeded!" );
+}
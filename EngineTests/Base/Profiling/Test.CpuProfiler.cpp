@@ -0,0 +1,125 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "../Common.h"
+
+
+/*
+=================================================
+	FindThreadZones
+=================================================
+*/
+static const CpuProfiler::ThreadZones*  FindThreadZones (const CpuProfiler::Capture &capture, StringCRef zoneName)
+{
+	for (auto& tz : capture.threads)
+	{
+		for (auto& z : tz.zones)
+		{
+			if ( zoneName == z.name )
+				return &tz;
+		}
+	}
+	return null;
+}
+
+/*
+=================================================
+	MeasureZoneCost
+=================================================
+*/
+static TimeD  MeasureZoneCost (uint count)
+{
+	TimeProfilerD	timer;
+	timer.Start();
+
+	for (uint i = 0; i < count; ++i)
+	{
+		GX_PROFILE_ZONE( "cost" );
+	}
+	return TimeD::FromSeconds( timer.GetTimeDelta().Seconds() / count );
+}
+
+/*
+=================================================
+	Test_CpuProfiler
+----
+	captures nested zones in ring buffer mode,
+	only last frames must be captured.
+=================================================
+*/
+extern void Test_CpuProfiler ()
+{
+	static const uint	num_frames		= 4;
+	static const uint	last_frames		= 2;
+	static const uint	num_zones		= 100000;
+	static const TimeD	max_zone_cost	= 50.0_nanoSec;
+
+	auto	ms = GetMainSystemInstance();
+
+	CpuProfiler::Start( last_frames );
+
+	for (uint frame = 0; frame < num_frames; ++frame)
+	{
+		ms->Send( ModuleMsg::Update{} );	// frame boundary
+
+		GX_PROFILE_ZONE( "outer" );
+		{
+			GX_PROFILE_ZONE( "inner" );
+		}
+	}
+
+	CpuProfiler::Capture	capture;
+	CHECK( CpuProfiler::GetCapture( OUT capture ) );
+	CHECK( capture.frames.Count() == last_frames );
+
+	// check zones
+	const CpuProfiler::ThreadZones*	tz = FindThreadZones( capture, "outer" );
+	CHECK( tz != null );
+
+	uint	outer_count		= 0;
+	uint	inner_count		= 0;
+	bool	has_msg_zone	= false;
+
+	for (auto& z : tz->zones)
+	{
+		CHECK( z.begin >= capture.begin and z.begin <= z.end );
+
+		if ( StringCRef("outer") == z.name )
+			++outer_count;
+
+		if ( StringCRef("inner") == z.name )
+		{
+			++inner_count;
+			CHECK( z.depth > 0 );
+		}
+
+		has_msg_zone |= (z.moduleId == ms->GetModuleID());
+	}
+
+	CHECK( outer_count == last_frames );
+	CHECK( inner_count == last_frames );
+	CHECK( has_msg_zone );
+
+	// check export
+	String	json;
+	CHECK( CpuProfiler::ToChromeTrace( capture, OUT json ) );
+	CHECK( json.HasSubString( "\"traceEvents\"" ) );
+	CHECK( json.HasSubString( "\"name\":\"inner\"" ) );
+	CHECK( json.HasSubString( "\"ph\":\"i\"" ) );
+
+	// overhead
+	const TimeD	enabled_cost = MeasureZoneCost( num_zones );
+
+	CpuProfiler::Stop();
+
+	const TimeD	disabled_cost = MeasureZoneCost( num_zones );
+
+	LOG( "CPU profiler zone cost:"_str
+		 << "\n  enabled:  " << ToString( enabled_cost ) << " (target: " << ToString( max_zone_cost ) << ")"
+		 << "\n  disabled: " << ToString( disabled_cost ), ELog::Info );
+
+	// timing depends on build configuration and machine load, so it is reported but not checked
+	if ( enabled_cost > max_zone_cost )
+		LOG( "CPU profiler zone cost is above target", ELog::Warning );
+
+	WARNING( "CPU profiler test succeeded!" );
+}
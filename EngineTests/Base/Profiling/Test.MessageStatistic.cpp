@@ -0,0 +1,85 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "../Common.h"
+
+
+/*
+=================================================
+	TestReport
+=================================================
+*/
+static void TestReport ()
+{
+	MessageStatistic::Entries_t		entries;
+
+	MessageStatistic::Entry		e0;
+	e0.msgType		= TypeIdOf< ModuleMsg::Link >();
+	e0.sender		= ulong( "sender"_GModID );
+	e0.target		= ulong( "target"_GModID );
+	e0.count		= 10;
+	e0.totalTime	= 1000;
+	e0.maxTime		= 200;
+	entries.PushBack( e0 );
+
+	MessageStatistic::Entry		e1;
+	e1.msgType		= TypeIdOf< ModuleMsg::Update >();
+	e1.sender		= 0;
+	e1.target		= ulong( "target"_GModID );
+	e1.count		= 5;
+	e1.asyncCount	= 5;
+	e1.totalTime	= 5000;
+	e1.maxTime		= 1000;
+	entries.PushBack( e1 );
+
+	// report is sorted by total time
+	String	report;
+	MessageStatistic::ToReport( entries, OUT report );
+
+	usize	pos_update	= 0;
+	usize	pos_link	= 0;
+	CHECK( report.Find( "count: 5, async: 5", OUT pos_update ) );
+	CHECK( report.Find( "count: 10, async: 0", OUT pos_link ) );
+	CHECK( pos_update < pos_link );
+
+	// graph
+	String	graph;
+	MessageStatistic::ToGraph( entries, OUT graph );
+
+	CHECK( graph.HasSubString( "\"sender\" -> \"target\"" ) );
+	CHECK( graph.HasSubString( "\"external\" -> \"target\"" ) );
+	CHECK( graph.HasSubString( "style=dashed" ) );
+}
+
+/*
+=================================================
+	Test_MessageStatistic
+=================================================
+*/
+extern void Test_MessageStatistic ()
+{
+	TestReport();
+
+	GX_PROFILE_MSG(
+		auto	ms = GetMainSystemInstance();
+
+		MessageStatistic::Reset();
+		MessageStatistic::Start();
+
+		ms->Send( ModuleMsg::Update{} );
+
+		MessageStatistic::Stop();
+
+		MessageStatistic::Entries_t		entries;
+		MessageStatistic::GetStatistic( OUT entries );
+
+		// handler time is measured in nanoseconds, so it must not be zero
+		bool	found = false;
+		for (auto& e : entries) {
+			found |= (e.msgType == TypeIdOf< ModuleMsg::Update >() and e.target == ms->GetModuleID() and e.count == 1 and
+					  e.totalTime > 0 and e.maxTime <= e.totalTime);
+		}
+		CHECK( found );
+	)
+
+	WARNING( "Message statistic test succeeded!" );
+}
@@ -0,0 +1,179 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "../Common.h"
+#include "Core/STL/Containers/CircularQueue.h"
+#include "Core/STL/ThreadSafe/MtQueue.h"
+
+
+/*
+=================================================
+	CopyCounter
+=================================================
+*/
+struct CopyCounter
+{
+	static uint		copyCount;
+	static uint		instanceCount;
+
+	CopyCounter ()						{ ++instanceCount; }
+	CopyCounter (CopyCounter &&)		{ ++instanceCount; }
+	CopyCounter (const CopyCounter &)	{ ++instanceCount;  ++copyCount; }
+	~CopyCounter ()						{ --instanceCount; }
+};
+
+uint	CopyCounter::copyCount		= 0;
+uint	CopyCounter::instanceCount	= 0;
+
+/*
+=================================================
+	TestNoCopy
+----
+	message passes the same layers as in TaskManager:
+	PushAsyncMessage -> message copy in SendAsync -> ReadOnce::Get -> MtQueue
+=================================================
+*/
+static void TestNoCopy ()
+{
+	using MsgQueue_t	= MtQueue< CircularQueue< AsyncMessage > >;
+
+	MsgQueue_t	queue;
+	uint		processed = 0;
+	{
+		ModuleMsg::PushAsyncMessage		msg{ ThreadID::GetCurrent(),
+											 LAMBDA( counter = CopyCounter{}, &processed ) (GlobalSystemsRef) { ++processed; }};
+
+		ModuleMsg::PushAsyncMessage		msg_copy{ msg };
+
+		AsyncMessage&	async_msg = msg_copy.asyncMsg.Get();
+
+		CHECK( async_msg.IsInline() );
+		queue.Push( RVREF( async_msg ) );
+	}
+	queue.Flush();
+	queue.ProcessAll( LAMBDA() (const AsyncMessage &op) {{ op.Process( GlobalSystemsRef(null) ); }} );
+	queue.ClearAll();
+
+	CHECK( processed == 1 );
+	CHECK( CopyCounter::copyCount == 0 );
+	CHECK( CopyCounter::instanceCount == 0 );
+
+	// typical captures must fit into queue slot
+	const auto	typical = LAMBDA( a = ModulePtr(), b = ModulePtr(), c = uint(0) ) (GlobalSystemsRef) {};
+
+	CHECK( AsyncMessage::IsInlineCapable< decltype(typical) >() );
+}
+
+/*
+=================================================
+	TestSelfAssign
+=================================================
+*/
+static void TestSelfAssign ()
+{
+	uint	processed = 0;
+	{
+		AsyncMessage	msg{ LAMBDA( counter = CopyCounter{}, &processed ) (GlobalSystemsRef) { ++processed; }};
+		AsyncMessage&	ref = msg;
+
+		msg = ref;
+		CHECK( msg.IsValid() );
+
+		msg = RVREF( ref );
+		CHECK( msg.IsValid() );
+
+		msg.Process( GlobalSystemsRef(null) );
+
+		AsyncMessage	empty;
+		CHECK( not empty.IsValid() );
+
+		msg = empty;
+		CHECK( not msg.IsValid() );
+	}
+	CHECK( processed == 1 );
+	CHECK( CopyCounter::instanceCount == 0 );
+}
+
+/*
+=================================================
+	Benchmark
+----
+	pushes messages with captures that doesn't fit into std::function local storage
+=================================================
+*/
+static void Benchmark ()
+{
+	static const uint	num_msgs	= 100000;
+	static const uint	num_iter	= 10;
+
+	using Func_t		= std::function< void (GlobalSystemsRef) >;
+	using FuncQueue_t	= MtQueue< CircularQueue< Func_t > >;
+	using MsgQueue_t	= MtQueue< CircularQueue< AsyncMessage > >;
+
+	FuncQueue_t		func_queue;
+	MsgQueue_t		msg_queue;
+	usize			checksum0	= 0;
+	usize			checksum1	= 0;
+	usize			heap_msgs	= 0;
+	TimeProfilerD	timer;
+	TimeD			func_push, func_process;
+	TimeD			msg_push, msg_process;
+
+	func_queue.ReservePending( num_msgs );
+	func_queue.ReserveCurrent( num_msgs );
+	msg_queue.ReservePending( num_msgs );
+	msg_queue.ReserveCurrent( num_msgs );
+
+	for (uint j = 0; j < num_iter; ++j)
+	{
+		// std::function
+		timer.Start();
+		for (usize i = 0; i < num_msgs; ++i) {
+			func_queue.Push( Func_t{ LAMBDA( &checksum0, a = ModulePtr(), b = ModulePtr(), i ) (GlobalSystemsRef) { checksum0 += i; }} );
+		}
+		func_push += timer.GetTimeDelta();
+		
+		timer.Start();
+		func_queue.Flush();
+		func_queue.ProcessAll( LAMBDA() (const Func_t &op) {{ op( GlobalSystemsRef(null) ); }} );
+		func_process += timer.GetTimeDelta();
+
+		// AsyncMessage
+		timer.Start();
+		for (usize i = 0; i < num_msgs; ++i) {
+			msg_queue.Push( AsyncMessage{ LAMBDA( &checksum1, a = ModulePtr(), b = ModulePtr(), i ) (GlobalSystemsRef) { checksum1 += i; }} );
+		}
+		msg_push += timer.GetTimeDelta();
+		
+		timer.Start();
+		msg_queue.Flush();
+		msg_queue.ProcessAll( LAMBDA( &heap_msgs ) (const AsyncMessage &op) {{ heap_msgs += not op.IsInline();  op.Process( GlobalSystemsRef(null) ); }} );
+		msg_process += timer.GetTimeDelta();
+	}
+
+	func_queue.ClearAll();
+	msg_queue.ClearAll();
+
+	CHECK( checksum0 == checksum1 );
+	CHECK( heap_msgs == 0 );
+
+	const double	scale = 1.0e9 / double(num_msgs * num_iter);
+
+	LOG( "AsyncMessage benchmark, "_str << num_msgs * num_iter << " messages:"
+		 << "\n  std::function push:    " << (func_push.Seconds() * scale) << " ns, process: " << (func_process.Seconds() * scale) << " ns"
+		 << "\n  AsyncMessage push:     " << (msg_push.Seconds() * scale) << " ns, process: " << (msg_process.Seconds() * scale) << " ns"
+		 << "\n  AsyncMessage heap allocations: " << heap_msgs, ELog::Info );
+}
+
+/*
+=================================================
+	Test_AsyncMessage
+=================================================
+*/
+extern void Test_AsyncMessage ()
+{
+	TestNoCopy();
+	TestSelfAssign();
+	Benchmark();
+
+	WARNING( "AsyncMessage test succeeded!" );
+}
@@ -0,0 +1,225 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "../Common.h"
+#include "Engine/Base/Tasks/JobScheduler.h"
+
+using JobID = JobGraph::JobID;
+
+
+/*
+=================================================
+	SyntheticWork
+=================================================
+*/
+static uint SyntheticWork (uint iterations)
+{
+	uint	hash = 2166136261u;
+
+	for (uint i = 0; i < iterations; ++i) {
+		hash = (hash ^ i) * 16777619u;
+	}
+	return hash;
+}
+
+/*
+=================================================
+	BuildFrameGraph
+----
+	input (main thread) -> scene update -> culling ->
+	batch building -> command recording -> submit (main thread)
+=================================================
+*/
+static void BuildFrameGraph (OUT JobGraph &graph, Atomic<uint> &checksum, uint work)
+{
+	static const uint	num_update	= 256;
+	static const uint	num_cull	= 64;
+	static const uint	num_batch	= 16;
+	static const uint	num_record	= 8;
+
+	const auto	Work = LAMBDA( &checksum, work ) () { checksum.Add( SyntheticWork( work ) ); };
+
+	Array< JobID >	update;
+	Array< JobID >	cull;
+	Array< JobID >	batch;
+	Array< JobID >	record;
+
+	graph.Clear();
+
+	const JobID	input = graph.AddMainThread( Work );
+
+	for (uint i = 0; i < num_update; ++i) {
+		update.PushBack( graph.Add( Work, { input }) );
+	}
+
+	for (uint i = 0; i < num_cull; ++i) {
+		cull.PushBack( graph.Add( Work, update.SubArray( i * (num_update / num_cull), num_update / num_cull ) ));
+	}
+
+	for (uint i = 0; i < num_batch; ++i) {
+		batch.PushBack( graph.Add( Work, cull.SubArray( i * (num_cull / num_batch), num_cull / num_batch ) ));
+	}
+
+	for (uint i = 0; i < num_record; ++i) {
+		record.PushBack( graph.Add( Work, batch.SubArray( i * (num_batch / num_record), num_batch / num_record ) ));
+	}
+
+	graph.AddMainThread( Work, record );
+}
+
+/*
+=================================================
+	BuildWideGraph
+----
+	a lot of independent jobs, measures scheduling overhead
+=================================================
+*/
+static void BuildWideGraph (OUT JobGraph &graph, Atomic<uint> &checksum, uint count, uint work)
+{
+	const auto	Work = LAMBDA( &checksum, work ) () { checksum.Add( SyntheticWork( work ) ); };
+
+	graph.Clear();
+
+	const JobID		root = graph.Add( Work );
+	Array< JobID >	jobs;
+
+	for (uint i = 0; i < count; ++i) {
+		jobs.PushBack( graph.Add( Work, { root }) );
+	}
+
+	graph.Add( Work, jobs );
+}
+
+/*
+=================================================
+	RunSerial
+----
+	jobs are added in topological order
+=================================================
+*/
+static void RunSerial (const JobGraph &graph)
+{
+	for (auto& job : graph.GetJobs()) {
+		job.func();
+	}
+}
+
+/*
+=================================================
+	TestDependencies
+=================================================
+*/
+static void TestDependencies (JobScheduler &scheduler)
+{
+	static const uint	num_jobs	= 1000;
+
+	JobGraph		graph;
+	Array< uint >	order;
+	Atomic< uint >	counter;
+	Atomic< uint >	main_errors;
+	const ThreadID	main_thread	= ThreadID::GetCurrent();
+	uint			seed		= 12345;
+
+	order.Resize( num_jobs );
+
+	for (uint i = 0; i < num_jobs; ++i)
+	{
+		const bool	is_main	= (i % 50 == 0);
+		const auto	func	= LAMBDA( &order, &counter, &main_errors, main_thread, is_main, i ) ()
+							  {
+								  if ( is_main and ThreadID::GetCurrent() != main_thread )
+									  main_errors.Inc();
+
+								  order[i] = counter.Inc();
+							  };
+
+		const JobID	id = is_main ? graph.AddMainThread( func ) : graph.Add( func );
+
+		// random dependencies on previous jobs
+		for (uint j = 0; j < 3 and id > 0; ++j)
+		{
+			seed = seed * 1103515245u + 12345u;
+			graph.AddDependency( id, (seed >> 8) % id );
+		}
+	}
+
+	for (uint frame = 0; frame < 10; ++frame)
+	{
+		counter.Set( 0 );
+		CHECK( scheduler.Run( graph ) );
+		CHECK( counter.Get() == num_jobs );
+
+		FOR( i, graph.GetJobs() )
+		{
+			for (auto& next : graph.GetJobs()[i].successors) {
+				CHECK( order[i] < order[next] );
+			}
+		}
+	}
+
+	CHECK( main_errors.Get() == 0 );
+}
+
+/*
+=================================================
+	Benchmark
+=================================================
+*/
+static void Benchmark (JobScheduler &scheduler, StringCRef name, const JobGraph &graph, Atomic<uint> &checksum)
+{
+	static const uint	num_frames	= 50;
+
+	TimeProfilerD	timer;
+
+	// serial
+	checksum.Set( 0 );
+	timer.Start();
+
+	for (uint i = 0; i < num_frames; ++i) {
+		RunSerial( graph );
+	}
+
+	const TimeD		serial_time		= timer.GetTimeDelta();
+	const uint		serial_checksum	= checksum.Get();
+
+	// parallel
+	checksum.Set( 0 );
+	timer.Start();
+
+	for (uint i = 0; i < num_frames; ++i) {
+		CHECK( scheduler.Run( graph ) );
+	}
+
+	const TimeD		parallel_time	= timer.GetTimeDelta();
+
+	CHECK( checksum.Get() == serial_checksum );
+
+	LOG( String(name) << ", " << graph.Count() << " jobs, " << scheduler.ThreadCount() << " threads:"
+		 << "\n  serial:   " << ToString( TimeD::FromSeconds( serial_time.Seconds() / num_frames ) ) << " per frame"
+		 << "\n  parallel: " << ToString( TimeD::FromSeconds( parallel_time.Seconds() / num_frames ) ) << " per frame"
+		 << "\n  speedup:  " << (serial_time.Seconds() / Max( parallel_time.Seconds(), 1.0e-9 )), ELog::Info );
+}
+
+/*
+=================================================
+	Test_JobGraph
+=================================================
+*/
+extern void Test_JobGraph ()
+{
+	JobScheduler	scheduler;
+	JobGraph		graph;
+	Atomic<uint>	checksum;
+
+	TestDependencies( scheduler );
+
+	BuildFrameGraph( OUT graph, checksum, 20000 );
+	Benchmark( scheduler, "Frame graph", graph, checksum );
+
+	BuildWideGraph( OUT graph, checksum, 1000, 20000 );
+	Benchmark( scheduler, "Wide graph", graph, checksum );
+
+	BuildWideGraph( OUT graph, checksum, 10000, 100 );
+	Benchmark( scheduler, "Fine-grained graph", graph, checksum );
+
+	WARNING( "Job graph test succeeded!" );
+}
@@ -2,6 +2,8 @@
 
 #include "GApp.h"
 
+extern void Test_OffscreenSurface ();
+
 
 /*
 =================================================
@@ -40,5 +42,7 @@ int main ()
 	GetMainSystemInstance()->Send( ModuleMsg::Delete{} );
 	#endif
 
+	Test_OffscreenSurface();
+
 	return 0;
 }
@@ -0,0 +1,206 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Offscreen surface renders frames without window surface
+	and delivers them to callback in submission order.
+*/
+
+#include "GApp.h"
+#include "Engine/Scene/Engine.Scene.h"
+#include "Engine/Profilers/Engine.Profilers.h"
+
+
+class OffscreenApp final : public StaticRefCountedObject
+{
+// constants
+private:
+	static constexpr uint	_FrameCount		= 16;
+	static constexpr uint	_MaxUpdates		= 10000;
+
+
+// variables
+private:
+	Ptr< Module >		ms;
+	ModulePtr			surface;
+	const uint2			size		{ 64, 32 };
+	uint				updates		= 0;
+
+	// written by render thread
+	Atomic< uint >		framesReceived	{ 0 };
+	Atomic< uint >		errors			{ 0 };
+	Atomic< ulong >		nextFrameId		{ 0 };
+
+
+// methods
+public:
+	OffscreenApp ();
+
+	bool Initialize (GAPI::type api);
+	bool Update ();
+	bool Check ();
+
+private:
+	bool _Init (const ModuleMsg::Compose &);
+	void _OnFrameReady (const CreateInfo::OffscreenSurface::Frame &frame);
+};
+
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+OffscreenApp::OffscreenApp ()
+{
+	ms = GetMainSystemInstance();
+
+	Platforms::RegisterPlatforms();
+	Profilers::RegisterProfilers();
+	Graphics::RegisterGraphics();
+	Scene::RegisterScene();
+}
+
+/*
+=================================================
+	Initialize
+=================================================
+*/
+bool OffscreenApp::Initialize (GAPI::type api)
+{
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	ms->AddModule( 0, CreateInfo::Platform{} );
+
+	// scene manager uses existing window
+	ModulePtr	window;
+	CHECK_ERR( factory->Create( 0, ms->GlobalSystems(),
+								CreateInfo::Window{
+								   Uninitialized,
+								   Uninitialized,
+								   uint2(1,1),
+								   int2(),
+								   CreateInfo::Window::EVisibility::Invisible
+								},
+								OUT window ) );
+	ms->GlobalSystems()->parallelThread->Send( ModuleMsg::AttachModule{ window });
+
+	CreateInfo::SceneManager	scene_mngr_ci;
+	scene_mngr_ci.settings.version	= api;
+
+	ms->AddModule( Scene::SceneManagerModuleID, scene_mngr_ci );
+
+	ModulePtr	scene_mngr	= ms->GetModuleByID( Scene::SceneManagerModuleID );
+	CHECK_ERR( scene_mngr );
+
+	scene_mngr->Subscribe( this, &OffscreenApp::_Init );
+
+	// finish initialization
+	ModuleUtils::Initialize({ ms });
+	return true;
+}
+
+/*
+=================================================
+	_Init
+=================================================
+*/
+bool OffscreenApp::_Init (const ModuleMsg::Compose &)
+{
+	auto	gs	= ms->GlobalSystems();
+
+	CreateInfo::OffscreenSurface	ci;
+	ci.size			= size;
+	ci.colorFmt		= EPixelFormat::RGBA8_UNorm;
+	ci.onFrameReady	= LAMBDA( this ) (const CreateInfo::OffscreenSurface::Frame &frame) { _OnFrameReady( frame ); };
+
+	CHECK_ERR( gs->modulesFactory->Create( Scene::OffscreenSurfaceModuleID, gs, ci, OUT surface ) );
+
+	gs->parallelThread->Send( ModuleMsg::AttachModule{ "surface", surface });
+	return true;
+}
+
+/*
+=================================================
+	_OnFrameReady
+=================================================
+*/
+void OffscreenApp::_OnFrameReady (const CreateInfo::OffscreenSurface::Frame &frame)
+{
+	const BytesU	row_size = BytesU(size.x * EPixelFormat::BitPerPixel( frame.format ).ToBytes());
+
+	bool	ok	= All( frame.size == size ) and
+				  frame.format == EPixelFormat::RGBA8_UNorm and
+				  frame.rowPitch >= row_size and
+				  frame.pixels.Size() == frame.rowPitch * size.y and
+				  frame.frameId == nextFrameId.Get();		// frames must be in order
+
+	nextFrameId.Set( frame.frameId + 1 );
+	framesReceived.Inc();
+
+	if ( not ok )
+		errors.Inc();
+}
+
+/*
+=================================================
+	Update
+=================================================
+*/
+bool OffscreenApp::Update ()
+{
+	if ( framesReceived.Get() >= _FrameCount or ++updates > _MaxUpdates )
+		return false;
+
+	ms->Send( ModuleMsg::Update{} );
+	return true;
+}
+
+/*
+=================================================
+	Check
+=================================================
+*/
+bool OffscreenApp::Check ()
+{
+	CHECK_ERR( surface );
+	CHECK_ERR( framesReceived.Get() >= _FrameCount );
+	CHECK_ERR( errors.Get() == 0 );
+
+	SceneMsg::OffscreenSurfaceGetStatistic	req_stat;
+	surface->Send( req_stat );
+
+	CHECK_ERR( req_stat.result->framesRead == framesReceived.Get() );
+	CHECK_ERR( req_stat.result->bytesRead == BytesU(ulong(4 * size.x * size.y) * framesReceived.Get()) );
+
+	surface = null;
+	return true;
+}
+//-----------------------------------------------------------------------------
+
+
+static void RunOffscreenSurface (GAPI::type api)
+{
+	{
+		OffscreenApp	app;
+		app.Initialize( api );
+
+		// main loop
+		for (; app.Update();) {}
+
+		CHECK_FATAL( app.Check() );
+	}
+	GetMainSystemInstance()->Send( ModuleMsg::Delete{} );
+}
+
+
+extern void Test_OffscreenSurface ()
+{
+	#ifdef GRAPHICS_API_SOFT
+	RunOffscreenSurface( "SW 1.0"_GAPI );
+	#endif
+
+	#ifdef GRAPHICS_API_VULKAN
+	RunOffscreenSurface( "VK 1.0"_GAPI );
+	#endif
+
+	LOG( "OffscreenSurface - OK", ELog::Info );
+}
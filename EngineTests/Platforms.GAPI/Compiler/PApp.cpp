@@ -24,6 +24,8 @@ PApp::PApp ()
 			<< &PApp::_Test_GlobalToLocal
 			<< &PApp::_Test_UnnamedBuffer
 			<< &PApp::_Test_Include
+			<< &PApp::_Test_Optimizer
+			<< &PApp::_Test_NativeShaderCache
 		;
 }
 
@@ -45,6 +47,8 @@ bool PApp::Initialize (GAPI::type api, StringCRef dev, bool debug)
 {
 	auto	factory	= ms->GlobalSystems()->modulesFactory;
 
+	gapi = api;
+
 	ms->AddModule( 0, CreateInfo::Platform{} );
 
 	ComputeSettings	settings;
@@ -14,6 +14,8 @@ private:
 
 	using ImageRange	= GpuMsg::ImageRange;
 
+	using CreatePipelineFunc_t	= void (*) (PipelineTemplateDescription &);
+
 
 // variables
 private:
@@ -29,6 +31,8 @@ private:
 	uint				testsPassed	= 0;
 	uint				testsFailed	= 0;
 
+	GAPI::type			gapi;
+
 
 // methods
 public:
@@ -60,4 +64,12 @@ private:
 	bool _Test_UnnamedBuffer ();	// OpenCL, C++
 	
 	bool _Test_Include ();
+
+	// compare with unoptimized shaders
+	bool _Test_Optimizer ();
+
+	// software renderer only
+	bool _Test_NativeShaderCache ();
+
+	bool _RunShader (CreatePipelineFunc_t createPipeline, StringCRef bufferName, BytesU bufSize, OUT BinaryArray &result);
 };
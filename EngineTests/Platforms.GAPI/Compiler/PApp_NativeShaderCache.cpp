@@ -0,0 +1,77 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	C++ shader source is compiled at runtime by native shader cache,
+	compiled shader must write the same data as builtin shader.
+*/
+
+#include "PApp.h"
+#include "Pipelines/Optimized/all_pipelines.h"
+#include "Engine/Platforms/Soft/Impl/SWNativeShaderCache.h"
+
+/*
+=================================================
+	_Test_NativeShaderCache
+=================================================
+*/
+bool PApp::_Test_NativeShaderCache ()
+{
+#if defined( GRAPHICS_API_SOFT ) and defined( GX_SW_NATIVE_SHADERS )
+	using PlatformSW::SWNativeShaderCache;
+	using SWInvoke_t = SWNativeShaderCache::SWInvoke_t;
+
+	if ( gapi != "SW 1.0"_GAPI )
+		return true;
+
+	auto&			cache		= SWNativeShaderCache::Instance();
+	const BytesU	buf_size	= SizeOf< OptimizedPipelines::VecSwizzle_SSBO >;
+
+	CHECK_ERR( not cache.IsEnabled() );
+
+	// run builtin shader
+	BinaryArray		builtin;
+	CHECK_ERR( _RunShader( &OptimizedPipelines::Create_vecswizzle, "ssb", buf_size, OUT builtin ) );
+
+
+	// setup cache, current directory is 'EngineTests/Platforms.GAPI/Compute'
+	String	cur_dir;
+	CHECK_ERR( OS::FileSystem::GetCurrentDirectory( OUT cur_dir ) );
+
+	const String	root_dir = FileAddress::BuildPath( cur_dir, "../../.." );
+
+	SWNativeShaderCache::Settings	settings;
+	settings.folder		= "sw_shader_cache_test";
+	settings.includeDirs.PushBack( root_dir );
+	settings.includeDirs.PushBack( FileAddress::BuildPath( root_dir, "External" ) );
+	settings.defines.PushBack( "GRAPHICS_API_SOFT" );
+
+	CHECK_ERR( cache.Setup( settings ) );
+
+
+	// compile and load shader
+	PipelineTemplateDescription	descr;
+	OptimizedPipelines::Create_vecswizzle( OUT descr );
+
+	StringCRef	src = descr.shaders[EShader::Compute].GetString( EShaderLangFormat::Software_100 | EShaderLangFormat::HighLevel );
+	CHECK_ERR( not src.Empty() );
+
+	SWInvoke_t	native_func	= null;
+	SWInvoke_t	cached_func	= null;
+
+	CHECK_ERR( cache.GetShader( src, OUT native_func ) and native_func );
+	CHECK_ERR( cache.GetShader( src, OUT cached_func ) and cached_func == native_func );	// loaded shader must be reused
+	CHECK_ERR( native_func != descr.shaders[EShader::Compute].GetInvocable( EShaderLangFormat::Software_100 | EShaderLangFormat::CPP_Invocable ) );
+
+
+	// run native shader, pipeline template takes shader from cache
+	BinaryArray		native;
+	const bool		res = _RunShader( &OptimizedPipelines::Create_vecswizzle, "ssb", buf_size, OUT native );
+
+	cache.Disable();
+
+	CHECK_ERR( res );
+	CHECK_ERR( BinArrayCRef(builtin) == BinArrayCRef(native) );
+
+	LOG( "NativeShaderCache - OK", ELog::Info );
+#endif
+	return true;
+}
@@ -0,0 +1,158 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	The same test shaders are compiled with and without AST optimizer ('optimizeSource'),
+	both versions must write the same data to buffer.
+*/
+
+#include "PApp.h"
+#include "Pipelines/all_pipelines.h"
+#include "Pipelines/Optimized/all_pipelines.h"
+
+/*
+=================================================
+	_RunShader
+----
+	buffer is filled by the same pattern before dispatch,
+	so shaders that read from buffer get the same input.
+=================================================
+*/
+bool PApp::_RunShader (CreatePipelineFunc_t createPipeline, StringCRef bufferName, BytesU bufSize, OUT BinaryArray &result)
+{
+	// create resources
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	GpuMsg::CreateFence		fence_ctor;
+	syncManager->Send( fence_ctor );
+
+	ModulePtr	cmd_buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.commandBuffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuCommandBuffer{},
+					OUT cmd_buffer ) );
+	cmdBuilder->Send( ModuleMsg::AttachModule{ cmd_buffer });
+
+	ModulePtr	buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.buffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuBuffer{
+						BufferDescription{ bufSize, EBufferUsage::Storage },
+						EGpuMemory::CoherentWithCPU },
+					OUT buffer ) );
+
+	CreateInfo::PipelineTemplate	pt_ci;
+	createPipeline( OUT pt_ci.descr );
+
+	ModulePtr	pipeline_template;
+	CHECK_ERR( factory->Create(
+					PipelineTemplateModuleID,
+					gpuThread->GlobalSystems(),
+					pt_ci,
+					OUT pipeline_template ) );
+	ModuleUtils::Initialize({ pipeline_template });
+
+	GpuMsg::CreateComputePipeline	cppl_ctor{ gpuIDs.pipeline, gpuThread };
+	pipeline_template->Send( cppl_ctor );
+
+	ModulePtr	pipeline	= *cppl_ctor.result;
+
+	ModulePtr	resource_table;
+	CHECK_ERR( factory->Create(
+					gpuIDs.resourceTable,
+					gpuThread->GlobalSystems(),
+					CreateInfo::PipelineResourceTable{},
+					OUT resource_table ) );
+
+	resource_table->Send( ModuleMsg::AttachModule{ "pipeline", pipeline });
+	resource_table->Send( GpuMsg::PipelineAttachBuffer{ bufferName, buffer, 0_b, bufSize });
+
+	ModuleUtils::Initialize({ cmd_buffer, buffer, pipeline, resource_table });
+
+
+	// write data to buffer
+	BinaryArray	src_data;	src_data.Resize( usize(bufSize) );
+
+	FOR( i, src_data ) {
+		src_data[i] = ubyte(i * 7 + 1);
+	}
+
+	GpuMsg::WriteToGpuMemory	write_cmd{ src_data };
+	buffer->Send( write_cmd );
+	CHECK_ERR( *write_cmd.wasWritten == bufSize );
+
+
+	// build command buffer
+	cmdBuilder->Send( GpuMsg::CmdBegin{ cmd_buffer });
+
+	cmdBuilder->Send( GpuMsg::CmdBindComputePipeline{ pipeline });
+	cmdBuilder->Send( GpuMsg::CmdBindComputeResourceTable{ resource_table });
+	cmdBuilder->Send( GpuMsg::CmdDispatch{ uint3(1) });
+
+	GpuMsg::CmdEnd	cmd_end;
+	cmdBuilder->Send( cmd_end );
+
+
+	// submit and sync
+	gpuThread->Send( GpuMsg::SubmitCommands{ *cmd_end.result }.SetFence( *fence_ctor.result ));
+
+	syncManager->Send( GpuMsg::ClientWaitFence{ *fence_ctor.result });
+
+
+	// read from buffer
+	result.Resize( usize(bufSize) );
+
+	GpuMsg::ReadFromGpuMemory	read_cmd{ result };
+	buffer->Send( read_cmd );
+	CHECK_ERR( read_cmd.result->Size() == bufSize );
+
+	return true;
+}
+
+/*
+=================================================
+	_Test_Optimizer
+----
+	'AtomicAdd' is not tested because order of
+	atomic operations is not defined.
+=================================================
+*/
+bool PApp::_Test_Optimizer ()
+{
+	struct ShaderInfo
+	{
+		StringCRef				name;
+		CreatePipelineFunc_t	create;
+		CreatePipelineFunc_t	createOptimized;
+		StringCRef				bufferName;
+		BytesU					bufferSize;
+	};
+
+	const ShaderInfo	shaders[] = {
+		{ "FindLSB",		&Pipelines::Create_findlsb,			&OptimizedPipelines::Create_findlsb,		"ssb",	SizeOf< Pipelines::FindLSB_SSBO > },
+		{ "FindMSB",		&Pipelines::Create_findmsb,			&OptimizedPipelines::Create_findmsb,		"ssb",	SizeOf< Pipelines::FindMSB_SSBO > },
+		{ "InlineAll",		&Pipelines::Create_inlineall,		&OptimizedPipelines::Create_inlineall,		"ssb",	SizeOf< Pipelines::InlineAll_SSBO > },
+		{ "VecSwizzle",		&Pipelines::Create_vecswizzle,		&OptimizedPipelines::Create_vecswizzle,		"ssb",	SizeOf< Pipelines::VecSwizzle_SSBO > },
+		{ "GlobalToLocal",	&Pipelines::Create_globaltolocal,	&OptimizedPipelines::Create_globaltolocal,	"ssb",	SizeOf< Pipelines::GlobalToLocal_SSBO > },
+		{ "UnnamedBuffer",	&Pipelines::Create_unnamedbuffer,	&OptimizedPipelines::Create_unnamedbuffer,	"",		SizeOf< Pipelines::UnnamedBuffer_SSBO > },
+		{ "Include",		&Pipelines::Create_include,			&OptimizedPipelines::Create_include,		"ssb",	SizeOf< Pipelines::Include_SSBO > }
+	};
+
+	for (auto& sh : shaders)
+	{
+		BinaryArray		unoptimized;
+		BinaryArray		optimized;
+
+		CHECK_ERR( _RunShader( sh.create, sh.bufferName, sh.bufferSize, OUT unoptimized ) );
+		CHECK_ERR( _RunShader( sh.createOptimized, sh.bufferName, sh.bufferSize, OUT optimized ) );
+
+		if ( BinArrayCRef(unoptimized) != BinArrayCRef(optimized) )
+		{
+			LOG( "optimized shader '"_str << sh.name << "' returns different result", ELog::Warning );
+			return false;
+		}
+	}
+
+	LOG( "Optimizer - OK", ELog::Info );
+	return true;
+}
@@ -2,6 +2,7 @@
 
 #include "CApp.h"
 #include "Engine/Platforms/Public/Tools/GPUThreadHelper.h"
+#include "Engine/Profilers/Engine.Profilers.h"
 
 
 /*
@@ -14,6 +15,7 @@ CApp::CApp ()
 	ms = GetMainSystemInstance();
 
 	Platforms::RegisterPlatforms();
+	Profilers::RegisterProfilers();
 
 	tests	<< &CApp::_Test_CopyBuffer
 			<< &CApp::_Test_ClearBuffer
@@ -23,6 +25,8 @@ CApp::CApp ()
 			<< &CApp::_Test_BufferRange
 			//<< &CApp::_Test_SpecializationConstants
 			<< &CApp::_Test_ShaderBarrier
+			<< &CApp::_Test_CommandReordering
+			<< &CApp::_Test_DispatchIndirect
 			<< &CApp::_Test_CopyImage2D
 			<< &CApp::_Test_CopyBufferToImage2D
 			<< &CApp::_Test_CopyImage2DToBuffer
@@ -31,6 +35,9 @@ CApp::CApp ()
 			//<< &CApp::_Test_PushConstants
 			<< &CApp::_Test_Image2DNearestFilter
 			<< &CApp::_Test_Image2DBilinearFilter
+			<< &CApp::_Test_BlitImage2D
+			<< &CApp::_Test_QueryTimestamp
+			<< &CApp::_Test_GpuProfiler
 			<< &CApp::_Test_ExplicitMemoryObjectSharing
 		;
 }
@@ -60,6 +67,8 @@ bool CApp::Initialize (GAPI::type api, StringCRef dev, bool debug)
 	settings.device		= dev;
 	settings.isDebug	= debug;
 
+	apiName = GAPI::ToString( api );
+
 	{
 		ModulePtr	context;
 		CHECK_ERR( factory->Create( 0, ms->GlobalSystems(), CreateInfo::GpuContext{ settings }, OUT context ) );
@@ -131,6 +140,29 @@ bool CApp::Update ()
 	return true;
 }
 
+/*
+=================================================
+	EnableBenchmarks
+----
+	replaces correctness tests by benchmarks,
+	results will be saved to '<output>.json' and '<output>.csv'.
+=================================================
+*/
+void CApp::EnableBenchmarks (StringCRef output, uint repeats)
+{
+	benchOutput		= output;
+	benchRepeats	= Max( repeats, 1u );
+	benchResults.Clear();
+
+	tests.Clear();
+	tests	<< &CApp::_Bench_DispatchOverhead
+			<< &CApp::_Bench_CopyBuffer
+			<< &CApp::_Bench_Image2DBilinearFilter
+			<< &CApp::_Bench_ShaderBarrier
+			<< &CApp::_Bench_GenerateMipmaps2D
+		;
+}
+
 /*
 =================================================
 	_OnWindowClosed
@@ -166,6 +198,9 @@ bool CApp::_Draw (const ModuleMsg::Update &)
 	{
 		Quit();
 
+		if ( not benchOutput.Empty() )
+			CHECK( _SaveBenchmarkResults() );
+
 		LOG( "Tests passed: "_str << testsPassed << ", failed: " << testsFailed, ELog::Info );
 		CHECK_FATAL( testsFailed == 0 );
 	}
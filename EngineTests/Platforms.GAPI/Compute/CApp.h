@@ -14,6 +14,21 @@ private:
 
 	using ImageRange	= GpuMsg::ImageRange;
 
+	struct BenchResult
+	{
+		String		name;
+		String		params;
+		usize		workSize	= 0;
+		String		workUnit;			// bytes, pixels, dispatches
+		uint		repeats		= 0;
+		double		minMs		= 0.0;
+		double		avgMs		= 0.0;
+		double		maxMs		= 0.0;
+	};
+
+	using BenchResults_t	= Array< BenchResult >;
+	using CmdRecorder_t		= Function< bool () >;		// records commands to 'cmdBuilder'
+
 
 // variables
 private:
@@ -31,6 +46,11 @@ private:
 	uint				testsPassed	= 0;
 	uint				testsFailed	= 0;
 
+	String				apiName;
+	String				benchOutput;				// file name without extension
+	uint				benchRepeats	= 0;
+	BenchResults_t		benchResults;
+
 
 // methods
 public:
@@ -41,6 +61,8 @@ public:
 	void Quit ();
 	bool Update ();
 
+	void EnableBenchmarks (StringCRef output, uint repeats = 10);
+
 
 private:
 	bool _OnWindowClosed (const OSMsg::WindowAfterDestroy &);
@@ -59,6 +81,8 @@ private:
 	bool _Test_BufferRange ();
 	bool _Test_SpecializationConstants ();
 	bool _Test_ShaderBarrier ();
+	bool _Test_CommandReordering ();
+	bool _Test_DispatchIndirect ();
 	//bool _Test_PushConstants ();
 
 	// image
@@ -69,7 +93,26 @@ private:
 	//bool _Test_CopyImage3D ();
 	bool _Test_Image2DNearestFilter ();
 	bool _Test_Image2DBilinearFilter ();
+	bool _Test_BlitImage2D ();
+
+	// query
+	bool _Test_QueryTimestamp ();
+	bool _Test_GpuProfiler ();
 
 	// memory
 	bool _Test_ExplicitMemoryObjectSharing ();
+
+// Benchmarks
+private:
+	bool _Bench_DispatchOverhead ();
+	bool _Bench_CopyBuffer ();
+	bool _Bench_Image2DBilinearFilter ();
+	bool _Bench_ShaderBarrier ();
+	bool _Bench_GenerateMipmaps2D ();
+
+	bool _RunBenchmark (StringCRef name, StringCRef params, usize workSize, StringCRef workUnit, const CmdRecorder_t &recorder);
+	bool _SaveBenchmarkResults () const;
+
+	bool _CreateBenchPipeline (const CreateInfo::PipelineTemplate &ci, OUT ModulePtr &pipeline, OUT ModulePtr &resourceTable);
+	bool _CreateBenchImage2D (const uint2 &dim, EPixelFormat::type format, EImageUsage::bits usage, OUT ModulePtr &image, MipmapLevel maxLevel = Uninitialized);
 };
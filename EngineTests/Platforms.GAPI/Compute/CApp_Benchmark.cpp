@@ -0,0 +1,433 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CApp.h"
+#include "Pipelines/all_pipelines.h"
+
+/*
+=================================================
+	_Bench_DispatchOverhead
+----
+	dispatches single work group many times,
+	so the time mostly depends on command processing.
+=================================================
+*/
+bool CApp::_Bench_DispatchOverhead ()
+{
+	CreateInfo::PipelineTemplate	pt_ci;
+	Pipelines::Create_shaderbarrier( OUT pt_ci.descr );
+
+	const uint2		img_dim	= pt_ci.descr.localGroupSize.xy();
+
+	ModulePtr	src_image, dst_image, pipeline, resource_table;
+	CHECK_ERR( _CreateBenchImage2D( img_dim, EPixelFormat::RGBA32F, EImageUsage::Storage, OUT src_image ) );
+	CHECK_ERR( _CreateBenchImage2D( img_dim, EPixelFormat::RGBA32F, EImageUsage::Storage, OUT dst_image ) );
+	CHECK_ERR( _CreateBenchPipeline( pt_ci, OUT pipeline, OUT resource_table ) );
+
+	resource_table->Send( ModuleMsg::AttachModule{ "un_SrcImage", src_image });
+	resource_table->Send( ModuleMsg::AttachModule{ "un_DstImage", dst_image });
+
+	ModuleUtils::Initialize({ src_image, dst_image, pipeline, resource_table });
+
+	for (uint count : { 1u, 16u, 256u, 1024u })
+	{
+		CHECK_ERR( _RunBenchmark( "DispatchOverhead", "dispatches="_str << count, count, "dispatches",
+					LAMBDA( this, &src_image, &dst_image, &pipeline, &resource_table, count ) ()
+					{
+						cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::TopOfPipe, EPipelineStage::ComputeShader }
+											.AddImage({	src_image,
+														EPipelineAccess::bits(),
+														EPipelineAccess::ShaderRead,
+														EImageLayout::Undefined,
+														EImageLayout::General,
+														EImageAspect::Color })
+											.AddImage({	dst_image,
+														EPipelineAccess::bits(),
+														EPipelineAccess::ShaderWrite,
+														EImageLayout::Undefined,
+														EImageLayout::General,
+														EImageAspect::Color }) );
+
+						cmdBuilder->Send( GpuMsg::CmdBindComputePipeline{ pipeline });
+						cmdBuilder->Send( GpuMsg::CmdBindComputeResourceTable{ resource_table });
+
+						for (uint i = 0; i < count; ++i) {
+							cmdBuilder->Send( GpuMsg::CmdDispatch{ uint3(1) });
+						}
+						return true;
+					}) );
+	}
+
+	ModuleUtils::Send({ resource_table, pipeline, src_image, dst_image }, ModuleMsg::Delete{} );
+
+	LOG( "DispatchOverhead - OK", ELog::Info );
+	return true;
+}
+
+/*
+=================================================
+	_Bench_CopyBuffer
+=================================================
+*/
+bool CApp::_Bench_CopyBuffer ()
+{
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	for (BytesU size : { 64_Kb, 1_Mb, 16_Mb })
+	{
+		ModulePtr	src_buffer;
+		CHECK_ERR( factory->Create(
+						gpuIDs.buffer,
+						gpuThread->GlobalSystems(),
+						CreateInfo::GpuBuffer{
+							BufferDescription{ size, EBufferUsage::TransferSrc },
+							EGpuMemory::LocalInGPU,
+							EMemoryAccess::GpuReadWrite },
+						OUT src_buffer ) );
+
+		ModulePtr	dst_buffer;
+		CHECK_ERR( factory->Create(
+						gpuIDs.buffer,
+						gpuThread->GlobalSystems(),
+						CreateInfo::GpuBuffer{
+							BufferDescription{ size, EBufferUsage::TransferDst },
+							EGpuMemory::LocalInGPU,
+							EMemoryAccess::GpuReadWrite },
+						OUT dst_buffer ) );
+
+		ModuleUtils::Initialize({ src_buffer, dst_buffer });
+
+		CHECK_ERR( _RunBenchmark( "CopyBuffer", "size="_str << usize(size), usize(size), "bytes",
+					LAMBDA( this, &src_buffer, &dst_buffer, size ) ()
+					{
+						using Region = GpuMsg::CmdCopyBuffer::Region;
+
+						GpuMsg::CmdCopyBuffer	copy_cmd;
+						copy_cmd.srcBuffer	= src_buffer;
+						copy_cmd.dstBuffer	= dst_buffer;
+						copy_cmd.regions	= ArrayCRef<Region>{ Region{0_b, 0_b, size} };
+
+						cmdBuilder->Send( copy_cmd );
+						return true;
+					}) );
+
+		ModuleUtils::Send({ src_buffer, dst_buffer }, ModuleMsg::Delete{} );
+	}
+
+	LOG( "CopyBuffer - OK", ELog::Info );
+	return true;
+}
+
+/*
+=================================================
+	_Bench_Image2DBilinearFilter
+=================================================
+*/
+bool CApp::_Bench_Image2DBilinearFilter ()
+{
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	ModulePtr	sampler;
+	CHECK_ERR( factory->Create(
+					gpuIDs.sampler,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuSampler{
+						SamplerDescription::Builder()
+						.SetFilter( EFilter::MinMagMipLinear )
+						.SetAddressMode( EAddressMode::Repeat )
+						.Finish()
+					},
+					OUT sampler ) );
+	ModuleUtils::Initialize({ sampler });
+
+	CreateInfo::PipelineTemplate	pt_ci;
+	Pipelines::Create_image2dbilinearfilter( OUT pt_ci.descr );
+
+	const uint2		local_size	= Max( pt_ci.descr.localGroupSize.xy(), 1u );
+
+	for (uint size : { 128u, 512u, 1024u })
+	{
+		const uint2		img_dim		{ size };
+		const uint2		group_count	= (img_dim + local_size - 1) / local_size;
+
+		ModulePtr	src_image, dst_image, pipeline, resource_table;
+		CHECK_ERR( _CreateBenchImage2D( img_dim, EPixelFormat::RGBA8_UNorm, EImageUsage::Sampled, OUT src_image ) );
+		CHECK_ERR( _CreateBenchImage2D( img_dim, EPixelFormat::RGBA8_UNorm, EImageUsage::Storage, OUT dst_image ) );
+		CHECK_ERR( _CreateBenchPipeline( pt_ci, OUT pipeline, OUT resource_table ) );
+
+		resource_table->Send( GpuMsg::PipelineAttachTexture{ "un_SrcTexture", src_image, sampler, EImageLayout::ShaderReadOnlyOptimal });
+		resource_table->Send( ModuleMsg::AttachModule{ "un_DstImage", dst_image });
+
+		ModuleUtils::Initialize({ src_image, dst_image, pipeline, resource_table });
+
+		CHECK_ERR( _RunBenchmark( "Image2DBilinearFilter", "size="_str << size << 'x' << size, usize(size) * size, "pixels",
+					LAMBDA( this, &src_image, &dst_image, &pipeline, &resource_table, group_count ) ()
+					{
+						cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::TopOfPipe, EPipelineStage::ComputeShader }
+											.AddImage({	src_image,
+														EPipelineAccess::bits(),
+														EPipelineAccess::ShaderRead,
+														EImageLayout::Undefined,
+														EImageLayout::ShaderReadOnlyOptimal,
+														EImageAspect::Color })
+											.AddImage({	dst_image,
+														EPipelineAccess::bits(),
+														EPipelineAccess::ShaderWrite,
+														EImageLayout::Undefined,
+														EImageLayout::General,
+														EImageAspect::Color }) );
+
+						cmdBuilder->Send( GpuMsg::CmdBindComputePipeline{ pipeline });
+						cmdBuilder->Send( GpuMsg::CmdBindComputeResourceTable{ resource_table });
+						cmdBuilder->Send( GpuMsg::CmdDispatch{ uint3(group_count, 1) });
+						return true;
+					}) );
+
+		ModuleUtils::Send({ resource_table, pipeline, src_image, dst_image }, ModuleMsg::Delete{} );
+	}
+
+	LOG( "Image2DBilinearFilter - OK", ELog::Info );
+	return true;
+}
+
+/*
+=================================================
+	_Bench_ShaderBarrier
+----
+	shared memory and barriers in each work group.
+=================================================
+*/
+bool CApp::_Bench_ShaderBarrier ()
+{
+	CreateInfo::PipelineTemplate	pt_ci;
+	Pipelines::Create_shaderbarrier( OUT pt_ci.descr );
+
+	const uint2		local_size	= pt_ci.descr.localGroupSize.xy();
+
+	for (uint groups : { 4u, 16u, 64u })
+	{
+		const uint2		group_count { groups };
+		const uint2		img_dim		= local_size * group_count;
+
+		ModulePtr	src_image, dst_image, pipeline, resource_table;
+		CHECK_ERR( _CreateBenchImage2D( img_dim, EPixelFormat::RGBA32F, EImageUsage::Storage, OUT src_image ) );
+		CHECK_ERR( _CreateBenchImage2D( img_dim, EPixelFormat::RGBA32F, EImageUsage::Storage, OUT dst_image ) );
+		CHECK_ERR( _CreateBenchPipeline( pt_ci, OUT pipeline, OUT resource_table ) );
+
+		resource_table->Send( ModuleMsg::AttachModule{ "un_SrcImage", src_image });
+		resource_table->Send( ModuleMsg::AttachModule{ "un_DstImage", dst_image });
+
+		ModuleUtils::Initialize({ src_image, dst_image, pipeline, resource_table });
+
+		CHECK_ERR( _RunBenchmark( "ShaderBarrier", "groups="_str << groups << 'x' << groups, usize(img_dim.x) * img_dim.y, "pixels",
+					LAMBDA( this, &src_image, &dst_image, &pipeline, &resource_table, group_count ) ()
+					{
+						cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::TopOfPipe, EPipelineStage::ComputeShader }
+											.AddImage({	src_image,
+														EPipelineAccess::bits(),
+														EPipelineAccess::ShaderRead,
+														EImageLayout::Undefined,
+														EImageLayout::General,
+														EImageAspect::Color })
+											.AddImage({	dst_image,
+														EPipelineAccess::bits(),
+														EPipelineAccess::ShaderWrite,
+														EImageLayout::Undefined,
+														EImageLayout::General,
+														EImageAspect::Color }) );
+
+						cmdBuilder->Send( GpuMsg::CmdBindComputePipeline{ pipeline });
+						cmdBuilder->Send( GpuMsg::CmdBindComputeResourceTable{ resource_table });
+						cmdBuilder->Send( GpuMsg::CmdDispatch{ uint3(group_count, 1) });
+						return true;
+					}) );
+
+		ModuleUtils::Send({ resource_table, pipeline, src_image, dst_image }, ModuleMsg::Delete{} );
+	}
+
+	LOG( "ShaderBarrier - OK", ELog::Info );
+	return true;
+}
+
+/*
+=================================================
+	_RunBenchmark
+----
+	commands are recorded for each iteration,
+	only submission and waiting for fence are measured.
+	first iteration is warmup and not included to results.
+=================================================
+*/
+bool CApp::_RunBenchmark (StringCRef name, StringCRef params, usize workSize, StringCRef workUnit, const CmdRecorder_t &recorder)
+{
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	ModulePtr	cmd_buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.commandBuffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuCommandBuffer{ CommandBufferDescription{ ECmdBufferCreate::bits() | ECmdBufferCreate::ImplicitResetable }},
+					OUT cmd_buffer ) );
+	cmdBuilder->Send( ModuleMsg::AttachModule{ cmd_buffer });
+	ModuleUtils::Initialize({ cmd_buffer });
+
+	BenchResult		result;
+	result.name		= name;
+	result.params	= params;
+	result.workSize	= workSize;
+	result.workUnit	= workUnit;
+	result.repeats	= benchRepeats;
+	result.minMs	= MaxValue<double>();
+
+	TimeProfilerD	timer;
+
+	for (uint i = 0; i <= benchRepeats; ++i)
+	{
+		// build command buffer
+		cmdBuilder->Send( GpuMsg::CmdBegin{ cmd_buffer });
+
+		CHECK_ERR( recorder() );
+
+		GpuMsg::CmdEnd	cmd_end;
+		cmdBuilder->Send( cmd_end );
+
+		GpuMsg::CreateFence		fence_ctor;
+		syncManager->Send( fence_ctor );
+
+		// submit and sync
+		timer.Start();
+
+		gpuThread->Send( GpuMsg::SubmitCommands{ *cmd_end.result }.SetFence( *fence_ctor.result ));
+		syncManager->Send( GpuMsg::ClientWaitFence{ *fence_ctor.result });
+
+		const double	dt = timer.GetTimeDelta().MilliSeconds();
+
+		syncManager->Send( GpuMsg::DestroyFence{ *fence_ctor.result });
+
+		if ( i == 0 )
+			continue;
+
+		result.minMs  = Min( result.minMs, dt );
+		result.maxMs  = Max( result.maxMs, dt );
+		result.avgMs += dt;
+	}
+
+	result.avgMs /= double(benchRepeats);
+
+	cmdBuilder->Send( ModuleMsg::DetachModule{ cmd_buffer });
+	cmd_buffer->Send( ModuleMsg::Delete{} );
+
+	LOG( "bench "_str << name << " (" << params << "): avg " << result.avgMs << " ms, min " << result.minMs << " ms, max " << result.maxMs << " ms", ELog::Info );
+
+	benchResults.PushBack( RVREF(result) );
+	return true;
+}
+
+/*
+=================================================
+	_SaveBenchmarkResults
+=================================================
+*/
+bool CApp::_SaveBenchmarkResults () const
+{
+	// json
+	{
+		String	str;
+		str << "{\n"
+			<< "	\"api\": \"" << apiName << "\",\n"
+			<< "	\"repeats\": " << benchRepeats << ",\n"
+			<< "	\"results\": [\n";
+
+		FOR( i, benchResults )
+		{
+			const auto&		res = benchResults[i];
+
+			str << "		{ \"name\": \"" << res.name << "\", \"params\": \"" << res.params << "\""
+				<< ", \"work\": " << res.workSize << ", \"unit\": \"" << res.workUnit << "\""
+				<< ", \"repeats\": " << res.repeats
+				<< ", \"min_ms\": " << res.minMs << ", \"avg_ms\": " << res.avgMs << ", \"max_ms\": " << res.maxMs
+				<< ", \"per_second\": " << (double(res.workSize) * 1.0e+3 / Max( res.avgMs, 1.0e-6 )) << " }"
+				<< (i+1 < benchResults.Count() ? ",\n" : "\n");
+		}
+		str << "	]\n}\n";
+
+		GXFile::WFilePtr	file = GXFile::HddWFile::New( String(benchOutput) << ".json" );
+		CHECK_ERR( file );
+		CHECK_ERR( file->Write( StringCRef(str) ) );
+	}
+
+	// csv
+	{
+		String	str;
+		str << "api,name,params,work,unit,repeats,min_ms,avg_ms,max_ms,per_second\n";
+
+		FOR( i, benchResults )
+		{
+			const auto&		res = benchResults[i];
+
+			str << apiName << ',' << res.name << ',' << res.params << ',' << res.workSize << ',' << res.workUnit << ','
+				<< res.repeats << ',' << res.minMs << ',' << res.avgMs << ',' << res.maxMs << ','
+				<< (double(res.workSize) * 1.0e+3 / Max( res.avgMs, 1.0e-6 )) << '\n';
+		}
+
+		GXFile::WFilePtr	file = GXFile::HddWFile::New( String(benchOutput) << ".csv" );
+		CHECK_ERR( file );
+		CHECK_ERR( file->Write( StringCRef(str) ) );
+	}
+
+	LOG( "benchmark results saved to '"_str << benchOutput << ".json' and '.csv'", ELog::Info );
+	return true;
+}
+
+/*
+=================================================
+	_CreateBenchPipeline
+----
+	resources must be attached to resource table
+	before initialization.
+=================================================
+*/
+bool CApp::_CreateBenchPipeline (const CreateInfo::PipelineTemplate &ci, OUT ModulePtr &pipeline, OUT ModulePtr &resourceTable)
+{
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	ModulePtr	pipeline_template;
+	CHECK_ERR( factory->Create(
+					PipelineTemplateModuleID,
+					gpuThread->GlobalSystems(),
+					ci,
+					OUT pipeline_template ) );
+	ModuleUtils::Initialize({ pipeline_template });
+
+	GpuMsg::CreateComputePipeline	cppl_ctor{ gpuIDs.pipeline, gpuThread };
+	pipeline_template->Send( cppl_ctor );
+
+	pipeline = *cppl_ctor.result;
+	CHECK_ERR( pipeline );
+
+	CHECK_ERR( factory->Create(
+					gpuIDs.resourceTable,
+					gpuThread->GlobalSystems(),
+					CreateInfo::PipelineResourceTable{},
+					OUT resourceTable ) );
+
+	resourceTable->Send( ModuleMsg::AttachModule{ "pipeline", pipeline });
+	return true;
+}
+
+/*
+=================================================
+	_CreateBenchImage2D
+=================================================
+*/
+bool CApp::_CreateBenchImage2D (const uint2 &dim, EPixelFormat::type format, EImageUsage::bits usage, OUT ModulePtr &image, MipmapLevel maxLevel)
+{
+	CHECK_ERR( ms->GlobalSystems()->modulesFactory->Create(
+					gpuIDs.image,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuImage{
+						ImageDescription{ EImage::Tex2D, uint4(dim), format, usage, maxLevel },
+						EGpuMemory::LocalInGPU | EGpuMemory::Dedicated,
+						EMemoryAccess::GpuReadWrite },
+					OUT image ) );
+	return true;
+}
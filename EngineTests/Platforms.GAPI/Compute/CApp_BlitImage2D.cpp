@@ -0,0 +1,261 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CApp.h"
+
+/*
+=================================================
+	_Test_BlitImage2D
+=================================================
+*/
+bool CApp::_Test_BlitImage2D ()
+{
+	const uint2		img_dim		{64, 64};
+	const uint2		img2_dim	= img_dim * 2;
+	const uint		num_levels	= 7;
+
+
+	// create resources
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	GpuMsg::CreateFence		fence_ctor;
+	syncManager->Send( fence_ctor );
+
+	ModulePtr	cmd_buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.commandBuffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuCommandBuffer{},
+					OUT cmd_buffer ) );
+	cmdBuilder->Send( ModuleMsg::AttachModule{ cmd_buffer });
+
+	ModulePtr	src_image;
+	CHECK_ERR( factory->Create(
+					gpuIDs.image,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuImage{
+						ImageDescription{ EImage::Tex2D, uint4(img_dim), EPixelFormat::RGBA8_UNorm,
+										  EImageUsage::TransferSrc | EImageUsage::TransferDst, MipmapLevel(num_levels) },
+						EGpuMemory::CoherentWithCPU },
+					OUT src_image ) );
+
+	ModulePtr	dst_image;
+	CHECK_ERR( factory->Create(
+					gpuIDs.image,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuImage{
+						ImageDescription{ EImage::Tex2D, uint4(img2_dim), EPixelFormat::RGBA32F, EImageUsage::TransferDst },
+						EGpuMemory::CoherentWithCPU },
+					OUT dst_image ) );
+
+	ModuleUtils::Initialize({ cmd_buffer, src_image, dst_image });
+
+
+	// generate image data
+	GpuMsg::GetImageMemoryLayout	req_src_layout;
+	src_image->Send( req_src_layout );
+
+	const BytesU	src_pitch	= req_src_layout.result->rowPitch;
+
+	BinaryArray		image_data;		image_data.Resize( usize(src_pitch * req_src_layout.result->dimension.y) );
+
+	FOR( i, image_data ) {
+		image_data[i] = Random::Int<ubyte>();
+	}
+
+	// write data to image
+	GpuMsg::WriteToImageMemory		write_cmd{ image_data, uint3(), uint3(img_dim), src_pitch };
+	src_image->Send( write_cmd );
+	CHECK_ERR( *write_cmd.wasWritten == image_data.Size() );
+
+
+	// build command buffer
+	cmdBuilder->Send( GpuMsg::CmdBegin{ cmd_buffer });
+
+	cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::Host, EPipelineStage::Transfer }
+						.AddImage({	src_image,
+									EPipelineAccess::HostWrite,
+									EPipelineAccess::TransferRead | EPipelineAccess::TransferWrite,
+									EImageLayout::Preinitialized,
+									EImageLayout::General,
+									EImageAspect::Color, 0_mipmap, num_levels }) );
+
+	cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::TopOfPipe, EPipelineStage::Transfer }
+						.AddImage({	dst_image,
+									EPipelineAccess::bits(),
+									EPipelineAccess::TransferWrite,
+									EImageLayout::Preinitialized,
+									EImageLayout::TransferDstOptimal,
+									EImageAspect::Color }) );
+
+	// upscale with format conversion
+	cmdBuilder->Send( GpuMsg::CmdBlitImage{ src_image, EImageLayout::General, dst_image, EImageLayout::TransferDstOptimal, false }
+						.AddRegion( ImageRange{ EImageAspect::Color, 0_mipmap, 0_layer, 1 },
+									uint3(0), uint3(img_dim, 1),
+									ImageRange{ EImageAspect::Color, 0_mipmap, 0_layer, 1 },
+									uint3(0), uint3(img2_dim, 1) ));
+
+	// generate mipmaps
+	for (uint i = 1; i < num_levels; ++i)
+	{
+		const uint2		src_dim	= Max( img_dim >> (i-1), 1u );
+		const uint2		dst_dim	= Max( img_dim >> i, 1u );
+
+		cmdBuilder->Send( GpuMsg::CmdBlitImage{ src_image, EImageLayout::General, src_image, EImageLayout::General, true }
+							.AddRegion( ImageRange{ EImageAspect::Color, MipmapLevel(i-1), 0_layer, 1 },
+										uint3(0), uint3(src_dim, 1),
+										ImageRange{ EImageAspect::Color, MipmapLevel(i), 0_layer, 1 },
+										uint3(0), uint3(dst_dim, 1) ));
+
+		cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::Transfer, EPipelineStage::Transfer }
+							.AddImage({	src_image,
+										EPipelineAccess::TransferWrite,
+										EPipelineAccess::TransferRead,
+										EImageLayout::General,
+										EImageLayout::General,
+										EImageAspect::Color, MipmapLevel(i), 1 }) );
+	}
+
+	cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::Transfer, EPipelineStage::Host }
+						.AddImage({	dst_image,
+									EPipelineAccess::TransferWrite,
+									EPipelineAccess::HostRead,
+									EImageLayout::TransferDstOptimal,
+									EImageLayout::General,
+									EImageAspect::Color })
+						.AddImage({	src_image,
+									EPipelineAccess::TransferWrite,
+									EPipelineAccess::HostRead,
+									EImageLayout::General,
+									EImageLayout::General,
+									EImageAspect::Color, 0_mipmap, num_levels }) );
+
+	GpuMsg::CmdEnd	cmd_end;
+	cmdBuilder->Send( cmd_end );
+
+
+	// submit and sync
+	gpuThread->Send( GpuMsg::SubmitCommands{ *cmd_end.result }.SetFence( *fence_ctor.result ));
+
+	syncManager->Send( GpuMsg::ClientWaitFence{ *fence_ctor.result });
+
+
+	// read from images
+	GpuMsg::GetImageMemoryLayout	req_dst_layout;
+	dst_image->Send( req_dst_layout );
+
+	const BytesU	dst_pitch	= req_dst_layout.result->rowPitch;
+
+	BinaryArray	dst_data;	dst_data.Resize( usize(dst_pitch * req_dst_layout.result->dimension.y) );
+
+	GpuMsg::ReadFromImageMemory		read_cmd{ dst_data, uint3(), uint3(img2_dim), dst_pitch };
+	dst_image->Send( read_cmd );
+	CHECK_ERR( dst_data.Size() == read_cmd.result->Size() );
+
+	const uint2		mip_dim		= img_dim / 2;
+	const BytesU	mip_pitch	= SizeOf<ubyte4> * mip_dim.x;
+
+	BinaryArray	mip_data;	mip_data.Resize( usize(mip_pitch * mip_dim.y) );
+
+	GpuMsg::ReadFromImageMemory		read_mip_cmd{ mip_data, uint3(), uint3(mip_dim), mip_pitch };
+	read_mip_cmd.mipLevel = 1_mipmap;
+	src_image->Send( read_mip_cmd );
+	CHECK_ERR( mip_data.Size() == read_mip_cmd.result->Size() );
+
+
+	// compare nearest upscale
+	for (uint y = 0; y < img2_dim.y; ++y)
+	{
+		ubyte4 const*	src_row = Cast<ubyte4 const*>(image_data.ptr() + src_pitch * (y / 2));
+		float4 const*	dst_row = Cast<float4 const*>(dst_data.ptr() + dst_pitch * y);
+
+		for (uint x = 0; x < img2_dim.x; ++x)
+		{
+			const float4	src = float4(src_row[ x / 2 ]) / 255.0f;
+			const float4	dst = dst_row[ x ];
+
+			CHECK_ERR(All( Abs( src - dst ) < 1.0e-4f ));
+		}
+	}
+
+	// compare mipmap with 2x2 box filter
+	for (uint y = 0; y < mip_dim.y; ++y)
+	{
+		ubyte4 const*	src_row0 = Cast<ubyte4 const*>(image_data.ptr() + src_pitch * (y*2));
+		ubyte4 const*	src_row1 = Cast<ubyte4 const*>(image_data.ptr() + src_pitch * (y*2 + 1));
+		ubyte4 const*	dst_row	 = Cast<ubyte4 const*>(mip_data.ptr() + mip_pitch * y);
+
+		for (uint x = 0; x < mip_dim.x; ++x)
+		{
+			const int4	sum = int4(src_row0[x*2]) + int4(src_row0[x*2+1]) + int4(src_row1[x*2]) + int4(src_row1[x*2+1]);
+			const int4	dst = int4(dst_row[x]);
+
+			// allow rounding difference between implementations
+			CHECK_ERR(All( Abs( (sum + 2) / 4 - dst ) <= 1 ));
+		}
+	}
+
+	LOG( "BlitImage2D - OK", ELog::Info );
+	return true;
+}
+
+/*
+=================================================
+	_Bench_GenerateMipmaps2D
+----
+	generates full mipmap chain by
+	blitting each level to the next one.
+=================================================
+*/
+bool CApp::_Bench_GenerateMipmaps2D ()
+{
+	const uint2		img_dim		{4096, 4096};
+	const uint		num_levels	= GXImageUtils::GetNumberOfMipmaps( img_dim.Max() ) + 1;
+
+	usize	num_pixels = 0;
+	for (uint i = 1; i < num_levels; ++i) {
+		num_pixels += Max( img_dim >> i, 1u ).Area();
+	}
+
+	for (EPixelFormat::type format : { EPixelFormat::RGBA8_UNorm, EPixelFormat::RGBA16F })
+	{
+		ModulePtr	image;
+		CHECK_ERR( _CreateBenchImage2D( img_dim, format, EImageUsage::TransferSrc | EImageUsage::TransferDst, OUT image, MipmapLevel(num_levels) ) );
+
+		ModuleUtils::Initialize({ image });
+
+		CHECK_ERR( _RunBenchmark( "GenerateMipmaps2D", "format="_str << EPixelFormat::ToString( format ) << ", size=" << img_dim.x, num_pixels, "pixels",
+					LAMBDA( this, &image, &img_dim, num_levels ) ()
+					{
+						cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::TopOfPipe, EPipelineStage::Transfer }
+											.AddImage({	image,
+														EPipelineAccess::bits(),
+														EPipelineAccess::TransferRead | EPipelineAccess::TransferWrite,
+														EImageLayout::Undefined,
+														EImageLayout::General,
+														EImageAspect::Color, 0_mipmap, num_levels }) );
+
+						for (uint i = 1; i < num_levels; ++i)
+						{
+							cmdBuilder->Send( GpuMsg::CmdBlitImage{ image, EImageLayout::General, image, EImageLayout::General, true }
+												.AddRegion( ImageRange{ EImageAspect::Color, MipmapLevel(i-1), 0_layer, 1 },
+															uint3(0), uint3(Max( img_dim >> (i-1), 1u ), 1),
+															ImageRange{ EImageAspect::Color, MipmapLevel(i), 0_layer, 1 },
+															uint3(0), uint3(Max( img_dim >> i, 1u ), 1) ));
+
+							cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::Transfer, EPipelineStage::Transfer }
+												.AddImage({	image,
+															EPipelineAccess::TransferWrite,
+															EPipelineAccess::TransferRead,
+															EImageLayout::General,
+															EImageLayout::General,
+															EImageAspect::Color, MipmapLevel(i), 1 }) );
+						}
+						return true;
+					}) );
+
+		image->Send( ModuleMsg::Delete{} );
+	}
+
+	LOG( "GenerateMipmaps2D - OK", ELog::Info );
+	return true;
+}
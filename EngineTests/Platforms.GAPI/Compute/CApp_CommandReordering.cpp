@@ -0,0 +1,175 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+/*
+	Commands may be reordered by command buffer, but commands that access
+	the same memory must be executed in the recorded order.
+	Buffer update and copy may be deferred to the end of batch, image copies are not,
+	so missed dependency changes the result.
+*/
+
+#include "CApp.h"
+
+bool CApp::_Test_CommandReordering ()
+{
+	using Pixel		= ubyte4;
+
+	const uint2		img_dim		{32, 16};
+	const BytesU	data_size	= BytesU(img_dim.x * img_dim.y * sizeof(Pixel));
+	const uint		row_length	= img_dim.x;
+
+	// generate data
+	BinaryArray		data1;	data1.Resize( usize(data_size) );
+	BinaryArray		data2;	data2.Resize( usize(data_size) );
+	BinaryArray		zeros;	zeros.Resize( usize(data_size) );
+
+	FOR( i, data1 ) {
+		data1[i] = Random::Int<ubyte>();
+		data2[i] = ~data1[i];
+		zeros[i] = 0;
+	}
+
+
+	// create resources
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	ModulePtr	buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.buffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuBuffer{
+						BufferDescription{ data_size, EBufferUsage::TransferSrc | EBufferUsage::TransferDst },
+						EGpuMemory::CoherentWithCPU },
+					OUT buffer ) );
+
+	ModulePtr	dst_buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.buffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuBuffer{
+						BufferDescription{ data_size, EBufferUsage::TransferDst },
+						EGpuMemory::CoherentWithCPU },
+					OUT dst_buffer ) );
+
+	ModulePtr	dst_image;
+	CHECK_ERR( factory->Create(
+					gpuIDs.image,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuImage{
+						ImageDescription{ EImage::Tex2D, uint4(img_dim), EPixelFormat::RGBA8U, EImageUsage::TransferDst },
+						EGpuMemory::CoherentWithCPU },
+					OUT dst_image ) );
+
+	ModulePtr	src_image;
+	CHECK_ERR( factory->Create(
+					gpuIDs.image,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuImage{
+						ImageDescription{ EImage::Tex2D, uint4(img_dim), EPixelFormat::RGBA8U, EImageUsage::TransferSrc },
+						EGpuMemory::CoherentWithCPU },
+					OUT src_image ) );
+
+	ModuleUtils::Initialize({ buffer, dst_buffer, dst_image, src_image });
+
+
+	// write initial data
+	GpuMsg::WriteToGpuMemory	write_buf{ zeros };
+	buffer->Send( write_buf );
+	CHECK_ERR( *write_buf.wasWritten == zeros.Size() );
+
+	GpuMsg::GetImageMemoryLayout	req_layout;
+	src_image->Send( req_layout );
+
+	const BytesU	img_pitch	= req_layout.result->rowPitch;
+	BinaryArray		image_data;	image_data.Resize( usize(img_pitch * img_dim.y) );
+
+	for (uint y = 0; y < img_dim.y; ++y) {
+		UnsafeMem::MemCopy( image_data.ptr() + usize(img_pitch * y), data2.ptr() + y * row_length * sizeof(Pixel), BytesU(row_length * sizeof(Pixel)) );
+	}
+
+	GpuMsg::WriteToImageMemory	write_img{ image_data, uint3(), uint3(img_dim), img_pitch };
+	src_image->Send( write_img );
+	CHECK_ERR( *write_img.wasWritten == image_data.Size() );
+
+
+	// build command buffer
+	cmdBuilder->Send( GpuMsg::CmdBegin{} );
+
+	cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::TopOfPipe, EPipelineStage::Transfer }
+						.AddImage({	dst_image,
+									EPipelineAccess::bits(),
+									EPipelineAccess::TransferWrite,
+									EImageLayout::Undefined,
+									EImageLayout::TransferDstOptimal,
+									EImageAspect::Color })
+						.AddImage({	src_image,
+									EPipelineAccess::HostWrite,
+									EPipelineAccess::TransferRead,
+									EImageLayout::Undefined,
+									EImageLayout::TransferSrcOptimal,
+									EImageAspect::Color }) );
+
+	// 'buffer' = data1
+	cmdBuilder->Send( GpuMsg::CmdUpdateBuffer{ buffer, data1 });
+
+	// read after write: 'dst_image' = data1
+	cmdBuilder->Send( GpuMsg::CmdCopyBufferToImage{ buffer, dst_image, EImageLayout::TransferDstOptimal }
+						.AddRegion( 0_b, row_length, img_dim.y,
+									ImageRange{ EImageAspect::Color, 0_mipmap, 0_layer, 1 },
+									uint3(), uint3(img_dim, 1) ));
+
+	// write after read and write after write: 'buffer' = data2
+	cmdBuilder->Send( GpuMsg::CmdCopyImageToBuffer{ src_image, EImageLayout::TransferSrcOptimal, buffer }
+						.AddRegion( 0_b, row_length, img_dim.y,
+									ImageRange{ EImageAspect::Color, 0_mipmap, 0_layer, 1 },
+									uint3(), uint3(img_dim, 1) ));
+
+	// read after write: 'dst_buffer' = data2
+	cmdBuilder->Send( GpuMsg::CmdCopyBuffer{ buffer, dst_buffer }.AddRegion( 0_b, 0_b, data_size ));
+
+	cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::Transfer, EPipelineStage::Host }
+						.AddImage({	dst_image,
+									EPipelineAccess::TransferWrite,
+									EPipelineAccess::HostRead,
+									EImageLayout::TransferDstOptimal,
+									EImageLayout::General,
+									EImageAspect::Color }) );
+
+	GpuMsg::CmdEnd	cmd_end;
+	cmdBuilder->Send( cmd_end );
+
+	GpuMsg::CreateFence		fence_ctor;
+	syncManager->Send( fence_ctor );
+
+
+	// submit and sync
+	gpuThread->Send( GpuMsg::SubmitCommands{ *cmd_end.result }.SetFence( *fence_ctor.result ));
+	syncManager->Send( GpuMsg::ClientWaitFence{ *fence_ctor.result });
+
+
+	// read
+	BinaryArray		buf_data;		buf_data.Resize( usize(data_size) );
+	BinaryArray		dst_buf_data;	dst_buf_data.Resize( usize(data_size) );
+
+	CHECK_ERR( BinArrayCRef(buffer->Request( GpuMsg::ReadFromGpuMemory{ buf_data })) == BinArrayCRef(data2) );
+	CHECK_ERR( BinArrayCRef(dst_buffer->Request( GpuMsg::ReadFromGpuMemory{ dst_buf_data })) == BinArrayCRef(data2) );
+
+	GpuMsg::GetImageMemoryLayout	req_dst_layout;
+	dst_image->Send( req_dst_layout );
+
+	const BytesU	dst_pitch	= req_dst_layout.result->rowPitch;
+	BinaryArray		dst_img_data;	dst_img_data.Resize( usize(dst_pitch * img_dim.y) );
+
+	GpuMsg::ReadFromImageMemory		read_img{ dst_img_data, uint3(), uint3(img_dim), dst_pitch };
+	dst_image->Send( read_img );
+	CHECK_ERR( dst_img_data.Size() == read_img.result->Size() );
+
+	for (uint y = 0; y < img_dim.y; ++y)
+	{
+		const BinArrayCRef	row		= BinArrayCRef(dst_img_data).SubArray( usize(dst_pitch * y), row_length * sizeof(Pixel) );
+		const BinArrayCRef	expected	= BinArrayCRef(data1).SubArray( y * row_length * sizeof(Pixel), row_length * sizeof(Pixel) );
+
+		CHECK_ERR( row == expected );
+	}
+
+	LOG( "CommandReordering - OK", ELog::Info );
+	return true;
+}
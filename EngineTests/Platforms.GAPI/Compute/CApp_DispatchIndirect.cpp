@@ -0,0 +1,136 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CApp.h"
+#include "Pipelines/all_pipelines.h"
+
+bool CApp::_Test_DispatchIndirect ()
+{
+	// indirect dispatch is not implemented in OpenGL and OpenCL backends
+	if ( not StringCRef(apiName).StartsWith( "SW" ) and not StringCRef(apiName).StartsWith( "VK" ) )
+		return true;
+
+	// generate data
+	Pipelines::BufferAlign_Struct	st1;
+	st1.b1	= true;
+	st1.b3	= Bool32_3( false, true, true );
+	st1.f1	= 2.5f;
+	st1.f2	= float2( 1.25f, -7.5f );
+	st1.i1	= -356;
+	st1.i4	= int4( 11, -22, 33, -44 );
+	st1.u3	= uint3( 100, 200, 300 );
+
+	const BytesU	buf_size = SizeOf<Pipelines::BufferAlign_Struct> * 3;
+
+	// first command has zero work groups and must be skipped,
+	// layout of each command is the same as in VkDispatchIndirectCommand
+	const uint4		indirect_data[] = { uint4( 0, 1, 1, 0 ), uint4( 1, 1, 1, 0 ) };
+
+
+	// create resources
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	GpuMsg::CreateFence		fence_ctor;
+	syncManager->Send( fence_ctor );
+
+	ModulePtr	cmd_buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.commandBuffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuCommandBuffer{},
+					OUT cmd_buffer ) );
+	cmdBuilder->Send( ModuleMsg::AttachModule{ cmd_buffer });
+
+	ModulePtr	buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.buffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuBuffer{
+						BufferDescription{ buf_size, EBufferUsage::Storage },
+						EGpuMemory::CoherentWithCPU },
+					OUT buffer ) );
+
+	ModulePtr	indirect_buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.buffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuBuffer{
+						BufferDescription{ BytesU::SizeOf(indirect_data), EBufferUsage::Indirect },
+						EGpuMemory::CoherentWithCPU },
+					OUT indirect_buffer ) );
+
+	CreateInfo::PipelineTemplate	pt_ci;
+	Pipelines::Create_bufferalign( OUT pt_ci.descr );
+
+	ModulePtr	pipeline_template;
+	CHECK_ERR( factory->Create(
+					PipelineTemplateModuleID,
+					gpuThread->GlobalSystems(),
+					pt_ci,
+					OUT pipeline_template ) );
+	ModuleUtils::Initialize({ pipeline_template });
+
+	GpuMsg::CreateComputePipeline	cppl_ctor{ gpuIDs.pipeline, gpuThread };
+	pipeline_template->Send( cppl_ctor );
+
+	ModulePtr	pipeline	= *cppl_ctor.result;
+	ModulePtr	resource_table;
+	CHECK_ERR( factory->Create(
+					gpuIDs.resourceTable,
+					gpuThread->GlobalSystems(),
+					CreateInfo::PipelineResourceTable{},
+					OUT resource_table ) );
+
+	resource_table->Send( ModuleMsg::AttachModule{ "pipeline", pipeline });
+	resource_table->Send( ModuleMsg::AttachModule{ "ssb", buffer });
+
+	ModuleUtils::Initialize({ cmd_buffer, buffer, indirect_buffer, pipeline, resource_table });
+
+
+	// write data to buffers
+	GpuMsg::WriteToGpuMemory	write_cmd{ BinArrayCRef::FromValue(st1) };
+	buffer->Send( write_cmd );
+	CHECK_ERR( *write_cmd.wasWritten == BytesU::SizeOf(st1) );
+
+	GpuMsg::WriteToGpuMemory	write_indirect_cmd{ BinArrayCRef::FromValue(indirect_data) };
+	indirect_buffer->Send( write_indirect_cmd );
+	CHECK_ERR( *write_indirect_cmd.wasWritten == BytesU::SizeOf(indirect_data) );
+
+
+	// build command buffer
+	cmdBuilder->Send( GpuMsg::CmdBegin{ cmd_buffer });
+
+	cmdBuilder->Send( GpuMsg::CmdBindComputePipeline{ pipeline });
+	cmdBuilder->Send( GpuMsg::CmdBindComputeResourceTable{ resource_table });
+	cmdBuilder->Send( GpuMsg::CmdDispatchIndirect{ indirect_buffer, 0_b });
+	cmdBuilder->Send( GpuMsg::CmdDispatchIndirect{ indirect_buffer, SizeOf<uint4> });
+
+	GpuMsg::CmdEnd	cmd_end;
+	cmdBuilder->Send( cmd_end );
+
+
+	// submit and sync
+	gpuThread->Send( GpuMsg::SubmitCommands{ *cmd_end.result }.SetFence( *fence_ctor.result ));
+
+	syncManager->Send( GpuMsg::ClientWaitFence{ *fence_ctor.result });
+
+
+	// read from buffer, shader copies first struct to second and writes constants to third
+	BinaryArray	dst_data;	dst_data.Resize( usize(buf_size) );
+
+	GpuMsg::ReadFromGpuMemory	read_cmd{ dst_data };
+	buffer->Send( read_cmd );
+
+	Pipelines::BufferAlign_Struct const*	res_st = reinterpret_cast< Pipelines::BufferAlign_Struct const *>( dst_data.ptr() );
+
+	++res_st;
+	CHECK_ERR(	All( st1.b1			== res_st->b1		)	and
+				All( st1.b3.xyz()	== res_st->b3.xyz() )	and
+				All( st1.f1			== res_st->f1		)	and
+				All( st1.f2.xy()	== res_st->f2.xy()	)	and
+				All( st1.i1			== res_st->i1		)	and
+				All( st1.i4.xyzw()	== res_st->i4.xyzw())	and
+				All( st1.u3.xyz()	== res_st->u3.xyz() )	);
+
+	LOG( "DispatchIndirect - OK", ELog::Info );
+	return true;
+}
@@ -0,0 +1,124 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CApp.h"
+#include "Pipelines/all_pipelines.h"
+#include "Engine/Profilers/Engine.Profilers.h"
+
+bool CApp::_Test_GpuProfiler ()
+{
+	// pipeline statistic for compute shader is supported only in software renderer
+	if ( not StringCRef(apiName).StartsWith( "SW" ) )
+		return true;
+
+	using Scope_t = ProfilerMsg::GetGpuProfilerResults::Scope;
+
+
+	// create resources
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	GpuMsg::CreateFence		fence_ctor;
+	syncManager->Send( fence_ctor );
+
+	ModulePtr	cmd_buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.commandBuffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuCommandBuffer{},
+					OUT cmd_buffer ) );
+	cmdBuilder->Send( ModuleMsg::AttachModule{ cmd_buffer });
+
+	ModulePtr	buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.buffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuBuffer{
+						BufferDescription{ SizeOf<Pipelines::BufferAlign_Struct> * 3, EBufferUsage::Storage },
+						EGpuMemory::CoherentWithCPU },
+					OUT buffer ) );
+
+	CreateInfo::PipelineTemplate	pt_ci;
+	Pipelines::Create_bufferalign( OUT pt_ci.descr );
+
+	ModulePtr	pipeline_template;
+	CHECK_ERR( factory->Create(
+					PipelineTemplateModuleID,
+					gpuThread->GlobalSystems(),
+					pt_ci,
+					OUT pipeline_template ) );
+	ModuleUtils::Initialize({ pipeline_template });
+
+	GpuMsg::CreateComputePipeline	cppl_ctor{ gpuIDs.pipeline, gpuThread };
+	pipeline_template->Send( cppl_ctor );
+
+	ModulePtr	pipeline	= *cppl_ctor.result;
+	ModulePtr	resource_table;
+	CHECK_ERR( factory->Create(
+					gpuIDs.resourceTable,
+					gpuThread->GlobalSystems(),
+					CreateInfo::PipelineResourceTable{},
+					OUT resource_table ) );
+
+	resource_table->Send( ModuleMsg::AttachModule{ "pipeline", pipeline });
+	resource_table->Send( ModuleMsg::AttachModule{ "ssb", buffer });
+
+	CreateInfo::GpuProfiler		prof_ci;
+	prof_ci.gpuThread	= gpuThread;
+	prof_ci.maxScopes	= 4;
+	prof_ci.statistic	= EPipelineStatistic::bits().Set( EPipelineStatistic::ComputeShaderInvocations ).Set( EPipelineStatistic::ComputeShaderWorkGroups );
+
+	ModulePtr	profiler;
+	CHECK_ERR( factory->Create(
+					Profilers::GpuProfilerModuleID,
+					ms->GlobalSystems(),
+					prof_ci,
+					OUT profiler ) );
+
+	ModuleUtils::Initialize({ cmd_buffer, buffer, pipeline, resource_table, profiler });
+
+
+	// build command buffer, dispatch is recorded in nested scope
+	cmdBuilder->Send( GpuMsg::CmdBegin{ cmd_buffer });
+
+	profiler->Send( ProfilerMsg::GpuProfilerBeginFrame{ cmdBuilder });
+	profiler->Send( ProfilerMsg::GpuProfilerBeginScope{ cmdBuilder, "frame" });
+	profiler->Send( ProfilerMsg::GpuProfilerBeginScope{ cmdBuilder, "dispatch" });
+
+	cmdBuilder->Send( GpuMsg::CmdBindComputePipeline{ pipeline });
+	cmdBuilder->Send( GpuMsg::CmdBindComputeResourceTable{ resource_table });
+	cmdBuilder->Send( GpuMsg::CmdDispatch{ uint3(2, 1, 1) });
+
+	profiler->Send( ProfilerMsg::GpuProfilerEndScope{ cmdBuilder });
+	profiler->Send( ProfilerMsg::GpuProfilerEndScope{ cmdBuilder });
+	profiler->Send( ProfilerMsg::GpuProfilerEndFrame{ cmdBuilder });
+
+	GpuMsg::CmdEnd	cmd_end;
+	cmdBuilder->Send( cmd_end );
+
+
+	// submit and sync
+	gpuThread->Send( GpuMsg::SubmitCommands{ *cmd_end.result }.SetFence( *fence_ctor.result ));
+
+	syncManager->Send( GpuMsg::ClientWaitFence{ *fence_ctor.result });
+
+
+	// check results, statistic is in order of flags and only for top level scope
+	ProfilerMsg::GetGpuProfilerResults	req_results;
+	profiler->Send( req_results );
+
+	ArrayCRef< Scope_t >	results = *req_results.result;
+
+	CHECK_ERR( results.Count() == 2 );
+	CHECK_ERR( results[0].name == "frame" and results[0].depth == 0 );
+	CHECK_ERR( results[1].name == "dispatch" and results[1].depth == 1 );
+	CHECK_ERR( results[0].time >= results[1].time );
+
+	CHECK_ERR( results[0].statistic.Count() == 2 );
+	CHECK_ERR( results[0].statistic[0] == 2 );		// invocations, local group size is 1
+	CHECK_ERR( results[0].statistic[1] == 2 );		// work groups
+	CHECK_ERR( results[1].statistic.Empty() );
+
+	profiler->Send( ModuleMsg::Delete{} );
+
+	LOG( "GpuProfiler - OK, dispatch time: "_str << ToString( results[1].time ), ELog::Info );
+	return true;
+}
@@ -0,0 +1,107 @@
+// Copyright (c)  Zhirnov Andrey. For more information see 'LICENSE.txt'
+
+#include "CApp.h"
+
+bool CApp::_Test_QueryTimestamp ()
+{
+	if ( gpuIDs.queryPool == OModID::type(0) )
+	{
+		LOG( "QueryTimestamp - skipped, queries are not supported", ELog::Info );
+		return true;
+	}
+
+	const BytesU	buf_size	= 1_Mb;
+	const uint		num_queries	= 2;
+
+
+	// create resources
+	auto	factory	= ms->GlobalSystems()->modulesFactory;
+
+	GpuMsg::CreateFence		fence_ctor;
+	syncManager->Send( fence_ctor );
+
+	ModulePtr	cmd_buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.commandBuffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuCommandBuffer{},
+					OUT cmd_buffer ) );
+	cmdBuilder->Send( ModuleMsg::AttachModule{ cmd_buffer });
+
+	ModulePtr	buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.buffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuBuffer{
+						BufferDescription{ buf_size, EBufferUsage::TransferDst },
+						EGpuMemory::CoherentWithCPU },
+					OUT buffer ) );
+
+	ModulePtr	result_buffer;
+	CHECK_ERR( factory->Create(
+					gpuIDs.buffer,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuBuffer{
+						BufferDescription{ SizeOf<ulong> * num_queries, EBufferUsage::TransferDst },
+						EGpuMemory::CoherentWithCPU },
+					OUT result_buffer ) );
+
+	ModulePtr	query_pool;
+	CHECK_ERR( factory->Create(
+					gpuIDs.queryPool,
+					gpuThread->GlobalSystems(),
+					CreateInfo::GpuQueryPool{ QueryPoolDescription{ EQuery::Timestamp, num_queries } },
+					OUT query_pool ) );
+
+	ModuleUtils::Initialize({ cmd_buffer, buffer, result_buffer, query_pool });
+
+
+	// build command buffer
+	cmdBuilder->Send( GpuMsg::CmdBegin{ cmd_buffer });
+
+	cmdBuilder->Send( GpuMsg::CmdResetQueryPool{ query_pool, 0, num_queries });
+	cmdBuilder->Send( GpuMsg::CmdWriteTimestamp{ query_pool, 0, EPipelineStage::TopOfPipe });
+
+	cmdBuilder->Send( GpuMsg::CmdFillBuffer{ buffer, 0x12345678 });
+
+	cmdBuilder->Send( GpuMsg::CmdWriteTimestamp{ query_pool, 1, EPipelineStage::BottomOfPipe });
+
+	cmdBuilder->Send( GpuMsg::CmdCopyQueryPoolResults{}
+						.SetSource( query_pool, 0, num_queries )
+						.SetDestination( result_buffer, 0_b )
+						.SetFlags( EQueryResult::bits().Set( EQueryResult::Wait )) );
+
+	cmdBuilder->Send( GpuMsg::CmdPipelineBarrier{ EPipelineStage::Transfer, EPipelineStage::Host }
+						.AddBuffer({ result_buffer,
+									 EPipelineAccess::TransferWrite,
+									 EPipelineAccess::HostRead,
+									 0_b, SizeOf<ulong> * num_queries }) );
+
+	GpuMsg::CmdEnd	cmd_end;
+	cmdBuilder->Send( cmd_end );
+
+
+	// submit and sync
+	gpuThread->Send( GpuMsg::SubmitCommands{ *cmd_end.result }.SetFence( *fence_ctor.result ));
+
+	syncManager->Send( GpuMsg::ClientWaitFence{ *fence_ctor.result });
+
+
+	// read timestamps
+	ulong	timestamps[num_queries] = {};
+
+	GpuMsg::ReadFromGpuMemory	read_cmd{ BinArrayRef::From( timestamps ) };
+	result_buffer->Send( read_cmd );
+
+	CHECK_ERR( read_cmd.result->Size() == BytesU::SizeOf(timestamps) );
+	CHECK_ERR( timestamps[0] > 0 );
+	CHECK_ERR( timestamps[1] >= timestamps[0] );
+
+	GpuMsg::GetDeviceProperties		req_props;
+	gpuThread->Send( req_props );
+
+	const TimeD	time = TimeD::FromNanoSeconds( double(timestamps[1] - timestamps[0]) * req_props.result->timestampPeriod );
+
+	LOG( "QueryTimestamp - OK, fill buffer time: "_str << ToString( time ), ELog::Info );
+	return true;
+}
@@ -55,3 +55,47 @@ extern void Test_ComputeApi (StringCRef device, bool debug)
 	GetMainSystemInstance()->Send( ModuleMsg::Delete{} );
 	#endif
 }
+
+extern void Bench_ComputeApi (StringCRef device, bool debug)
+{
+	CHECK( OS::FileSystem::FindAndSetCurrentDir( "EngineTests/Platforms.GAPI/Compute" ) );
+
+	#ifdef GRAPHICS_API_VULKAN
+	{
+		CApp	app;
+		app.Initialize( "VK 1.0"_GAPI, device, debug );
+		app.EnableBenchmarks( "bench_compute_vk" );
+
+		for (; app.Update();) {}
+
+		app.Quit();
+	}
+	GetMainSystemInstance()->Send( ModuleMsg::Delete{} );
+	#endif
+	
+	#ifdef COMPUTE_API_OPENCL
+	{
+		CApp	app;
+		app.Initialize( "CL 1.2"_GAPI, device, debug );
+		app.EnableBenchmarks( "bench_compute_cl" );
+
+		for (; app.Update();) {}
+
+		app.Quit();
+	}
+	GetMainSystemInstance()->Send( ModuleMsg::Delete{} );
+	#endif
+	
+	#ifdef GRAPHICS_API_SOFT
+	{
+		CApp	app;
+		app.Initialize( "SW 1.0"_GAPI, device, debug );
+		app.EnableBenchmarks( "bench_compute_sw" );
+
+		for (; app.Update();) {}
+
+		app.Quit();
+	}
+	GetMainSystemInstance()->Send( ModuleMsg::Delete{} );
+	#endif
+}
@@ -8,6 +8,7 @@ extern void Test_Sharing (StringCRef device, bool debug);
 extern void Test_PipelineCompiler (StringCRef device, bool debug);
 extern void Test_MultiGPU (StringCRef device, bool debug);
 extern void Test_Window ();
+extern void Bench_ComputeApi (StringCRef device, bool debug);
 
 
 /*
@@ -30,6 +31,7 @@ int main ()
 	Test_Sharing( device, debug );
 	//Test_MultiGPU( device, debug );
 	//Test_Window();
+	//Bench_ComputeApi( device, debug );
 
 	return 0;
 }
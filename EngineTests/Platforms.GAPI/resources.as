@@ -36,6 +36,31 @@ void main ()
 		rpack.ConvertPipelines( "Compiler/Pipelines" );
 	}
 	
+	// setup compute pipeline compiler with AST optimizer
+	{
+		Pipeline_ConverterConfig	cfg;
+		
+		cfg.searchForSharedTypes	= true;
+		cfg.addPaddingToStructs		= true;
+		cfg.optimizeSource			= true;
+		cfg.optimizeBindings		= false;
+		cfg.minimalRebuild			= true;
+		cfg.softwareShaderSource	= true;		// to test runtime compilation of C++ shaders
+		cfg.nameSpace				= "OptimizedPipelines";
+		cfg.targets					|= EShaderFormat_GLSL_450;
+		cfg.targets					|= EShaderFormat_VK_100_SPIRV;
+		cfg.targets					|= EShaderFormat_CL_120;
+		cfg.targets					|= EShaderFormat_Soft_100_Exe;
+		
+		rpack.SetConfig( cfg );
+	}
+
+	// convert the same pipelines to compare results with unoptimized version
+	{
+		rpack.AddAllPipelines( "Compiler/Pipelines" );
+		rpack.ConvertPipelines( "Compiler/Pipelines/Optimized" );
+	}
+	
 	// setup graphics pipeline compiler
 	{
 		Pipeline_ConverterConfig	cfg;
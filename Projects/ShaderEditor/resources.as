@@ -10,7 +10,7 @@ void main ()
 		
 		cfg.searchForSharedTypes	= true;
 		cfg.addPaddingToStructs		= true;
-		cfg.optimizeSource			= false;
+		cfg.optimizeSource			= true;
 		cfg.optimizeBindings		= true;
 		cfg.minimalRebuild			= true;
 		cfg.nameSpace				= "Pipelines";